@@ -17,6 +17,7 @@
 
 #include <geos/geom/prep/PreparedGeometryFactory.h> 
 #include <geos/index/strtree/STRtree.h>
+#include <geos/index/strtree/PackedSTRtree.h>
 #include <geos/io/WKTReader.h>
 #include <geos/io/WKBReader.h>
 #include <geos/io/WKTWriter.h>
@@ -35,6 +36,7 @@
 #define GEOSPreparedGeometry geos::geom::prep::PreparedGeometry
 #define GEOSCoordSequence geos::geom::CoordinateSequence
 #define GEOSSTRtree geos::index::strtree::STRtree
+#define GEOSPackedSTRtree geos::index::strtree::PackedSTRtree
 #define GEOSWKTReader_t geos::io::WKTReader
 #define GEOSWKTWriter_t geos::io::WKTWriter
 #define GEOSWKBReader_t geos::io::WKBReader
@@ -72,6 +74,7 @@ using geos::io::WKBWriter;
 using geos::io::CLocalizer;
 
 using geos::index::strtree::STRtree;
+using geos::index::strtree::PackedSTRtree;
 
 using geos::operation::overlay::OverlayOp;
 using geos::operation::overlay::overlayOp;
@@ -84,6 +87,9 @@ typedef std::auto_ptr<Geometry> GeomAutoPtr;
 // NOTE: SRID will have to be changed after geometry creation
 GEOSContextHandle_t handle = NULL;
 
+// Defined in geos_ts_c.cpp
+void freeThreadContextPool();
+
 extern "C" {
 
 void
@@ -107,6 +113,7 @@ finishGEOS ()
         finishGEOS_r( handle );
         handle = NULL;
     }
+    freeThreadContextPool();
 }
 
 void 
@@ -254,6 +261,12 @@ GEOSDistance(const Geometry *g1, const Geometry *g2, double *dist)
     return GEOSDistance_r( handle, g1, g2, dist );
 }
 
+char
+GEOSDistanceWithin(const Geometry *g1, const Geometry *g2, double dist)
+{
+    return GEOSDistanceWithin_r( handle, g1, g2, dist );
+}
+
 int
 GEOSHausdorffDistance(const Geometry *g1, const Geometry *g2, double *dist)
 {
@@ -317,6 +330,20 @@ GEOSGeomFromHEX_buf(const unsigned char *hex, size_t size)
     return GEOSGeomFromHEX_buf_r( handle, hex, size );
 }
 
+int
+GEOSGeomFromWKB_batch(const unsigned char* const* wkbs, const size_t* sizes,
+                      size_t n, unsigned int numThreads, Geometry** geoms)
+{
+    return GEOSGeomFromWKB_batch_r( handle, wkbs, sizes, n, numThreads, geoms );
+}
+
+int
+GEOSGeomFromWKT_batch(const char* const* wkts, size_t n,
+                      unsigned int numThreads, Geometry** geoms)
+{
+    return GEOSGeomFromWKT_batch_r( handle, wkts, n, numThreads, geoms );
+}
+
 char
 GEOSisEmpty(const Geometry *g1)
 {
@@ -436,6 +463,12 @@ GEOSUnaryUnion(const Geometry *g1)
     return GEOSUnaryUnion_r( handle, g1);
 }
 
+Geometry *
+GEOSUnaryUnionParallel(const Geometry *g1, unsigned int numThreads)
+{
+    return GEOSUnaryUnionParallel_r( handle, g1, numThreads );
+}
+
 Geometry *
 GEOSUnionCascaded(const Geometry *g1)
 {
@@ -621,6 +654,13 @@ GEOSPolygonize(const Geometry * const * g, unsigned int ngeoms)
     return GEOSPolygonize_r( handle, g, ngeoms );
 }
 
+Geometry *
+GEOSPolygonizeParallel(const Geometry * const * g, unsigned int ngeoms,
+                       unsigned int numThreads)
+{
+    return GEOSPolygonizeParallel_r( handle, g, ngeoms, numThreads );
+}
+
 Geometry *
 GEOSPolygonizer_getCutEdges(const Geometry * const * g, unsigned int ngeoms)
 {
@@ -682,6 +722,18 @@ GEOS_setWKBByteOrder(int byteOrder)
 	return GEOS_setWKBByteOrder_r( handle, byteOrder );
 }
 
+int
+GEOS_setGeometryCounting(int enable)
+{
+	return GEOS_setGeometryCounting_r( handle, enable );
+}
+
+int
+GEOS_getGeometryCounts(size_t *created, size_t *live)
+{
+	return GEOS_getGeometryCounts_r( handle, created, live );
+}
+
 
 CoordinateSequence *
 GEOSCoordSeq_create(unsigned int size, unsigned int dims)
@@ -809,6 +861,12 @@ GEOSGeom_getCoordinateDimension(const Geometry *g)
     return GEOSGeom_getCoordinateDimension_r( handle, g );
 }
 
+size_t
+GEOSGeom_getMemoryUsage(const Geometry *g)
+{
+    return GEOSGeom_getMemoryUsage_r( handle, g );
+}
+
 Geometry *
 GEOSSimplify(const Geometry *g1, double tolerance)
 {
@@ -1058,6 +1116,122 @@ GEOSPreparedWithin(const geos::geom::prep::PreparedGeometry *pg1, const Geometry
     return GEOSPreparedWithin_r( handle, pg1, g2 );
 }
 
+int
+GEOSPreparedDistance(const geos::geom::prep::PreparedGeometry *pg1, const Geometry *g2, double *dist)
+{
+    return GEOSPreparedDistance_r( handle, pg1, g2, dist );
+}
+
+char
+GEOSPreparedDistanceWithin(const geos::geom::prep::PreparedGeometry *pg1, const Geometry *g2, double dist)
+{
+    return GEOSPreparedDistanceWithin_r( handle, pg1, g2, dist );
+}
+
+int
+GEOSPreparedContains_many(const geos::geom::prep::PreparedGeometry *pg1,
+        const Geometry* const* geoms, size_t n, unsigned int numThreads,
+        char* results)
+{
+    return GEOSPreparedContains_many_r( handle, pg1, geoms, n, numThreads, results );
+}
+
+int
+GEOSPreparedContainsProperly_many(const geos::geom::prep::PreparedGeometry *pg1,
+        const Geometry* const* geoms, size_t n, unsigned int numThreads,
+        char* results)
+{
+    return GEOSPreparedContainsProperly_many_r( handle, pg1, geoms, n, numThreads, results );
+}
+
+int
+GEOSPreparedCovers_many(const geos::geom::prep::PreparedGeometry *pg1,
+        const Geometry* const* geoms, size_t n, unsigned int numThreads,
+        char* results)
+{
+    return GEOSPreparedCovers_many_r( handle, pg1, geoms, n, numThreads, results );
+}
+
+int
+GEOSPreparedIntersects_many(const geos::geom::prep::PreparedGeometry *pg1,
+        const Geometry* const* geoms, size_t n, unsigned int numThreads,
+        char* results)
+{
+    return GEOSPreparedIntersects_many_r( handle, pg1, geoms, n, numThreads, results );
+}
+
+int
+GEOSContext_setPreparedCacheSize(unsigned int size)
+{
+    return GEOSContext_setPreparedCacheSize_r( handle, size );
+}
+
+int
+GEOSContext_getPreparedCacheStats(unsigned long *hits, unsigned long *misses)
+{
+    return GEOSContext_getPreparedCacheStats_r( handle, hits, misses );
+}
+
+char
+GEOSPreparedContains_cached(const Geometry *g1, const Geometry *g2)
+{
+    return GEOSPreparedContains_cached_r( handle, g1, g2 );
+}
+
+char
+GEOSPreparedContainsProperly_cached(const Geometry *g1, const Geometry *g2)
+{
+    return GEOSPreparedContainsProperly_cached_r( handle, g1, g2 );
+}
+
+char
+GEOSPreparedCoveredBy_cached(const Geometry *g1, const Geometry *g2)
+{
+    return GEOSPreparedCoveredBy_cached_r( handle, g1, g2 );
+}
+
+char
+GEOSPreparedCovers_cached(const Geometry *g1, const Geometry *g2)
+{
+    return GEOSPreparedCovers_cached_r( handle, g1, g2 );
+}
+
+char
+GEOSPreparedCrosses_cached(const Geometry *g1, const Geometry *g2)
+{
+    return GEOSPreparedCrosses_cached_r( handle, g1, g2 );
+}
+
+char
+GEOSPreparedDisjoint_cached(const Geometry *g1, const Geometry *g2)
+{
+    return GEOSPreparedDisjoint_cached_r( handle, g1, g2 );
+}
+
+char
+GEOSPreparedIntersects_cached(const Geometry *g1, const Geometry *g2)
+{
+    return GEOSPreparedIntersects_cached_r( handle, g1, g2 );
+}
+
+char
+GEOSPreparedOverlaps_cached(const Geometry *g1, const Geometry *g2)
+{
+    return GEOSPreparedOverlaps_cached_r( handle, g1, g2 );
+}
+
+char
+GEOSPreparedTouches_cached(const Geometry *g1, const Geometry *g2)
+{
+    return GEOSPreparedTouches_cached_r( handle, g1, g2 );
+}
+
+char
+GEOSPreparedWithin_cached(const Geometry *g1, const Geometry *g2)
+{
+    return GEOSPreparedWithin_cached_r( handle, g1, g2 );
+}
+
 STRtree *
 GEOSSTRtree_create (size_t nodeCapacity)
 {
@@ -1097,12 +1271,92 @@ GEOSSTRtree_remove (geos::index::strtree::STRtree *tree,
     return GEOSSTRtree_remove_r( handle, tree, g, item );
 }
 
+int
+GEOSSTRtree_nearest (geos::index::strtree::STRtree *tree,
+                     const void *item,
+                     const geos::geom::Geometry *itemEnvelope,
+                     size_t k,
+                     GEOSDistanceCallback distancefn,
+                     void *userdata,
+                     void **results)
+{
+    return GEOSSTRtree_nearest_r( handle, tree, item, itemEnvelope, k,
+                                  distancefn, userdata, results );
+}
+
+int
+GEOSSTRtree_query_batch (geos::index::strtree::STRtree *tree,
+                         const geos::geom::Geometry *const *geoms,
+                         size_t numGeoms,
+                         size_t **offsets,
+                         void ***items)
+{
+    return GEOSSTRtree_query_batch_r( handle, tree, geoms, numGeoms,
+                                      offsets, items );
+}
+
+int
+GEOSSTRtree_join (geos::index::strtree::STRtree *tree1,
+                  geos::index::strtree::STRtree *tree2,
+                  int predicate,
+                  GEOSJoinCallback callback,
+                  void *userdata)
+{
+    return GEOSSTRtree_join_r( handle, tree1, tree2, predicate,
+                               callback, userdata );
+}
+
 void
 GEOSSTRtree_destroy (geos::index::strtree::STRtree *tree)
 {
     GEOSSTRtree_destroy_r( handle, tree );
 }
 
+PackedSTRtree *
+GEOSPackedSTRtree_create (size_t nodeCapacity)
+{
+    return GEOSPackedSTRtree_create_r( handle, nodeCapacity );
+}
+
+void
+GEOSPackedSTRtree_insert (PackedSTRtree *tree,
+                          const geos::geom::Geometry *g,
+                          void *item)
+{
+    GEOSPackedSTRtree_insert_r( handle, tree, g, item );
+}
+
+void
+GEOSPackedSTRtree_query (PackedSTRtree *tree,
+                         const geos::geom::Geometry *g, 
+                         GEOSQueryCallback cb,
+                         void *userdata)
+{
+    GEOSPackedSTRtree_query_r( handle, tree, g, cb, userdata );
+}
+
+void 
+GEOSPackedSTRtree_iterate(PackedSTRtree *tree,
+                          GEOSQueryCallback callback,
+                          void *userdata)
+{
+    GEOSPackedSTRtree_iterate_r( handle, tree, callback, userdata );
+}
+
+char
+GEOSPackedSTRtree_remove (PackedSTRtree *tree,
+                          const geos::geom::Geometry *g,
+                          void *item)
+{
+    return GEOSPackedSTRtree_remove_r( handle, tree, g, item );
+}
+
+void
+GEOSPackedSTRtree_destroy (PackedSTRtree *tree)
+{
+    GEOSPackedSTRtree_destroy_r( handle, tree );
+}
+
 double
 GEOSProject (const geos::geom::Geometry *g,
              const geos::geom::Geometry *p)
@@ -16,10 +16,12 @@
  *
  ***********************************************************************/
 
-#include <geos/platform.h>  // for FINITE
+#include <geos/platform.h>  // for FINITE, HAVE_PTHREAD
 #include <geos/geom/Geometry.h> 
 #include <geos/geom/prep/PreparedGeometry.h> 
 #include <geos/geom/prep/PreparedGeometryFactory.h> 
+#include <geos/geom/prep/PreparedJoinFilter.h>
+#include <geos/geom/prep/PreparedGeometryCache.h>
 #include <geos/geom/GeometryCollection.h> 
 #include <geos/geom/Polygon.h> 
 #include <geos/geom/Point.h> 
@@ -34,8 +36,14 @@
 #include <geos/geom/Coordinate.h> 
 #include <geos/geom/IntersectionMatrix.h> 
 #include <geos/geom/Envelope.h> 
+#include <geos/geom/GeometryComponentFilter.h>
 #include <geos/index/strtree/STRtree.h> 
+#include <geos/index/strtree/PackedSTRtree.h>
+#include <geos/index/strtree/ItemBoundable.h>
+#include <geos/index/strtree/ItemDistance.h>
+#include <geos/index/strtree/GeometryItemDistance.h>
 #include <geos/index/ItemVisitor.h>
+#include <geos/index/ItemPairVisitor.h>
 #include <geos/io/WKTReader.h>
 #include <geos/io/WKBReader.h>
 #include <geos/io/WKTWriter.h>
@@ -50,6 +58,7 @@
 #include <geos/operation/linemerge/LineMerger.h>
 #include <geos/operation/overlay/OverlayOp.h>
 #include <geos/operation/union/CascadedPolygonUnion.h>
+#include <geos/operation/union/UnaryUnionOp.h>
 #include <geos/operation/buffer/BufferOp.h>
 #include <geos/operation/buffer/BufferParameters.h>
 #include <geos/operation/buffer/BufferBuilder.h>
@@ -60,19 +69,28 @@
 #include <geos/util/IllegalArgumentException.h>
 #include <geos/util/UniqueCoordinateArrayFilter.h>
 #include <geos/util/Machine.h>
+#include <geos/util/TaskGroup.h>
 #include <geos/version.h> 
 
 // This should go away
+#include <algorithm>
 #include <cmath> // finite
 #include <cstddef>
 #include <cstdio>
 #include <cstdlib>
 #include <cstring>
+#include <cstdarg>
 #include <fstream>
 #include <iostream>
 #include <sstream>
 #include <string>
 #include <memory>
+#include <new>
+#include <vector>
+
+#if defined(HAVE_PTHREAD) && ! defined(_WIN32)
+# include <pthread.h>
+#endif
 
 #ifdef _MSC_VER
 #pragma warning(disable : 4099)
@@ -85,6 +103,7 @@
 #define GEOSCoordSequence geos::geom::CoordinateSequence
 #define GEOSBufferParams geos::operation::buffer::BufferParameters
 #define GEOSSTRtree geos::index::strtree::STRtree
+#define GEOSPackedSTRtree geos::index::strtree::PackedSTRtree
 #define GEOSWKTReader_t geos::io::WKTReader
 #define GEOSWKTWriter_t geos::io::WKTWriter
 #define GEOSWKBReader_t geos::io::WKBReader
@@ -130,13 +149,86 @@ typedef std::auto_ptr<Geometry> GeomAutoPtr;
 typedef struct GEOSContextHandleInternal
 {
     const GeometryFactory *geomFactory;
-    GEOSMessageHandler NOTICE_MESSAGE;
-    GEOSMessageHandler ERROR_MESSAGE;
+    GEOSMessageHandler noticeHandler;
+    GEOSMessageHandler errorHandler;
     int WKBOutputDims;
     int WKBByteOrder;
     int initialized;
+    // Built on first use by the *_cached predicates
+    geos::geom::prep::PreparedGeometryCache *preparedCache;
+    // GEOS_ERROR_CALL_HANDLER or GEOS_ERROR_RECORD
+    int errorMode;
+    // Errors reported since the last GEOSContext_getLastError_r
+    int errorCount;
+    char lastError[1024];
+    // Next released handle in the pool of a thread
+    GEOSContextHandleInternal *nextFree;
+
+    // Report to the handlers, printf style
+    void NOTICE_MESSAGE(const char *fmt, ...);
+    void ERROR_MESSAGE(const char *fmt, ...);
 } GEOSContextHandleInternal_t;
 
+#if defined(_MSC_VER) && _MSC_VER < 1900
+# define vsnprintf _vsnprintf
+#endif
+
+namespace { // anonymous
+
+/*
+ * Copies a printf style message to buf, only formatting it when it
+ * has arguments other than a single string, as most of ours do not.
+ */
+void
+copyMessage(char *buf, std::size_t size, const char *fmt, va_list ap)
+{
+    const char *msg = fmt;
+    if ( 0 == std::strcmp(fmt, "%s") )
+    {
+        msg = va_arg(ap, const char *);
+    }
+    else if ( std::strchr(fmt, '%') )
+    {
+        vsnprintf(buf, size, fmt, ap);
+        buf[size-1] = '\0';
+        return;
+    }
+
+    std::strncpy(buf, msg, size-1);
+    buf[size-1] = '\0';
+}
+
+} // namespace anonymous
+
+void
+GEOSContextHandleInternal::NOTICE_MESSAGE(const char *fmt, ...)
+{
+    if ( ! noticeHandler ) return;
+
+    char msg[sizeof(lastError)];
+    va_list ap;
+    va_start(ap, fmt);
+    copyMessage(msg, sizeof(msg), fmt, ap);
+    va_end(ap);
+
+    noticeHandler("%s", msg);
+}
+
+void
+GEOSContextHandleInternal::ERROR_MESSAGE(const char *fmt, ...)
+{
+    va_list ap;
+    va_start(ap, fmt);
+    copyMessage(lastError, sizeof(lastError), fmt, ap);
+    va_end(ap);
+    ++errorCount;
+
+    if ( errorMode == GEOS_ERROR_CALL_HANDLER && errorHandler )
+    {
+        errorHandler("%s", lastError);
+    }
+}
+
 // CAPI_ItemVisitor is used internally by the CAPI STRtree
 // wrappers. It's defined here just to keep it out of the
 // extern "C" block.
@@ -149,6 +241,42 @@ class CAPI_ItemVisitor : public geos::index::ItemVisitor {
     void visitItem (void *item) { callback(item, userdata); }
 };
 
+// CAPI_ItemPairVisitor is used internally by the CAPI STRtree
+// join wrapper to call back a user-provided function.
+class CAPI_ItemPairVisitor : public geos::index::ItemPairVisitor {
+    GEOSJoinCallback callback;
+    void *userdata;
+  public:
+    CAPI_ItemPairVisitor (GEOSJoinCallback cb, void *ud)
+        : ItemPairVisitor(), callback(cb), userdata(ud) {}
+    void visitItemPair (void *item1, void *item2)
+    {
+        callback(item1, item2, userdata);
+    }
+};
+
+// CAPI_ItemDistance is used internally by the CAPI STRtree
+// nearest neighbour wrapper to call back a user-provided
+// distance function.
+class CAPI_ItemDistance : public geos::index::strtree::ItemDistance {
+    GEOSDistanceCallback distancefn;
+    void *userdata;
+  public:
+    CAPI_ItemDistance (GEOSDistanceCallback df, void *ud)
+        : ItemDistance(), distancefn(df), userdata(ud) {}
+    double distance (const geos::index::strtree::ItemBoundable* item1,
+                     const geos::index::strtree::ItemBoundable* item2)
+    {
+        double d;
+        if ( 0 == distancefn(item1->getItem(), item2->getItem(),
+                             &d, userdata) )
+        {
+            throw std::runtime_error("Failed to compute distance.");
+        }
+        return d;
+    }
+};
+
 
 //## PROTOTYPES #############################################
 
@@ -182,88 +310,16 @@ char* gstrdup(std::string const& str)
     return gstrdup_s(str.c_str(), str.size());
 }
 
-} // namespace anonymous
-
-extern "C" {
-
-GEOSContextHandle_t
-initGEOS_r(GEOSMessageHandler nf, GEOSMessageHandler ef)
-{
-    GEOSContextHandleInternal_t *handle = 0;
-    void *extHandle = 0;
-
-    extHandle = std::malloc(sizeof(GEOSContextHandleInternal_t));
-    if (0 != extHandle)
-    {
-        handle = static_cast<GEOSContextHandleInternal_t*>(extHandle);
-        handle->NOTICE_MESSAGE = nf;
-        handle->ERROR_MESSAGE = ef;
-        handle->geomFactory = GeometryFactory::getDefaultInstance();
-        handle->WKBOutputDims = 2;
-        handle->WKBByteOrder = getMachineByteOrder();
-        handle->initialized = 1;
-    }
-
-    return static_cast<GEOSContextHandle_t>(extHandle);
-}
-
-GEOSMessageHandler
-GEOSContext_setNoticeHandler_r(GEOSContextHandle_t extHandle, GEOSMessageHandler nf)
-{
-    GEOSMessageHandler f;
-    GEOSContextHandleInternal_t *handle = 0;
-    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
-    if ( 0 == handle->initialized )
-    {
-        return NULL;
-    }
-
-    f = handle->NOTICE_MESSAGE;
-    handle->NOTICE_MESSAGE = nf;
-
-    return f;
-}
-
-GEOSMessageHandler
-GEOSContext_setErrorHandler_r(GEOSContextHandle_t extHandle, GEOSMessageHandler nf)
-{
-    GEOSMessageHandler f;
-    GEOSContextHandleInternal_t *handle = 0;
-    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
-    if ( 0 == handle->initialized )
-    {
-        return NULL;
-    }
-
-    f = handle->ERROR_MESSAGE;
-    handle->ERROR_MESSAGE = nf;
-
-    return f;
-}
-
-void
-finishGEOS_r(GEOSContextHandle_t extHandle)
-{
-    // Fix up freeing handle w.r.t. malloc above
-    std::free(extHandle);
-    extHandle = NULL;
-}
-
-void 
-GEOSFree_r (GEOSContextHandle_t extHandle, void* buffer) 
-{ 
-    assert(0 != extHandle);
-
-    std::free(buffer); 
-} 
-
-//-----------------------------------------------------------
-// relate()-related functions
-//  return 0 = false, 1 = true, 2 = error occured
-//-----------------------------------------------------------
+typedef bool (geos::geom::prep::PreparedGeometry::*PreparedPredicate)(
+        const Geometry*) const;
 
+/*
+ * Evaluates a predicate between g1, prepared by the context cache,
+ * and g2. Returns 2 on exception, 1 on true, 0 on false.
+ */
 char
-GEOSDisjoint_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *g2)
+cachedPredicate(GEOSContextHandle_t extHandle, const Geometry *g1,
+                const Geometry *g2, PreparedPredicate predicate)
 {
     if ( 0 == extHandle )
     {
@@ -272,20 +328,23 @@ GEOSDisjoint_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry
 
     GEOSContextHandleInternal_t *handle = 0;
     handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
-    if ( handle->initialized == 0 )
+    if ( 0 == handle->initialized )
     {
         return 2;
     }
 
     try
     {
-        bool result = g1->disjoint(g2);
+        using geos::geom::prep::PreparedGeometryCache;
+        if ( 0 == handle->preparedCache )
+        {
+            handle->preparedCache = new PreparedGeometryCache();
+        }
+        const geos::geom::prep::PreparedGeometry& pg =
+            handle->preparedCache->get(*g1);
+        bool result = (pg.*predicate)(g2);
         return result;
     }
-
-    // TODO: mloskot is going to replace these double-catch block
-    // with a macro to remove redundant code in this and
-    // following functions.
     catch (const std::exception &e)
     {
         handle->ERROR_MESSAGE("%s", e.what());
@@ -298,121 +357,290 @@ GEOSDisjoint_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry
     return 2;
 }
 
-char
-GEOSTouches_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *g2)
+/*
+ * Decodes inputs [begin, end) of a batch with readers of its own,
+ * building geometries on the context factory. Failures leave a NULL
+ * geometry; the first one is remembered for the caller to report.
+ * Either wkbs (and sizes) or wkts are given.
+ */
+class CAPI_DecodeTask : public geos::util::Task
 {
-    if ( 0 == extHandle )
-    {
-        return 2;
-    }
+public:
 
-    GEOSContextHandleInternal_t *handle = 0;
-    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
-    if ( 0 == handle->initialized )
-    {
-        return 2;
-    }
+    CAPI_DecodeTask(const GeometryFactory* f,
+                    const unsigned char* const* w, const std::size_t* s,
+                    const char* const* t,
+                    std::size_t b, std::size_t e, Geometry** out)
+        : factory(f), wkbs(w), sizes(s), wkts(t), begin(b), end(e),
+          geoms(out), numDecoded(0), firstError(e)
+    {}
 
-    try
-    {
-        bool result = g1->touches(g2);
-        return result;
-    }
-    catch (const std::exception &e)
+    void run()
     {
-        handle->ERROR_MESSAGE("%s", e.what());
+        using geos::io::WKBReader;
+        WKBReader wkbReader(*factory);
+        WKTReader wktReader(factory);
+
+        for (std::size_t i=begin; i<end; ++i)
+        {
+            geoms[i] = 0;
+            try
+            {
+                if ( wkbs )
+                {
+                    if ( ! wkbs[i] ) throw std::runtime_error("NULL input");
+                    geoms[i] = wkbReader.read(wkbs[i], sizes[i]);
+                }
+                else
+                {
+                    if ( ! wkts[i] ) throw std::runtime_error("NULL input");
+                    geoms[i] = wktReader.read(std::string(wkts[i]));
+                }
+                ++numDecoded;
+            }
+            catch (const std::exception& e)
+            {
+                fail(i, e.what());
+            }
+            catch (...)
+            {
+                fail(i, "Unknown exception thrown");
+            }
+        }
     }
-    catch (...)
+
+    const GeometryFactory* factory;
+    const unsigned char* const* wkbs;
+    const std::size_t* sizes;
+    const char* const* wkts;
+    std::size_t begin;
+    std::size_t end;
+    Geometry** geoms;
+
+    std::size_t numDecoded;
+    std::size_t firstError; // end if none
+    std::string errorMessage;
+
+private:
+
+    void fail(std::size_t i, const char* msg)
     {
-        handle->ERROR_MESSAGE("Unknown exception thrown");
+        if ( firstError != end ) return;
+        firstError = i;
+        errorMessage = msg;
     }
-    
-    return 2;
-}
+};
 
-char
-GEOSIntersects_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *g2)
+/*
+ * Decodes a batch of WKB or WKT inputs on numThreads threads,
+ * see GEOSGeomFromWKB_batch_r.
+ */
+int
+decodeBatch(GEOSContextHandleInternal_t* handle,
+            const unsigned char* const* wkbs, const std::size_t* sizes,
+            const char* const* wkts, std::size_t n,
+            unsigned int numThreads, Geometry** geoms)
 {
-    if ( 0 == extHandle )
-    {
-        return 2;
-    }
+    const GeometryFactory* factory =
+        static_cast<GeometryFactory const*>(handle->geomFactory);
 
-    GEOSContextHandleInternal_t *handle = 0;
-    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
-    if ( 0 == handle->initialized )
-    {
-        return 2;
-    }
+    geos::util::TaskGroup group(numThreads);
 
-    try
-    {
-        bool result = g1->intersects(g2);
-        return result;
-    }
-    catch (const std::exception &e)
+    // A few chunks per thread even out the load of
+    // inputs of different sizes
+    std::size_t numChunks = std::min(n, 4 * group.getNumThreads());
+    std::vector<CAPI_DecodeTask> tasks;
+    tasks.reserve(numChunks);
+    for (std::size_t c=0; c<numChunks; ++c)
     {
-        handle->ERROR_MESSAGE("%s", e.what());
+        tasks.push_back(CAPI_DecodeTask(factory, wkbs, sizes, wkts,
+                                        n * c / numChunks,
+                                        n * (c+1) / numChunks, geoms));
     }
-    catch (...)
+    for (std::size_t c=0; c<numChunks; ++c) group.add(&tasks[c]);
+    group.run();
+
+    std::size_t numDecoded = 0;
+    bool reported = false;
+    for (std::size_t c=0; c<numChunks; ++c)
     {
-        handle->ERROR_MESSAGE("Unknown exception thrown");
+        const CAPI_DecodeTask& t = tasks[c];
+        numDecoded += t.numDecoded;
+        if ( ! reported && t.firstError != t.end )
+        {
+            handle->ERROR_MESSAGE("Error decoding geometry %u: %s",
+                static_cast<unsigned int>(t.firstError),
+                t.errorMessage.c_str());
+            reported = true;
+        }
     }
-    
-    return 2;
+
+    return static_cast<int>(numDecoded);
 }
 
-char
-GEOSCrosses_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *g2)
+typedef bool (geos::geom::prep::PreparedGeometry::*PreparedPredicate)(
+        const Geometry*) const;
+
+/*
+ * Evaluates a prepared predicate against inputs [begin, end) of
+ * a batch. Failures get a result of 2; the first one is remembered
+ * for the caller to report.
+ */
+class CAPI_PredicateTask : public geos::util::Task
 {
-    if ( 0 == extHandle )
+public:
+
+    CAPI_PredicateTask(const geos::geom::prep::PreparedGeometry* p,
+                       PreparedPredicate pr, const Geometry* const* g,
+                       std::size_t b, std::size_t e, char* out)
+        : prep(p), pred(pr), geoms(g), begin(b), end(e), results(out),
+          numTrue(0), firstError(e)
+    {}
+
+    void run()
     {
-        return 2;
+        for (std::size_t i=begin; i<end; ++i)
+        {
+            results[i] = 2;
+            try
+            {
+                if ( ! geoms[i] ) throw std::runtime_error("NULL input");
+                bool result = (prep->*pred)(geoms[i]);
+                results[i] = result;
+                if ( result ) ++numTrue;
+            }
+            catch (const std::exception& e)
+            {
+                fail(i, e.what());
+            }
+            catch (...)
+            {
+                fail(i, "Unknown exception thrown");
+            }
+        }
     }
 
-    GEOSContextHandleInternal_t *handle = 0;
-    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
-    if ( 0 == handle->initialized )
+    const geos::geom::prep::PreparedGeometry* prep;
+    PreparedPredicate pred;
+    const Geometry* const* geoms;
+    std::size_t begin;
+    std::size_t end;
+    char* results;
+
+    std::size_t numTrue;
+    std::size_t firstError; // end if none
+    std::string errorMessage;
+
+private:
+
+    void fail(std::size_t i, const char* msg)
     {
-        return 2;
+        if ( firstError != end ) return;
+        firstError = i;
+        errorMessage = msg;
     }
+};
 
-    try
-    {
-        bool result = g1->crosses(g2);
-        return result;
+/// Computes the cached envelope of each component
+class CAPI_EnvelopeComputer : public geos::geom::GeometryComponentFilter
+{
+public:
+    void filter_ro(const Geometry* g) { g->getEnvelopeInternal(); }
+    void filter_rw(Geometry* g) { g->getEnvelopeInternal(); }
+};
+
+/*
+ * Batches smaller than this per thread are not worth
+ * starting more threads for
+ */
+const std::size_t MIN_PREDICATES_PER_THREAD = 256;
+
+/*
+ * Evaluates a prepared predicate against a batch of geometries
+ * on numThreads threads, see GEOSPreparedIntersects_many_r.
+ */
+int
+predicateBatch(GEOSContextHandleInternal_t* handle,
+               const geos::geom::prep::PreparedGeometry* pg,
+               PreparedPredicate pred, const Geometry* const* geoms,
+               std::size_t n, unsigned int numThreads, char* results)
+{
+    std::size_t maxThreads = numThreads ? numThreads
+                           : geos::util::TaskGroup::getNumProcessors();
+    maxThreads = std::min(maxThreads,
+        (n + MIN_PREDICATES_PER_THREAD - 1) / MIN_PREDICATES_PER_THREAD);
+    geos::util::TaskGroup group(std::max(maxThreads, std::size_t(1)));
+
+    if ( group.getNumThreads() > 1 )
+    {
+        // Compute all lazily computed state before the tasks
+        // start, so that they only read the shared geometries
+        pg->buildIndexes();
+        CAPI_EnvelopeComputer computer;
+        for (std::size_t i=0; i<n; ++i)
+        {
+            if ( geoms[i] ) geoms[i]->apply_ro(&computer);
+        }
     }
-    catch (const std::exception &e)
+
+    // A few chunks per thread even out the load of
+    // inputs of different sizes
+    std::size_t numChunks = std::min(n, 4 * group.getNumThreads());
+    std::vector<CAPI_PredicateTask> tasks;
+    tasks.reserve(numChunks);
+    for (std::size_t c=0; c<numChunks; ++c)
     {
-        handle->ERROR_MESSAGE("%s", e.what());
+        tasks.push_back(CAPI_PredicateTask(pg, pred, geoms,
+                                           n * c / numChunks,
+                                           n * (c+1) / numChunks, results));
     }
-    catch (...)
+    for (std::size_t c=0; c<numChunks; ++c) group.add(&tasks[c]);
+    group.run();
+
+    std::size_t numTrue = 0;
+    bool reported = false;
+    for (std::size_t c=0; c<numChunks; ++c)
     {
-        handle->ERROR_MESSAGE("Unknown exception thrown");
+        const CAPI_PredicateTask& t = tasks[c];
+        numTrue += t.numTrue;
+        if ( ! reported && t.firstError != t.end )
+        {
+            handle->ERROR_MESSAGE("Error evaluating geometry %u: %s",
+                static_cast<unsigned int>(t.firstError),
+                t.errorMessage.c_str());
+            reported = true;
+        }
     }
-    
-    return 2;
+
+    return static_cast<int>(numTrue);
 }
 
-char
-GEOSWithin_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *g2)
+/*
+ * The context checks and exception handling
+ * of the GEOSPrepared*_many_r functions
+ */
+int
+predicateBatch_r(GEOSContextHandle_t extHandle,
+                 const geos::geom::prep::PreparedGeometry* pg,
+                 PreparedPredicate pred, const Geometry* const* geoms,
+                 std::size_t n, unsigned int numThreads, char* results)
 {
     if ( 0 == extHandle )
     {
-        return 2;
+        return -1;
     }
 
     GEOSContextHandleInternal_t *handle = 0;
     handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
     if ( 0 == handle->initialized )
     {
-        return 2;
+        return -1;
     }
 
     try
     {
-        bool result = g1->within(g2);
-        return result;
+        return predicateBatch(handle, pg, pred, geoms, n, numThreads,
+                              results);
     }
     catch (const std::exception &e)
     {
@@ -422,48 +650,299 @@ GEOSWithin_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *
     {
         handle->ERROR_MESSAGE("Unknown exception thrown");
     }
-    
-    return 2;
+
+    return -1;
 }
 
-// call g1->contains(g2)
-// returns 0 = false
-//         1 = true
-//         2 = error was trapped
-char
-GEOSContains_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *g2)
+/*
+ * Sets up a new or released handle
+ */
+void
+initHandle(GEOSContextHandleInternal_t *handle,
+           GEOSMessageHandler nf, GEOSMessageHandler ef)
+{
+    handle->noticeHandler = nf;
+    handle->errorHandler = ef;
+    handle->geomFactory = GeometryFactory::getDefaultInstance();
+    handle->WKBOutputDims = 2;
+    handle->WKBByteOrder = getMachineByteOrder();
+    handle->preparedCache = 0;
+    handle->errorMode = GEOS_ERROR_CALL_HANDLER;
+    handle->errorCount = 0;
+    handle->lastError[0] = '\0';
+    handle->nextFree = 0;
+    handle->initialized = 1;
+}
+
+/*
+ * Frees what a handle owns, leaving it unusable
+ */
+void
+clearHandle(GEOSContextHandleInternal_t *handle)
+{
+    delete handle->preparedCache;
+    handle->preparedCache = 0;
+    handle->initialized = 0;
+}
+
+#if defined(HAVE_PTHREAD) && ! defined(_WIN32)
+# define GEOS_CAPI_CONTEXT_POOL 1
+
+/// Released handles kept by each thread for GEOSContext_acquire_r
+const int MAX_POOLED_CONTEXTS = 4;
+
+/*
+ * The handles released by a thread, only ever used by that
+ * thread so needing no locks; freed when the thread exits.
+ */
+struct ContextPool
+{
+    GEOSContextHandleInternal_t *first;
+    int size;
+};
+
+pthread_key_t contextPoolKey;
+pthread_once_t contextPoolKeyOnce = PTHREAD_ONCE_INIT;
+
+void
+freeContextPool(void *arg)
+{
+    ContextPool *pool = static_cast<ContextPool*>(arg);
+    while ( pool->first )
+    {
+        GEOSContextHandleInternal_t *handle = pool->first;
+        pool->first = handle->nextFree;
+        std::free(handle);
+    }
+    delete pool;
+}
+
+void
+createContextPoolKey()
+{
+    pthread_key_create(&contextPoolKey, freeContextPool);
+}
+
+/*
+ * Returns the pool of the calling thread, creating it if asked to.
+ * Returns NULL if there is none.
+ */
+ContextPool*
+getContextPool(bool create)
+{
+    pthread_once(&contextPoolKeyOnce, createContextPoolKey);
+
+    void *pool = pthread_getspecific(contextPoolKey);
+    if ( ! pool && create )
+    {
+        ContextPool *newPool = new (std::nothrow) ContextPool;
+        if ( ! newPool ) return 0;
+        newPool->first = 0;
+        newPool->size = 0;
+        if ( 0 != pthread_setspecific(contextPoolKey, newPool) )
+        {
+            delete newPool;
+            return 0;
+        }
+        pool = newPool;
+    }
+    return static_cast<ContextPool*>(pool);
+}
+
+#endif // HAVE_PTHREAD && ! _WIN32
+
+} // namespace anonymous
+
+/*
+ * Frees the handles pooled by the calling thread.
+ * Called by finishGEOS, as the thread specific data of the main
+ * thread is not destroyed when it returns from main().
+ */
+void
+freeThreadContextPool()
+{
+#if defined(GEOS_CAPI_CONTEXT_POOL)
+    ContextPool *pool = getContextPool(false);
+    if ( pool )
+    {
+        pthread_setspecific(contextPoolKey, 0);
+        freeContextPool(pool);
+    }
+#endif
+}
+
+extern "C" {
+
+GEOSContextHandle_t
+initGEOS_r(GEOSMessageHandler nf, GEOSMessageHandler ef)
+{
+    GEOSContextHandleInternal_t *handle = 0;
+    void *extHandle = 0;
+
+    extHandle = std::malloc(sizeof(GEOSContextHandleInternal_t));
+    if (0 != extHandle)
+    {
+        handle = static_cast<GEOSContextHandleInternal_t*>(extHandle);
+        initHandle(handle, nf, ef);
+    }
+
+    return static_cast<GEOSContextHandle_t>(extHandle);
+}
+
+GEOSContextHandle_t
+GEOSContext_acquire_r(GEOSMessageHandler nf, GEOSMessageHandler ef)
+{
+#if defined(GEOS_CAPI_CONTEXT_POOL)
+    ContextPool *pool = getContextPool(false);
+    if ( pool && pool->first )
+    {
+        GEOSContextHandleInternal_t *handle = pool->first;
+        pool->first = handle->nextFree;
+        --pool->size;
+        initHandle(handle, nf, ef);
+        return reinterpret_cast<GEOSContextHandle_t>(handle);
+    }
+#endif
+
+    return initGEOS_r(nf, ef);
+}
+
+void
+GEOSContext_release_r(GEOSContextHandle_t extHandle)
 {
+#if defined(GEOS_CAPI_CONTEXT_POOL)
     if ( 0 == extHandle )
     {
-        return 2;
+        return;
+    }
+
+    ContextPool *pool = getContextPool(true);
+    if ( pool && pool->size < MAX_POOLED_CONTEXTS )
+    {
+        GEOSContextHandleInternal_t *handle = 0;
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        clearHandle(handle);
+        handle->nextFree = pool->first;
+        pool->first = handle;
+        ++pool->size;
+        return;
+    }
+#endif
+
+    finishGEOS_r(extHandle);
+}
+
+int
+GEOSContext_setErrorMode_r(GEOSContextHandle_t extHandle, int mode)
+{
+    if ( 0 == extHandle )
+    {
+        return -1;
     }
 
     GEOSContextHandleInternal_t *handle = 0;
     handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
     if ( 0 == handle->initialized )
     {
-        return 2;
+        return -1;
     }
 
-    try
+    if ( mode != GEOS_ERROR_CALL_HANDLER && mode != GEOS_ERROR_RECORD )
     {
-        bool result = g1->contains(g2);
-        return result;
+        return -1;
     }
-    catch (const std::exception &e)
+
+    int prev = handle->errorMode;
+    handle->errorMode = mode;
+    return prev;
+}
+
+int
+GEOSContext_getLastError_r(GEOSContextHandle_t extHandle, const char** message)
+{
+    if ( 0 == extHandle )
     {
-        handle->ERROR_MESSAGE("%s", e.what());
+        return 0;
     }
-    catch (...)
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
     {
-        handle->ERROR_MESSAGE("Unknown exception thrown");
+        return 0;
     }
-    
-    return 2;
+
+    if ( message ) *message = handle->lastError;
+
+    int count = handle->errorCount;
+    handle->errorCount = 0;
+    return count;
+}
+
+GEOSMessageHandler
+GEOSContext_setNoticeHandler_r(GEOSContextHandle_t extHandle, GEOSMessageHandler nf)
+{
+    GEOSMessageHandler f;
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return NULL;
+    }
+
+    f = handle->noticeHandler;
+    handle->noticeHandler = nf;
+
+    return f;
+}
+
+GEOSMessageHandler
+GEOSContext_setErrorHandler_r(GEOSContextHandle_t extHandle, GEOSMessageHandler nf)
+{
+    GEOSMessageHandler f;
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return NULL;
+    }
+
+    f = handle->errorHandler;
+    handle->errorHandler = nf;
+
+    return f;
+}
+
+void
+finishGEOS_r(GEOSContextHandle_t extHandle)
+{
+    if ( 0 != extHandle )
+    {
+        GEOSContextHandleInternal_t *handle = 0;
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        clearHandle(handle);
+    }
+
+    // Fix up freeing handle w.r.t. malloc above
+    std::free(extHandle);
+    extHandle = NULL;
 }
 
+void 
+GEOSFree_r (GEOSContextHandle_t extHandle, void* buffer) 
+{ 
+    assert(0 != extHandle);
+
+    std::free(buffer); 
+} 
+
+//-----------------------------------------------------------
+// relate()-related functions
+//  return 0 = false, 1 = true, 2 = error occured
+//-----------------------------------------------------------
+
 char
-GEOSOverlaps_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *g2)
+GEOSDisjoint_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *g2)
 {
     if ( 0 == extHandle )
     {
@@ -472,16 +951,20 @@ GEOSOverlaps_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry
 
     GEOSContextHandleInternal_t *handle = 0;
     handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
-    if ( 0 == handle->initialized )
+    if ( handle->initialized == 0 )
     {
         return 2;
     }
 
     try
     {
-        bool result = g1->overlaps(g2);
+        bool result = g1->disjoint(g2);
         return result;
     }
+
+    // TODO: mloskot is going to replace these double-catch block
+    // with a macro to remove redundant code in this and
+    // following functions.
     catch (const std::exception &e)
     {
         handle->ERROR_MESSAGE("%s", e.what());
@@ -490,12 +973,12 @@ GEOSOverlaps_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry
     {
         handle->ERROR_MESSAGE("Unknown exception thrown");
     }
-    
+
     return 2;
 }
 
 char
-GEOSCovers_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *g2)
+GEOSTouches_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *g2)
 {
     if ( 0 == extHandle )
     {
@@ -511,7 +994,7 @@ GEOSCovers_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *
 
     try
     {
-        bool result = g1->covers(g2);
+        bool result = g1->touches(g2);
         return result;
     }
     catch (const std::exception &e)
@@ -527,7 +1010,7 @@ GEOSCovers_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *
 }
 
 char
-GEOSCoveredBy_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *g2)
+GEOSIntersects_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *g2)
 {
     if ( 0 == extHandle )
     {
@@ -543,7 +1026,7 @@ GEOSCoveredBy_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometr
 
     try
     {
-        bool result = g1->coveredBy(g2);
+        bool result = g1->intersects(g2);
         return result;
     }
     catch (const std::exception &e)
@@ -558,13 +1041,8 @@ GEOSCoveredBy_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometr
     return 2;
 }
 
-
-//-------------------------------------------------------------------
-// low-level relate functions
-//------------------------------------------------------------------
-
 char
-GEOSRelatePattern_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *g2, const char *pat)
+GEOSCrosses_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *g2)
 {
     if ( 0 == extHandle )
     {
@@ -580,8 +1058,7 @@ GEOSRelatePattern_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geo
 
     try
     {
-        std::string s(pat);
-        bool result = g1->relate(g2, s);
+        bool result = g1->crosses(g2);
         return result;
     }
     catch (const std::exception &e)
@@ -597,8 +1074,7 @@ GEOSRelatePattern_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geo
 }
 
 char
-GEOSRelatePatternMatch_r(GEOSContextHandle_t extHandle, const char *mat,
-                           const char *pat)
+GEOSWithin_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *g2)
 {
     if ( 0 == extHandle )
     {
@@ -614,13 +1090,7 @@ GEOSRelatePatternMatch_r(GEOSContextHandle_t extHandle, const char *mat,
 
     try
     {
-        using geos::geom::IntersectionMatrix;
-
-        std::string m(mat);
-        std::string p(pat);
-        IntersectionMatrix im(m);
-
-        bool result = im.matches(p);
+        bool result = g1->within(g2);
         return result;
     }
     catch (const std::exception &e)
@@ -635,36 +1105,28 @@ GEOSRelatePatternMatch_r(GEOSContextHandle_t extHandle, const char *mat,
     return 2;
 }
 
-char *
-GEOSRelate_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *g2)
+// call g1->contains(g2)
+// returns 0 = false
+//         1 = true
+//         2 = error was trapped
+char
+GEOSContains_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *g2)
 {
     if ( 0 == extHandle )
     {
-        return NULL;
+        return 2;
     }
 
     GEOSContextHandleInternal_t *handle = 0;
     handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
     if ( 0 == handle->initialized )
     {
-        return NULL;
+        return 2;
     }
 
     try
     {
-        using geos::geom::IntersectionMatrix;
-
-        IntersectionMatrix* im = g1->relate(g2);
-        if (0 == im)
-        {
-            return 0;
-        }
-       
-        char *result = gstrdup(im->toString());
-
-        delete im;
-        im = 0;
-
+        bool result = g1->contains(g2);
         return result;
     }
     catch (const std::exception &e)
@@ -676,28 +1138,245 @@ GEOSRelate_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *
         handle->ERROR_MESSAGE("Unknown exception thrown");
     }
     
-    return NULL;
+    return 2;
 }
 
-char *
-GEOSRelateBoundaryNodeRule_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *g2, int bnr)
+char
+GEOSOverlaps_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *g2)
 {
     if ( 0 == extHandle )
     {
-        return NULL;
+        return 2;
     }
 
     GEOSContextHandleInternal_t *handle = 0;
     handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
     if ( 0 == handle->initialized )
     {
-        return NULL;
+        return 2;
     }
 
     try
     {
-        using geos::operation::relate::RelateOp;
-        using geos::geom::IntersectionMatrix;
+        bool result = g1->overlaps(g2);
+        return result;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+    
+    return 2;
+}
+
+char
+GEOSCovers_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *g2)
+{
+    if ( 0 == extHandle )
+    {
+        return 2;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 2;
+    }
+
+    try
+    {
+        bool result = g1->covers(g2);
+        return result;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+    
+    return 2;
+}
+
+char
+GEOSCoveredBy_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *g2)
+{
+    if ( 0 == extHandle )
+    {
+        return 2;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 2;
+    }
+
+    try
+    {
+        bool result = g1->coveredBy(g2);
+        return result;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+    
+    return 2;
+}
+
+
+//-------------------------------------------------------------------
+// low-level relate functions
+//------------------------------------------------------------------
+
+char
+GEOSRelatePattern_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *g2, const char *pat)
+{
+    if ( 0 == extHandle )
+    {
+        return 2;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 2;
+    }
+
+    try
+    {
+        std::string s(pat);
+        bool result = g1->relate(g2, s);
+        return result;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+    
+    return 2;
+}
+
+char
+GEOSRelatePatternMatch_r(GEOSContextHandle_t extHandle, const char *mat,
+                           const char *pat)
+{
+    if ( 0 == extHandle )
+    {
+        return 2;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 2;
+    }
+
+    try
+    {
+        using geos::geom::IntersectionMatrix;
+
+        std::string m(mat);
+        std::string p(pat);
+        IntersectionMatrix im(m);
+
+        bool result = im.matches(p);
+        return result;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+    
+    return 2;
+}
+
+char *
+GEOSRelate_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *g2)
+{
+    if ( 0 == extHandle )
+    {
+        return NULL;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return NULL;
+    }
+
+    try
+    {
+        using geos::geom::IntersectionMatrix;
+
+        IntersectionMatrix* im = g1->relate(g2);
+        if (0 == im)
+        {
+            return 0;
+        }
+       
+        char *result = gstrdup(im->toString());
+
+        delete im;
+        im = 0;
+
+        return result;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+    
+    return NULL;
+}
+
+char *
+GEOSRelateBoundaryNodeRule_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *g2, int bnr)
+{
+    if ( 0 == extHandle )
+    {
+        return NULL;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return NULL;
+    }
+
+    try
+    {
+        using geos::operation::relate::RelateOp;
+        using geos::geom::IntersectionMatrix;
         using geos::algorithm::BoundaryNodeRule;
 
         IntersectionMatrix* im;
@@ -773,6 +1452,8 @@ GEOSisValid_r(GEOSContextHandle_t extHandle, const Geometry *g1)
         using geos::operation::valid::TopologyValidationError;
 
         IsValidOp ivo(g1);
+        // the error is only computed for invalid geometries
+        if ( ivo.isValid() ) return 1;
         TopologyValidationError *err = ivo.getValidationError();
         if ( err )
         {
@@ -1007,6 +1688,38 @@ GEOSDistance_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry
     return 0;
 }
 
+char
+GEOSDistanceWithin_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *g2, double dist)
+{
+    if ( 0 == extHandle )
+    {
+        return 2;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 2;
+    }
+
+    try
+    {
+        bool result = g1->isWithinDistance(g2, dist);
+        return result;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return 2;
+}
+
 int
 GEOSHausdorffDistance_r(GEOSContextHandle_t extHandle, const Geometry *g1, const Geometry *g2, double *dist)
 {
@@ -1277,12 +1990,8 @@ GEOSGeomFromWKB_buf_r(GEOSContextHandle_t extHandle, const unsigned char *wkb, s
     using geos::io::WKBReader;
     try
     {
-        std::string wkbstring(reinterpret_cast<const char*>(wkb), size); // make it binary !
         WKBReader r(*(static_cast<GeometryFactory const*>(handle->geomFactory)));
-        std::istringstream is(std::ios_base::binary);
-        is.str(wkbstring);
-        is.seekg(0, std::ios::beg); // rewind reader pointer
-        Geometry *g = r.read(is);
+        Geometry *g = r.read(wkb, size);
         return g;
     }
     catch (const std::exception &e)
@@ -1297,10 +2006,77 @@ GEOSGeomFromWKB_buf_r(GEOSContextHandle_t extHandle, const unsigned char *wkb, s
     return NULL;
 }
 
-/* Read/write wkb hex values.  Returned geometries are
-   owned by the caller.*/
-unsigned char *
-GEOSGeomToHEX_buf_r(GEOSContextHandle_t extHandle, const Geometry *g, size_t *size)
+int
+GEOSGeomFromWKB_batch_r(GEOSContextHandle_t extHandle,
+                        const unsigned char* const* wkbs,
+                        const size_t* sizes, size_t n,
+                        unsigned int numThreads, Geometry** geoms)
+{
+    if ( 0 == extHandle )
+    {
+        return -1;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return -1;
+    }
+
+    try
+    {
+        return decodeBatch(handle, wkbs, sizes, 0, n, numThreads, geoms);
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return -1;
+}
+
+int
+GEOSGeomFromWKT_batch_r(GEOSContextHandle_t extHandle,
+                        const char* const* wkts, size_t n,
+                        unsigned int numThreads, Geometry** geoms)
+{
+    if ( 0 == extHandle )
+    {
+        return -1;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return -1;
+    }
+
+    try
+    {
+        return decodeBatch(handle, 0, 0, wkts, n, numThreads, geoms);
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return -1;
+}
+
+/* Read/write wkb hex values.  Returned geometries are
+   owned by the caller.*/
+unsigned char *
+GEOSGeomToHEX_buf_r(GEOSContextHandle_t extHandle, const Geometry *g, size_t *size)
 {
     if ( 0 == extHandle )
     {
@@ -2017,6 +2793,41 @@ GEOSUnaryUnion_r(GEOSContextHandle_t extHandle, const Geometry *g)
     return NULL;
 }
 
+Geometry *
+GEOSUnaryUnionParallel_r(GEOSContextHandle_t extHandle, const Geometry *g,
+                         unsigned int numThreads)
+{
+    if ( 0 == extHandle )
+    {
+        return NULL;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return NULL;
+    }
+
+    try
+    {
+        geos::operation::geounion::UnaryUnionOp op(*g);
+        op.setNumThreads(numThreads);
+        GeomAutoPtr g3 ( op.Union() );
+        return g3.release();
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+    
+    return NULL;
+}
+
 Geometry *
 GEOSUnionCascaded_r(GEOSContextHandle_t extHandle, const Geometry *g1)
 {
@@ -2921,6 +3732,14 @@ GEOSGeom_createCollection_r(GEOSContextHandle_t extHandle, int type, Geometry **
 
 Geometry *
 GEOSPolygonize_r(GEOSContextHandle_t extHandle, const Geometry * const * g, unsigned int ngeoms)
+{
+    return GEOSPolygonizeParallel_r(extHandle, g, ngeoms, 1);
+}
+
+Geometry *
+GEOSPolygonizeParallel_r(GEOSContextHandle_t extHandle,
+                         const Geometry * const * g, unsigned int ngeoms,
+                         unsigned int numThreads)
 {
     if ( 0 == extHandle )
     {
@@ -2941,6 +3760,7 @@ GEOSPolygonize_r(GEOSContextHandle_t extHandle, const Geometry * const * g, unsi
         // Polygonize
         using geos::operation::polygonize::Polygonizer;
         Polygonizer plgnzr;
+        plgnzr.setNumThreads(numThreads);
         for (std::size_t i = 0; i < ngeoms; ++i)
         {
             plgnzr.add(g[i]);
@@ -3367,6 +4187,49 @@ GEOS_setWKBByteOrder_r(GEOSContextHandle_t extHandle, int byteOrder)
     return oldByteOrder;
 }
 
+int
+GEOS_setGeometryCounting_r(GEOSContextHandle_t extHandle, int enable)
+{
+    if ( 0 == extHandle )
+    {
+        return -1;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return -1;
+    }
+
+    const int wasCounting = handle->geomFactory->isGeometryCounting();
+    handle->geomFactory->setGeometryCounting(enable != 0);
+
+    return wasCounting;
+}
+
+int
+GEOS_getGeometryCounts_r(GEOSContextHandle_t extHandle,
+                         size_t *created, size_t *live)
+{
+    if ( 0 == extHandle )
+    {
+        return 0;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 0;
+    }
+
+    if ( created ) *created = handle->geomFactory->getNumGeometriesCreated();
+    if ( live ) *live = handle->geomFactory->getNumGeometriesLive();
+
+    return 1;
+}
+
 
 CoordinateSequence *
 GEOSCoordSeq_create_r(GEOSContextHandle_t extHandle, unsigned int size, unsigned int dims)
@@ -4038,6 +4901,37 @@ GEOSGeom_getCoordinateDimension_r(GEOSContextHandle_t extHandle, const Geometry
     return 0;
 }
 
+size_t
+GEOSGeom_getMemoryUsage_r(GEOSContextHandle_t extHandle, const Geometry *g)
+{
+    if ( 0 == extHandle )
+    {
+        return 0;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 0;
+    }
+
+    try
+    {
+        return g->getMemoryUsage();
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+    
+    return 0;
+}
+
 Geometry *
 GEOSSimplify_r(GEOSContextHandle_t extHandle, const Geometry *g1, double tolerance)
 {
@@ -4547,12 +5441,7 @@ GEOSWKBReader_read_r(GEOSContextHandle_t extHandle, WKBReader *reader, const uns
 
     try
     {
-        std::string wkbstring(reinterpret_cast<const char*>(wkb), size); // make it binary !
-        std::istringstream is(std::ios_base::binary);
-        is.str(wkbstring);
-        is.seekg(0, std::ios::beg); // rewind reader pointer
-        
-        Geometry *g = reader->read(is);
+        Geometry *g = reader->read(wkb, size);
         return g;
     }
     catch (const std::exception &e)
@@ -4967,7 +5856,7 @@ GEOSPrepare_r(GEOSContextHandle_t extHandle, const Geometry *g)
 
     try
     {
-        prep = geos::geom::prep::PreparedGeometryFactory::prepare(g);
+        prep = geos::geom::prep::PreparedGeometryFactory::prepareAdaptive(g);
     }
     catch (const std::exception &e)
     {
@@ -5137,76 +6026,709 @@ GEOSPreparedCovers_r(GEOSContextHandle_t extHandle,
     assert(0 != pg);
     assert(0 != g);
 
-    if ( 0 == extHandle )
-    {
-        return 2;
+    if ( 0 == extHandle )
+    {
+        return 2;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 2;
+    }
+
+    try 
+    {
+        bool result = pg->covers(g);
+        return result;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+    
+    return 2;
+}
+
+char
+GEOSPreparedCrosses_r(GEOSContextHandle_t extHandle,
+        const geos::geom::prep::PreparedGeometry *pg, const Geometry *g)
+{
+    assert(0 != pg);
+    assert(0 != g);
+
+    if ( 0 == extHandle )
+    {
+        return 2;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 2;
+    }
+
+    try 
+    {
+        bool result = pg->crosses(g);
+        return result;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+    
+    return 2;
+}
+
+char
+GEOSPreparedDisjoint_r(GEOSContextHandle_t extHandle,
+        const geos::geom::prep::PreparedGeometry *pg, const Geometry *g)
+{
+    assert(0 != pg);
+    assert(0 != g);
+
+    if ( 0 == extHandle )
+    {
+        return 2;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 2;
+    }
+
+    try 
+    {
+        bool result = pg->disjoint(g);
+        return result;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+    
+    return 2;
+}
+
+char
+GEOSPreparedIntersects_r(GEOSContextHandle_t extHandle,
+        const geos::geom::prep::PreparedGeometry *pg, const Geometry *g)
+{
+    assert(0 != pg);
+    assert(0 != g);
+
+    if ( 0 == extHandle )
+    {
+        return 2;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 2;
+    }
+
+    try 
+    {
+        bool result = pg->intersects(g);
+        return result;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+    
+    return 2;
+}
+
+char
+GEOSPreparedOverlaps_r(GEOSContextHandle_t extHandle,
+        const geos::geom::prep::PreparedGeometry *pg, const Geometry *g)
+{
+    assert(0 != pg);
+    assert(0 != g);
+
+    if ( 0 == extHandle )
+    {
+        return 2;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 2;
+    }
+
+    try 
+    {
+        bool result = pg->overlaps(g);
+        return result;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+    
+    return 2;
+}
+
+char
+GEOSPreparedTouches_r(GEOSContextHandle_t extHandle,
+        const geos::geom::prep::PreparedGeometry *pg, const Geometry *g)
+{
+    assert(0 != pg);
+    assert(0 != g);
+
+    if ( 0 == extHandle )
+    {
+        return 2;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 2;
+    }
+
+    try 
+    {
+        bool result = pg->touches(g);
+        return result;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+    
+    return 2;
+}
+
+char
+GEOSPreparedWithin_r(GEOSContextHandle_t extHandle,
+        const geos::geom::prep::PreparedGeometry *pg, const Geometry *g)
+{
+    assert(0 != pg);
+    assert(0 != g);
+
+    if ( 0 == extHandle )
+    {
+        return 2;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 2;
+    }
+
+    try 
+    {
+        bool result = pg->within(g);
+        return result;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+    
+    return 2;
+}
+
+int
+GEOSPreparedDistance_r(GEOSContextHandle_t extHandle,
+        const geos::geom::prep::PreparedGeometry *pg, const Geometry *g,
+        double *dist)
+{
+    assert(0 != pg);
+    assert(0 != g);
+    assert(0 != dist);
+
+    if ( 0 == extHandle )
+    {
+        return 0;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 0;
+    }
+
+    try 
+    {
+        *dist = pg->distance(g);
+        return 1;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+    
+    return 0;
+}
+
+char
+GEOSPreparedDistanceWithin_r(GEOSContextHandle_t extHandle,
+        const geos::geom::prep::PreparedGeometry *pg, const Geometry *g,
+        double dist)
+{
+    assert(0 != pg);
+    assert(0 != g);
+
+    if ( 0 == extHandle )
+    {
+        return 2;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 2;
+    }
+
+    try 
+    {
+        bool result = pg->isWithinDistance(g, dist);
+        return result;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+    
+    return 2;
+}
+
+int
+GEOSPreparedContains_many_r(GEOSContextHandle_t extHandle,
+        const geos::geom::prep::PreparedGeometry *pg,
+        const Geometry* const* geoms, size_t n, unsigned int numThreads,
+        char* results)
+{
+    assert(0 != pg);
+
+    return predicateBatch_r(extHandle, pg,
+        &geos::geom::prep::PreparedGeometry::contains,
+        geoms, n, numThreads, results);
+}
+
+int
+GEOSPreparedContainsProperly_many_r(GEOSContextHandle_t extHandle,
+        const geos::geom::prep::PreparedGeometry *pg,
+        const Geometry* const* geoms, size_t n, unsigned int numThreads,
+        char* results)
+{
+    assert(0 != pg);
+
+    return predicateBatch_r(extHandle, pg,
+        &geos::geom::prep::PreparedGeometry::containsProperly,
+        geoms, n, numThreads, results);
+}
+
+int
+GEOSPreparedCovers_many_r(GEOSContextHandle_t extHandle,
+        const geos::geom::prep::PreparedGeometry *pg,
+        const Geometry* const* geoms, size_t n, unsigned int numThreads,
+        char* results)
+{
+    assert(0 != pg);
+
+    return predicateBatch_r(extHandle, pg,
+        &geos::geom::prep::PreparedGeometry::covers,
+        geoms, n, numThreads, results);
+}
+
+int
+GEOSPreparedIntersects_many_r(GEOSContextHandle_t extHandle,
+        const geos::geom::prep::PreparedGeometry *pg,
+        const Geometry* const* geoms, size_t n, unsigned int numThreads,
+        char* results)
+{
+    assert(0 != pg);
+
+    return predicateBatch_r(extHandle, pg,
+        &geos::geom::prep::PreparedGeometry::intersects,
+        geoms, n, numThreads, results);
+}
+
+int
+GEOSContext_setPreparedCacheSize_r(GEOSContextHandle_t extHandle,
+                                   unsigned int size)
+{
+    if ( 0 == extHandle )
+    {
+        return -1;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return -1;
+    }
+
+    try
+    {
+        using geos::geom::prep::PreparedGeometryCache;
+        if ( 0 == handle->preparedCache )
+        {
+            handle->preparedCache = new PreparedGeometryCache(size);
+            return static_cast<int>(PreparedGeometryCache::DEFAULT_CAPACITY);
+        }
+        int old = static_cast<int>(handle->preparedCache->getCapacity());
+        handle->preparedCache->setCapacity(size);
+        return old;
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+
+    return -1;
+}
+
+int
+GEOSContext_getPreparedCacheStats_r(GEOSContextHandle_t extHandle,
+                                    unsigned long *hits,
+                                    unsigned long *misses)
+{
+    if ( 0 == extHandle )
+    {
+        return 0;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 0;
+    }
+
+    const geos::geom::prep::PreparedGeometryCache* cache =
+        handle->preparedCache;
+    if ( hits ) *hits = cache ? cache->getHits() : 0;
+    if ( misses ) *misses = cache ? cache->getMisses() : 0;
+    return 1;
+}
+
+char
+GEOSPreparedContains_cached_r(GEOSContextHandle_t extHandle,
+        const Geometry *g1, const Geometry *g2)
+{
+    return cachedPredicate(extHandle, g1, g2,
+        &geos::geom::prep::PreparedGeometry::contains);
+}
+
+char
+GEOSPreparedContainsProperly_cached_r(GEOSContextHandle_t extHandle,
+        const Geometry *g1, const Geometry *g2)
+{
+    return cachedPredicate(extHandle, g1, g2,
+        &geos::geom::prep::PreparedGeometry::containsProperly);
+}
+
+char
+GEOSPreparedCoveredBy_cached_r(GEOSContextHandle_t extHandle,
+        const Geometry *g1, const Geometry *g2)
+{
+    return cachedPredicate(extHandle, g1, g2,
+        &geos::geom::prep::PreparedGeometry::coveredBy);
+}
+
+char
+GEOSPreparedCovers_cached_r(GEOSContextHandle_t extHandle,
+        const Geometry *g1, const Geometry *g2)
+{
+    return cachedPredicate(extHandle, g1, g2,
+        &geos::geom::prep::PreparedGeometry::covers);
+}
+
+char
+GEOSPreparedCrosses_cached_r(GEOSContextHandle_t extHandle,
+        const Geometry *g1, const Geometry *g2)
+{
+    return cachedPredicate(extHandle, g1, g2,
+        &geos::geom::prep::PreparedGeometry::crosses);
+}
+
+char
+GEOSPreparedDisjoint_cached_r(GEOSContextHandle_t extHandle,
+        const Geometry *g1, const Geometry *g2)
+{
+    return cachedPredicate(extHandle, g1, g2,
+        &geos::geom::prep::PreparedGeometry::disjoint);
+}
+
+char
+GEOSPreparedIntersects_cached_r(GEOSContextHandle_t extHandle,
+        const Geometry *g1, const Geometry *g2)
+{
+    return cachedPredicate(extHandle, g1, g2,
+        &geos::geom::prep::PreparedGeometry::intersects);
+}
+
+char
+GEOSPreparedOverlaps_cached_r(GEOSContextHandle_t extHandle,
+        const Geometry *g1, const Geometry *g2)
+{
+    return cachedPredicate(extHandle, g1, g2,
+        &geos::geom::prep::PreparedGeometry::overlaps);
+}
+
+char
+GEOSPreparedTouches_cached_r(GEOSContextHandle_t extHandle,
+        const Geometry *g1, const Geometry *g2)
+{
+    return cachedPredicate(extHandle, g1, g2,
+        &geos::geom::prep::PreparedGeometry::touches);
+}
+
+char
+GEOSPreparedWithin_cached_r(GEOSContextHandle_t extHandle,
+        const Geometry *g1, const Geometry *g2)
+{
+    return cachedPredicate(extHandle, g1, g2,
+        &geos::geom::prep::PreparedGeometry::within);
+}
+
+//-----------------------------------------------------------------
+// STRtree
+//-----------------------------------------------------------------
+
+geos::index::strtree::STRtree *
+GEOSSTRtree_create_r(GEOSContextHandle_t extHandle,
+                                  size_t nodeCapacity)
+{
+    if ( 0 == extHandle )
+    {
+        return 0;
+    }
+
+    GEOSContextHandleInternal_t *handle = 0;
+    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+    if ( 0 == handle->initialized )
+    {
+        return 0;
+    }
+
+    geos::index::strtree::STRtree *tree = 0;
+
+    try
+    {
+        tree = new geos::index::strtree::STRtree(nodeCapacity);
+    }
+    catch (const std::exception &e)
+    {
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        handle->ERROR_MESSAGE("Unknown exception thrown");
+    }
+    
+    return tree;
+}
+
+void
+GEOSSTRtree_insert_r(GEOSContextHandle_t extHandle,
+                     geos::index::strtree::STRtree *tree,
+                     const geos::geom::Geometry *g,
+                     void *item)
+{
+    GEOSContextHandleInternal_t *handle = 0;
+    assert(tree != 0);
+    assert(g != 0);
+
+    try
+    {
+        tree->insert(g->getEnvelopeInternal(), item);
+    }
+    catch (const std::exception &e)
+    {
+        if ( 0 == extHandle )
+        {
+            return;
+        }
+
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if ( 0 == handle->initialized )
+        {
+            return;
+        }
+
+        handle->ERROR_MESSAGE("%s", e.what());
+    }
+    catch (...)
+    {
+        if ( 0 == extHandle )
+        {
+            return;
+        }
+
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if ( 0 == handle->initialized )
+        {
+            return;
+        }
+
+        handle->ERROR_MESSAGE("Unknown exception thrown");
     }
+}
 
+void 
+GEOSSTRtree_query_r(GEOSContextHandle_t extHandle,
+                    geos::index::strtree::STRtree *tree,
+                    const geos::geom::Geometry *g,
+                    GEOSQueryCallback callback,
+                    void *userdata)
+{
     GEOSContextHandleInternal_t *handle = 0;
-    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
-    if ( 0 == handle->initialized )
-    {
-        return 2;
-    }
+    assert(tree != 0);
+    assert(g != 0);
+    assert(callback != 0);
 
-    try 
+    try
     {
-        bool result = pg->covers(g);
-        return result;
+        CAPI_ItemVisitor visitor(callback, userdata);
+        tree->query(g->getEnvelopeInternal(), visitor);
     }
     catch (const std::exception &e)
     {
+        if ( 0 == extHandle )
+        {
+            return;
+        }
+
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if ( 0 == handle->initialized )
+        {
+            return;
+        }
+
         handle->ERROR_MESSAGE("%s", e.what());
     }
     catch (...)
     {
+        if ( 0 == extHandle )
+        {
+            return;
+        }
+
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if ( 0 == handle->initialized )
+        {
+            return;
+        }
+
         handle->ERROR_MESSAGE("Unknown exception thrown");
     }
-    
-    return 2;
 }
 
-char
-GEOSPreparedCrosses_r(GEOSContextHandle_t extHandle,
-        const geos::geom::prep::PreparedGeometry *pg, const Geometry *g)
+void 
+GEOSSTRtree_iterate_r(GEOSContextHandle_t extHandle,
+                    geos::index::strtree::STRtree *tree,
+                    GEOSQueryCallback callback,
+                    void *userdata)
 {
-    assert(0 != pg);
-    assert(0 != g);
-
-    if ( 0 == extHandle )
-    {
-        return 2;
-    }
-
     GEOSContextHandleInternal_t *handle = 0;
-    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
-    if ( 0 == handle->initialized )
-    {
-        return 2;
-    }
+    assert(tree != 0);
+    assert(callback != 0);
 
-    try 
+    try
     {
-        bool result = pg->crosses(g);
-        return result;
+        CAPI_ItemVisitor visitor(callback, userdata);
+        tree->iterate(visitor);
     }
     catch (const std::exception &e)
     {
+        if ( 0 == extHandle )
+        {
+            return;
+        }
+
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if ( 0 == handle->initialized )
+        {
+            return;
+        }
+
         handle->ERROR_MESSAGE("%s", e.what());
     }
     catch (...)
     {
+        if ( 0 == extHandle )
+        {
+            return;
+        }
+
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if ( 0 == handle->initialized )
+        {
+            return;
+        }
+
         handle->ERROR_MESSAGE("Unknown exception thrown");
     }
-    
-    return 2;
 }
 
 char
-GEOSPreparedDisjoint_r(GEOSContextHandle_t extHandle,
-        const geos::geom::prep::PreparedGeometry *pg, const Geometry *g)
+GEOSSTRtree_remove_r(GEOSContextHandle_t extHandle,
+                     geos::index::strtree::STRtree *tree,
+                     const geos::geom::Geometry *g,
+                     void *item)
 {
-    assert(0 != pg);
+    assert(0 != tree);
     assert(0 != g);
 
     if ( 0 == extHandle )
@@ -5223,7 +6745,7 @@ GEOSPreparedDisjoint_r(GEOSContextHandle_t extHandle,
 
     try 
     {
-        bool result = pg->disjoint(g);
+        bool result = tree->remove(g->getEnvelopeInternal(), item);
         return result;
     }
     catch (const std::exception &e)
@@ -5238,29 +6760,50 @@ GEOSPreparedDisjoint_r(GEOSContextHandle_t extHandle,
     return 2;
 }
 
-char
-GEOSPreparedIntersects_r(GEOSContextHandle_t extHandle,
-        const geos::geom::prep::PreparedGeometry *pg, const Geometry *g)
+int
+GEOSSTRtree_nearest_r(GEOSContextHandle_t extHandle,
+                      geos::index::strtree::STRtree *tree,
+                      const void *item,
+                      const geos::geom::Geometry *itemEnvelope,
+                      size_t k,
+                      GEOSDistanceCallback distancefn,
+                      void *userdata,
+                      void **results)
 {
-    assert(0 != pg);
-    assert(0 != g);
+    assert(0 != tree);
+    assert(0 != itemEnvelope);
+    assert(0 != results);
 
     if ( 0 == extHandle )
     {
-        return 2;
+        return -1;
     }
 
     GEOSContextHandleInternal_t *handle = 0;
     handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
     if ( 0 == handle->initialized )
     {
-        return 2;
+        return -1;
     }
 
     try 
     {
-        bool result = pg->intersects(g);
-        return result;
+        std::vector<void*> neighbours;
+        if ( distancefn )
+        {
+            CAPI_ItemDistance itemDist(distancefn, userdata);
+            tree->nearestNeighbour(itemEnvelope->getEnvelopeInternal(),
+                                   item, &itemDist, k, neighbours);
+        }
+        else
+        {
+            geos::index::strtree::GeometryItemDistance itemDist;
+            tree->nearestNeighbour(itemEnvelope->getEnvelopeInternal(),
+                                   item, &itemDist, k, neighbours);
+        }
+
+        std::copy(neighbours.begin(), neighbours.end(), results);
+        return static_cast<int>(neighbours.size());
     }
     catch (const std::exception &e)
     {
@@ -5271,32 +6814,62 @@ GEOSPreparedIntersects_r(GEOSContextHandle_t extHandle,
         handle->ERROR_MESSAGE("Unknown exception thrown");
     }
     
-    return 2;
+    return -1;
 }
 
-char
-GEOSPreparedOverlaps_r(GEOSContextHandle_t extHandle,
-        const geos::geom::prep::PreparedGeometry *pg, const Geometry *g)
+int
+GEOSSTRtree_query_batch_r(GEOSContextHandle_t extHandle,
+                          geos::index::strtree::STRtree *tree,
+                          const geos::geom::Geometry *const *geoms,
+                          size_t numGeoms,
+                          size_t **offsets,
+                          void ***items)
 {
-    assert(0 != pg);
-    assert(0 != g);
+    assert(0 != tree);
+    assert(0 != offsets);
+    assert(0 != items);
 
     if ( 0 == extHandle )
     {
-        return 2;
+        return 0;
     }
 
     GEOSContextHandleInternal_t *handle = 0;
     handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
     if ( 0 == handle->initialized )
     {
-        return 2;
+        return 0;
     }
 
     try 
     {
-        bool result = pg->overlaps(g);
-        return result;
+        std::vector<const geos::geom::Envelope*> envs(numGeoms);
+        for (size_t i=0; i<numGeoms; ++i)
+        {
+            envs[i] = geoms[i]->getEnvelopeInternal();
+        }
+
+        std::vector<size_t> offsetsV;
+        std::vector<void*> itemsV;
+        tree->queryBatch(envs, offsetsV, itemsV);
+
+        // malloc(0) may return NULL, always ask for an item
+        size_t* offsetsOut = static_cast<size_t*>(
+            std::malloc(offsetsV.size() * sizeof(size_t)));
+        void** itemsOut = static_cast<void**>(
+            std::malloc((itemsV.size()+1) * sizeof(void*)));
+        if ( ! offsetsOut || ! itemsOut )
+        {
+            std::free(offsetsOut);
+            std::free(itemsOut);
+            throw std::bad_alloc();
+        }
+
+        std::copy(offsetsV.begin(), offsetsV.end(), offsetsOut);
+        std::copy(itemsV.begin(), itemsV.end(), itemsOut);
+        *offsets = offsetsOut;
+        *items = itemsOut;
+        return 1;
     }
     catch (const std::exception &e)
     {
@@ -5307,32 +6880,65 @@ GEOSPreparedOverlaps_r(GEOSContextHandle_t extHandle,
         handle->ERROR_MESSAGE("Unknown exception thrown");
     }
     
-    return 2;
+    return 0;
 }
 
-char
-GEOSPreparedTouches_r(GEOSContextHandle_t extHandle,
-        const geos::geom::prep::PreparedGeometry *pg, const Geometry *g)
+int
+GEOSSTRtree_join_r(GEOSContextHandle_t extHandle,
+                   geos::index::strtree::STRtree *tree1,
+                   geos::index::strtree::STRtree *tree2,
+                   int predicate,
+                   GEOSJoinCallback callback,
+                   void *userdata)
 {
-    assert(0 != pg);
-    assert(0 != g);
+    using geos::geom::prep::PreparedJoinFilter;
+
+    assert(0 != tree1);
+    assert(0 != tree2);
+    assert(0 != callback);
 
     if ( 0 == extHandle )
     {
-        return 2;
+        return 0;
     }
 
     GEOSContextHandleInternal_t *handle = 0;
     handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
     if ( 0 == handle->initialized )
     {
-        return 2;
+        return 0;
     }
 
     try 
     {
-        bool result = pg->touches(g);
-        return result;
+        CAPI_ItemPairVisitor visitor(callback, userdata);
+        if ( predicate == GEOSJOIN_ENVELOPES )
+        {
+            tree1->join(*tree2, visitor);
+            return 1;
+        }
+
+        PreparedJoinFilter::Predicate p;
+        switch (predicate)
+        {
+            case GEOSJOIN_INTERSECTS: p = PreparedJoinFilter::INTERSECTS; break;
+            case GEOSJOIN_CONTAINS: p = PreparedJoinFilter::CONTAINS; break;
+            case GEOSJOIN_CONTAINSPROPERLY:
+                p = PreparedJoinFilter::CONTAINS_PROPERLY; break;
+            case GEOSJOIN_COVERS: p = PreparedJoinFilter::COVERS; break;
+            case GEOSJOIN_COVEREDBY: p = PreparedJoinFilter::COVERED_BY; break;
+            case GEOSJOIN_CROSSES: p = PreparedJoinFilter::CROSSES; break;
+            case GEOSJOIN_OVERLAPS: p = PreparedJoinFilter::OVERLAPS; break;
+            case GEOSJOIN_TOUCHES: p = PreparedJoinFilter::TOUCHES; break;
+            case GEOSJOIN_WITHIN: p = PreparedJoinFilter::WITHIN; break;
+            default:
+                handle->ERROR_MESSAGE("Invalid join predicate %d", predicate);
+                return 0;
+        }
+
+        PreparedJoinFilter filter(p, visitor);
+        tree1->join(*tree2, filter);
+        return 1;
     }
     catch (const std::exception &e)
     {
@@ -5343,52 +6949,58 @@ GEOSPreparedTouches_r(GEOSContextHandle_t extHandle,
         handle->ERROR_MESSAGE("Unknown exception thrown");
     }
     
-    return 2;
+    return 0;
 }
 
-char
-GEOSPreparedWithin_r(GEOSContextHandle_t extHandle,
-        const geos::geom::prep::PreparedGeometry *pg, const Geometry *g)
+void
+GEOSSTRtree_destroy_r(GEOSContextHandle_t extHandle,
+                      geos::index::strtree::STRtree *tree)
 {
-    assert(0 != pg);
-    assert(0 != g);
-
-    if ( 0 == extHandle )
-    {
-        return 2;
-    }
-
     GEOSContextHandleInternal_t *handle = 0;
-    handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
-    if ( 0 == handle->initialized )
-    {
-        return 2;
-    }
 
-    try 
+    try
     {
-        bool result = pg->within(g);
-        return result;
+        delete tree;
     }
     catch (const std::exception &e)
     {
+        if ( 0 == extHandle )
+        {
+            return;
+        }
+
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if ( 0 == handle->initialized )
+        {
+            return;
+        }
+
         handle->ERROR_MESSAGE("%s", e.what());
     }
     catch (...)
     {
+        if ( 0 == extHandle )
+        {
+            return;
+        }
+
+        handle = reinterpret_cast<GEOSContextHandleInternal_t*>(extHandle);
+        if ( 0 == handle->initialized )
+        {
+            return;
+        }
+
         handle->ERROR_MESSAGE("Unknown exception thrown");
     }
-    
-    return 2;
 }
 
 //-----------------------------------------------------------------
-// STRtree
+// PackedSTRtree
 //-----------------------------------------------------------------
 
-geos::index::strtree::STRtree *
-GEOSSTRtree_create_r(GEOSContextHandle_t extHandle,
-                                  size_t nodeCapacity)
+geos::index::strtree::PackedSTRtree *
+GEOSPackedSTRtree_create_r(GEOSContextHandle_t extHandle,
+                           size_t nodeCapacity)
 {
     if ( 0 == extHandle )
     {
@@ -5402,11 +7014,11 @@ GEOSSTRtree_create_r(GEOSContextHandle_t extHandle,
         return 0;
     }
 
-    geos::index::strtree::STRtree *tree = 0;
+    geos::index::strtree::PackedSTRtree *tree = 0;
 
     try
     {
-        tree = new geos::index::strtree::STRtree(nodeCapacity);
+        tree = new geos::index::strtree::PackedSTRtree(nodeCapacity);
     }
     catch (const std::exception &e)
     {
@@ -5421,10 +7033,10 @@ GEOSSTRtree_create_r(GEOSContextHandle_t extHandle,
 }
 
 void
-GEOSSTRtree_insert_r(GEOSContextHandle_t extHandle,
-                     geos::index::strtree::STRtree *tree,
-                     const geos::geom::Geometry *g,
-                     void *item)
+GEOSPackedSTRtree_insert_r(GEOSContextHandle_t extHandle,
+                           geos::index::strtree::PackedSTRtree *tree,
+                           const geos::geom::Geometry *g,
+                           void *item)
 {
     GEOSContextHandleInternal_t *handle = 0;
     assert(tree != 0);
@@ -5467,11 +7079,11 @@ GEOSSTRtree_insert_r(GEOSContextHandle_t extHandle,
 }
 
 void 
-GEOSSTRtree_query_r(GEOSContextHandle_t extHandle,
-                    geos::index::strtree::STRtree *tree,
-                    const geos::geom::Geometry *g,
-                    GEOSQueryCallback callback,
-                    void *userdata)
+GEOSPackedSTRtree_query_r(GEOSContextHandle_t extHandle,
+                          geos::index::strtree::PackedSTRtree *tree,
+                          const geos::geom::Geometry *g,
+                          GEOSQueryCallback callback,
+                          void *userdata)
 {
     GEOSContextHandleInternal_t *handle = 0;
     assert(tree != 0);
@@ -5516,10 +7128,10 @@ GEOSSTRtree_query_r(GEOSContextHandle_t extHandle,
 }
 
 void 
-GEOSSTRtree_iterate_r(GEOSContextHandle_t extHandle,
-                    geos::index::strtree::STRtree *tree,
-                    GEOSQueryCallback callback,
-                    void *userdata)
+GEOSPackedSTRtree_iterate_r(GEOSContextHandle_t extHandle,
+                            geos::index::strtree::PackedSTRtree *tree,
+                            GEOSQueryCallback callback,
+                            void *userdata)
 {
     GEOSContextHandleInternal_t *handle = 0;
     assert(tree != 0);
@@ -5563,10 +7175,10 @@ GEOSSTRtree_iterate_r(GEOSContextHandle_t extHandle,
 }
 
 char
-GEOSSTRtree_remove_r(GEOSContextHandle_t extHandle,
-                     geos::index::strtree::STRtree *tree,
-                     const geos::geom::Geometry *g,
-                     void *item)
+GEOSPackedSTRtree_remove_r(GEOSContextHandle_t extHandle,
+                           geos::index::strtree::PackedSTRtree *tree,
+                           const geos::geom::Geometry *g,
+                           void *item)
 {
     assert(0 != tree);
     assert(0 != g);
@@ -5601,8 +7213,8 @@ GEOSSTRtree_remove_r(GEOSContextHandle_t extHandle,
 }
 
 void
-GEOSSTRtree_destroy_r(GEOSContextHandle_t extHandle,
-                      geos::index::strtree::STRtree *tree)
+GEOSPackedSTRtree_destroy_r(GEOSContextHandle_t extHandle,
+                            geos::index::strtree::PackedSTRtree *tree)
 {
     GEOSContextHandleInternal_t *handle = 0;
 
@@ -103,7 +103,8 @@ private:
 public:
 	/**
 	 * Creates a new locator for a given {@link Geometry}
-	 * @param g the Geometry to locate in
+	 * @param g the Geometry to locate in, a Polygon, MultiPolygon
+	 *          or LinearRing (locating in the area it encloses)
 	 */
 	IndexedPointInAreaLocator( const geom::Geometry & g);
 
@@ -112,6 +113,9 @@ public:
 	/**
 	 * Determines the {@link Location} of a point in an areal {@link Geometry}.
 	 * 
+	 * Only reads the index, which is built on construction,
+	 * so calls may run concurrently.
+	 *
 	 * @param p the point to test
 	 * @return the location of the point in the geometry  
 	 */
@@ -0,0 +1,197 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_GEOM_COMPACTGEOMETRY_H
+#define GEOS_GEOM_COMPACTGEOMETRY_H
+
+#include <geos/export.h>
+#include <geos/geom/Geometry.h> // for GeometryTypeId
+#include <geos/geom/Envelope.h> // for inlines
+
+#include <memory>
+#include <cstddef>
+
+// Forward declarations
+namespace geos {
+	namespace geom {
+		class Coordinate;
+		class GeometryFactory;
+	}
+}
+
+namespace geos {
+namespace geom { // geos::geom
+
+/**
+ * \brief
+ * A frozen, read-only encoding of a Geometry held in a single
+ * memory block.
+ *
+ * The block starts with a fixed header (type, counts and envelope)
+ * followed by the packed ordinates (2 or 3 doubles per coordinate),
+ * the offsets of the rings into the coordinates, the offsets of the
+ * components into the rings and the type of each component.
+ * A small polygon so needs one allocation instead of the five or more
+ * of the Geometry tree, and a fraction of its memory.
+ *
+ * Components are Points (one ring of zero or one coordinate),
+ * LineStrings and LinearRings (one ring) and Polygons (the shell
+ * followed by the holes). Collections are flattened: a collection
+ * nested in another one is not restored by toGeometry.
+ * SRID and user data are not kept.
+ *
+ * The locate, intersects and distance methods work directly on the
+ * encoding. They test all segment pairs with an envelope filter,
+ * which suits the small geometries this class is meant for.
+ *
+ * Instances are created by create() and released by delete.
+ */
+class GEOS_DLL CompactGeometry {
+
+public:
+
+	/// Encodes the given Geometry
+	static std::auto_ptr<CompactGeometry> create(const Geometry& g);
+
+	/// Releases the block of an instance made by create()
+	static void operator delete(void* p);
+
+	/// Builds the equivalent Geometry tree with the given factory
+	std::auto_ptr<Geometry> toGeometry(const GeometryFactory& factory) const;
+
+	GeometryTypeId getGeometryTypeId() const
+	{
+		return static_cast<GeometryTypeId>(typeId);
+	}
+
+	/// Returns the number of ordinates stored per coordinate (2 or 3)
+	std::size_t getCoordinateDimension() const { return dimension; }
+
+	/// Returns the number of (flattened) components
+	std::size_t getNumGeometries() const { return numParts; }
+
+	std::size_t getNumPoints() const { return numPoints; }
+
+	bool isEmpty() const { return numPoints == 0; }
+
+	/// Returns the envelope, null for empty geometries
+	Envelope getEnvelope() const
+	{
+		if ( isEmpty() ) return Envelope();
+		return Envelope(minx, maxx, miny, maxy);
+	}
+
+	/// Returns the size of the memory block
+	std::size_t getMemoryUsage() const;
+
+	/**
+	 * \brief
+	 * Returns the Location of a point relative to the areal
+	 * components of the geometry.
+	 *
+	 * @return Location::INTERIOR, Location::BOUNDARY or
+	 *         Location::EXTERIOR (also for non-areal geometries)
+	 */
+	int locate(const Coordinate& p) const;
+
+	/// Tests whether the point lies on any component of the geometry
+	bool intersects(const Coordinate& p) const;
+
+	/// Tests whether the two geometries have at least a point in common
+	bool intersects(const CompactGeometry& other) const;
+
+	/// Returns the distance of a point, 0 if empty
+	double distance(const Coordinate& p) const;
+
+	/// Returns the distance between the geometries, 0 if either is empty
+	double distance(const CompactGeometry& other) const;
+
+	/// Tests whether the geometries are within the given distance
+	bool isWithinDistance(const CompactGeometry& other, double dist) const;
+
+private:
+
+	unsigned char typeId;
+
+	unsigned char dimension;
+
+	unsigned int numParts;
+
+	unsigned int numRings;
+
+	unsigned int numPoints;
+
+	double minx, miny, maxx, maxy;
+
+	CompactGeometry() {}
+
+	// Declare type as noncopyable
+	CompactGeometry(const CompactGeometry& other);
+	CompactGeometry& operator=(const CompactGeometry& rhs);
+
+	static std::size_t blockSize(std::size_t nParts, std::size_t nRings,
+	                             std::size_t nPoints, std::size_t dim);
+
+	/// Ordinates, dimension per coordinate, right after the header
+	const double* ordinates() const
+	{
+		return reinterpret_cast<const double*>(this + 1);
+	}
+
+	/// Index of the first coordinate of each ring, plus the end
+	const unsigned int* ringStarts() const
+	{
+		return reinterpret_cast<const unsigned int*>(
+			ordinates() + std::size_t(numPoints) * dimension);
+	}
+
+	/// Index of the first ring of each component, plus the end
+	const unsigned int* partStarts() const
+	{
+		return ringStarts() + numRings + 1;
+	}
+
+	/// GeometryTypeId of each component
+	const unsigned char* partTypes() const
+	{
+		return reinterpret_cast<const unsigned char*>(
+			partStarts() + numParts + 1);
+	}
+
+	void getCoordinate(std::size_t i, Coordinate& c) const;
+
+	std::size_t ringSize(std::size_t r) const
+	{
+		return ringStarts()[r+1] - ringStarts()[r];
+	}
+
+	Envelope ringEnvelope(std::size_t r) const;
+
+	/// Location of p relative to the given Polygon component
+	int locateInPolygon(const Coordinate& p, std::size_t part) const;
+
+	/// Tests whether the first coordinate of any component of
+	/// this geometry intersects the other one
+	bool hasComponentIn(const CompactGeometry& other) const;
+
+	/// Tests whether any segment of the two geometries intersect
+	bool hasSegmentIntersection(const CompactGeometry& other) const;
+
+	/// Returns the distance, or any value not above terminateDistance
+	double computeDistance(const CompactGeometry& other,
+	                       double terminateDistance) const;
+};
+
+} // namespace geos::geom
+} // namespace geos
+
+#endif // ndef GEOS_GEOM_COMPACTGEOMETRY_H
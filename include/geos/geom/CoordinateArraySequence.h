@@ -108,6 +108,8 @@ public:
 
 	void expandEnvelope(Envelope &env) const;
 
+	std::size_t getMemoryUsage() const;
+
     std::size_t getDimension() const;
 
 	void apply_rw(const CoordinateFilter *filter); 
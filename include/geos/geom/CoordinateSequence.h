@@ -357,6 +357,15 @@ public:
 	 */
 	virtual void expandEnvelope(Envelope &env) const;
 
+	/**
+	 * Returns the number of bytes held by the sequence, including
+	 * the object itself.
+	 *
+	 * The default implementation assumes one Coordinate per point,
+	 * implementing classes report their actual storage.
+	 */
+	virtual std::size_t getMemoryUsage() const;
+
 	virtual void apply_rw(const CoordinateFilter *filter)=0; //Abstract
 	virtual void apply_ro(CoordinateFilter *filter) const=0; //Abstract
 
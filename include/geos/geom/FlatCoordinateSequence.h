@@ -0,0 +1,205 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_GEOM_FLATCOORDINATESEQUENCE_H
+#define GEOS_GEOM_FLATCOORDINATESEQUENCE_H
+
+#include <geos/export.h>
+#include <geos/platform.h> // for DoubleNotANumber
+#include <geos/geom/CoordinateSequence.h> // for inheritance
+#include <geos/geom/Coordinate.h> // for inlines
+
+#include <vector>
+#include <string>
+#include <cstddef>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+namespace geos {
+namespace geom { // geos::geom
+
+/**
+ * \brief
+ * A CoordinateSequence storing the ordinates of its coordinates
+ * interleaved in a single array of doubles.
+ *
+ * Sequences have a fixed dimension: XY sequences store two ordinates
+ * per coordinate (Z values set into them are dropped and read back as
+ * NaN), XYZ sequences store three. Short sequences (up to 6 XY or 4
+ * XYZ coordinates) keep their ordinates inside the object, requiring
+ * no further allocation.
+ *
+ * Coordinates are best read by copy, with getAt(i, c) or the ordinate
+ * accessors (getX, getY, getOrdinate, and the non-virtual getXAt,
+ * getYAt, getZAt and getCoordinate). getOrdinates and getStride give
+ * direct access to the underlying array.
+ *
+ * The Coordinate references returned by getAt(i) and toVector() point
+ * into a Coordinate copy of the sequence, built on first use (safely
+ * from concurrent readers) and dropped by any change to the sequence.
+ * Once the copy is built the sequence takes more memory than a
+ * CoordinateArraySequence: it only saves memory until the first of
+ * these calls. LineString envelopes and closure tests,
+ * CGAlgorithms::signedArea, length and locatePointInRing, and
+ * MonotoneChainBuilder read the ordinates directly; most other
+ * operations (Geometry::getCoordinate, getCoordinates, overlay,
+ * relate, buffer...) build the copy.
+ *
+ * @see FlatCoordinateSequenceFactory
+ */
+class GEOS_DLL FlatCoordinateSequence : public CoordinateSequence {
+
+public:
+
+	/// Construct an empty sequence of the given dimension (2 or 3)
+	FlatCoordinateSequence(std::size_t dimension=3);
+
+	/// Construct a sequence of n (0, 0) coordinates
+	FlatCoordinateSequence(std::size_t n, std::size_t dimension);
+
+	/// Construct a sequence copying the given coordinates
+	FlatCoordinateSequence(const std::vector<Coordinate>& coords,
+	                       std::size_t dimension);
+
+	FlatCoordinateSequence(const FlatCoordinateSequence& other);
+
+	~FlatCoordinateSequence();
+
+	CoordinateSequence *clone() const;
+
+	const Coordinate& getAt(std::size_t pos) const;
+
+	void getAt(std::size_t pos, Coordinate& c) const
+	{
+		getCoordinate(pos, c);
+	}
+
+	std::size_t getSize() const { return count; }
+
+	// @deprecated
+	const std::vector<Coordinate>* toVector() const;
+
+	void toVector(std::vector<Coordinate>& coords) const;
+
+	bool isEmpty() const { return count == 0; }
+
+	void add(const Coordinate& c);
+
+	void add(const Coordinate& c, bool allowRepeated);
+
+	void add(std::size_t i, const Coordinate& coord, bool allowRepeated);
+
+	void setAt(const Coordinate& c, std::size_t pos);
+
+	void deleteAt(std::size_t pos);
+
+	std::string toString() const;
+
+	void setPoints(const std::vector<Coordinate> &v);
+
+	std::size_t getDimension() const { return stride; }
+
+	double getOrdinate(std::size_t index, std::size_t ordinateIndex) const;
+
+	double getX(std::size_t index) const { return getXAt(index); }
+
+	double getY(std::size_t index) const { return getYAt(index); }
+
+	void setOrdinate(std::size_t index, std::size_t ordinateIndex,
+	                 double value);
+
+	void expandEnvelope(Envelope &env) const;
+
+	/// Counts the ordinates array, and the Coordinate copy if any
+	std::size_t getMemoryUsage() const;
+
+	void apply_rw(const CoordinateFilter *filter);
+
+	void apply_ro(CoordinateFilter *filter) const;
+
+	CoordinateSequence& removeRepeatedPoints();
+
+	/// Makes room for n coordinates without reallocating
+	void reserve(std::size_t n);
+
+	/// Returns the number of ordinates stored per coordinate (2 or 3)
+	std::size_t getStride() const { return stride; }
+
+	/// Returns the ordinates, getStride() per coordinate
+	const double* getOrdinates() const { return ords; }
+
+	double getXAt(std::size_t i) const { return ords[i*stride]; }
+
+	double getYAt(std::size_t i) const { return ords[i*stride+1]; }
+
+	double getZAt(std::size_t i) const
+	{
+		return stride > 2 ? ords[i*stride+2] : DoubleNotANumber;
+	}
+
+	/// Copy coordinate at position i to Coordinate c, without a virtual call
+	void getCoordinate(std::size_t i, Coordinate& c) const
+	{
+		const double* o = ords + i*stride;
+		c.x = o[0];
+		c.y = o[1];
+		c.z = stride > 2 ? o[2] : DoubleNotANumber;
+	}
+
+private:
+
+	/// Number of ordinates stored inside the object
+	enum { INLINE_ORDINATES = 12 };
+
+	double* ords;
+
+	std::size_t count;
+
+	/// Number of coordinates ords can hold
+	std::size_t capacity;
+
+	std::size_t stride;
+
+	double inlineOrds[INLINE_ORDINATES];
+
+	/// Coordinate copy of the sequence, see getAt
+	mutable std::vector<Coordinate>* view;
+
+	void init(std::size_t dimension, std::size_t n);
+
+	void store(std::size_t i, const Coordinate& c)
+	{
+		double* o = ords + i*stride;
+		o[0] = c.x;
+		o[1] = c.y;
+		if ( stride > 2 ) o[2] = c.z;
+	}
+
+	const std::vector<Coordinate>& getView() const;
+
+	void dropView();
+
+	// Declare type as non-assignable
+	FlatCoordinateSequence& operator=(const FlatCoordinateSequence& rhs);
+};
+
+} // namespace geos::geom
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // ndef GEOS_GEOM_FLATCOORDINATESEQUENCE_H
@@ -0,0 +1,68 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_GEOM_FLATCOORDINATESEQUENCEFACTORY_H
+#define GEOS_GEOM_FLATCOORDINATESEQUENCEFACTORY_H
+
+#include <geos/export.h>
+#include <geos/geom/CoordinateSequenceFactory.h> // for inheritance
+
+#include <vector>
+#include <cstddef>
+
+// Forward declarations
+namespace geos {
+	namespace geom { 
+		class Coordinate;
+	}
+}
+
+namespace geos {
+namespace geom { // geos::geom
+
+/**
+ * \brief
+ * Creates FlatCoordinateSequences, storing ordinates in
+ * a single array of doubles.
+ *
+ * Pass it to a GeometryFactory to have geometries built by
+ * the factory (and the readers using it) use such sequences.
+ * Sequences created with dimension 2 store XY ordinates only.
+ */
+class GEOS_DLL FlatCoordinateSequenceFactory: public CoordinateSequenceFactory {
+
+public:
+
+	/** \brief
+	 * Returns a FlatCoordinateSequence copying the given coordinates
+	 * and deletes the vector (callers give up ownership).
+	 *
+	 * With a dimension of 0 the sequence stores XYZ ordinates only
+	 * if any of the coordinates has a Z value.
+	 */
+	CoordinateSequence *create(std::vector<Coordinate> *coords,
+	                           std::size_t dimension=0) const;
+
+	/** @see CoordinateSequenceFactory::create(std::size_t, int) */
+	CoordinateSequence *create(std::size_t size,
+	                           std::size_t dimension=0) const;
+
+	/** \brief
+	 * Returns the singleton instance of FlatCoordinateSequenceFactory
+	 */
+	static const CoordinateSequenceFactory *instance();
+};
+
+} // namespace geos::geom
+} // namespace geos
+
+#endif // ndef GEOS_GEOM_FLATCOORDINATESEQUENCEFACTORY_H
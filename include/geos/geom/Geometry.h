@@ -263,6 +263,15 @@ public:
 	/// Returns the count of this Geometrys vertices.
 	virtual std::size_t getNumPoints() const=0; //Abstract
 
+	/**
+	 * \brief
+	 * Returns the number of bytes held by this Geometry: the object,
+	 * its cached envelope, its coordinates and its components.
+	 *
+	 * The factory and user data, which may be shared, are not counted.
+	 */
+	virtual std::size_t getMemoryUsage() const=0; //Abstract
+
 	/// Returns false if the Geometry not simple.
 	virtual bool isSimple() const; 
 
@@ -766,6 +775,12 @@ protected:
 
 	/// The bounding box of this Geometry
 	mutable std::auto_ptr<Envelope> envelope;
+
+	/// Returns the bytes held by the cached envelope, if computed
+	std::size_t getEnvelopeMemoryUsage() const
+	{
+		return envelope.get() ? sizeof(Envelope) : 0;
+	}
 	
 	/// Returns true if the array contains any non-empty Geometrys.
 	static bool hasNonEmptyElements(const std::vector<Geometry *>* geometries);
@@ -806,6 +821,9 @@ protected:
 			double tolerance) const;
 	int SRID;
 
+	/// True if this Geometry was counted by its factory on construction
+	bool counted;
+
 	/// @deprecated
 	//Geometry* toInternalGeometry(const Geometry *g) const;
 
@@ -118,6 +118,8 @@ public:
 
 	virtual std::size_t getNumPoints() const;
 
+	virtual std::size_t getMemoryUsage() const;
+
 	virtual std::string getGeometryType() const;
 
 	virtual GeometryTypeId getGeometryTypeId() const;
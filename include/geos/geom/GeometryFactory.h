@@ -383,10 +383,45 @@ public:
 	/// Destroy a Geometry, or release it
 	void destroyGeometry(Geometry *g) const;
 
+	/** \brief
+	 * Enables or disables counting of the Geometry objects
+	 * built with this factory.
+	 *
+	 * Counting is off by default. Only Geometries constructed while
+	 * it is on are counted, and their destruction is counted even
+	 * if it is later turned off. Counters are updated atomically,
+	 * so a factory shared by threads reports totals for all of them.
+	 */
+	void setGeometryCounting(bool enable) const;
+
+	/// Returns true if Geometry counting is enabled
+	bool isGeometryCounting() const;
+
+	/// Number of counted Geometries constructed so far
+	std::size_t getNumGeometriesCreated() const;
+
+	/// Number of counted Geometries not destroyed yet
+	std::size_t getNumGeometriesLive() const;
+
 private:
+
+	friend class Geometry;
+
+	/// Called by the Geometry constructors, when counting
+	void geometryCreated() const;
+
+	/// Called by the Geometry destructor, for counted Geometries
+	void geometryDestroyed() const;
+
 	const PrecisionModel* precisionModel;
 	int SRID;
 	const CoordinateSequenceFactory *coordinateListFactory;
+
+	/// Non-zero when counting; read and written atomically,
+	/// as geometries may be built by several threads
+	mutable std::size_t countGeometries;
+	mutable std::size_t geometriesCreated;
+	mutable std::size_t geometriesDestroyed;
 };
 
 } // namespace geos::geom
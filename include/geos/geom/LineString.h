@@ -117,6 +117,8 @@ public:
 
 	virtual std::size_t getNumPoints() const;
 
+	virtual std::size_t getMemoryUsage() const;
+
 	virtual Point* getPointN(std::size_t n) const;
 
 	/// \brief
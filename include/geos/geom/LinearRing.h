@@ -113,6 +113,8 @@ public:
 
 	virtual GeometryTypeId getGeometryTypeId() const;
 
+	std::size_t getMemoryUsage() const;
+
 	void setPoints(CoordinateSequence* cl);
 
   	Geometry* reverse() const;
@@ -73,6 +73,8 @@ public:
 
 	virtual GeometryTypeId getGeometryTypeId() const;
 
+	std::size_t getMemoryUsage() const;
+
 	bool isClosed() const;
 
 	bool equalsExact(const Geometry *other, double tolerance=0) const;
@@ -82,6 +82,8 @@ public:
 
 	virtual GeometryTypeId getGeometryTypeId() const;
 
+	std::size_t getMemoryUsage() const;
+
 	bool equalsExact(const Geometry *other, double tolerance=0) const;
 
 	Geometry *clone() const { return new MultiPoint(*this); }
@@ -83,6 +83,8 @@ public:
 
 	virtual GeometryTypeId getGeometryTypeId() const;
 
+	std::size_t getMemoryUsage() const;
+
 	bool isSimple() const;
 
 	bool equalsExact(const Geometry *other, double tolerance=0) const;
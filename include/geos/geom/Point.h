@@ -89,6 +89,8 @@ public:
 	const CoordinateSequence* getCoordinatesRO() const;
 
 	size_t getNumPoints() const;
+
+	std::size_t getMemoryUsage() const;
 	bool isEmpty() const;
 	bool isSimple() const;
 
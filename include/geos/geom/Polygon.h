@@ -87,6 +87,8 @@ public:
 
 	size_t getNumPoints() const;
 
+	std::size_t getMemoryUsage() const;
+
 	/// Returns surface dimension (2)
 	Dimension::DimensionType getDimension() const;
 
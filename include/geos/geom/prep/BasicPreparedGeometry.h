@@ -28,12 +28,18 @@
 
 #include <vector>
 #include <string>
+#include <memory> // for auto_ptr
 
 namespace geos {
 	namespace geom {
 		class Geometry;
 		class Coordinate;
 	}
+	namespace operation {
+		namespace distance {
+			class IndexedFacetDistance;
+		}
+	}
 }
 
 
@@ -62,6 +68,15 @@ private:
 	const geom::Geometry * baseGeom;
 	Coordinate::ConstVect representativePts;
 
+	/// Facets of baseGeom, indexed by the first distance query
+	mutable std::auto_ptr<operation::distance::IndexedFacetDistance>
+		facetDistance;
+
+	operation::distance::IndexedFacetDistance& getFacetDistance() const;
+
+	/// Tests whether the distance to g may be 0 while facets are apart
+	bool hasAreaWith(const geom::Geometry* g) const;
+
 protected:
 	/**
 	 * Sets the original {@link Geometry} which will be prepared.
@@ -171,6 +186,24 @@ public:
 	 */
 	bool within(const geom::Geometry * g) const;
 
+	/**
+	 * Standard implementation for all geometries,
+	 * using an index of the facets of the base geometry.
+	 */
+	double distance(const geom::Geometry * g) const;
+
+	/**
+	 * Standard implementation for all geometries,
+	 * using an index of the facets of the base geometry.
+	 */
+	bool isWithinDistance(const geom::Geometry * g, double dist) const;
+
+	/**
+	 * Computes the envelopes of all components of the base geometry,
+	 * the only index of the standard implementation.
+	 */
+	virtual void buildIndexes() const;
+
 	std::string toString();
 
 };
@@ -191,6 +191,45 @@ public:
 	 * @see Geometry#within(Geometry)
 	 */
 	virtual bool within(const geom::Geometry *geom) const =0;
+
+	/**
+	 * Computes the distance between the base {@link Geometry}
+	 * and a given geometry.
+	 *
+	 * The facets of the base geometry are indexed by the first call,
+	 * and the index is reused by the following ones.
+	 *
+	 * @param geom the Geometry to compute the distance to
+	 * @return the distance, 0 if either geometry is empty
+	 *
+	 * @see Geometry#distance(Geometry)
+	 */
+	virtual double distance(const geom::Geometry *geom) const =0;
+
+	/**
+	 * Tests whether the base {@link Geometry} is within a given
+	 * distance of a given geometry, stopping at the first facets
+	 * found that close.
+	 *
+	 * @param geom the Geometry to test
+	 * @param dist the distance to test
+	 * @return true if distance(geom) <= dist
+	 *
+	 * @see Geometry#isWithinDistance(Geometry, double)
+	 */
+	virtual bool isWithinDistance(const geom::Geometry *geom,
+	                              double dist) const =0;
+
+	/**
+	 * Builds the indexes used by the spatial predicates, which are
+	 * otherwise built on first use (or, for polygons tested against
+	 * few points, not at all).
+	 *
+	 * The predicates then only read the prepared geometry, so they
+	 * may be evaluated from several threads at once. The facet index
+	 * used by distance and isWithinDistance is not built.
+	 */
+	virtual void buildIndexes() const =0;
 };
 
 
@@ -0,0 +1,149 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_GEOM_PREP_PREPAREDGEOMETRYCACHE_H
+#define GEOS_GEOM_PREP_PREPAREDGEOMETRYCACHE_H
+
+#include <geos/export.h>
+
+#include <list>
+#include <map>
+#include <cstddef>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// Forward declarations
+namespace geos {
+	namespace geom {
+		class Geometry;
+		namespace prep {
+			class PreparedGeometry;
+		}
+	}
+}
+
+namespace geos {
+namespace geom { // geos::geom
+namespace prep { // geos::geom::prep
+
+/**
+ * \brief
+ * A bounded cache of PreparedGeometry objects, dropping the least
+ * recently used one when full.
+ *
+ * Entries are keyed by the address of the given Geometry, but each
+ * entry prepares a copy of it: deleting or changing the Geometry
+ * never leaves the cache pointing to freed memory. As an address may
+ * be reused, an entry is only used for a Geometry exactly equal
+ * to its copy (compared once their content hashes match, see
+ * contentHash), and is prepared again otherwise.
+ *
+ * Not thread-safe: use one cache per thread.
+ */
+class GEOS_DLL PreparedGeometryCache
+{
+public:
+
+	/// The capacity of caches built with the default constructor
+	static const std::size_t DEFAULT_CAPACITY = 16;
+
+	/**
+	 * @param capacity maximum number of geometries kept prepared,
+	 *        at least 1
+	 */
+	PreparedGeometryCache(std::size_t capacity = DEFAULT_CAPACITY);
+
+	~PreparedGeometryCache();
+
+	/**
+	 * Returns g prepared, preparing it unless found in the cache.
+	 *
+	 * The returned object stays valid until the next call to a
+	 * non-const method of the cache.
+	 */
+	const PreparedGeometry& get(const Geometry& g);
+
+	/// Drops the entry of the given geometry, if any
+	void remove(const Geometry* g);
+
+	/// Drops all entries
+	void clear();
+
+	/// Sets the maximum number of entries (at least 1)
+	void setCapacity(std::size_t capacity);
+
+	std::size_t getCapacity() const { return capacity; }
+
+	/// Returns the number of geometries currently prepared
+	std::size_t size() const { return index.size(); }
+
+	/// Returns the number of get() calls finding their geometry prepared
+	unsigned long getHits() const { return hits; }
+
+	/// Returns the number of get() calls preparing their geometry
+	unsigned long getMisses() const { return misses; }
+
+	/**
+	 * Returns a hash of the type, number of points, envelope and
+	 * of (a sample of at most a few hundreds of) the coordinates
+	 * of a geometry, in time independent of its size for all but
+	 * collections of very many parts.
+	 */
+	static std::size_t contentHash(const Geometry& g);
+
+private:
+
+	struct Entry {
+		/// Address of the geometry given to get(): never dereferenced
+		const Geometry* geom;
+		std::size_t hash;
+		/// The copy of the geometry which is prepared, owned
+		const Geometry* base;
+		const PreparedGeometry* prepared;
+	};
+
+	/// Most recently used first
+	typedef std::list<Entry> EntryList;
+
+	typedef std::map<const Geometry*, EntryList::iterator> EntryIndex;
+
+	EntryList entries;
+
+	EntryIndex index;
+
+	std::size_t capacity;
+
+	unsigned long hits;
+
+	unsigned long misses;
+
+	void erase(EntryIndex::iterator i);
+
+	void shrink(std::size_t n);
+
+	// Declare type as noncopyable
+	PreparedGeometryCache(const PreparedGeometryCache& other);
+	PreparedGeometryCache& operator=(const PreparedGeometryCache& rhs);
+};
+
+} // namespace geos::geom::prep
+} // namespace geos::geom
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // GEOS_GEOM_PREP_PREPAREDGEOMETRYCACHE_H
@@ -23,6 +23,8 @@
 #include <geos/export.h>
 #include <geos/geom/prep/PreparedGeometry.h>
 
+#include <cstddef>
+
 namespace geos {
 	namespace geom {
         namespace prep {
@@ -53,6 +55,18 @@ class GEOS_DLL PreparedGeometryFactory
 {
 public:
 
+	/// The index threshold used by prepareAdaptive
+	static const std::size_t DEFAULT_INDEX_THRESHOLD = 16;
+
+	/**
+	 * @param indexThreshold number of points polygons prepared by this
+	 *        factory locate before building their indexes, see
+	 *        PreparedPolygon::setIndexThreshold
+	 */
+	PreparedGeometryFactory(std::size_t threshold = 0)
+		: indexThreshold(threshold)
+	{}
+
 	/**
 	* Creates a new {@link PreparedGeometry} appropriate for the argument {@link Geometry}.
 	* 
@@ -64,6 +78,23 @@ public:
 		PreparedGeometryFactory pf;
 		return pf.create(geom); 
 	}
+
+	/**
+	* Creates a new {@link PreparedGeometry} appropriate for the argument
+	* {@link Geometry}, building its indexes only once enough predicates
+	* were evaluated for them to pay off.
+	*
+	* Preparing a geometry this way costs little more than evaluating a
+	* single predicate on it, so it can be done even for one-shot tests.
+	*
+	* @param geom the geometry to prepare
+	* @return the prepared geometry
+	*/
+	static const PreparedGeometry * prepareAdaptive(const geom::Geometry * geom)
+	{
+		PreparedGeometryFactory pf(DEFAULT_INDEX_THRESHOLD);
+		return pf.create(geom);
+	}
     
     /**
  	* Destroys {@link PreparedGeometry} allocated with the factory.
@@ -83,6 +114,9 @@ public:
 	*/
 	const PreparedGeometry* create(const geom::Geometry* geom) const;
 
+private:
+
+	std::size_t indexThreshold;
 };
 
 } // namespace geos::geom::prep
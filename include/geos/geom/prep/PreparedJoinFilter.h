@@ -0,0 +1,120 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_GEOM_PREP_PREPAREDJOINFILTER_H
+#define GEOS_GEOM_PREP_PREPAREDJOINFILTER_H
+
+#include <geos/export.h>
+#include <geos/index/ItemPairVisitor.h> // for inheritance
+
+#include <map>
+#include <cstddef>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// Forward declarations
+namespace geos {
+	namespace geom {
+		class Geometry;
+		namespace prep {
+			class PreparedGeometry;
+		}
+	}
+}
+
+namespace geos {
+namespace geom { // geos::geom
+namespace prep { // geos::geom::prep
+
+/**
+ * \brief
+ * Refines the candidate pairs of a spatial join with a
+ * PreparedGeometry predicate.
+ *
+ * Both items of each pair must be Geometry objects.
+ * The first one is prepared the first time it is seen and kept
+ * until the filter is destroyed, so that the preparation cost
+ * is paid once per geometry rather than once per pair; the pair
+ * is passed on to the wrapped visitor if the predicate holds
+ * between the prepared geometry and the second one.
+ *
+ * Example:
+ *
+ * <pre>
+ *   PreparedJoinFilter filter(PreparedJoinFilter::CONTAINS, visitor);
+ *   polygonTree.join(pointTree, filter);
+ * </pre>
+ *
+ * @see index::strtree::STRtree::join
+ */
+class GEOS_DLL PreparedJoinFilter: public index::ItemPairVisitor
+{
+public:
+
+	/// The predicates a join can be refined with
+	enum Predicate {
+		INTERSECTS,
+		CONTAINS,
+		CONTAINS_PROPERLY,
+		COVERS,
+		COVERED_BY,
+		CROSSES,
+		OVERLAPS,
+		TOUCHES,
+		WITHIN
+	};
+
+	/**
+	 * @param predicate the predicate pairs of geometries must satisfy
+	 * @param visitor the visitor to pass the matching pairs to,
+	 *        ownership left to caller
+	 */
+	PreparedJoinFilter(Predicate predicate, index::ItemPairVisitor& visitor);
+
+	~PreparedJoinFilter();
+
+	void visitItemPair(void *item, void *otherItem);
+
+	/// Returns the number of geometries prepared so far
+	std::size_t getNumPrepared() const { return prepared.size(); }
+
+private:
+
+	Predicate predicate;
+
+	index::ItemPairVisitor& visitor;
+
+	typedef std::map<const Geometry*, const PreparedGeometry*> PreparedMap;
+
+	PreparedMap prepared;
+
+	const PreparedGeometry& getPrepared(const Geometry* g);
+
+	bool evaluate(const PreparedGeometry& pg, const Geometry* g) const;
+
+	// Declare type as noncopyable
+	PreparedJoinFilter(const PreparedJoinFilter& other);
+	PreparedJoinFilter& operator=(const PreparedJoinFilter& rhs);
+};
+
+} // namespace geos::geom::prep
+} // namespace geos::geom
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // GEOS_GEOM_PREP_PREPAREDJOINFILTER_H
@@ -60,6 +60,9 @@ public:
 
 	bool intersects(const geom::Geometry * g) const;
 
+	/// Also builds the segment index
+	void buildIndexes() const;
+
 };
 
 } // namespace geos::geom::prep
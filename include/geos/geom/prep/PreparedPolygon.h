@@ -23,6 +23,8 @@
 #include <geos/geom/prep/BasicPreparedGeometry.h> // for inheritance
 #include <geos/noding/SegmentString.h> 
 
+#include <cstddef>
+
 namespace geos {
 	namespace noding {
 		class FastSegmentSetIntersectionFinder;
@@ -42,6 +44,12 @@ namespace prep { // geos::geom::prep
  * \brief
  * A prepared version of {@link Polygon} or {@link MultiPolygon} geometries.
  * 
+ * The indexes used by the predicates are built on first use.
+ * Polygons can also be told to put it off until a number of points
+ * have been tested against them (see setIndexThreshold): until then
+ * predicates with puntal arguments scan all polygon segments, which
+ * is cheaper for a few points than building the indexes.
+ *
  * @author mbdavis
  *
  */
@@ -53,6 +61,25 @@ private:
 	mutable algorithm::locate::PointOnGeometryLocator * ptOnGeomLoc;
 	mutable noding::SegmentString::ConstVect segStrings;
 
+	/// Number of points that may be located without the indexes
+	std::size_t indexThreshold;
+
+	/// Number of points located without the indexes so far
+	mutable std::size_t numUnindexedPoints;
+
+	enum PointPredicate {
+		CONTAINS,
+		CONTAINS_PROPERLY,
+		COVERS,
+		INTERSECTS
+	};
+
+	bool useUnindexed(const geom::Geometry* g) const;
+
+	int locateUnindexed(const geom::Coordinate& p) const;
+
+	bool evalUnindexed(const geom::Geometry* g, PointPredicate pred) const;
+
 protected:
 public:
 	PreparedPolygon( const geom::Geometry * geom);
@@ -60,12 +87,31 @@ public:
   
 	noding::FastSegmentSetIntersectionFinder * getIntersectionFinder() const;
 	algorithm::locate::PointOnGeometryLocator * getPointLocator() const;
+
+	/**
+	 * Sets the number of points to locate by scanning the polygon
+	 * segments before building the indexes. 0, the default, uses
+	 * the indexes right away.
+	 */
+	void setIndexThreshold(std::size_t numPoints)
+	{
+		indexThreshold = numPoints;
+	}
+
+	/// Returns true once any of the indexes has been built
+	bool isIndexed() const
+	{
+		return segIntFinder || ptOnGeomLoc;
+	}
 	
 	bool contains( const geom::Geometry* g) const;
 	bool containsProperly( const geom::Geometry* g) const;
 	bool covers( const geom::Geometry* g) const;
 	bool intersects( const geom::Geometry* g) const;
 
+	/// Also builds the segment and point-in-area indexes
+	void buildIndexes() const;
+
 };
 
 } // namespace geos::geom::prep
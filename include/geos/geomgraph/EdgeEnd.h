@@ -25,6 +25,7 @@
 #include <geos/export.h>
 #include <geos/geom/Coordinate.h>  // for p0,p1
 #include <geos/geomgraph/Label.h>  // for composition
+#include <geos/geomgraph/GraphArena.h> // for operator new
 #include <geos/inline.h>
 
 #include <string>
@@ -63,6 +64,17 @@ public:
 
 	virtual ~EdgeEnd() {}
 
+	/// Allocated from the current GraphArena, if any
+	static void* operator new(std::size_t size)
+	{
+		return GraphArena::allocateComponent(size);
+	}
+
+	static void operator delete(void* ptr)
+	{
+		GraphArena::deallocateComponent(ptr);
+	}
+
 	/**
 	 * NOTES:
 	 *  - Copies the given Label 
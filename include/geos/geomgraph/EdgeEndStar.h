@@ -24,6 +24,7 @@
 
 #include <geos/export.h>
 #include <geos/geomgraph/EdgeEnd.h>  // for EdgeEndLT
+#include <geos/geomgraph/GraphArena.h> // for operator new
 #include <geos/geom/Coordinate.h>  // for p0,p1
 
 #include <geos/inline.h>
@@ -72,6 +73,17 @@ public:
 
 	virtual ~EdgeEndStar() {}
 
+	/// Allocated from the current GraphArena, if any
+	static void* operator new(std::size_t size)
+	{
+		return GraphArena::allocateComponent(size);
+	}
+
+	static void operator delete(void* ptr)
+	{
+		GraphArena::deallocateComponent(ptr);
+	}
+
 	/** \brief
 	 * Insert a EdgeEnd into this EdgeEndStar
 	 */
@@ -25,6 +25,7 @@
 #include <geos/export.h>
 
 #include <geos/geom/Coordinate.h> // for composition and inlines
+#include <geos/geomgraph/GraphArena.h> // for operator new
 
 #include <geos/inline.h>
 
@@ -45,6 +46,17 @@ namespace geomgraph { // geos.geomgraph
 class GEOS_DLL EdgeIntersection {
 public:
 
+	/// Allocated from the current GraphArena, if any
+	static void* operator new(std::size_t size)
+	{
+		return GraphArena::allocateComponent(size);
+	}
+
+	static void operator delete(void* ptr)
+	{
+		GraphArena::deallocateComponent(ptr);
+	}
+
 	// the point of intersection
 	geom::Coordinate coord;
 
@@ -112,8 +112,17 @@ private:
 
 	geom::Coordinate invalidPoint; 
 
-	/// Allocates a new EdgeSetIntersector. Remember to delete it!
-	index::EdgeSetIntersector* createEdgeSetIntersector();
+	/**
+	 * Allocates a new EdgeSetIntersector for the given edges.
+	 * Remember to delete it!
+	 *
+	 * A sweep line is used, unless the monotone chains of the
+	 * edges overlap in x so much (e.g. many long east-west edges)
+	 * that an index of the chains pays off.
+	 */
+	static index::EdgeSetIntersector* createEdgeSetIntersector(
+			const std::vector<Edge*>& edges0,
+			const std::vector<Edge*>* edges1=NULL);
 
 	void add(const geom::Geometry *g);
 		// throw(UnsupportedOperationException);
@@ -0,0 +1,120 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_GEOMGRAPH_GRAPHARENA_H
+#define GEOS_GEOMGRAPH_GRAPHARENA_H
+
+#include <geos/export.h>
+
+#include <vector>
+#include <cstddef>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+namespace geos {
+namespace geomgraph { // geos::geomgraph
+
+/** \brief
+ * A bump allocator for the components of a graph (edges, nodes,
+ * edge ends, edge intersections).
+ *
+ * Operations building a graph own a GraphArena and make it the
+ * current arena of the calling thread with a GraphArena::Scope.
+ * While a scope is active, graph components are carved from
+ * large memory blocks owned by the arena; deleting them runs
+ * their destructors but releases no memory, which is all given
+ * back at once when the arena is destroyed.
+ *
+ * Components allocated with no current arena come from the heap
+ * as usual, so graphs built outside an operation are unaffected.
+ *
+ * An arena must outlive all components allocated from it.
+ */
+class GEOS_DLL GraphArena {
+
+public:
+
+	GraphArena();
+
+	~GraphArena();
+
+	/**
+	 * Returns a block of at least the given size, aligned
+	 * for any type. The block is released with the arena.
+	 */
+	void* allocate(std::size_t size);
+
+	/// Returns the number of bytes allocated from this arena
+	std::size_t getNumBytes() const { return numBytes; }
+
+	/**
+	 * Makes an arena the current one of the calling thread
+	 * for the lifetime of the Scope object, restoring the
+	 * previous one on destruction.
+	 */
+	class GEOS_DLL Scope {
+	public:
+		explicit Scope(GraphArena& arena);
+		~Scope();
+	private:
+		GraphArena* previous;
+
+		// Declare type as noncopyable
+		Scope(const Scope& other);
+		Scope& operator=(const Scope& rhs);
+	};
+
+	/// Returns the current arena of the calling thread, or 0
+	static GraphArena* getCurrent();
+
+	/**
+	 * Allocates a graph component from the current arena,
+	 * or from the heap if there is none.
+	 *
+	 * Used by the class-specific operator new of graph components.
+	 *
+	 * @throws std::bad_alloc if memory is exhausted
+	 */
+	static void* allocateComponent(std::size_t size);
+
+	/**
+	 * Releases memory obtained by allocateComponent, if
+	 * it did not come from an arena.
+	 */
+	static void deallocateComponent(void* ptr);
+
+private:
+
+	std::vector<char*> blocks;
+
+	/// Free space in the last block of the blocks vector
+	char* top;
+	char* end;
+
+	std::size_t numBytes;
+
+	// Declare type as noncopyable
+	GraphArena(const GraphArena& other);
+	GraphArena& operator=(const GraphArena& rhs);
+};
+
+} // namespace geos::geomgraph
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // ifndef GEOS_GEOMGRAPH_GRAPHARENA_H
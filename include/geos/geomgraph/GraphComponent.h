@@ -26,6 +26,7 @@
 #include <geos/inline.h>
 
 #include <geos/geomgraph/Label.h>
+#include <geos/geomgraph/GraphArena.h> // for operator new
 
 // Forward declarations
 namespace geos {
@@ -54,6 +55,17 @@ public:
 	GraphComponent(const Label& newLabel); 
 	virtual ~GraphComponent();
 
+	/// Allocated from the current GraphArena, if any
+	static void* operator new(std::size_t size)
+	{
+		return GraphArena::allocateComponent(size);
+	}
+
+	static void operator delete(void* ptr)
+	{
+		GraphArena::deallocateComponent(ptr);
+	}
+
 	Label& getLabel() { return label; }
 	const Label& getLabel() const { return label; }
 	void setLabel(const Label& newLabel) { label = newLabel; }
@@ -0,0 +1,107 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_GEOMGRAPH_INDEX_MCINDEXEDGESETINTERSECTOR_H
+#define GEOS_GEOMGRAPH_INDEX_MCINDEXEDGESETINTERSECTOR_H
+
+#include <geos/export.h>
+#include <geos/geomgraph/index/EdgeSetIntersector.h> // for inheritance
+#include <geos/geom/Envelope.h> // for composition
+
+#include <vector>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// Forward declarations
+namespace geos {
+	namespace geomgraph {
+		class Edge;
+		namespace index {
+			class MonotoneChainEdge;
+			class SegmentIntersector;
+		}
+	}
+}
+
+namespace geos {
+namespace geomgraph { // geos::geomgraph
+namespace index { // geos::geomgraph::index
+
+/** \brief
+ * Finds all intersections in one or two sets of edges,
+ * using an STR tree of the Monotone Chains of the edges.
+ *
+ * Each chain is compared with the chains whose envelope
+ * intersects its own, as noding::MCIndexNoder does.
+ * Unlike the sweep-line intersectors, which compare all the chains
+ * overlapping in x, this does not degrade when many edges
+ * have long x-extents (e.g. long east-west boundaries), at the
+ * cost of building the tree.
+ */
+class GEOS_DLL MCIndexEdgeSetIntersector: public EdgeSetIntersector {
+
+public:
+
+	MCIndexEdgeSetIntersector();
+
+	virtual ~MCIndexEdgeSetIntersector();
+
+	void computeIntersections(std::vector<Edge*> *edges,
+			SegmentIntersector *si, bool testAllSegments);
+
+	void computeIntersections(std::vector<Edge*> *edges0,
+			std::vector<Edge*> *edges1,
+			SegmentIntersector *si);
+
+	/// Returns the number of chain pairs compared by the last run
+	int getNumOverlaps() const { return nOverlaps; }
+
+private:
+
+	/// A chain of an edge, and the group of the edge
+	struct Chain {
+		MonotoneChainEdge* mce;
+		int chainIndex;
+		void* edgeSet;
+		geom::Envelope env;
+	};
+
+	// statistics information
+	int nOverlaps;
+
+	/// Adds the chains of the edges, each edge in its own group
+	static void addChains(std::vector<Edge*> *edges,
+			std::vector<Chain>& chains);
+
+	static void addChains(std::vector<Edge*> *edges, void* edgeSet,
+			std::vector<Chain>& chains);
+
+	static void addChains(Edge* edge, void* edgeSet,
+			std::vector<Chain>& chains);
+
+	// Declare type as noncopyable
+	MCIndexEdgeSetIntersector(const MCIndexEdgeSetIntersector& other);
+	MCIndexEdgeSetIntersector& operator=(const MCIndexEdgeSetIntersector& rhs);
+};
+
+} // namespace geos.geomgraph.index
+} // namespace geos.geomgraph
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // GEOS_GEOMGRAPH_INDEX_MCINDEXEDGESETINTERSECTOR_H
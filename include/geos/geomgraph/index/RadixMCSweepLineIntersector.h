@@ -0,0 +1,134 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_GEOMGRAPH_INDEX_RADIXMCSWEEPLINEINTERSECTOR_H
+#define GEOS_GEOMGRAPH_INDEX_RADIXMCSWEEPLINEINTERSECTOR_H
+
+#include <geos/export.h>
+#include <geos/geomgraph/index/EdgeSetIntersector.h> // for inheritance
+#include <geos/geomgraph/index/MonotoneChain.h> // for composition
+
+#include <vector>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// Forward declarations
+namespace geos {
+	namespace geomgraph {
+		class Edge;
+		namespace index {
+			class SegmentIntersector;
+		}
+	}
+}
+
+namespace geos {
+namespace geomgraph { // geos::geomgraph
+namespace index { // geos::geomgraph::index
+
+/** \brief
+ * Finds all intersections in one or two sets of edges,
+ * using an x-axis sweepline over Monotone Chains.
+ *
+ * Computes the same chain overlaps as SimpleMCSweepLineIntersector,
+ * without allocating objects per chain: the chains are kept by value
+ * in a single vector, and the events are small values holding an
+ * integer key of their x-ordinate and the index of their chain.
+ * The events are sorted by a radix sort on that key, inserts
+ * before deletes at the same x.
+ */
+class GEOS_DLL RadixMCSweepLineIntersector: public EdgeSetIntersector {
+
+public:
+
+	RadixMCSweepLineIntersector();
+
+	virtual ~RadixMCSweepLineIntersector();
+
+	void computeIntersections(std::vector<Edge*> *edges,
+			SegmentIntersector *si, bool testAllSegments);
+
+	void computeIntersections(std::vector<Edge*> *edges0,
+			std::vector<Edge*> *edges1,
+			SegmentIntersector *si);
+
+	/// Returns the number of chain pairs compared by the last run
+	int getNumOverlaps() const { return nOverlaps; }
+
+private:
+
+	enum {
+		INSERT_EVENT = 0,
+		DELETE_EVENT
+	};
+
+	/// The x-ordinate of the start or end of a chain
+	struct Event {
+		/// unsigned integers ordered as the x-ordinates
+		unsigned int keyHi;
+		unsigned int keyLo;
+		unsigned int chain;
+		unsigned int type;
+	};
+
+	std::vector<MonotoneChain> chains;
+
+	/// group of the edge of each chain, NULL to compare with all
+	std::vector<void*> edgeSets;
+
+	/// Inserts of all chains, then their deletes
+	std::vector<Event> inserts;
+	std::vector<Event> deletes;
+
+	/// Sorted events
+	std::vector<Event> events;
+
+	/// Index in events of the delete event of each chain
+	std::vector<unsigned int> deleteIndex;
+
+	// statistics information
+	int nOverlaps;
+
+	void add(std::vector<Edge*> *edges);
+
+	void add(std::vector<Edge*> *edges, void* edgeSet);
+
+	void add(Edge *edge, void* edgeSet);
+
+	static Event makeEvent(double x, unsigned int chain, unsigned int type);
+
+	void prepareEvents();
+
+	static void sortEvents(std::vector<Event>& events);
+
+	void computeIntersections(SegmentIntersector *si);
+
+	void processOverlaps(unsigned int start, unsigned int end,
+			unsigned int chain0, SegmentIntersector *si);
+
+	// Declare type as noncopyable
+	RadixMCSweepLineIntersector(const RadixMCSweepLineIntersector& other);
+	RadixMCSweepLineIntersector& operator=(const RadixMCSweepLineIntersector& rhs);
+};
+
+} // namespace geos.geomgraph.index
+} // namespace geos.geomgraph
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // GEOS_GEOMGRAPH_INDEX_RADIXMCSWEEPLINEINTERSECTOR_H
@@ -27,6 +27,8 @@ namespace index {
 # include <geos/geomgraph/index/SimpleEdgeSetIntersector.h>
 # include <geos/geomgraph/index/SimpleSweepLineIntersector.h>
 # include <geos/geomgraph/index/SimpleMCSweepLineIntersector.h>
+# include <geos/geomgraph/index/RadixMCSweepLineIntersector.h>
+# include <geos/geomgraph/index/MCIndexEdgeSetIntersector.h>
 
 #include <geos/geomgraph/index/SweepLineSegment.h>
 #include <geos/geomgraph/index/SweepLineEvent.h>
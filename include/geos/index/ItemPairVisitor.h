@@ -0,0 +1,39 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_INDEX_ITEMPAIRVISITOR_H
+#define GEOS_INDEX_ITEMPAIRVISITOR_H
+
+#include <geos/export.h>
+
+namespace geos {
+namespace index {
+
+/** \brief
+ * A visitor for pairs of items found by joining two indexes.
+ */
+class GEOS_DLL ItemPairVisitor {
+public:
+	/**
+	 * @param item an item of the index being joined
+	 * @param otherItem an item of the index it is joined with
+	 */
+	virtual void visitItemPair(void *item, void *otherItem)=0;
+
+	virtual ~ItemPairVisitor() {}
+};
+
+} // namespace geos.index
+} // namespace geos
+
+#endif // GEOS_INDEX_ITEMPAIRVISITOR_H
+
@@ -0,0 +1,151 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_IDX_CHAIN_SEGMENTENVELOPEBLOCK_H
+#define GEOS_IDX_CHAIN_SEGMENTENVELOPEBLOCK_H
+
+#include <geos/export.h>
+
+#include <cstddef>
+
+// Forward declarations
+namespace geos {
+	namespace geom {
+		class Coordinate;
+		class CoordinateSequence;
+	}
+}
+
+namespace geos {
+namespace index { // geos::index
+namespace chain { // geos::index::chain
+
+/** \brief
+ * The envelopes of a block of consecutive segments, tested for
+ * intersection with another envelope all at once.
+ *
+ * Extents are stored by ordinate, so that the test runs on several
+ * envelopes per instruction where SSE2 or AVX are available (as
+ * chosen at compile time), with a plain loop otherwise. The result
+ * is the same as that of Envelope::intersects for each envelope.
+ *
+ * The pairs of segments of two sequences with intersecting envelopes
+ * can so be found with one test per segment of the first, see
+ * intersectingSegments and visitOverlaps.
+ */
+class GEOS_DLL SegmentEnvelopeBlock {
+
+public:
+
+	/// Maximum number of segments in a block
+	enum { CAPACITY = 32 };
+
+	SegmentEnvelopeBlock() : count(0) {}
+
+	/**
+	 * Sets the block to the segments [start, end) of pts,
+	 * at most CAPACITY of them. Segment i joins points i and i+1.
+	 */
+	void setSegments(const geom::CoordinateSequence& pts,
+	                 std::size_t start, std::size_t end);
+
+	/// Returns the number of segments in the block
+	std::size_t size() const { return count; }
+
+	/**
+	 * Returns a mask with bit i set if the envelope of the i-th
+	 * segment of the block intersects the given extent.
+	 */
+	unsigned int intersecting(double minx, double miny,
+	                          double maxx, double maxy) const;
+
+	/**
+	 * Returns a mask with bit i set if the envelope of the i-th
+	 * segment of the block intersects the envelope of p0-p1.
+	 */
+	unsigned int intersecting(const geom::Coordinate& p0,
+	                          const geom::Coordinate& p1) const;
+
+	/**
+	 * Sets masks[k] to the intersecting() mask of segment start+k
+	 * of pts, for each segment in [start, end).
+	 */
+	void intersectingSegments(const geom::CoordinateSequence& pts,
+	                          std::size_t start, std::size_t end,
+	                          unsigned int* masks) const;
+
+private:
+
+	std::size_t count;
+
+	// Padded to a multiple of the vector width
+	double minX[CAPACITY];
+	double maxX[CAPACITY];
+	double minY[CAPACITY];
+	double maxY[CAPACITY];
+};
+
+/**
+ * Calls action(i, j) for each pair of segments i in [start0, end0) and
+ * j in [start1, end1) for which bit j-base1 of masks[i-base0] is set,
+ * in the order MonotoneChain::computeOverlaps finds overlapping pairs
+ * by bisecting both ranges.
+ *
+ * @param masks the intersectingSegments masks of the first range
+ *        against a block of the second, starting at segments
+ *        base0 and base1
+ */
+template <class Action>
+void
+visitOverlaps(const unsigned int* masks, std::size_t base0, std::size_t base1,
+              std::size_t start0, std::size_t end0,
+              std::size_t start1, std::size_t end1, Action& action)
+{
+	if ( end0-start0 == 1 && end1-start1 == 1 )
+	{
+		if ( masks[start0-base0] & (1u << (start1-base1)) )
+			action(start0, start1);
+		return;
+	}
+
+	// nothing to do if no pair in the ranges overlaps
+	std::size_t width = end1 - start1;
+	unsigned int cols = width < 32 ? (1u << width) - 1 : ~0u;
+	cols <<= start1 - base1;
+	unsigned int any = 0;
+	for (std::size_t i=start0; i<end0; ++i) any |= masks[i-base0];
+	if ( ! (any & cols) ) return;
+
+	std::size_t mid0 = (start0 + end0) / 2;
+	std::size_t mid1 = (start1 + end1) / 2;
+
+	if ( start0 < mid0 )
+	{
+		if ( start1 < mid1 )
+			visitOverlaps(masks, base0, base1, start0, mid0, start1, mid1, action);
+		if ( mid1 < end1 )
+			visitOverlaps(masks, base0, base1, start0, mid0, mid1, end1, action);
+	}
+	if ( mid0 < end0 )
+	{
+		if ( start1 < mid1 )
+			visitOverlaps(masks, base0, base1, mid0, end0, start1, mid1, action);
+		if ( mid1 < end1 )
+			visitOverlaps(masks, base0, base1, mid0, end0, mid1, end1, action);
+	}
+}
+
+} // namespace geos::index::chain
+} // namespace geos::index
+} // namespace geos
+
+#endif // GEOS_IDX_CHAIN_SEGMENTENVELOPEBLOCK_H
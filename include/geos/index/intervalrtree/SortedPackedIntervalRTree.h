@@ -84,6 +84,13 @@ public:
 	 */
 	void query( double min, double max, index::ItemVisitor * visitor);
 
+	/**
+	 * Builds the tree now rather than on the first query, after
+	 * which queries only read the index and may run concurrently.
+	 * No items can be inserted afterwards, unless the index is empty.
+	 */
+	void build();
+
 };
 
 } // geos::intervalrtree
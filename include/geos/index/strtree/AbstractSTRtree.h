@@ -132,7 +132,6 @@ public:
 class GEOS_DLL AbstractSTRtree {
 
 private:
-	bool built;
 	BoundableList* itemBoundables;
 
 	/**
@@ -158,6 +157,8 @@ private:
 
 protected:
 
+	bool built;
+
 	/** \brief
 	 * A test for intersection between two bounds, necessary because
 	 * subclasses of AbstractSTRtree have different implementations of
@@ -249,8 +250,8 @@ public:
 	 */
 	AbstractSTRtree(std::size_t newNodeCapacity)
 		:
-		built(false),
 		itemBoundables(new BoundableList()),
+		built(false),
 		nodes(new std::vector<AbstractNode *>()),
 		nodeCapacity(newNodeCapacity)
 	{
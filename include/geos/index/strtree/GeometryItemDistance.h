@@ -0,0 +1,44 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation. 
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_INDEX_STRTREE_GEOMETRYITEMDISTANCE_H
+#define GEOS_INDEX_STRTREE_GEOMETRYITEMDISTANCE_H
+
+#include <geos/export.h>
+#include <geos/index/strtree/ItemDistance.h> // for inheritance
+
+namespace geos {
+namespace index { // geos::index
+namespace strtree { // geos::index::strtree
+
+/** \brief
+ * An ItemDistance function for items which are Geometry objects,
+ * using the Geometry::distance method.
+ */
+class GEOS_DLL GeometryItemDistance: public ItemDistance {
+public:
+	/**
+	 * Computes the distance between two Geometry items,
+	 * using the Geometry::distance method.
+	 *
+	 * @param item1 an item which is a Geometry
+	 * @param item2 an item which is a Geometry
+	 * @return the distance between the geometries
+	 */
+	double distance(const ItemBoundable* item1, const ItemBoundable* item2);
+};
+
+} // namespace geos::index::strtree
+} // namespace geos::index
+} // namespace geos
+
+#endif // GEOS_INDEX_STRTREE_GEOMETRYITEMDISTANCE_H
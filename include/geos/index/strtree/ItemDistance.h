@@ -0,0 +1,60 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation. 
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_INDEX_STRTREE_ITEMDISTANCE_H
+#define GEOS_INDEX_STRTREE_ITEMDISTANCE_H
+
+#include <geos/export.h>
+
+// Forward declarations
+namespace geos {
+	namespace index { 
+		namespace strtree { 
+			class ItemBoundable;
+		}
+	}
+}
+
+namespace geos {
+namespace index { // geos::index
+namespace strtree { // geos::index::strtree
+
+/** \brief
+ * A function method which computes the distance
+ * between two ItemBoundables in an STRtree.
+ *
+ * Used for Nearest Neighbour searches.
+ *
+ * The distance returned must never be less than the distance
+ * between the envelopes of the two items, or the branch-and-bound
+ * search in STRtree::nearestNeighbour will give wrong results.
+ */
+class GEOS_DLL ItemDistance {
+public:
+	/**
+	 * Computes the distance between two items.
+	 *
+	 * @param item1
+	 * @param item2
+	 * @return the distance between the items
+	 */
+	virtual double distance(const ItemBoundable* item1,
+	                        const ItemBoundable* item2)=0;
+
+	virtual ~ItemDistance() {}
+};
+
+} // namespace geos::index::strtree
+} // namespace geos::index
+} // namespace geos
+
+#endif // GEOS_INDEX_STRTREE_ITEMDISTANCE_H
@@ -0,0 +1,191 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_INDEX_STRTREE_PACKEDSTRTREE_H
+#define GEOS_INDEX_STRTREE_PACKEDSTRTREE_H
+
+#include <geos/export.h>
+#include <geos/index/SpatialIndex.h> // for inheritance
+#include <geos/index/strtree/AbstractSTRtree.h> // for ItemsList
+#include <geos/geom/Envelope.h> // for inlines
+
+#include <vector>
+#include <cstddef>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// Forward declarations
+namespace geos {
+	namespace index {
+		class ItemVisitor;
+	}
+}
+
+namespace geos {
+namespace index { // geos::index
+namespace strtree { // geos::index::strtree
+
+/**
+ * \brief
+ * A query-only R-tree created using the Sort-Tile-Recursive (STR)
+ * algorithm, stored in flat arrays.
+ *
+ * Packs items the same way as STRtree does, but rather than building
+ * a graph of heap-allocated nodes it stores the envelopes of all items
+ * and nodes in contiguous arrays of doubles (one per ordinate), with
+ * nodes addressing their children by index. Items come first, in
+ * tree order, followed by each level of nodes; the root is last.
+ *
+ * Queries walk the arrays without virtual calls or pointer chasing,
+ * which makes them considerably faster than STRtree queries on large
+ * trees. On the other hand the tree is immutable once built: items
+ * can still be removed, but that only hides them from later queries.
+ *
+ * The item envelopes are copied on insertion, so they need not
+ * outlive the tree.
+ *
+ * @see STRtree
+ */
+class GEOS_DLL PackedSTRtree: public SpatialIndex
+{
+public:
+
+	/**
+	 * Constructs a PackedSTRtree with the given maximum number
+	 * of child nodes that a node may have
+	 */
+	PackedSTRtree(std::size_t nodeCapacity=10);
+
+	~PackedSTRtree();
+
+	/**
+	 * Adds an item with the given envelope.
+	 *
+	 * @throws util::IllegalArgumentException if the tree is built
+	 */
+	void insert(const geom::Envelope *itemEnv, void* item);
+
+	/**
+	 * Creates the node levels for the items that have been
+	 * inserted into the tree. Can only be called once; query
+	 * methods call it if the tree was not built yet.
+	 *
+	 * @throws util::IllegalArgumentException if the tree is built
+	 */
+	void build();
+
+	///  Also builds the tree, if necessary.
+	void query(const geom::Envelope *searchEnv, std::vector<void*>& matches);
+
+	///  Also builds the tree, if necessary.
+	void query(const geom::Envelope *searchEnv, ItemVisitor& visitor);
+
+	/**
+	 * Removes a single item from the tree.
+	 *
+	 * Once the tree is built the item is only masked out, the
+	 * space it uses is not released nor are node bounds shrunk.
+	 */
+	bool remove(const geom::Envelope *itemEnv, void* item);
+
+	/**
+	 * Iterate over all items added thus far.  Explicitly does not build
+	 * the tree.
+	 */
+	void iterate(ItemVisitor& visitor);
+
+	/**
+	 * Gets a tree structure (as a nested list) corresponding
+	 * to the structure of the items and nodes in this tree,
+	 * in the same form as AbstractSTRtree::itemsTree.
+	 *
+	 * Builds the tree if necessary.
+	 *
+	 * @note The caller is responsible for releasing the list
+	 */
+	ItemsList* itemsTree();
+
+	/// Returns the number of items in the tree
+	std::size_t size() const;
+
+	/// Returns the maximum number of child nodes that a node may have
+	std::size_t getNodeCapacity() const { return nodeCapacity; }
+
+private:
+
+	std::size_t nodeCapacity;
+
+	bool built;
+
+	/// Number of items inserted (including removed ones once built)
+	std::size_t numItems;
+
+	/// Bounds of items and nodes, indexed by slot
+	std::vector<double> minXs;
+	std::vector<double> minYs;
+	std::vector<double> maxXs;
+	std::vector<double> maxYs;
+
+	/// Items, indexed by slot (slots below numItems)
+	std::vector<void*> items;
+
+	/// Range of child slots, indexed by (slot - numItems)
+	std::vector<std::size_t> childBegin;
+	std::vector<std::size_t> childEnd;
+
+	bool intersects(std::size_t slot, const geom::Envelope& env) const
+	{
+		return ! ( minXs[slot] > env.getMaxX() ||
+		           maxXs[slot] < env.getMinX() ||
+		           minYs[slot] > env.getMaxY() ||
+		           maxYs[slot] < env.getMinY() );
+	}
+
+	bool isRemoved(std::size_t slot) const
+	{
+		return minXs[slot] > maxXs[slot];
+	}
+
+	std::size_t rootSlot() const { return minXs.size() - 1; }
+
+	/// Sorts slots [begin, end) in STR order and packs them into parents
+	void createParentLevel(std::size_t begin, std::size_t end);
+
+	void permute(std::size_t begin, const std::vector<std::size_t>& order);
+
+	void addParent(std::size_t begin, std::size_t end);
+
+	void query(const geom::Envelope& searchEnv, std::size_t node,
+	           std::vector<void*>& matches) const;
+
+	void query(const geom::Envelope& searchEnv, std::size_t node,
+	           ItemVisitor& visitor) const;
+
+	ItemsList* itemsTree(std::size_t node) const;
+
+	// Declare type as noncopyable
+	PackedSTRtree(const PackedSTRtree& other);
+	PackedSTRtree& operator=(const PackedSTRtree& rhs);
+};
+
+} // namespace geos::index::strtree
+} // namespace geos::index
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // GEOS_INDEX_STRTREE_PACKEDSTRTREE_H
@@ -25,6 +25,7 @@
 #include <geos/geom/Envelope.h> // for inlines
 
 #include <vector>
+#include <utility> // for std::pair
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -34,8 +35,10 @@
 // Forward declarations
 namespace geos {
 	namespace index { 
+		class ItemPairVisitor;
 		namespace strtree { 
 			class Boundable;
+			class ItemDistance;
 		}
 	}
 }
@@ -79,12 +82,43 @@ private:
 	 */
 	std::auto_ptr<BoundableList> createParentBoundables(BoundableList* childBoundables, int newLevel);
 
-	std::auto_ptr<BoundableList> createParentBoundablesFromVerticalSlices(std::vector<BoundableList*>* verticalSlices, int newLevel);
+	/**
+	 * Sorts and packs each of the given vertical slices,
+	 * on the given number of threads if more than one.
+	 */
+	std::auto_ptr<BoundableList> createParentBoundablesFromVerticalSlices(
+			std::vector<BoundableList*>* verticalSlices,
+			int newLevel, std::size_t numThreads);
 
 	STRIntersectsOp intersectsOp;
 
+	/// Reports the pairs of items below a and b whose envelopes intersect
+	static void join(Boundable* a, Boundable* b, ItemPairVisitor& visitor);
+
+	/// Number of threads used by build(), 0 for one per processor
+	std::size_t buildThreads;
+
+	/**
+	 * Finds the nearest pair of items of this tree and other, ignoring
+	 * pairs farther apart than maxDistance and stopping at the first
+	 * pair at most terminateDistance apart.
+	 *
+	 * @return the distance between the pair found, or infinity
+	 */
+	double nearestPair(STRtree& other, ItemDistance* itemDist,
+	                   double terminateDistance, double maxDistance,
+	                   std::pair<void*, void*>& nearest);
+
+	/// Stable sort on the y of the midpoints, as all levels are sorted
 	std::auto_ptr<BoundableList> sortBoundables(const BoundableList* input);
 
+	/**
+	 * Same as sortBoundables, using the given number of threads.
+	 * Being stable, the sort gives the same order for any of them.
+	 */
+	std::auto_ptr<BoundableList> parallelSortBoundables(
+			const BoundableList* input, std::size_t numThreads);
+
 	std::auto_ptr<BoundableList> createParentBoundablesFromVerticalSlice(
 			BoundableList* childBoundables,
 			int newLevel);
@@ -119,6 +153,25 @@ public:
 
 	void insert(const geom::Envelope *itemEnv,void* item);
 
+	/**
+	 * Sets the number of threads used to sort and pack the levels
+	 * of the tree when it is built.
+	 *
+	 * Only levels with many (tens of thousands) nodes are worth
+	 * building in parallel; smaller ones are always built by the
+	 * calling thread. The resulting tree is the same whatever
+	 * the number of threads.
+	 *
+	 * @param numThreads number of threads, 0 for one per processor.
+	 *        Defaults to 1.
+	 */
+	void setBuildThreads(std::size_t numThreads) {
+		buildThreads = numThreads;
+	}
+
+	/// @see setBuildThreads
+	std::size_t getBuildThreads() const { return buildThreads; }
+
 	//static double centreX(const geom::Envelope *e);
 
 	static double avg(double a, double b) {
@@ -140,6 +193,126 @@ public:
 	bool remove(const geom::Envelope *itemEnv, void* item) {
 		return AbstractSTRtree::remove(itemEnv, item);
 	}
+
+	/**
+	 * Queries the tree with many envelopes at once.
+	 *
+	 * The queries are sorted spatially and walk the tree in small
+	 * batches, each node being tested against all the queries of a
+	 * batch reaching it. This saves most of the traversal work done
+	 * by as many calls to query() when queries are close to one
+	 * another, as in spatial joins.
+	 *
+	 * Results are returned in compressed sparse row layout: the items
+	 * found for searchEnvs[i] are items[offsets[i]] to
+	 * items[offsets[i+1]-1], in the order query() would return them.
+	 *
+	 * Builds the tree, if necessary.
+	 *
+	 * @param searchEnvs the envelopes to query
+	 * @param offsets set to searchEnvs.size()+1 offsets into items
+	 * @param items set to the items found by all queries
+	 */
+	void queryBatch(const std::vector<const geom::Envelope*>& searchEnvs,
+	                std::vector<std::size_t>& offsets,
+	                std::vector<void*>& items);
+
+	/**
+	 * Finds all pairs of items of this tree and another one
+	 * whose envelopes intersect.
+	 *
+	 * The two trees are traversed together, descending only into
+	 * pairs of nodes whose envelopes intersect, which is much cheaper
+	 * than querying one tree with every item of the other.
+	 *
+	 * Joining a tree with itself reports each pair of intersecting
+	 * items twice, and each item paired with itself.
+	 *
+	 * Builds both trees, if necessary.
+	 *
+	 * @param other the tree to join this one with
+	 * @param visitor called with each item of this tree and
+	 *        an item of the other tree intersecting it
+	 */
+	void join(STRtree& other, ItemPairVisitor& visitor);
+
+	/**
+	 * Finds the item in this tree which is nearest to the given item,
+	 * using ItemDistance as the distance metric.
+	 *
+	 * The search is a best-first branch-and-bound traversal of
+	 * the tree, pruning nodes on the distance between their
+	 * envelopes and the envelope of the query item.
+	 *
+	 * Builds the tree, if necessary.
+	 *
+	 * @param env the envelope of the query item
+	 * @param item the item to find the nearest neighbour of
+	 * @param itemDist a distance metric applicable to the items
+	 *        in this tree and the query item
+	 * @return the nearest item in this tree, or NULL if the tree is empty
+	 */
+	void* nearestNeighbour(const geom::Envelope *env, const void* item,
+	                       ItemDistance* itemDist);
+
+	/**
+	 * Finds the k items in this tree which are nearest
+	 * to the given item, using ItemDistance as the distance metric.
+	 *
+	 * Builds the tree, if necessary.
+	 *
+	 * @param env the envelope of the query item
+	 * @param item the item to find the nearest neighbours of
+	 * @param itemDist a distance metric applicable to the items
+	 *        in this tree and the query item
+	 * @param k the maximum number of items to find
+	 * @param neighbours the nearest items are appended here,
+	 *        in order of increasing distance
+	 */
+	void nearestNeighbour(const geom::Envelope *env, const void* item,
+	                      ItemDistance* itemDist, std::size_t k,
+	                      std::vector<void*>& neighbours);
+
+	/**
+	 * Finds the pair of items, one of this tree and one of another,
+	 * which are nearest to each other, using ItemDistance as the
+	 * distance metric.
+	 *
+	 * The search is a best-first branch-and-bound traversal of both
+	 * trees together, pruning pairs of nodes whose envelopes are
+	 * farther apart than the nearest pair of items found so far.
+	 *
+	 * Builds both trees, if necessary.
+	 *
+	 * @param other the tree to search together with this one
+	 * @param itemDist a distance metric applicable to the items,
+	 *        called with an item of this tree first
+	 * @param terminateDistance the search stops as soon as a pair of
+	 *        items at most this far apart is found
+	 * @return the nearest pair of items, (NULL, NULL) if either
+	 *         tree is empty
+	 */
+	std::pair<void*, void*> nearestNeighbour(STRtree& other,
+	                                         ItemDistance* itemDist,
+	                                         double terminateDistance=0.0);
+
+	/**
+	 * Tests whether some item of this tree and some item of another
+	 * are at most a given distance apart, using ItemDistance as the
+	 * distance metric.
+	 *
+	 * Only pairs of nodes whose envelopes are within the distance are
+	 * searched, and the search stops at the first pair of items found.
+	 *
+	 * Builds both trees, if necessary.
+	 *
+	 * @param other the tree to search together with this one
+	 * @param itemDist a distance metric applicable to the items,
+	 *        called with an item of this tree first
+	 * @param maxDistance the distance to test
+	 */
+	bool isWithinDistance(STRtree& other, ItemDistance* itemDist,
+	                      double maxDistance);
 };
 
 } // namespace geos::index::strtree
@@ -28,6 +28,8 @@
 #include <geos/inline.h>
 
 #include <iosfwd> // ostream, istream (if we remove inlines)
+#include <cstddef>
+#include <limits>
 
 namespace geos {
 namespace io {
@@ -36,7 +38,8 @@ namespace io {
  * \class ByteOrderDataInStream io.h geos.h
  * 
  * Allows reading an stream of primitive datatypes from an underlying
- * istream, with the representation being in either common byte ordering.
+ * istream or memory buffer, with the representation being in either
+ * common byte ordering.
  *
  */
 class GEOS_DLL ByteOrderDataInStream {
@@ -53,6 +56,12 @@ public:
 	 */
 	void setInStream(std::istream *s);
 
+	/**
+	 * Reads from a memory buffer rather than an istream.
+	 * The buffer is not copied, it must outlive the reads.
+	 */
+	void setInBuffer(const unsigned char *buf, std::size_t size);
+
 	void setOrder(int order);
 
 	unsigned char readByte(); // throws ParseException
@@ -63,6 +72,20 @@ public:
 
 	double readDouble(); // throws ParseException
 
+	/// Reads n doubles into the given array
+	void readDoubles(double *out, std::size_t n); // throws ParseException
+
+	/**
+	 * Returns the number of bytes left in the buffer set with
+	 * setInBuffer, or the largest size_t when reading from an
+	 * istream (the size of which is unknown).
+	 */
+	std::size_t available() const
+	{
+		if ( stream ) return (std::numeric_limits<std::size_t>::max)();
+		return dataEnd - data;
+	}
+
 private:
 	int byteOrder;
 	std::istream *stream;
@@ -70,6 +93,13 @@ private:
 	// buffers to hold primitive datatypes
 	unsigned char buf[8];
 
+	// the rest of the buffer set with setInBuffer, used if stream is NULL
+	const unsigned char *data;
+	const unsigned char *dataEnd;
+
+	/// Returns the next n (at most 8) bytes
+	const unsigned char *readBytes(std::size_t n); // throws ParseException
+
 };
 
 } // namespace io
@@ -34,7 +34,9 @@ INLINE
 ByteOrderDataInStream::ByteOrderDataInStream(std::istream *s)
 	:
 	byteOrder(getMachineByteOrder()),
-	stream(s)
+	stream(s),
+	data(0),
+	dataEnd(0)
 {
 }
 
@@ -47,6 +49,15 @@ INLINE void
 ByteOrderDataInStream::setInStream(std::istream *s)
 {
 	stream=s;
+	data=dataEnd=0;
+}
+
+INLINE void 
+ByteOrderDataInStream::setInBuffer(const unsigned char *b, std::size_t size)
+{
+	stream=0;
+	data=b;
+	dataEnd=b+size;
 }
 
 INLINE void
@@ -55,40 +66,45 @@ ByteOrderDataInStream::setOrder(int order)
 	byteOrder=order;
 }
 
-INLINE unsigned char
-ByteOrderDataInStream::readByte() // throws ParseException
+INLINE const unsigned char *
+ByteOrderDataInStream::readBytes(std::size_t n)
 {
-	stream->read(reinterpret_cast<char *>(buf), 1);
+	if ( ! stream )
+	{
+		if ( static_cast<std::size_t>(dataEnd - data) < n )
+			throw  ParseException("Unexpected EOF parsing WKB");
+		const unsigned char *ret = data;
+		data += n;
+		return ret;
+	}
+	stream->read(reinterpret_cast<char *>(buf), n);
 	if ( stream->eof() )
 		throw  ParseException("Unexpected EOF parsing WKB");
-	return buf[0];
+	return buf;
+}
+
+INLINE unsigned char
+ByteOrderDataInStream::readByte() // throws ParseException
+{
+	return readBytes(1)[0];
 }
 
 INLINE int
 ByteOrderDataInStream::readInt() 
 {
-	stream->read(reinterpret_cast<char *>(buf), 4);
-	if ( stream->eof() )
-		throw  ParseException("Unexpected EOF parsing WKB");
-	return ByteOrderValues::getInt(buf, byteOrder);
+	return ByteOrderValues::getInt(readBytes(4), byteOrder);
 }
 
 INLINE long
 ByteOrderDataInStream::readLong() 
 {
-	stream->read(reinterpret_cast<char *>(buf), 8);
-	if ( stream->eof() )
-		throw  ParseException("Unexpected EOF parsing WKB");
-	return static_cast<long>(ByteOrderValues::getLong(buf, byteOrder));
+	return static_cast<long>(ByteOrderValues::getLong(readBytes(8), byteOrder));
 }
 
 INLINE double
 ByteOrderDataInStream::readDouble() 
 {
-	stream->read(reinterpret_cast<char *>(buf), 8);
-	if ( stream->eof() )
-		throw  ParseException("Unexpected EOF parsing WKB");
-	return ByteOrderValues::getDouble(buf, byteOrder);
+	return ByteOrderValues::getDouble(readBytes(8), byteOrder);
 }
 
 } // namespace io
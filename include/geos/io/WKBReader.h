@@ -28,6 +28,7 @@
 #include <iosfwd> // ostream, istream
 #include <vector>
 #include <string>
+#include <cstddef>
 
 #define BAD_GEOM_TYPE_MSG "Bad geometry type encountered in"
 
@@ -96,6 +97,21 @@ public:
 	geom::Geometry* read(std::istream &is);
 		// throws IOException, ParseException
 
+	/**
+	 * \brief Reads a Geometry from a memory buffer.
+	 *
+	 * Parses the buffer in place, with no istream in between,
+	 * copying runs of coordinates in bulk. The buffer is not
+	 * retained after the call.
+	 *
+	 * @param buf the WKB bytes
+	 * @param size the number of bytes in buf
+	 * @return the Geometry read
+	 * @throws ParseException
+	 */
+	geom::Geometry* read(const unsigned char *buf, std::size_t size);
+		// throws ParseException
+
 	/**
 	 * \brief Reads a Geometry from an istream in hex format.
 	 *
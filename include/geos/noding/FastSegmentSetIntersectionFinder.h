@@ -44,13 +44,15 @@ namespace noding { // geos::noding
  * against a target set of lines.
  * Short-circuited to return as soon an intersection is found.
  *
+ * The index is built on construction and only read by the
+ * intersects methods, which may so run concurrently.
+ *
  * @version 1.7
  */
 class FastSegmentSetIntersectionFinder
 {
 private:
 	MCIndexSegmentSetMutualIntersector * segSetMutInt; 
-	geos::algorithm::LineIntersector * lineIntersector;
 
 protected:
 public:
@@ -69,9 +69,12 @@ private:
 	std::vector<SegmentString*>* nodedSegStrings;
 	// statistics
 	int nOverlaps;
+	std::size_t numThreads;
 
 	void intersectChains();
 
+	void intersectChainsParallel();
+
 	void add(SegmentString* segStr);
 
 public:
@@ -81,7 +84,8 @@ public:
 		SinglePassNoder(nSegInt),
 		idCounter(0),
 		nodedSegStrings(NULL),
-		nOverlaps(0)
+		nOverlaps(0),
+		numThreads(1)
 	{}
 
 	~MCIndexNoder();
@@ -95,6 +99,21 @@ public:
 
 	void computeNodes(std::vector<SegmentString*>* inputSegmentStrings);
 
+	/**
+	 * Sets the number of threads searching for chain overlaps.
+	 *
+	 * With more than one thread, the chains are split in ranges
+	 * searched concurrently, each thread keeping the pairs of
+	 * segments which intersect in a buffer of its own. The
+	 * SegmentIntersector is then given those pairs in the order
+	 * a single thread would, so the noding is the same; it is
+	 * not given pairs of segments which do not intersect.
+	 *
+	 * @param n number of threads, 0 for one per processor.
+	 *        Defaults to 1.
+	 */
+	void setNumThreads(std::size_t n) { numThreads = n; }
+
 	class SegmentOverlapAction : public index::chain::MonotoneChainOverlapAction {
 	public:
 		SegmentOverlapAction(SegmentIntersector& newSi)
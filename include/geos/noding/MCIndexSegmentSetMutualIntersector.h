@@ -78,6 +78,23 @@ public:
 	// NOTE: re-populates the MonotoneChain vector with newly created chains
 	void process(SegmentString::ConstVect* segStrings);
 
+	/**
+	 * Intersects the given segment strings with the base ones,
+	 * reporting to si rather than to the SegmentIntersector set on
+	 * this object, and keeping the chains built for them to this call.
+	 *
+	 * The base segments are only read, so once the index is built
+	 * (see buildIndex) calls may run concurrently.
+	 */
+	void process(SegmentString::ConstVect* segStrings,
+	             SegmentIntersector& si);
+
+	/**
+	 * Builds the index of the base segments now, rather than
+	 * on the first call to process.
+	 */
+	void buildIndex();
+
     class SegmentOverlapAction : public index::chain::MonotoneChainOverlapAction
     {
     private:
@@ -121,6 +138,9 @@ private:
 
 	void intersectChains();
 
+	// Returns the number of overlapping chains tested
+	int intersectChains(const MonoChains& chains, SegmentIntersector& si);
+
 	void addToMonoChains( SegmentString * segStr);
 
 };
@@ -22,6 +22,7 @@
 
 #include <geos/export.h>
 #include <geos/algorithm/LineIntersector.h> // for composition
+#include <geos/geomgraph/GraphArena.h> // for composition
 
 #include <vector>
 
@@ -68,6 +69,14 @@ public:
 
 protected:
 
+	/** \brief
+	 * Memory for the components of the graphs built by the
+	 * operation, released when the operation is destroyed.
+	 *
+	 * Declared first so it outlives any member referencing them.
+	 */
+	geomgraph::GraphArena arena;
+
 	algorithm::LineIntersector li;
 
 	const geom::PrecisionModel* resultPrecisionModel;
@@ -28,6 +28,7 @@
 #include <geos/operation/buffer/BufferOp.h> // for inlines (BufferOp enums)
 #include <geos/operation/buffer/OffsetCurveBuilder.h> // for inline (OffsetCurveBuilder enums)
 #include <geos/geomgraph/EdgeList.h> // for composition
+#include <geos/geomgraph/GraphArena.h> // for composition
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -150,6 +151,9 @@ private:
 	 */
 	static int depthDelta(const geomgraph::Label& label);
 
+	/// Memory for the graph components, outlives edgeList
+	geomgraph::GraphArena arena;
+
 	const BufferParameters& bufParams; 
 
 	const geom::PrecisionModel* workingPrecisionModel;
@@ -66,9 +66,9 @@ namespace distance { // geos::operation::distance
  * the coordinate computed is a close
  * approximation to the exact point.
  * 
- * The algorithms used are straightforward O(n^2)
- * comparisons.  This worst-case performance could be improved on
- * by using Voronoi techniques or spatial indexes.
+ * Small inputs are compared facet by facet, in O(n^2) time.
+ * Larger ones are searched with an IndexedFacetDistance on each,
+ * in about O(n log n) time.
  *
  */
 class GEOS_DLL DistanceOp {
@@ -244,6 +244,12 @@ private:
 	 */
 	void computeFacetDistance();
 
+	/**
+	 * Computes distance between facets of input geometries
+	 * with an IndexedFacetDistance on each.
+	 */
+	void computeFacetDistanceIndexed();
+
 	void computeMinDistanceLines(
 			const std::vector<const geom::LineString*>& lines0,
 			const std::vector<const geom::LineString*>& lines1,
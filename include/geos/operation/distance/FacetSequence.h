@@ -0,0 +1,108 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_OP_DISTANCE_FACETSEQUENCE_H
+#define GEOS_OP_DISTANCE_FACETSEQUENCE_H
+
+#include <geos/export.h>
+
+#include <geos/geom/Envelope.h> // for composition
+
+#include <cstddef>
+
+// Forward declarations
+namespace geos {
+	namespace geom {
+		class Geometry;
+		class CoordinateSequence;
+	}
+	namespace operation {
+		namespace distance {
+			class GeometryLocation;
+		}
+	}
+}
+
+namespace geos {
+namespace operation { // geos::operation
+namespace distance { // geos::operation::distance
+
+/** \brief
+ * A run of consecutive points of a Point or LineString component
+ * of a Geometry: a single vertex, or the segments joining them.
+ *
+ * Facet sequences are the items indexed by IndexedFacetDistance.
+ * They only refer to the coordinates of their component, which
+ * must outlive them.
+ */
+class GEOS_DLL FacetSequence {
+
+public:
+
+	/**
+	 * @param component the Point or LineString the points belong to
+	 * @param pts the coordinates of the component
+	 * @param start the index of the first point of the sequence
+	 * @param end the index past its last point, greater than start
+	 */
+	FacetSequence(const geom::Geometry* component,
+	              const geom::CoordinateSequence& pts,
+	              std::size_t start, std::size_t end);
+
+	const geom::Envelope& getEnvelope() const { return env; }
+
+	/// Returns the number of points in the sequence
+	std::size_t size() const { return end - start; }
+
+	/// Tests whether the sequence is a single vertex
+	bool isPoint() const { return end - start == 1; }
+
+	/// Computes the distance between the facets of two sequences
+	double distance(const FacetSequence& other) const;
+
+	/**
+	 * Computes the distance between the facets of two sequences,
+	 * and the nearest locations on them.
+	 *
+	 * @param loc0 set to a new location on this sequence,
+	 *        ownership to caller
+	 * @param loc1 set to a new location on the other sequence,
+	 *        ownership to caller
+	 * @return the distance between the locations
+	 */
+	double nearestLocations(const FacetSequence& other,
+	                        GeometryLocation*& loc0,
+	                        GeometryLocation*& loc1) const;
+
+private:
+
+	const geom::Geometry* component;
+
+	const geom::CoordinateSequence* pts;
+
+	std::size_t start;
+
+	std::size_t end;
+
+	geom::Envelope env;
+
+	/// Finds the nearest facets, setting loc0 and loc1 if not null
+	double computeDistance(const FacetSequence& other,
+	                       GeometryLocation** loc0,
+	                       GeometryLocation** loc1) const;
+};
+
+} // namespace geos::operation::distance
+} // namespace geos::operation
+} // namespace geos
+
+#endif // GEOS_OP_DISTANCE_FACETSEQUENCE_H
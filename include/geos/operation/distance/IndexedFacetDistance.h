@@ -0,0 +1,139 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_OP_DISTANCE_INDEXEDFACETDISTANCE_H
+#define GEOS_OP_DISTANCE_INDEXEDFACETDISTANCE_H
+
+#include <geos/export.h>
+
+#include <geos/operation/distance/FacetSequence.h> // for composition
+#include <geos/index/strtree/STRtree.h> // for composition
+
+#include <vector>
+#include <cstddef>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+// Forward declarations
+namespace geos {
+	namespace geom {
+		class Geometry;
+	}
+	namespace operation {
+		namespace distance {
+			class GeometryLocation;
+		}
+	}
+}
+
+namespace geos {
+namespace operation { // geos::operation
+namespace distance { // geos::operation::distance
+
+/** \brief
+ * Computes the distance between the facets (segments and vertices)
+ * of two geometries, using an STRtree of short FacetSequences
+ * on each of them.
+ *
+ * The nearest pair of facets is found by a branch-and-bound search
+ * of both trees (see STRtree::nearestNeighbour), which takes about
+ * O(n log n) time instead of the O(n*m) of comparing all facets.
+ * A geometry indexed once can be tested against many others.
+ *
+ * Facet distance is the distance between two geometries unless
+ * one lies inside an area of the other, where it is not zero:
+ * DistanceOp checks for that before using this class.
+ */
+class GEOS_DLL IndexedFacetDistance {
+
+public:
+
+	/// Number of segments in each indexed FacetSequence
+	static const std::size_t FACET_SEQUENCE_SIZE = 6;
+
+	/// Indexes the facets of g, which must outlive this object
+	IndexedFacetDistance(const geom::Geometry& g);
+
+	~IndexedFacetDistance();
+
+	/**
+	 * Computes the facet distance between two geometries.
+	 *
+	 * @return the distance, 0 if either geometry is empty
+	 */
+	static double distance(const geom::Geometry& g1,
+	                       const geom::Geometry& g2);
+
+	/**
+	 * Computes the facet distance between the indexed geometry
+	 * and another one.
+	 *
+	 * @return the distance, 0 if either geometry is empty
+	 */
+	double getDistance(const geom::Geometry& g);
+
+	/**
+	 * Tests whether some facets of the indexed geometry and of
+	 * another one are at most maxDistance apart, searching only
+	 * pairs of facets that close.
+	 *
+	 * @return false if either geometry is empty
+	 */
+	bool isWithinDistance(const geom::Geometry& g, double maxDistance);
+
+	/**
+	 * Finds the nearest facets of the indexed geometries.
+	 *
+	 * @param other the index of the other geometry
+	 * @param terminateDistance the search stops as soon as facets
+	 *        at most this far apart are found
+	 * @param loc0 set to a new location on this geometry,
+	 *        or to NULL if either geometry is empty; ownership to caller
+	 * @param loc1 set to a new location on the other geometry,
+	 *        or to NULL if either geometry is empty; ownership to caller
+	 * @return the distance between the locations
+	 */
+	double nearestLocations(IndexedFacetDistance& other,
+	                        double terminateDistance,
+	                        GeometryLocation*& loc0,
+	                        GeometryLocation*& loc1);
+
+	/// Returns the number of FacetSequences indexed
+	std::size_t getNumFacetSequences() const { return facets.size(); }
+
+private:
+
+	std::vector<FacetSequence> facets;
+
+	index::strtree::STRtree tree;
+
+	/// Appends the facet sequences of the components of g
+	static void addFacetSequences(const geom::Geometry& g,
+	                              std::vector<FacetSequence>& facets);
+
+	// Declare type as noncopyable
+	IndexedFacetDistance(const IndexedFacetDistance& other);
+	IndexedFacetDistance& operator=(const IndexedFacetDistance& rhs);
+};
+
+} // namespace geos::operation::distance
+} // namespace geos::operation
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // GEOS_OP_DISTANCE_INDEXEDFACETDISTANCE_H
@@ -44,6 +44,11 @@ namespace geos {
 	namespace planargraph { 
 		class DirectedEdge;
 	}
+	namespace algorithm { 
+		namespace locate { 
+			class PointOnGeometryLocator;
+		}
+	}
 }
 
 namespace geos {
@@ -68,6 +73,22 @@ private:
 	typedef std::vector<geom::Geometry*> GeomVect;
 	GeomVect *holes;
 
+	/// Locates points in large rings, built on first use
+	algorithm::locate::PointOnGeometryLocator *ringLocator;
+
+	/// Rings with fewer points are scanned rather than indexed
+	enum { MIN_INDEXED_POINTS = 64 };
+
+	/** \brief
+	 * Tests whether the ring formed by the given points lies inside
+	 * this ring, using the first of them not on this ring.
+	 *
+	 * @return false if all of them are on this ring
+	 */
+	bool containsRing(const geom::CoordinateSequence *testPts);
+
+	void deleteLocator();
+
 	/** \brief
 	 * Computes the list of coordinates which are contained in this ring.
 	 * The coordinatea are computed once only and cached.
@@ -91,6 +112,10 @@ public:
 	 * 
 	 * ring A contains ring B iff envelope(ring A) contains envelope(ring B)
 	 *
+	 * Shells whose envelope does not contain the one of the
+	 * tested ring are skipped, so callers may pass a superset of
+	 * the candidates, as found by an index.
+	 *
 	 * This routine is only safe to use if the chosen point of the hole
 	 * is known to be properly contained in a shell
 	 * (which is guaranteed to be the case if the hole does not touch
@@ -25,6 +25,7 @@
 #include <geos/geom/GeometryComponentFilter.h> // for LineStringAdder inheritance
 
 #include <vector>
+#include <cstddef>
 
 #ifdef _MSC_VER
 #pragma warning(push)
@@ -98,11 +99,23 @@ private:
 	 */
 	void polygonize();
 
-	void findValidRings(const std::vector<EdgeRing*>& edgeRingList,
+	class ComponentTask;
+	friend class ComponentTask;
+
+	/**
+	 * Splits the graph into its connected components and finds
+	 * their dangles, cut edges, invalid rings, shells and holes
+	 * concurrently, each group of components in a graph of its own.
+	 */
+	void polygonizeComponents(std::size_t threads);
+
+	static void findValidRings(const std::vector<EdgeRing*>& edgeRingList,
 			std::vector<EdgeRing*>& validEdgeRingList,
 			std::vector<geom::LineString*>& invalidRingList);
 
-	void findShellsAndHoles(const std::vector<EdgeRing*>& edgeRingList);
+	static void findShellsAndHoles(const std::vector<EdgeRing*>& edgeRingList,
+			std::vector<EdgeRing*>& holeList,
+			std::vector<EdgeRing*>& shellList);
 
 	static void assignHolesToShells(const std::vector<EdgeRing*>& holeList,
 			std::vector<EdgeRing*>& shellList);
@@ -123,6 +136,12 @@ protected:
 	std::vector<EdgeRing*> shellList;
 	std::vector<geom::Polygon*> *polyList;
 
+	std::size_t numThreads;
+
+	// graphs of the groups of components, owning the rings
+	// found when polygonizing with more than one thread
+	std::vector<PolygonizeGraph*> componentGraphs;
+
 public:
 
 	/** \brief
@@ -133,6 +152,21 @@ public:
 
 	~Polygonizer();
 
+	/**
+	 * Sets the number of threads used to polygonize.
+	 *
+	 * Rings never span two connected components of the linework:
+	 * when more than one thread is used, the components are
+	 * polygonized concurrently, and only the holes are then assigned
+	 * to the shells of the whole input. The polygons, dangles,
+	 * cut edges and invalid ring lines are the same as with a single
+	 * thread, possibly in another order.
+	 *
+	 * @param n number of threads, 0 for one per processor.
+	 *        Defaults to 1.
+	 */
+	void setNumThreads(std::size_t n) { numThreads = n; }
+
 	/** \brief
 	 * Add a collection of geometries to be polygonized.
 	 * May be called multiple times.
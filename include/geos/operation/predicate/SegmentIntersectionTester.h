@@ -24,6 +24,9 @@
 
 #include <geos/algorithm/LineIntersector.h> // for composition
 #include <geos/geom/Coordinate.h> // for composition
+#include <geos/index/chain/SegmentEnvelopeBlock.h> // for composition
+
+#include <vector>
 
 // Forward declarations
 namespace geos {
@@ -62,6 +65,20 @@ private:
   geom::Coordinate pt00;
   geom::Coordinate pt01;
 
+	typedef std::vector<index::chain::SegmentEnvelopeBlock> BlockVect;
+
+	/// Splits the segments of seq into envelope blocks
+	static void buildBlocks(const geom::CoordinateSequence& seq,
+		BlockVect& blocks);
+
+	/// \brief
+	/// Tests p0-p1 against the segments of seq having envelopes
+	/// intersecting its own, using q0 and q1 as scratch
+	///
+	bool intersectsBlocks(const geom::Coordinate& p0,
+		const geom::Coordinate& p1,
+		const geom::CoordinateSequence& seq, const BlockVect& blocks,
+		geom::Coordinate& q0, geom::Coordinate& q1);
 
 public:
 
@@ -25,6 +25,7 @@
 #include <vector>
 #include <algorithm>
 #include <memory>
+#include <cstddef>
 
 #include "GeometryListHolder.h"
 
@@ -73,6 +74,9 @@ private:
     std::vector<geom::Polygon*>* inputPolys;
     geom::GeometryFactory const* geomFactory;
 
+    /// Number of threads to union with, 0 for one per processor
+    std::size_t numThreads;
+
     /**
      * The effectiveness of the index is somewhat sensitive
      * to the node capacity.  
@@ -107,8 +111,11 @@ public:
      * 
      * @param polys a collection of {@link Polygonal} {@link Geometry}s.
      *        ownership of elements _and_ vector are left to caller.
+     * @param numThreads number of threads to use, 0 for one per
+     *        processor (see setNumThreads)
      */
-    static geom::Geometry* Union(std::vector<geom::Polygon*>* polys);
+    static geom::Geometry* Union(std::vector<geom::Polygon*>* polys,
+                                 std::size_t numThreads=1);
 
     /**
      * Computes the union of a set of {@link Polygonal} {@link Geometry}s.
@@ -116,16 +123,18 @@ public:
      * @tparam T an iterator yelding something castable to const Polygon *
      * @param start start iterator
      * @param end end iterator
+     * @param numThreads number of threads to use, 0 for one per
+     *        processor (see setNumThreads)
      */
     template <class T>
-    static geom::Geometry* Union(T start, T end)
+    static geom::Geometry* Union(T start, T end, std::size_t numThreads=1)
     {
       std::vector<geom::Polygon*> polys;
       for (T i=start; i!=end; ++i) {
         const geom::Polygon* p = dynamic_cast<const geom::Polygon*>(*i);
         polys.push_back(const_cast<geom::Polygon*>(p));
       }
-      return Union(&polys);
+      return Union(&polys, numThreads);
     }
 
     /**
@@ -134,8 +143,11 @@ public:
      * 
      * @param polys a collection of {@link Polygonal} {@link Geometry}s
      *        ownership of elements _and_ vector are left to caller.
+     * @param numThreads number of threads to use, 0 for one per
+     *        processor (see setNumThreads)
      */
-    static geom::Geometry* Union(const geom::MultiPolygon* polys);
+    static geom::Geometry* Union(const geom::MultiPolygon* polys,
+                                 std::size_t numThreads=1);
 
     /**
      * Creates a new instance to union
@@ -146,9 +158,23 @@ public:
      */
     CascadedPolygonUnion(std::vector<geom::Polygon*>* polys)
       : inputPolys(polys),
-        geomFactory(NULL)
+        geomFactory(NULL),
+        numThreads(1)
     {}
 
+    /**
+     * Sets the number of threads used to compute the union.
+     *
+     * The cascade is a tree of independent unions: when more than
+     * one thread is used, the nodes at each depth of the tree are
+     * unioned concurrently, deepest first. The same unions are
+     * computed as by a single thread, so the result is the same.
+     *
+     * @param n number of threads, 0 for one per processor.
+     *        Defaults to 1.
+     */
+    void setNumThreads(std::size_t n) { numThreads = n; }
+
     /**
      * Computes the union of the input geometries.
      * 
@@ -158,8 +184,19 @@ public:
     geom::Geometry* Union();
 
 private:
+
+    class NodeUnionTask;
+    friend class NodeUnionTask;
+
     geom::Geometry* unionTree(index::strtree::ItemsList* geomTree);
 
+    /**
+     * Same as unionTree, unioning the nodes at each depth of
+     * the tree concurrently.
+     */
+    geom::Geometry* unionTreeParallel(index::strtree::ItemsList* geomTree,
+                                      std::size_t threads);
+
     /**
      * Unions a list of geometries 
      * by treating the list as a flattened binary tree,
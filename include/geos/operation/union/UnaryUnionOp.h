@@ -21,6 +21,7 @@
 
 #include <memory>
 #include <vector>
+#include <cstddef>
 
 #include <geos/export.h>
 #include <geos/geom/GeometryFactory.h>
@@ -108,7 +109,8 @@ public:
   template <class T>
   UnaryUnionOp(const T& geoms, geom::GeometryFactory& geomFactIn)
       :
-      geomFact(&geomFactIn)
+      geomFact(&geomFactIn),
+      numThreads(1)
   {
     extractGeoms(geoms);
   }
@@ -116,14 +118,16 @@ public:
   template <class T>
   UnaryUnionOp(const T& geoms)
       :
-      geomFact(0)
+      geomFact(0),
+      numThreads(1)
   {
     extractGeoms(geoms);
   }
 
   UnaryUnionOp(const geom::Geometry& geom)
       :
-      geomFact(geom.getFactory())
+      geomFact(geom.getFactory()),
+      numThreads(1)
   {
     extract(geom);
   }
@@ -140,6 +144,16 @@ public:
    */
   std::auto_ptr<geom::Geometry> Union();
 
+  /**
+   * Sets the number of threads used to union the polygonal
+   * components of the input.
+   *
+   * @param n number of threads, 0 for one per processor.
+   *        Defaults to 1.
+   * @see CascadedPolygonUnion::setNumThreads
+   */
+  void setNumThreads(std::size_t n) { numThreads = n; }
+
 private:
 
   template <typename T>
@@ -208,6 +222,8 @@ private:
 
   const geom::GeometryFactory* geomFact;
 
+  std::size_t numThreads;
+
   std::auto_ptr<geom::Geometry> empty;
 };
  
@@ -25,6 +25,8 @@
 
 #include <geos/operation/valid/TopologyValidationError.h> // for inlined destructor
 
+#include <vector>
+
 // Forward declarations
 namespace geos {
 	namespace util {
@@ -191,6 +193,34 @@ private:
 
 	bool isSelfTouchingRingFormingHoleValid;
 
+	/// Outcome of the checks which do not build a topology graph
+	enum FastCheck {
+		eFastValid,
+		eFastInvalid,
+		/// only the topology graph can tell
+		eFastUnknown
+	};
+
+	/**
+	 * Tells the validity of a geometry without building its
+	 * topology graph, when this is possible.
+	 *
+	 * Polygon rings meeting nowhere but at the common vertices of
+	 * consecutive segments are valid if no hole is outside its
+	 * shell or inside another hole, and no shell is in the interior
+	 * of another polygon: there is no need for the graph.
+	 * Rings meeting elsewhere need it, unless they cross, which is
+	 * always an error.
+	 */
+	FastCheck checkValidFast(const geom::Geometry *g);
+	FastCheck checkValidFast(const geom::LineString *g);
+	FastCheck checkValidFast(const geom::LinearRing *g);
+	FastCheck checkValidFast(const std::vector<const geom::Polygon*>& polys);
+
+	/// Checks that no ring of the polygons is nested where it should not
+	FastCheck checkNotNestedFast(
+			const std::vector<const geom::Polygon*>& polys);
+
 public:
 	/**
 	 * Find a point from the list of testCoords
@@ -234,6 +264,13 @@ public:
 		delete validErr;
 	}
 
+	/**
+	 * Tests whether the geometry is valid.
+	 *
+	 * Stops at the first error found, and only builds the topology
+	 * graph of the geometry when simpler checks cannot tell
+	 * (see getValidationError() for the error).
+	 */
 	bool isValid();
 
 	TopologyValidationError* getValidationError();
@@ -52,6 +52,9 @@
 /* Set to 1 if XCode __inline_isnand is defined */
 #cmakedefine HAVE_INLINE_ISNAND_XCODE 1
 
+/* Set to 1 if you have POSIX threads */
+#cmakedefine HAVE_PTHREAD 1
+
 /* Set to 1 if C++/C99 std::isfinite is defined */
 #cmakedefine HAVE_STD_ISFINITE 1
 
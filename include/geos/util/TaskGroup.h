@@ -0,0 +1,113 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#ifndef GEOS_UTIL_TASKGROUP_H
+#define GEOS_UTIL_TASKGROUP_H
+
+#include <geos/export.h>
+
+#include <vector>
+#include <cstddef>
+
+#ifdef _MSC_VER
+#pragma warning(push)
+#pragma warning(disable: 4251) // warning C4251: needs to have dll-interface to be used by clients of class
+#endif
+
+namespace geos {
+namespace util { // geos::util
+
+/// A unit of work to be run by a TaskGroup
+class GEOS_DLL Task {
+public:
+	virtual void run()=0;
+
+	virtual ~Task() {}
+};
+
+/**
+ * \brief
+ * Runs a set of independent Tasks on a number of threads,
+ * returning when all of them are done.
+ *
+ * Tasks are handed out to the threads in the order they were
+ * added, each thread taking the next one as soon as it is idle.
+ * The calling thread takes part in the work, so a TaskGroup
+ * with a single thread just runs all tasks in sequence.
+ *
+ * Tasks must not share mutable state (GEOS objects are not
+ * thread-safe) and must not throw anything but std::exception
+ * derived objects. If tasks throw, the remaining ones are still
+ * run and run() then throws the exception thrown by the task
+ * added first: a TopologyException or a GEOSException (other
+ * std::exceptions are converted to the latter).
+ *
+ * On platforms without thread support all tasks are run
+ * in the calling thread.
+ */
+class GEOS_DLL TaskGroup {
+
+public:
+
+	/**
+	 * @param numThreads maximum number of threads to use,
+	 *        including the calling one; 0 means one per processor
+	 */
+	TaskGroup(std::size_t numThreads);
+
+	~TaskGroup();
+
+	/**
+	 * Adds a task to the group.
+	 *
+	 * @param task the task to run, ownership left to caller
+	 */
+	void add(Task* task) { tasks.push_back(task); }
+
+	/// Returns the number of tasks added to the group
+	std::size_t size() const { return tasks.size(); }
+
+	/**
+	 * Runs all tasks added to the group, and forgets about them.
+	 *
+	 * @throws GEOSException, TopologyException if any task throws
+	 */
+	void run();
+
+	/// Returns the number of threads used by this group
+	std::size_t getNumThreads() const { return numThreads; }
+
+	/**
+	 * Returns the number of processors available, or 1 if
+	 * that cannot be determined or threads are not supported.
+	 */
+	static std::size_t getNumProcessors();
+
+private:
+
+	std::size_t numThreads;
+
+	std::vector<Task*> tasks;
+
+	// Declare type as noncopyable
+	TaskGroup(const TaskGroup& other);
+	TaskGroup& operator=(const TaskGroup& rhs);
+};
+
+} // namespace geos::util
+} // namespace geos
+
+#ifdef _MSC_VER
+#pragma warning(pop)
+#endif
+
+#endif // GEOS_UTIL_TASKGROUP_H
@@ -23,6 +23,7 @@
 #include <geos/algorithm/LineIntersector.h>
 #include <geos/algorithm/RayCrossingCounter.h>
 #include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/FlatCoordinateSequence.h>
 #include <geos/geom/Coordinate.h>
 #include <geos/geom/Location.h>
 #include <geos/util/IllegalArgumentException.h>
@@ -38,6 +39,65 @@ using namespace geos::geom;
 namespace geos {
 namespace algorithm { // geos.algorithm
 
+namespace {
+
+// Same as signedArea(const CoordinateSequence*), with no virtual calls
+double
+signedAreaFlat(const FlatCoordinateSequence& ring)
+{
+	size_t npts=ring.getSize();
+
+	if (npts<3) return 0.0;
+
+	double x0 = ring.getXAt(0);
+	double ppy;
+	double cpx;
+	double cpy = ring.getYAt(0);
+	double npx = ring.getXAt(1) - x0;
+	double npy = ring.getYAt(1);
+	double sum=0.0;
+	for (size_t i=1; i<npts; ++i)
+	{
+		ppy = cpy;
+		cpx = npx;
+		cpy = npy;
+		npx = ring.getXAt(i) - x0;
+		npy = ring.getYAt(i);
+		sum += cpx * (npy - ppy);
+	}
+	return -sum/2.0;
+}
+
+// Same as length(const CoordinateSequence*), with no virtual calls
+double
+lengthFlat(const FlatCoordinateSequence& pts)
+{
+	size_t npts=pts.getSize();
+	if (npts <= 1) return 0.0;
+
+	double len = 0.0;
+
+	double x0 = pts.getXAt(0);
+	double y0 = pts.getYAt(0);
+
+	for(size_t i = 1; i < npts; ++i)
+	{
+		double x1 = pts.getXAt(i);
+		double y1 = pts.getYAt(i);
+		double dx = x1 - x0;
+		double dy = y1 - y0;
+
+		len += sqrt(dx * dx + dy * dy);
+
+		x0 = x1;
+		y0 = y1;
+	}
+
+	return len;
+}
+
+} // anonymous namespace
+
 /*public static*/
 int
 CGAlgorithms::orientationIndex(const Coordinate& p1,const Coordinate& p2,const Coordinate& q)
@@ -303,6 +363,12 @@ limiting conditions:
 double
 CGAlgorithms::signedArea(const CoordinateSequence* ring)
 {
+	if ( const FlatCoordinateSequence* flat =
+	     dynamic_cast<const FlatCoordinateSequence*>(ring) )
+	{
+		return signedAreaFlat(*flat);
+	}
+
 	size_t npts=ring->getSize();
 
 	if (npts<3) return 0.0;
@@ -330,6 +396,11 @@ double
 CGAlgorithms::length(const CoordinateSequence* pts)
 {
 	// optimized for processing CoordinateSequences
+	if ( const FlatCoordinateSequence* flat =
+	     dynamic_cast<const FlatCoordinateSequence*>(pts) )
+	{
+		return lengthFlat(*flat);
+	}
 
 	size_t npts=pts->getSize();
 	if (npts <= 1) return 0.0;
@@ -22,6 +22,7 @@
 #include <geos/geom/Location.h>
 #include <geos/geom/Coordinate.h>
 #include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/FlatCoordinateSequence.h>
 
 
 namespace geos {
@@ -43,6 +44,24 @@ RayCrossingCounter::locatePointInRing(const geom::Coordinate& point,
 {
 	RayCrossingCounter rcc(point);
 
+	if ( const geom::FlatCoordinateSequence* flat =
+	     dynamic_cast<const geom::FlatCoordinateSequence*>(&ring) )
+	{
+		// read the ordinates directly, bypassing getAt()
+		geom::Coordinate p1, p2;
+		for (std::size_t i = 1, ni = flat->size(); i < ni; i++)
+		{
+			flat->getCoordinate(i, p1);
+			flat->getCoordinate(i - 1, p2);
+
+			rcc.countSegment(p1, p2);
+
+			if ( rcc.isOnSegment() )
+				return rcc.getLocation();
+		}
+		return rcc.getLocation();
+	}
+
 	for (int i = 1, ni = ring.size(); i < ni; i++) 
 	{
 		const geom::Coordinate & p1 = ring[ i ];
@@ -18,6 +18,7 @@
 #include <geos/geom/Polygon.h>
 #include <geos/geom/MultiPolygon.h>
 #include <geos/geom/LineString.h>
+#include <geos/geom/LinearRing.h>
 #include <geos/geom/LineSegment.h>
 #include <geos/geom/CoordinateSequence.h>
 #include <geos/geom/util/LinearComponentExtracter.h>
@@ -39,6 +40,9 @@ IndexedPointInAreaLocator::IntervalIndexedGeometry::IntervalIndexedGeometry( con
 {
 	index = new index::intervalrtree::SortedPackedIntervalRTree();
 	init( g);
+
+	// so that locate() only reads the index
+	index->build();
 }
 
 IndexedPointInAreaLocator::IntervalIndexedGeometry::~IntervalIndexedGeometry( )
@@ -102,8 +106,9 @@ IndexedPointInAreaLocator::IndexedPointInAreaLocator( const geom::Geometry & g)
 :	areaGeom( g)
 {
 	if (	typeid( areaGeom) != typeid( geom::Polygon)
-		&&	typeid( areaGeom) != typeid( geom::MultiPolygon) ) 
-		throw new util::IllegalArgumentException("Argument must be Polygonal");
+		&&	typeid( areaGeom) != typeid( geom::MultiPolygon)
+		&&	typeid( areaGeom) != typeid( geom::LinearRing) ) 
+		throw new util::IllegalArgumentException("Argument must be Polygonal or LinearRing");
 
 	//areaGeom = g;
 	
@@ -0,0 +1,574 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/geom/CompactGeometry.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/CoordinateSequenceFactory.h>
+#include <geos/geom/GeometryCollection.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/LinearRing.h>
+#include <geos/geom/LineString.h>
+#include <geos/geom/Location.h>
+#include <geos/geom/MultiLineString.h>
+#include <geos/geom/MultiPoint.h>
+#include <geos/geom/MultiPolygon.h>
+#include <geos/geom/Point.h>
+#include <geos/geom/Polygon.h>
+#include <geos/algorithm/CGAlgorithms.h>
+#include <geos/algorithm/LineIntersector.h>
+#include <geos/algorithm/RayCrossingCounter.h>
+#include <geos/platform.h> // for ISNAN, DoubleInfinity
+
+#include <vector>
+#include <algorithm> // std::copy
+#include <new>
+#include <cassert>
+
+using namespace std;
+using geos::algorithm::CGAlgorithms;
+using geos::algorithm::LineIntersector;
+using geos::algorithm::RayCrossingCounter;
+
+namespace geos {
+namespace geom { // geos::geom
+
+namespace {
+
+/*
+ * Appends the non-collection components of g to parts,
+ * descending into nested collections.
+ */
+void
+collectParts(const Geometry& g, vector<const Geometry*>& parts)
+{
+	const GeometryCollection* gc = dynamic_cast<const GeometryCollection*>(&g);
+	if ( ! gc )
+	{
+		parts.push_back(&g);
+		return;
+	}
+	for (size_t i=0, n=gc->getNumGeometries(); i<n; ++i)
+	{
+		collectParts(*gc->getGeometryN(i), parts);
+	}
+}
+
+/*
+ * Appends the sequences of the rings of the given component,
+ * as stored by CompactGeometry
+ */
+void
+collectRings(const Geometry& part, vector<const CoordinateSequence*>& rings)
+{
+	if ( const Polygon* poly = dynamic_cast<const Polygon*>(&part) )
+	{
+		rings.push_back(poly->getExteriorRing()->getCoordinatesRO());
+		for (size_t i=0, n=poly->getNumInteriorRing(); i<n; ++i)
+		{
+			rings.push_back(poly->getInteriorRingN(i)->getCoordinatesRO());
+		}
+	}
+	else if ( const LineString* ls = dynamic_cast<const LineString*>(&part) )
+	{
+		rings.push_back(ls->getCoordinatesRO());
+	}
+	else if ( const Point* pt = dynamic_cast<const Point*>(&part) )
+	{
+		rings.push_back(pt->getCoordinatesRO());
+	}
+	else
+	{
+		assert(0); // unknown component type
+	}
+}
+
+} // anonymous namespace
+
+/*public static*/
+auto_ptr<CompactGeometry>
+CompactGeometry::create(const Geometry& g)
+{
+	vector<const Geometry*> parts;
+	collectParts(g, parts);
+
+	vector<const CoordinateSequence*> rings;
+	vector<unsigned int> partStart(1, 0);
+	for (size_t i=0; i<parts.size(); ++i)
+	{
+		collectRings(*parts[i], rings);
+		partStart.push_back(static_cast<unsigned int>(rings.size()));
+	}
+
+	size_t nPoints = 0;
+	size_t dim = 2;
+	for (size_t r=0; r<rings.size(); ++r)
+	{
+		const CoordinateSequence& cs = *rings[r];
+		nPoints += cs.getSize();
+		for (size_t i=0, n=cs.getSize(); dim==2 && i<n; ++i)
+		{
+			if ( ! ISNAN(cs.getOrdinate(i, CoordinateSequence::Z)) ) dim = 3;
+		}
+	}
+
+	size_t size = blockSize(parts.size(), rings.size(), nPoints, dim);
+	void* mem = ::operator new(size);
+	auto_ptr<CompactGeometry> cg(::new (mem) CompactGeometry());
+
+	cg->typeId = static_cast<unsigned char>(g.getGeometryTypeId());
+	cg->dimension = static_cast<unsigned char>(dim);
+	cg->numParts = static_cast<unsigned int>(parts.size());
+	cg->numRings = static_cast<unsigned int>(rings.size());
+	cg->numPoints = static_cast<unsigned int>(nPoints);
+	cg->minx = cg->miny = DoubleInfinity;
+	cg->maxx = cg->maxy = -DoubleInfinity;
+
+	double* ords = const_cast<double*>(cg->ordinates());
+	unsigned int* ringStart = const_cast<unsigned int*>(cg->ringStarts());
+	unsigned int pos = 0;
+	for (size_t r=0; r<rings.size(); ++r)
+	{
+		ringStart[r] = pos;
+		const CoordinateSequence& cs = *rings[r];
+		for (size_t i=0, n=cs.getSize(); i<n; ++i, ++pos)
+		{
+			double x = cs.getX(i);
+			double y = cs.getY(i);
+			double* o = ords + size_t(pos) * dim;
+			o[0] = x;
+			o[1] = y;
+			if ( dim > 2 ) o[2] = cs.getOrdinate(i, CoordinateSequence::Z);
+			if ( x < cg->minx ) cg->minx = x;
+			if ( x > cg->maxx ) cg->maxx = x;
+			if ( y < cg->miny ) cg->miny = y;
+			if ( y > cg->maxy ) cg->maxy = y;
+		}
+	}
+	ringStart[rings.size()] = pos;
+
+	unsigned int* partStarts = const_cast<unsigned int*>(cg->partStarts());
+	std::copy(partStart.begin(), partStart.end(), partStarts);
+
+	unsigned char* types = const_cast<unsigned char*>(cg->partTypes());
+	for (size_t i=0; i<parts.size(); ++i)
+	{
+		types[i] = static_cast<unsigned char>(parts[i]->getGeometryTypeId());
+	}
+
+	return cg;
+}
+
+/*public static*/
+void
+CompactGeometry::operator delete(void* p)
+{
+	::operator delete(p);
+}
+
+/*private static*/
+size_t
+CompactGeometry::blockSize(size_t nParts, size_t nRings,
+                           size_t nPoints, size_t dim)
+{
+	return sizeof(CompactGeometry)
+	       + nPoints * dim * sizeof(double)
+	       + (nRings + 1 + nParts + 1) * sizeof(unsigned int)
+	       + nParts;
+}
+
+/*public*/
+size_t
+CompactGeometry::getMemoryUsage() const
+{
+	return blockSize(numParts, numRings, numPoints, dimension);
+}
+
+/*private*/
+void
+CompactGeometry::getCoordinate(size_t i, Coordinate& c) const
+{
+	const double* o = ordinates() + i * dimension;
+	c.x = o[0];
+	c.y = o[1];
+	c.z = dimension > 2 ? o[2] : DoubleNotANumber;
+}
+
+/*private*/
+Envelope
+CompactGeometry::ringEnvelope(size_t r) const
+{
+	Envelope env;
+	const double* o = ordinates();
+	for (size_t i=ringStarts()[r], end=ringStarts()[r+1]; i<end; ++i)
+	{
+		env.expandToInclude(o[i*dimension], o[i*dimension+1]);
+	}
+	return env;
+}
+
+/*public*/
+auto_ptr<Geometry>
+CompactGeometry::toGeometry(const GeometryFactory& factory) const
+{
+	const CoordinateSequenceFactory* csf =
+		factory.getCoordinateSequenceFactory();
+
+	vector<Geometry*>* comps = new vector<Geometry*>();
+	vector<LinearRing*> rings;
+	try
+	{
+		for (size_t p=0; p<numParts; ++p)
+		{
+			rings.clear();
+			for (size_t r=partStarts()[p]; r<partStarts()[p+1]; ++r)
+			{
+				vector<Coordinate>* coords =
+					new vector<Coordinate>(ringSize(r));
+				for (size_t i=0; i<coords->size(); ++i)
+				{
+					getCoordinate(ringStarts()[r] + i, (*coords)[i]);
+				}
+				auto_ptr<CoordinateSequence> cs(csf->create(coords, dimension));
+
+				switch (partTypes()[p])
+				{
+				case GEOS_POINT:
+					// empty Points have no sequence of size 0
+					if ( cs->isEmpty() ) comps->push_back(factory.createPoint());
+					else comps->push_back(factory.createPoint(cs.release()));
+					break;
+				case GEOS_LINESTRING:
+					comps->push_back(factory.createLineString(cs.release()));
+					break;
+				case GEOS_LINEARRING:
+					comps->push_back(factory.createLinearRing(cs.release()));
+					break;
+				default:
+					rings.push_back(factory.createLinearRing(cs.release()));
+				}
+			}
+
+			if ( partTypes()[p] == GEOS_POLYGON )
+			{
+				assert( ! rings.empty() );
+				vector<Geometry*>* holes =
+					new vector<Geometry*>(rings.begin()+1, rings.end());
+				LinearRing* shell = rings[0];
+				rings.clear(); // owned by the Polygon
+				comps->push_back(factory.createPolygon(shell, holes));
+			}
+		}
+	}
+	catch (...)
+	{
+		for (size_t i=0; i<rings.size(); ++i) delete rings[i];
+		for (size_t i=0; i<comps->size(); ++i) delete (*comps)[i];
+		delete comps;
+		throw;
+	}
+
+	switch (typeId)
+	{
+	case GEOS_MULTIPOINT:
+		return auto_ptr<Geometry>(factory.createMultiPoint(comps));
+	case GEOS_MULTILINESTRING:
+		return auto_ptr<Geometry>(factory.createMultiLineString(comps));
+	case GEOS_MULTIPOLYGON:
+		return auto_ptr<Geometry>(factory.createMultiPolygon(comps));
+	case GEOS_GEOMETRYCOLLECTION:
+		return auto_ptr<Geometry>(factory.createGeometryCollection(comps));
+	default:
+		assert(comps->size() == 1);
+		auto_ptr<Geometry> g((*comps)[0]);
+		delete comps;
+		return g;
+	}
+}
+
+/*private*/
+int
+CompactGeometry::locateInPolygon(const Coordinate& p, size_t part) const
+{
+	size_t shell = partStarts()[part];
+	for (size_t r=shell, end=partStarts()[part+1]; r<end; ++r)
+	{
+		size_t n = ringSize(r);
+		if ( n < 2 )
+		{
+			if ( r == shell ) return Location::EXTERIOR;
+			continue;
+		}
+
+		RayCrossingCounter rcc(p);
+		Coordinate p0, p1;
+		size_t start = ringStarts()[r];
+		getCoordinate(start, p0);
+		for (size_t i=1; i<n && ! rcc.isOnSegment(); ++i)
+		{
+			getCoordinate(start+i, p1);
+			rcc.countSegment(p0, p1);
+			p0 = p1;
+		}
+
+		int loc = rcc.getLocation();
+		if ( loc == Location::BOUNDARY ) return Location::BOUNDARY;
+		if ( r == shell )
+		{
+			if ( loc == Location::EXTERIOR ) return Location::EXTERIOR;
+		}
+		else if ( loc == Location::INTERIOR )
+		{
+			// in a hole
+			return Location::EXTERIOR;
+		}
+	}
+	return Location::INTERIOR;
+}
+
+/*public*/
+int
+CompactGeometry::locate(const Coordinate& p) const
+{
+	if ( isEmpty() || ! getEnvelope().covers(p.x, p.y) )
+		return Location::EXTERIOR;
+
+	for (size_t part=0; part<numParts; ++part)
+	{
+		if ( partTypes()[part] != GEOS_POLYGON ) continue;
+		int loc = locateInPolygon(p, part);
+		if ( loc != Location::EXTERIOR ) return loc;
+	}
+	return Location::EXTERIOR;
+}
+
+/*public*/
+bool
+CompactGeometry::intersects(const Coordinate& p) const
+{
+	if ( isEmpty() || ! getEnvelope().covers(p.x, p.y) ) return false;
+
+	for (size_t part=0; part<numParts; ++part)
+	{
+		if ( partTypes()[part] == GEOS_POLYGON )
+		{
+			if ( locateInPolygon(p, part) != Location::EXTERIOR ) return true;
+			continue;
+		}
+
+		size_t r = partStarts()[part];
+		size_t n = ringSize(r);
+		size_t start = ringStarts()[r];
+		Coordinate p0, p1;
+		if ( n == 1 )
+		{
+			getCoordinate(start, p0);
+			if ( p0.equals2D(p) ) return true;
+			continue;
+		}
+		for (size_t i=0; i+1<n; ++i)
+		{
+			getCoordinate(start+i, p0);
+			getCoordinate(start+i+1, p1);
+			if ( LineIntersector::hasIntersection(p, p0, p1) ) return true;
+		}
+	}
+	return false;
+}
+
+/*private*/
+bool
+CompactGeometry::hasComponentIn(const CompactGeometry& other) const
+{
+	Coordinate c;
+	for (size_t part=0; part<numParts; ++part)
+	{
+		size_t r = partStarts()[part];
+		if ( r == partStarts()[part+1] || ringSize(r) == 0 ) continue;
+		getCoordinate(ringStarts()[r], c);
+		if ( other.intersects(c) ) return true;
+	}
+	return false;
+}
+
+/*private*/
+bool
+CompactGeometry::hasSegmentIntersection(const CompactGeometry& other) const
+{
+	Envelope otherEnv = other.getEnvelope();
+	vector<Envelope> otherRingEnvs(other.numRings);
+	for (size_t rb=0; rb<other.numRings; ++rb)
+	{
+		otherRingEnvs[rb] = other.ringEnvelope(rb);
+	}
+
+	LineIntersector li;
+	Coordinate a0, a1, b0, b1;
+	for (size_t ra=0; ra<numRings; ++ra)
+	{
+		size_t na = ringSize(ra);
+		if ( na < 2 ) continue;
+		Envelope ea = ringEnvelope(ra);
+		if ( ! ea.intersects(otherEnv) ) continue;
+
+		for (size_t rb=0; rb<other.numRings; ++rb)
+		{
+			size_t nb = other.ringSize(rb);
+			if ( nb < 2 || ! ea.intersects(otherRingEnvs[rb]) ) continue;
+
+			size_t sa = ringStarts()[ra];
+			size_t sb = other.ringStarts()[rb];
+			for (size_t i=0; i+1<na; ++i)
+			{
+				getCoordinate(sa+i, a0);
+				getCoordinate(sa+i+1, a1);
+				if ( ! otherRingEnvs[rb].intersects(Envelope(a0, a1)) ) continue;
+				for (size_t j=0; j+1<nb; ++j)
+				{
+					other.getCoordinate(sb+j, b0);
+					other.getCoordinate(sb+j+1, b1);
+					if ( ! Envelope::intersects(a0, a1, b0, b1) ) continue;
+					li.computeIntersection(a0, a1, b0, b1);
+					if ( li.hasIntersection() ) return true;
+				}
+			}
+		}
+	}
+	return false;
+}
+
+/*public*/
+bool
+CompactGeometry::intersects(const CompactGeometry& other) const
+{
+	if ( isEmpty() || other.isEmpty() ) return false;
+	if ( ! getEnvelope().intersects(other.getEnvelope()) ) return false;
+
+	// one inside the other, or touching at a first vertex
+	if ( hasComponentIn(other) || other.hasComponentIn(*this) ) return true;
+
+	return hasSegmentIntersection(other);
+}
+
+/*public*/
+double
+CompactGeometry::distance(const Coordinate& p) const
+{
+	if ( isEmpty() ) return 0.0;
+	if ( locate(p) != Location::EXTERIOR ) return 0.0;
+
+	double minDist = DoubleInfinity;
+	Coordinate p0, p1;
+	for (size_t r=0; r<numRings; ++r)
+	{
+		size_t n = ringSize(r);
+		size_t start = ringStarts()[r];
+		if ( n == 1 )
+		{
+			getCoordinate(start, p0);
+			double d = p.distance(p0);
+			if ( d < minDist ) minDist = d;
+			continue;
+		}
+		for (size_t i=0; i+1<n; ++i)
+		{
+			getCoordinate(start+i, p0);
+			getCoordinate(start+i+1, p1);
+			double d = CGAlgorithms::distancePointLine(p, p0, p1);
+			if ( d < minDist ) minDist = d;
+		}
+	}
+	return minDist;
+}
+
+/*private*/
+double
+CompactGeometry::computeDistance(const CompactGeometry& other,
+                                 double terminateDistance) const
+{
+	if ( isEmpty() || other.isEmpty() ) return 0.0;
+
+	if ( hasComponentIn(other) || other.hasComponentIn(*this) ) return 0.0;
+
+	vector<Envelope> otherRingEnvs(other.numRings);
+	for (size_t rb=0; rb<other.numRings; ++rb)
+	{
+		otherRingEnvs[rb] = other.ringEnvelope(rb);
+	}
+
+	double minDist = DoubleInfinity;
+	Coordinate a0, a1, b0, b1;
+	for (size_t ra=0; ra<numRings; ++ra)
+	{
+		size_t na = ringSize(ra);
+		if ( na == 0 ) continue;
+		Envelope ea = ringEnvelope(ra);
+		size_t sa = ringStarts()[ra];
+
+		for (size_t rb=0; rb<other.numRings; ++rb)
+		{
+			size_t nb = other.ringSize(rb);
+			if ( nb == 0 || ea.distance(&otherRingEnvs[rb]) >= minDist )
+				continue;
+			size_t sb = other.ringStarts()[rb];
+
+			// a single coordinate stands for a degenerate segment
+			for (size_t i=0; i==0 || i+1<na; ++i)
+			{
+				getCoordinate(sa+i, a0);
+				getCoordinate(na > 1 ? sa+i+1 : sa+i, a1);
+				for (size_t j=0; j==0 || j+1<nb; ++j)
+				{
+					other.getCoordinate(sb+j, b0);
+					other.getCoordinate(nb > 1 ? sb+j+1 : sb+j, b1);
+
+					double d;
+					if ( na == 1 && nb == 1 ) d = a0.distance(b0);
+					else if ( na == 1 ) d = CGAlgorithms::distancePointLine(a0, b0, b1);
+					else if ( nb == 1 ) d = CGAlgorithms::distancePointLine(b0, a0, a1);
+					else d = CGAlgorithms::distanceLineLine(a0, a1, b0, b1);
+
+					if ( d < minDist )
+					{
+						minDist = d;
+						if ( minDist <= terminateDistance ) return minDist;
+					}
+				}
+			}
+		}
+	}
+	return minDist;
+}
+
+/*public*/
+double
+CompactGeometry::distance(const CompactGeometry& other) const
+{
+	return computeDistance(other, 0.0);
+}
+
+/*public*/
+bool
+CompactGeometry::isWithinDistance(const CompactGeometry& other,
+                                  double dist) const
+{
+	if ( ! isEmpty() && ! other.isEmpty() )
+	{
+		Envelope env = getEnvelope();
+		Envelope otherEnv = other.getEnvelope();
+		if ( env.distance(&otherEnv) > dist ) return false;
+	}
+	return computeDistance(other, dist) <= dist;
+}
+
+} // namespace geos::geom
+} // namespace geos
@@ -201,6 +201,13 @@ CoordinateArraySequence::expandEnvelope(Envelope &env) const
 		env.expandToInclude((*vect)[i]);
 }
 
+std::size_t
+CoordinateArraySequence::getMemoryUsage() const
+{
+	return sizeof(CoordinateArraySequence) + sizeof(std::vector<Coordinate>)
+	       + vect->capacity() * sizeof(Coordinate);
+}
+
 double
 CoordinateArraySequence::getOrdinate(size_t index, size_t ordinateIndex) const
 {
@@ -269,6 +269,12 @@ CoordinateSequence::expandEnvelope(Envelope &env) const
         env.expandToInclude(getAt(i));
 }
 
+std::size_t
+CoordinateSequence::getMemoryUsage() const
+{
+	return sizeof(CoordinateSequence) + getSize() * sizeof(Coordinate);
+}
+
 std::ostream& operator<< (std::ostream& os, const CoordinateSequence& cs)
 {
 	os << "(";
@@ -0,0 +1,439 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/geom/FlatCoordinateSequence.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/CoordinateFilter.h>
+#include <geos/geom/Envelope.h>
+#include <geos/util/IllegalArgumentException.h>
+
+#include <sstream>
+#include <vector>
+#include <algorithm> // std::copy, std::max
+#include <cstring> // std::memmove
+#include <cassert>
+
+#if defined(_MSC_VER)
+# include <windows.h> // for InterlockedCompareExchangePointer
+#endif
+
+using namespace std;
+
+namespace geos {
+namespace geom { // geos::geom
+
+namespace {
+
+/*
+ * Sets *slot to v unless another thread did it first, in which
+ * case false is returned. Concurrent readers of a sequence can
+ * so build its Coordinate view without locking.
+ */
+bool
+publish(vector<Coordinate>** slot, vector<Coordinate>* v)
+{
+#if defined(_MSC_VER)
+	return InterlockedCompareExchangePointer(
+		reinterpret_cast<PVOID volatile*>(slot), v, 0) == 0;
+#elif defined(__GNUC__)
+	return __sync_bool_compare_and_swap(slot,
+		static_cast<vector<Coordinate>*>(0), v);
+#else
+	*slot = v;
+	return true;
+#endif
+}
+
+/*
+ * Reads *slot, seeing the view it points to as built by the
+ * thread which published it.
+ */
+vector<Coordinate>*
+acquire(vector<Coordinate>* const* slot)
+{
+#if defined(_MSC_VER)
+	return static_cast<vector<Coordinate>*>(InterlockedCompareExchangePointer(
+		reinterpret_cast<PVOID volatile*>(const_cast<vector<Coordinate>**>(slot)),
+		0, 0));
+#elif defined(__ATOMIC_ACQUIRE)
+	return __atomic_load_n(slot, __ATOMIC_ACQUIRE);
+#elif defined(__GNUC__)
+	return __sync_val_compare_and_swap(
+		const_cast<vector<Coordinate>**>(slot),
+		static_cast<vector<Coordinate>*>(0),
+		static_cast<vector<Coordinate>*>(0));
+#else
+	return *slot;
+#endif
+}
+
+} // anonymous namespace
+
+/*public*/
+FlatCoordinateSequence::FlatCoordinateSequence(size_t dimension)
+{
+	init(dimension, 0);
+}
+
+/*public*/
+FlatCoordinateSequence::FlatCoordinateSequence(size_t n, size_t dimension)
+{
+	init(dimension, n);
+	for (size_t i=0; i<n*stride; ++i) ords[i] = 0.0;
+	if ( stride > 2 )
+	{
+		for (size_t i=0; i<n; ++i) ords[i*stride+2] = DoubleNotANumber;
+	}
+	count = n;
+}
+
+/*public*/
+FlatCoordinateSequence::FlatCoordinateSequence(
+		const vector<Coordinate>& coords, size_t dimension)
+{
+	if ( dimension == 0 )
+	{
+		// Only keep Z if any coordinate has one
+		dimension = 2;
+		for (size_t i=0, n=coords.size(); i<n; ++i)
+		{
+			if ( ! ISNAN(coords[i].z) )
+			{
+				dimension = 3;
+				break;
+			}
+		}
+	}
+	init(dimension, coords.size());
+	for (size_t i=0, n=coords.size(); i<n; ++i) store(i, coords[i]);
+	count = coords.size();
+}
+
+/*public*/
+FlatCoordinateSequence::FlatCoordinateSequence(
+		const FlatCoordinateSequence& other)
+	:
+	CoordinateSequence(other)
+{
+	init(other.stride, other.count);
+	copy(other.ords, other.ords + other.count*stride, ords);
+	count = other.count;
+}
+
+/*public*/
+FlatCoordinateSequence::~FlatCoordinateSequence()
+{
+	if ( ords != inlineOrds ) delete [] ords;
+	delete view;
+}
+
+/*private*/
+void
+FlatCoordinateSequence::init(size_t dimension, size_t n)
+{
+	stride = dimension == 2 ? 2 : 3;
+	count = 0;
+	view = 0;
+	ords = inlineOrds;
+	capacity = INLINE_ORDINATES / stride;
+	reserve(n);
+}
+
+/*public*/
+void
+FlatCoordinateSequence::reserve(size_t n)
+{
+	if ( n <= capacity ) return;
+
+	size_t newCapacity = max(n, capacity*2);
+	double* newOrds = new double[newCapacity*stride];
+	copy(ords, ords + count*stride, newOrds);
+	if ( ords != inlineOrds ) delete [] ords;
+	ords = newOrds;
+	capacity = newCapacity;
+}
+
+/*private*/
+const vector<Coordinate>&
+FlatCoordinateSequence::getView() const
+{
+	vector<Coordinate>* v = acquire(&view);
+	if ( ! v )
+	{
+		v = new vector<Coordinate>(count);
+		for (size_t i=0; i<count; ++i) getCoordinate(i, (*v)[i]);
+
+		// Another thread may have built one in the meantime
+		if ( ! publish(&view, v) )
+		{
+			delete v;
+			v = acquire(&view);
+		}
+	}
+	return *v;
+}
+
+/*private*/
+void
+FlatCoordinateSequence::dropView()
+{
+	delete view;
+	view = 0;
+}
+
+/*public*/
+CoordinateSequence *
+FlatCoordinateSequence::clone() const
+{
+	return new FlatCoordinateSequence(*this);
+}
+
+/*public*/
+const Coordinate&
+FlatCoordinateSequence::getAt(size_t pos) const
+{
+	assert(pos < count);
+	return getView()[pos];
+}
+
+/*public*/
+const vector<Coordinate>*
+FlatCoordinateSequence::toVector() const
+{
+	return &getView();
+}
+
+/*public*/
+void
+FlatCoordinateSequence::toVector(vector<Coordinate>& out) const
+{
+	size_t n = out.size();
+	out.resize(n + count);
+	for (size_t i=0; i<count; ++i) getCoordinate(i, out[n+i]);
+}
+
+/*public*/
+void
+FlatCoordinateSequence::add(const Coordinate& coord)
+{
+	// coord may be a reference into this sequence (see getAt),
+	// released by the changes below
+	const Coordinate c = coord;
+	dropView();
+	reserve(count+1);
+	store(count++, c);
+}
+
+/*public*/
+void
+FlatCoordinateSequence::add(const Coordinate& c, bool allowRepeated)
+{
+	if ( ! allowRepeated && count )
+	{
+		const double* last = ords + (count-1)*stride;
+		if ( last[0] == c.x && last[1] == c.y ) return;
+	}
+	add(c);
+}
+
+/*public*/
+void
+FlatCoordinateSequence::add(size_t i, const Coordinate& coord,
+                            bool allowRepeated)
+{
+	assert(i <= count);
+
+	// don't add duplicate coordinates
+	if ( ! allowRepeated )
+	{
+		if ( i > 0 && getXAt(i-1) == coord.x && getYAt(i-1) == coord.y )
+			return;
+		if ( i < count && getXAt(i) == coord.x && getYAt(i) == coord.y )
+			return;
+	}
+
+	const Coordinate c = coord; // may point into this sequence
+	dropView();
+	reserve(count+1);
+	memmove(ords + (i+1)*stride, ords + i*stride,
+	        (count-i)*stride*sizeof(double));
+	store(i, c);
+	++count;
+}
+
+/*public*/
+void
+FlatCoordinateSequence::setAt(const Coordinate& coord, size_t pos)
+{
+	assert(pos < count);
+	const Coordinate c = coord; // may point into this sequence
+	dropView();
+	store(pos, c);
+}
+
+/*public*/
+void
+FlatCoordinateSequence::deleteAt(size_t pos)
+{
+	assert(pos < count);
+	dropView();
+	memmove(ords + pos*stride, ords + (pos+1)*stride,
+	        (count-pos-1)*stride*sizeof(double));
+	--count;
+}
+
+/*public*/
+string
+FlatCoordinateSequence::toString() const
+{
+	string result("(");
+	Coordinate c;
+	for (size_t i=0; i<count; ++i)
+	{
+		if ( i ) result.append(", ");
+		getCoordinate(i, c);
+		result.append(c.toString());
+	}
+	result.append(")");
+	return result;
+}
+
+/*public*/
+void
+FlatCoordinateSequence::setPoints(const vector<Coordinate> &v)
+{
+	if ( &v == view ) return; // our own coordinates
+	dropView();
+	count = 0;
+	reserve(v.size());
+	for (size_t i=0, n=v.size(); i<n; ++i) store(i, v[i]);
+	count = v.size();
+}
+
+/*public*/
+double
+FlatCoordinateSequence::getOrdinate(size_t index, size_t ordinateIndex) const
+{
+	assert(index < count);
+	switch (ordinateIndex)
+	{
+		case CoordinateSequence::X:
+			return getXAt(index);
+		case CoordinateSequence::Y:
+			return getYAt(index);
+		case CoordinateSequence::Z:
+			return getZAt(index);
+		default:
+			return DoubleNotANumber;
+	}
+}
+
+/*public*/
+void
+FlatCoordinateSequence::setOrdinate(size_t index, size_t ordinateIndex,
+	double value)
+{
+	assert(index < count);
+	switch (ordinateIndex)
+	{
+		case CoordinateSequence::X:
+		case CoordinateSequence::Y:
+			break;
+		case CoordinateSequence::Z:
+			// XY sequences have no room for Z
+			if ( stride < 3 ) return;
+			break;
+		default:
+		{
+			std::stringstream ss;
+			ss << "Unknown ordinate index " << ordinateIndex;
+			throw util::IllegalArgumentException(ss.str());
+		}
+	}
+	dropView();
+	ords[index*stride + ordinateIndex] = value;
+}
+
+/*public*/
+void
+FlatCoordinateSequence::expandEnvelope(Envelope &env) const
+{
+	for (size_t i=0; i<count; ++i)
+		env.expandToInclude(ords[i*stride], ords[i*stride+1]);
+}
+
+/*public*/
+std::size_t
+FlatCoordinateSequence::getMemoryUsage() const
+{
+	std::size_t bytes = sizeof(FlatCoordinateSequence);
+	if ( ords != inlineOrds )
+		bytes += capacity * stride * sizeof(double);
+	if ( const vector<Coordinate>* v = acquire(&view) )
+		bytes += sizeof(std::vector<Coordinate>)
+		         + v->capacity() * sizeof(Coordinate);
+	return bytes;
+}
+
+/*public*/
+void
+FlatCoordinateSequence::apply_rw(const CoordinateFilter *filter)
+{
+	dropView();
+	Coordinate c;
+	for (size_t i=0; i<count; ++i)
+	{
+		getCoordinate(i, c);
+		filter->filter_rw(&c);
+		store(i, c);
+	}
+}
+
+/*public*/
+void
+FlatCoordinateSequence::apply_ro(CoordinateFilter *filter) const
+{
+	// Filters may keep the pointers they are given,
+	// so they must point to persistent Coordinates
+	for (size_t i=0; i<count; ++i)
+	{
+		filter->filter_ro(&getAt(i));
+	}
+}
+
+/*public*/
+CoordinateSequence&
+FlatCoordinateSequence::removeRepeatedPoints()
+{
+	if ( count < 2 ) return *this;
+
+	dropView();
+
+	// Equality test is 2D, as in Coordinate::operator==
+	size_t last = 0;
+	for (size_t i=1; i<count; ++i)
+	{
+		if ( getXAt(i) == getXAt(last) && getYAt(i) == getYAt(last) )
+			continue;
+		++last;
+		if ( last != i )
+		{
+			copy(ords + i*stride, ords + (i+1)*stride, ords + last*stride);
+		}
+	}
+	count = last + 1;
+
+	return *this;
+}
+
+} // namespace geos::geom
+} // namespace geos
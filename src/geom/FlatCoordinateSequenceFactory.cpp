@@ -0,0 +1,52 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/geom/FlatCoordinateSequenceFactory.h>
+#include <geos/geom/FlatCoordinateSequence.h>
+#include <geos/geom/Coordinate.h>
+
+#include <memory> // for auto_ptr
+#include <vector>
+
+namespace geos {
+namespace geom { // geos::geom
+
+static FlatCoordinateSequenceFactory flatCoordinateSequenceFactory;
+
+/*public*/
+CoordinateSequence *
+FlatCoordinateSequenceFactory::create(std::vector<Coordinate> *coords,
+		std::size_t dimension) const
+{
+	if ( ! coords ) return new FlatCoordinateSequence(dimension);
+
+	std::auto_ptr< std::vector<Coordinate> > owned(coords);
+	return new FlatCoordinateSequence(*coords, dimension);
+}
+
+/*public*/
+CoordinateSequence *
+FlatCoordinateSequenceFactory::create(std::size_t size,
+		std::size_t dimension) const
+{
+	return new FlatCoordinateSequence(size, dimension);
+}
+
+/*public static*/
+const CoordinateSequenceFactory *
+FlatCoordinateSequenceFactory::instance()
+{
+	return &flatCoordinateSequenceFactory;
+}
+
+} // namespace geos::geom
+} // namespace geos
@@ -112,14 +112,18 @@ Geometry::Geometry(const GeometryFactory *newFactory)
 		factory = INTERNAL_GEOMETRY_FACTORY;
 	} 
 	SRID=factory->getSRID();
+	counted=factory->isGeometryCounting();
+	if ( counted ) factory->geometryCreated();
 }
 
 Geometry::Geometry(const Geometry &geom)
 	:
 	SRID(geom.getSRID()),
+	counted(geom.factory->isGeometryCounting()),
 	factory(geom.factory),
 	userData(NULL)
 {
+	if ( counted ) factory->geometryCreated();
 	if ( geom.envelope.get() )
 	{
 		envelope.reset(new Envelope(*(geom.envelope)));
@@ -178,13 +182,8 @@ Geometry::isWithinDistance(const Geometry *geom,double cDistance) const
 	{
 		return false;
 	}
-	// NOTE: this could be implemented more efficiently
-	double geomDist=distance(geom);
-	if (geomDist>cDistance)
-	{
-		return false;
-	}
-	return true;
+	// stops searching at the first facets within the distance
+	return DistanceOp::isWithinDistance(*this, *geom, cDistance);
 }
 
 /*public*/
@@ -767,6 +766,7 @@ Geometry::getLength() const
 Geometry::~Geometry()
 {
 	//delete envelope;
+	if ( counted ) factory->geometryDestroyed();
 }
 
 bool
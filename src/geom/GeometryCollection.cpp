@@ -161,6 +161,19 @@ GeometryCollection::getNumPoints() const
 	return numPoints;
 }
 
+std::size_t
+GeometryCollection::getMemoryUsage() const
+{
+	std::size_t bytes = sizeof(GeometryCollection) + getEnvelopeMemoryUsage()
+	                    + sizeof(std::vector<Geometry *>)
+	                    + geometries->capacity() * sizeof(Geometry *);
+	for (size_t i=0, n=geometries->size(); i<n; ++i)
+	{
+		bytes += (*geometries)[i]->getMemoryUsage();
+	}
+	return bytes;
+}
+
 string
 GeometryCollection::getGeometryType() const
 {
@@ -39,6 +39,10 @@
 #include <typeinfo>
 #include <cmath>
 
+#if defined(_MSC_VER)
+# include <windows.h> // for InterlockedExchangeAdd, InterlockedExchange
+#endif
+
 #ifndef GEOS_DEBUG
 #define GEOS_DEBUG 0
 #endif
@@ -56,6 +60,64 @@ using namespace std;
 namespace geos {
 namespace geom { // geos::geom
 
+namespace {
+
+/*
+ * Adds n to *counter and returns the new value, atomically
+ * where the compiler lets us do it.
+ */
+size_t
+atomicAdd(size_t* counter, size_t n)
+{
+#if defined(_MSC_VER) && defined(_WIN64)
+	return size_t(InterlockedExchangeAdd64(
+		reinterpret_cast<LONGLONG volatile*>(counter), LONGLONG(n))) + n;
+#elif defined(_MSC_VER)
+	return size_t(InterlockedExchangeAdd(
+		reinterpret_cast<LONG volatile*>(counter), LONG(n))) + n;
+#elif defined(__GNUC__)
+	return __sync_add_and_fetch(counter, n);
+#else
+	return *counter += n;
+#endif
+}
+
+/*
+ * Reads *source without a locked instruction, so that readers do
+ * not contend for the cache line; atomic where the compiler lets us
+ * do it (aligned volatile reads are atomic on the MSVC targets).
+ */
+size_t
+atomicLoad(const size_t* source)
+{
+#if defined(__ATOMIC_ACQUIRE)
+	return __atomic_load_n(source, __ATOMIC_ACQUIRE);
+#else
+	return *static_cast<const volatile size_t*>(source);
+#endif
+}
+
+/*
+ * Sets *target to value atomically, where the compiler lets us do it.
+ */
+void
+atomicSet(size_t* target, size_t value)
+{
+#if defined(_MSC_VER) && defined(_WIN64)
+	InterlockedExchange64(
+		reinterpret_cast<LONGLONG volatile*>(target), LONGLONG(value));
+#elif defined(_MSC_VER)
+	InterlockedExchange(
+		reinterpret_cast<LONG volatile*>(target), LONG(value));
+#elif defined(__GNUC__)
+	__sync_lock_test_and_set(target, value);
+#else
+	*target = value;
+#endif
+}
+
+} // anonymous namespace
+
 //namespace { 
 //	class gfCoordinateOperation: public CoordinateOperation {
 //	using CoordinateOperation::edit;
@@ -72,7 +134,10 @@ GeometryFactory::GeometryFactory()
 	:
 	precisionModel(new PrecisionModel()),
 	SRID(0),
-	coordinateListFactory(CoordinateArraySequenceFactory::instance())
+	coordinateListFactory(CoordinateArraySequenceFactory::instance()),
+	countGeometries(0),
+	geometriesCreated(0),
+	geometriesDestroyed(0)
 {
 #if GEOS_DEBUG
 	std::cerr << "GEOS_DEBUG: GeometryFactory["<<this<<"]::GeometryFactory()" << std::endl;
@@ -84,7 +149,10 @@ GeometryFactory::GeometryFactory()
 GeometryFactory::GeometryFactory(const PrecisionModel* pm, int newSRID,
 		CoordinateSequenceFactory* nCoordinateSequenceFactory)
 	:
-	SRID(newSRID)
+	SRID(newSRID),
+	countGeometries(0),
+	geometriesCreated(0),
+	geometriesDestroyed(0)
 {
 #if GEOS_DEBUG
 	std::cerr << "GEOS_DEBUG: GeometryFactory["<<this<<"]::GeometryFactory(PrecisionModel["<<pm<<"], SRID)" << std::endl;
@@ -107,7 +175,10 @@ GeometryFactory::GeometryFactory(
 		CoordinateSequenceFactory* nCoordinateSequenceFactory)
 	:
 	precisionModel(new PrecisionModel()),
-	SRID(0)
+	SRID(0),
+	countGeometries(0),
+	geometriesCreated(0),
+	geometriesDestroyed(0)
 {
 #if GEOS_DEBUG
 	std::cerr << "GEOS_DEBUG: GeometryFactory["<<this<<"]::GeometryFactory(CoordinateSequenceFactory["<<nCoordinateSequenceFactory<<"])" << std::endl;
@@ -123,7 +194,10 @@ GeometryFactory::GeometryFactory(
 GeometryFactory::GeometryFactory(const PrecisionModel *pm)
 	:
 	SRID(0),
-	coordinateListFactory(CoordinateArraySequenceFactory::instance())
+	coordinateListFactory(CoordinateArraySequenceFactory::instance()),
+	countGeometries(0),
+	geometriesCreated(0),
+	geometriesDestroyed(0)
 {
 #if GEOS_DEBUG
 	std::cerr << "GEOS_DEBUG: GeometryFactory["<<this<<"]::GeometryFactory(PrecisionModel["<<pm<<"])" << std::endl;
@@ -139,7 +213,10 @@ GeometryFactory::GeometryFactory(const PrecisionModel *pm)
 GeometryFactory::GeometryFactory(const PrecisionModel* pm, int newSRID)
 	:
 	SRID(newSRID),
-	coordinateListFactory(CoordinateArraySequenceFactory::instance())
+	coordinateListFactory(CoordinateArraySequenceFactory::instance()),
+	countGeometries(0),
+	geometriesCreated(0),
+	geometriesDestroyed(0)
 {
 #if GEOS_DEBUG
 	std::cerr << "GEOS_DEBUG: GeometryFactory["<<this<<"]::GeometryFactory(PrecisionModel["<<pm<<"], SRID)" << std::endl;
@@ -153,6 +230,10 @@ GeometryFactory::GeometryFactory(const PrecisionModel* pm, int newSRID)
 
 /*public*/
 GeometryFactory::GeometryFactory(const GeometryFactory &gf)
+	:
+	countGeometries(0),
+	geometriesCreated(0),
+	geometriesDestroyed(0)
 {
 	assert(gf.precisionModel);
 	precisionModel=new PrecisionModel(*(gf.precisionModel));
@@ -712,6 +793,49 @@ GeometryFactory::destroyGeometry(Geometry *g) const
 	delete g;
 }
 
+/*public*/
+void
+GeometryFactory::setGeometryCounting(bool enable) const
+{
+	atomicSet(&countGeometries, enable ? 1 : 0);
+}
+
+/*public*/
+bool
+GeometryFactory::isGeometryCounting() const
+{
+	return atomicLoad(&countGeometries) != 0;
+}
+
+/*public*/
+size_t
+GeometryFactory::getNumGeometriesCreated() const
+{
+	return atomicLoad(&geometriesCreated);
+}
+
+/*public*/
+size_t
+GeometryFactory::getNumGeometriesLive() const
+{
+	size_t destroyed = atomicLoad(&geometriesDestroyed);
+	return atomicLoad(&geometriesCreated) - destroyed;
+}
+
+/*private*/
+void
+GeometryFactory::geometryCreated() const
+{
+	atomicAdd(&geometriesCreated, 1);
+}
+
+/*private*/
+void
+GeometryFactory::geometryDestroyed() const
+{
+	atomicAdd(&geometriesDestroyed, 1);
+}
+
 /*public static*/
 const GeometryFactory*
 GeometryFactory::getDefaultInstance() 
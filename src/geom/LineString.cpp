@@ -164,6 +164,13 @@ LineString::getNumPoints() const
 	return points->getSize();
 }
 
+std::size_t
+LineString::getMemoryUsage() const
+{
+	return sizeof(LineString) + getEnvelopeMemoryUsage()
+	       + points->getMemoryUsage();
+}
+
 Point*
 LineString::getPointN(size_t n) const
 {
@@ -198,7 +205,11 @@ LineString::isClosed() const
 	if (isEmpty()) {
 		return false;
 	}
-	return getCoordinateN(0).equals2D(getCoordinateN(getNumPoints()-1));
+	// read by copy, not to build a Coordinate copy of flat sequences
+	Coordinate first, last;
+	points->getAt(0, first);
+	points->getAt(points->getSize()-1, last);
+	return first.equals2D(last);
 }
 
 bool
@@ -258,24 +269,13 @@ LineString::computeEnvelopeInternal() const
 	}
 
 	assert(points.get());
-	const Coordinate& c=points->getAt(0);
-	double minx = c.x;
-	double miny = c.y;
-	double maxx = c.x;
-	double maxy = c.y;
-	int npts=points->getSize();
-	for (int i=1; i<npts; i++) {
-		const Coordinate &c=points->getAt(i);
-		minx = minx < c.x ? minx : c.x;
-		maxx = maxx > c.x ? maxx : c.x;
-		miny = miny < c.y ? miny : c.y;
-		maxy = maxy > c.y ? maxy : c.y;
-	}
 
 	// caller expects a newly allocated Envelope.
 	// this function won't be called twice, unless
 	// cached Envelope is invalidated (set to NULL)
-	return Envelope::AutoPtr(new Envelope(minx, maxx, miny, maxy));
+	Envelope::AutoPtr env(new Envelope());
+	points->expandEnvelope(*env);
+	return env;
 }
 
 bool
@@ -97,6 +97,13 @@ LinearRing::isSimple() const
 	return true;
 }
 
+std::size_t
+LinearRing::getMemoryUsage() const
+{
+	return LineString::getMemoryUsage() - sizeof(LineString)
+	       + sizeof(LinearRing);
+}
+
 bool
 LinearRing::isClosed() const
 {
@@ -51,6 +51,13 @@ MultiLineString::MultiLineString(vector<Geometry *> *newLines,
 
 MultiLineString::~MultiLineString(){}
 
+std::size_t
+MultiLineString::getMemoryUsage() const
+{
+	return GeometryCollection::getMemoryUsage() - sizeof(GeometryCollection)
+	       + sizeof(MultiLineString);
+}
+
 Dimension::DimensionType
 MultiLineString::getDimension() const {
 	return Dimension::L; // line
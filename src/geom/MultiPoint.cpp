@@ -42,6 +42,13 @@ MultiPoint::MultiPoint(vector<Geometry *> *newPoints, const GeometryFactory *fac
 
 MultiPoint::~MultiPoint(){}
 
+std::size_t
+MultiPoint::getMemoryUsage() const
+{
+	return GeometryCollection::getMemoryUsage() - sizeof(GeometryCollection)
+	       + sizeof(MultiPoint);
+}
+
 Dimension::DimensionType
 MultiPoint::getDimension() const {
 	return Dimension::P; // point
@@ -46,6 +46,13 @@ MultiPolygon::MultiPolygon(vector<Geometry *> *newPolys, const GeometryFactory *
 
 MultiPolygon::~MultiPolygon(){}
 
+std::size_t
+MultiPolygon::getMemoryUsage() const
+{
+	return GeometryCollection::getMemoryUsage() - sizeof(GeometryCollection)
+	       + sizeof(MultiPolygon);
+}
+
 Dimension::DimensionType
 MultiPolygon::getDimension() const {
 	return Dimension::A; // area
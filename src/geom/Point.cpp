@@ -78,6 +78,13 @@ Point::getNumPoints() const
 	return isEmpty() ? 0 : 1;
 }
 
+std::size_t
+Point::getMemoryUsage() const
+{
+	return sizeof(Point) + getEnvelopeMemoryUsage()
+	       + coordinates->getMemoryUsage();
+}
+
 bool
 Point::isEmpty() const
 {
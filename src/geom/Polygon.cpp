@@ -140,6 +140,20 @@ Polygon::getNumPoints() const
 	return numPoints;
 }
 
+std::size_t
+Polygon::getMemoryUsage() const
+{
+	std::size_t bytes = sizeof(Polygon) + getEnvelopeMemoryUsage()
+	                    + shell->getMemoryUsage()
+	                    + sizeof(std::vector<Geometry *>)
+	                    + holes->capacity() * sizeof(Geometry *);
+	for(size_t i=0, n=holes->size(); i<n; ++i)
+	{
+		bytes += (*holes)[i]->getMemoryUsage();
+	}
+	return bytes;
+}
+
 Dimension::DimensionType
 Polygon::getDimension() const
 {
@@ -21,11 +21,28 @@
 #include <geos/geom/Coordinate.h> 
 #include <geos/algorithm/PointLocator.h> 
 #include <geos/geom/util/ComponentCoordinateExtracter.h> 
+#include <geos/geom/Geometry.h>
+#include <geos/geom/Envelope.h>
+#include <geos/geom/Dimension.h>
+#include <geos/geom/GeometryComponentFilter.h>
+#include <geos/operation/distance/IndexedFacetDistance.h>
 
 namespace geos {
 namespace geom { // geos.geom
 namespace prep { // geos.geom.prep
 
+namespace {
+
+/// Computes the cached envelope of each component
+class EnvelopeComputer : public geom::GeometryComponentFilter
+{
+public:
+	void filter_ro(const geom::Geometry* g) { g->getEnvelopeInternal(); }
+	void filter_rw(geom::Geometry* g) { g->getEnvelopeInternal(); }
+};
+
+} // anonymous namespace
+
 /*            *
  * protected: *
  *            */
@@ -145,6 +162,59 @@ BasicPreparedGeometry::within(const geom::Geometry * g) const
 	return baseGeom->within(g);
 }
 
+/*private*/
+operation::distance::IndexedFacetDistance&
+BasicPreparedGeometry::getFacetDistance() const
+{
+	if ( ! facetDistance.get() )
+	{
+		facetDistance.reset(
+			new operation::distance::IndexedFacetDistance(*baseGeom));
+	}
+	return *facetDistance;
+}
+
+/*private*/
+bool
+BasicPreparedGeometry::hasAreaWith(const geom::Geometry * g) const
+{
+	return baseGeom->getDimension() == Dimension::A ||
+	       g->getDimension() == Dimension::A;
+}
+
+double
+BasicPreparedGeometry::distance(const geom::Geometry * g) const
+{
+	// as DistanceOp
+	if ( baseGeom->isEmpty() || g->isEmpty() ) return 0.0;
+
+	// facets of an area are apart from what lies inside it
+	if ( hasAreaWith(g) && intersects(g) ) return 0.0;
+
+	return getFacetDistance().getDistance(*g);
+}
+
+bool
+BasicPreparedGeometry::isWithinDistance(const geom::Geometry * g,
+                                        double dist) const
+{
+	if ( baseGeom->isEmpty() || g->isEmpty() ) return 0.0 <= dist;
+
+	if ( baseGeom->getEnvelopeInternal()->distance(
+	         g->getEnvelopeInternal()) > dist ) return false;
+
+	if ( hasAreaWith(g) && intersects(g) ) return true;
+
+	return getFacetDistance().isWithinDistance(*g, dist);
+}
+
+void
+BasicPreparedGeometry::buildIndexes() const
+{
+	EnvelopeComputer computer;
+	baseGeom->apply_ro(&computer);
+}
+
 std::string 
 BasicPreparedGeometry::toString()
 {
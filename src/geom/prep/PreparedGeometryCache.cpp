@@ -0,0 +1,233 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/geom/prep/PreparedGeometryCache.h>
+#include <geos/geom/prep/PreparedGeometry.h>
+#include <geos/geom/prep/PreparedGeometryFactory.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/Polygon.h>
+#include <geos/geom/LineString.h>
+#include <geos/geom/Point.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/Envelope.h>
+
+#include <cstring> // std::memcpy
+#include <cassert>
+
+using namespace std;
+
+namespace geos {
+namespace geom { // geos.geom
+namespace prep { // geos.geom.prep
+
+namespace {
+
+/// Coordinates sampled from each sequence
+const size_t SAMPLES_PER_SEQUENCE = 8;
+
+/// Sequences sampled from each geometry
+const size_t MAX_SEQUENCES = 64;
+
+inline void
+combine(size_t& h, size_t v)
+{
+	h ^= v + 0x9e3779b9 + (h << 6) + (h >> 2);
+}
+
+inline void
+combine(size_t& h, double d)
+{
+	// Hash the bits, in 32-bit words to suit any size_t
+	unsigned int w[sizeof(double) / sizeof(unsigned int)];
+	memcpy(w, &d, sizeof(double));
+	for (size_t i=0; i<sizeof(w)/sizeof(w[0]); ++i) combine(h, size_t(w[i]));
+}
+
+void
+hashSequence(const CoordinateSequence& seq, size_t& h, size_t& budget)
+{
+	if ( ! budget ) return;
+	--budget;
+
+	size_t n = seq.getSize();
+	combine(h, n);
+	if ( ! n ) return;
+
+	// Evenly spaced samples, including both ends
+	size_t samples = n < SAMPLES_PER_SEQUENCE ? n : SAMPLES_PER_SEQUENCE;
+	for (size_t s=0; s<samples; ++s)
+	{
+		size_t i = samples > 1 ? s * (n-1) / (samples-1) : 0;
+		combine(h, seq.getX(i));
+		combine(h, seq.getY(i));
+	}
+}
+
+void
+hashComponents(const Geometry& g, size_t& h, size_t& budget)
+{
+	// Geometry is a virtual base of the concrete types
+	if ( const LineString* ls = dynamic_cast<const LineString*>(&g) )
+	{
+		hashSequence(*ls->getCoordinatesRO(), h, budget);
+	}
+	else if ( const Point* p = dynamic_cast<const Point*>(&g) )
+	{
+		hashSequence(*p->getCoordinatesRO(), h, budget);
+	}
+	else if ( const Polygon* p = dynamic_cast<const Polygon*>(&g) )
+	{
+		hashComponents(*p->getExteriorRing(), h, budget);
+		for (size_t i=0, n=p->getNumInteriorRing(); i<n && budget; ++i)
+			hashComponents(*p->getInteriorRingN(i), h, budget);
+	}
+	else
+	{
+		for (size_t i=0, n=g.getNumGeometries(); i<n && budget; ++i)
+			hashComponents(*g.getGeometryN(i), h, budget);
+	}
+}
+
+} // anonymous namespace
+
+const size_t PreparedGeometryCache::DEFAULT_CAPACITY;
+
+/*public*/
+PreparedGeometryCache::PreparedGeometryCache(size_t cap)
+	:
+	capacity(cap ? cap : 1),
+	hits(0),
+	misses(0)
+{
+}
+
+/*public*/
+PreparedGeometryCache::~PreparedGeometryCache()
+{
+	clear();
+}
+
+/*public static*/
+size_t
+PreparedGeometryCache::contentHash(const Geometry& g)
+{
+	size_t h = 0;
+	combine(h, size_t(g.getGeometryTypeId()));
+	combine(h, g.getNumPoints());
+
+	const Envelope* env = g.getEnvelopeInternal();
+	if ( ! env->isNull() )
+	{
+		combine(h, env->getMinX());
+		combine(h, env->getMinY());
+		combine(h, env->getMaxX());
+		combine(h, env->getMaxY());
+	}
+
+	size_t budget = MAX_SEQUENCES;
+	hashComponents(g, h, budget);
+	return h;
+}
+
+/*public*/
+const PreparedGeometry&
+PreparedGeometryCache::get(const Geometry& g)
+{
+	size_t hash = contentHash(g);
+
+	EntryIndex::iterator i = index.lower_bound(&g);
+	if ( i != index.end() && i->first == &g )
+	{
+		EntryList::iterator e = i->second;
+		if ( e->hash == hash && g.equalsExact(e->base) )
+		{
+			++hits;
+			entries.splice(entries.begin(), entries, e);
+			return *(e->prepared);
+		}
+
+		// Another geometry at the same address, or
+		// this one changed since it was prepared
+		EntryIndex::iterator next = i; ++next;
+		erase(i);
+		i = next;
+	}
+
+	++misses;
+	Entry entry;
+	entry.geom = &g;
+	entry.hash = hash;
+	entry.base = g.clone();
+	try
+	{
+		entry.prepared = PreparedGeometryFactory::prepare(entry.base);
+	}
+	catch (...)
+	{
+		delete entry.base;
+		throw;
+	}
+	entries.push_front(entry);
+	index.insert(i, EntryIndex::value_type(&g, entries.begin()));
+
+	shrink(capacity);
+	return *(entry.prepared);
+}
+
+/*public*/
+void
+PreparedGeometryCache::remove(const Geometry* g)
+{
+	EntryIndex::iterator i = index.find(g);
+	if ( i != index.end() ) erase(i);
+}
+
+/*public*/
+void
+PreparedGeometryCache::clear()
+{
+	shrink(0);
+}
+
+/*public*/
+void
+PreparedGeometryCache::setCapacity(size_t cap)
+{
+	capacity = cap ? cap : 1;
+	shrink(capacity);
+}
+
+/*private*/
+void
+PreparedGeometryCache::erase(EntryIndex::iterator i)
+{
+	EntryList::iterator e = i->second;
+	PreparedGeometryFactory::destroy(e->prepared);
+	delete e->base;
+	entries.erase(e);
+	index.erase(i);
+}
+
+/*private*/
+void
+PreparedGeometryCache::shrink(size_t n)
+{
+	while ( index.size() > n )
+	{
+		erase(index.find(entries.back().geom));
+	}
+	assert(entries.size() == index.size());
+}
+
+} // namespace geos.geom.prep
+} // namespace geos.geom
+} // namespace geos
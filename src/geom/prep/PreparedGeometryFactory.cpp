@@ -36,6 +36,8 @@ namespace geos {
 namespace geom { // geos.geom
 namespace prep { // geos.geom.prep
 
+const std::size_t PreparedGeometryFactory::DEFAULT_INDEX_THRESHOLD;
+
 const PreparedGeometry *
 PreparedGeometryFactory::create( const geom::Geometry * g) const
 {
@@ -63,8 +65,12 @@ PreparedGeometryFactory::create( const geom::Geometry * g) const
 
 		case GEOS_POLYGON:
 		case GEOS_MULTIPOLYGON:
-			pg = new PreparedPolygon( g);
+		{
+			PreparedPolygon* ppoly = new PreparedPolygon( g);
+			ppoly->setIndexThreshold( indexThreshold);
+			pg = ppoly;
 			break;
+		}
 
 		default:
 			pg = new BasicPreparedGeometry( g);
@@ -0,0 +1,91 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/geom/prep/PreparedJoinFilter.h>
+#include <geos/geom/prep/PreparedGeometry.h>
+#include <geos/geom/prep/PreparedGeometryFactory.h>
+#include <geos/geom/Geometry.h>
+
+#include <cassert>
+
+namespace geos {
+namespace geom { // geos.geom
+namespace prep { // geos.geom.prep
+
+/*public*/
+PreparedJoinFilter::PreparedJoinFilter(Predicate p,
+                                       index::ItemPairVisitor& v)
+	:
+	predicate(p),
+	visitor(v)
+{
+}
+
+/*public*/
+PreparedJoinFilter::~PreparedJoinFilter()
+{
+	for (PreparedMap::iterator i=prepared.begin(), e=prepared.end();
+			i!=e; ++i)
+	{
+		PreparedGeometryFactory::destroy(i->second);
+	}
+}
+
+/*public*/
+void
+PreparedJoinFilter::visitItemPair(void *item, void *otherItem)
+{
+	const Geometry* g = static_cast<const Geometry*>(item);
+	const Geometry* other = static_cast<const Geometry*>(otherItem);
+
+	if ( evaluate(getPrepared(g), other) )
+	{
+		visitor.visitItemPair(item, otherItem);
+	}
+}
+
+/*private*/
+const PreparedGeometry&
+PreparedJoinFilter::getPrepared(const Geometry* g)
+{
+	PreparedMap::iterator i = prepared.lower_bound(g);
+	if ( i != prepared.end() && i->first == g ) return *(i->second);
+
+	const PreparedGeometry* pg = PreparedGeometryFactory::prepare(g);
+	prepared.insert(i, PreparedMap::value_type(g, pg));
+	return *pg;
+}
+
+/*private*/
+bool
+PreparedJoinFilter::evaluate(const PreparedGeometry& pg,
+                             const Geometry* g) const
+{
+	switch (predicate)
+	{
+		case INTERSECTS: return pg.intersects(g);
+		case CONTAINS: return pg.contains(g);
+		case CONTAINS_PROPERLY: return pg.containsProperly(g);
+		case COVERS: return pg.covers(g);
+		case COVERED_BY: return pg.coveredBy(g);
+		case CROSSES: return pg.crosses(g);
+		case OVERLAPS: return pg.overlaps(g);
+		case TOUCHES: return pg.touches(g);
+		case WITHIN: return pg.within(g);
+	}
+	assert(0); // unsupported predicate
+	return false;
+}
+
+} // namespace geos.geom.prep
+} // namespace geos.geom
+} // namespace geos
@@ -65,6 +65,13 @@ PreparedLineString::intersects(const geom::Geometry * g) const
     return PreparedLineStringIntersects::intersects(prep, g);
 }
 
+void
+PreparedLineString::buildIndexes() const
+{
+	BasicPreparedGeometry::buildIndexes();
+	const_cast<PreparedLineString*>(this)->getIntersectionFinder();
+}
+
 } // namespace geos.geom.prep
 } // namespace geos.geom
 } // namespace geos
@@ -29,6 +29,10 @@
 #include <geos/operation/predicate/RectangleIntersects.h>
 #include <geos/algorithm/locate/PointOnGeometryLocator.h>
 #include <geos/algorithm/locate/IndexedPointInAreaLocator.h>
+#include <geos/algorithm/RayCrossingCounter.h>
+#include <geos/geom/Location.h>
+#include <geos/geom/LineString.h>
+#include <geos/geom/CoordinateSequence.h>
 // std
 #include <cstddef>
 
@@ -39,7 +43,8 @@ namespace prep { // geos.geom.prep
 // public:
 //
 PreparedPolygon::PreparedPolygon(const geom::Geometry * geom) 
-    : BasicPreparedGeometry(geom), segIntFinder(0), ptOnGeomLoc(0)
+    : BasicPreparedGeometry(geom), segIntFinder(0), ptOnGeomLoc(0),
+      indexThreshold(0), numUnindexedPoints(0)
 {
 	isRectangle = getGeometry().isRectangle();
 }
@@ -95,6 +100,9 @@ contains( const geom::Geometry * g) const
         return operation::predicate::RectangleContains::contains(poly, *g);
     }
 
+	if ( useUnindexed(g) )
+		return evalUnindexed(g, CONTAINS);
+
 	return PreparedPolygonContains::contains(this, g);
 }
 
@@ -106,6 +114,9 @@ containsProperly( const geom::Geometry* g) const
     if ( !envelopeCovers( g) ) 
 		return false;
 
+	if ( useUnindexed(g) )
+		return evalUnindexed(g, CONTAINS_PROPERLY);
+
 	return PreparedPolygonContainsProperly::containsProperly( this, g);
 }
 
@@ -121,6 +132,9 @@ covers( const geom::Geometry* g) const
     if ( isRectangle) 
 		return true;
 
+	if ( useUnindexed(g) )
+		return evalUnindexed(g, COVERS);
+
 	return PreparedPolygonCovers::covers( this, g);
 }
 
@@ -141,9 +155,101 @@ intersects( const geom::Geometry* g) const
         return operation::predicate::RectangleIntersects::intersects(poly, *g);
     }
     
+	if ( useUnindexed(g) )
+		return evalUnindexed(g, INTERSECTS);
+
 	return PreparedPolygonIntersects::intersects( this, g);
 }
 
+void
+PreparedPolygon::
+buildIndexes() const
+{
+	BasicPreparedGeometry::buildIndexes();
+	getIntersectionFinder();
+	getPointLocator();
+}
+
+//
+// private:
+//
+bool
+PreparedPolygon::
+useUnindexed( const geom::Geometry* g) const
+{
+	// Only worth it for points, until the indexes pay off
+	if ( isIndexed() || g->getDimension() != 0 || g->isEmpty() )
+		return false;
+
+	numUnindexedPoints += g->getNumPoints();
+	return numUnindexedPoints <= indexThreshold;
+}
+
+int
+PreparedPolygon::
+locateUnindexed( const geom::Coordinate& p) const
+{
+	// Same as IndexedPointInAreaLocator, counting all segments
+	algorithm::RayCrossingCounter rcc(p);
+
+	const geom::Geometry& geom = getGeometry();
+	for ( std::size_t i = 0, ni = geom.getNumGeometries(); i < ni; i++ )
+	{
+		const geom::Polygon* poly =
+			dynamic_cast<const geom::Polygon*>( geom.getGeometryN( i));
+		if ( ! poly ) continue;
+
+		for ( std::size_t r = 0, nr = poly->getNumInteriorRing(); r <= nr; r++ )
+		{
+			const geom::LineString* ring = r ? poly->getInteriorRingN( r-1)
+			                                 : poly->getExteriorRing();
+			const geom::CoordinateSequence* pts = ring->getCoordinatesRO();
+			for ( std::size_t j = 1, nj = pts->getSize(); j < nj; j++ )
+			{
+				rcc.countSegment( pts->getAt( j-1), pts->getAt( j));
+				if ( rcc.isOnSegment() )
+					return rcc.getLocation();
+			}
+		}
+	}
+	return rcc.getLocation();
+}
+
+bool
+PreparedPolygon::
+evalUnindexed( const geom::Geometry* g, PointPredicate pred) const
+{
+	bool anyInterior = false;
+	for ( std::size_t i = 0, ni = g->getNumGeometries(); i < ni; i++ )
+	{
+		const geom::Coordinate* p = g->getGeometryN( i)->getCoordinate();
+		if ( ! p ) continue; // empty point
+
+		int loc = locateUnindexed( *p);
+		if ( loc == geom::Location::INTERIOR )
+		{
+			if ( pred == INTERSECTS ) return true;
+			anyInterior = true;
+		}
+		else if ( loc == geom::Location::BOUNDARY )
+		{
+			if ( pred == INTERSECTS ) return true;
+			if ( pred == CONTAINS_PROPERLY ) return false;
+		}
+		else if ( pred != INTERSECTS )
+		{
+			return false;
+		}
+	}
+
+	switch ( pred )
+	{
+		case INTERSECTS: return false;
+		case CONTAINS: return anyInterior;
+		default: return true;
+	}
+}
+
 } // namespace geos.geom.prep
 } // namespace geos.geom
 } // namespace geos
@@ -29,7 +29,9 @@
 #include <geos/geomgraph/Label.h>
 #include <geos/geomgraph/Position.h>
 
-#include <geos/geomgraph/index/SimpleMCSweepLineIntersector.h> 
+#include <geos/geomgraph/index/RadixMCSweepLineIntersector.h>
+#include <geos/geomgraph/index/MCIndexEdgeSetIntersector.h>
+#include <geos/geomgraph/index/MonotoneChainEdge.h>
 #include <geos/geomgraph/index/SegmentIntersector.h> 
 #include <geos/geomgraph/index/EdgeSetIntersector.h>
 
@@ -68,6 +70,41 @@ using namespace geos::geom;
 namespace geos {
 namespace geomgraph { // geos.geomgraph
 
+namespace {
+
+// Fewer chains are quickly swept anyway
+const size_t MIN_INDEXED_CHAINS = 64;
+
+// Average number of chains overlapping each chain in x above which
+// the chains are indexed rather than swept
+const double MAX_SWEPT_OVERLAPS = 16.0;
+
+/*
+ * Accumulates the number of monotone chains of the edges, the sum of
+ * their widths and the x-range they span.
+ */
+void
+addChainExtents(const vector<Edge*>& edges, size_t& nChains,
+	double& widthSum, Envelope& extent)
+{
+	for (size_t i=0, n=edges.size(); i<n; ++i)
+	{
+		MonotoneChainEdge* mce = edges[i]->getMonotoneChainEdge();
+		size_t nc = mce->getStartIndexes().size() - 1;
+		for (size_t j=0; j<nc; ++j)
+		{
+			double minX = mce->getMinX(static_cast<int>(j));
+			double maxX = mce->getMaxX(static_cast<int>(j));
+			widthSum += maxX - minX;
+			extent.expandToInclude(minX, 0.0);
+			extent.expandToInclude(maxX, 0.0);
+		}
+		nChains += nc;
+	}
+}
+
+} // anonymous namespace
+
 /*
  * This method implements the Boundary Determination Rule
  * for determining whether
@@ -94,8 +131,10 @@ GeometryGraph::determineBoundary(int boundaryCount)
 }
 
 
+/*private static*/
 EdgeSetIntersector*
-GeometryGraph::createEdgeSetIntersector()
+GeometryGraph::createEdgeSetIntersector(const vector<Edge*>& edges0,
+	const vector<Edge*>* edges1)
 {
 	// various options for computing intersections, from slowest to fastest
 
@@ -106,7 +145,25 @@ GeometryGraph::createEdgeSetIntersector()
 	//private EdgeSetIntersector esi = new MCSweepLineIntersector();
 
 	//return new SimpleEdgeSetIntersector();
-	return new SimpleMCSweepLineIntersector();
+	//return new SimpleMCSweepLineIntersector();
+
+	size_t nChains = 0;
+	double widthSum = 0.0;
+	Envelope extent;
+	addChainExtents(edges0, nChains, widthSum, extent);
+	if ( edges1 ) addChainExtents(*edges1, nChains, widthSum, extent);
+
+	// Two chains of average width w, scattered over the x-range W,
+	// overlap with probability about 2w/W
+	if ( nChains >= MIN_INDEXED_CHAINS && extent.getWidth() > 0.0 )
+	{
+		double overlaps = 2.0 * widthSum / extent.getWidth();
+		if ( overlaps > MAX_SWEPT_OVERLAPS )
+			return new MCIndexEdgeSetIntersector();
+	}
+
+	// same overlaps as SimpleMCSweepLineIntersector, radix sorted
+	return new RadixMCSweepLineIntersector();
 }
 
 /*public*/
@@ -348,7 +405,7 @@ SegmentIntersector*
 GeometryGraph::computeSelfNodes(LineIntersector *li, bool computeRingSelfNodes)
 {
 	SegmentIntersector *si=new SegmentIntersector(li,true,false);
-    	auto_ptr<EdgeSetIntersector> esi(createEdgeSetIntersector());
+    	auto_ptr<EdgeSetIntersector> esi(createEdgeSetIntersector(*edges));
 
 	// optimized test for Polygons and Rings
 	if (! computeRingSelfNodes
@@ -381,7 +438,8 @@ GeometryGraph::computeEdgeIntersections(GeometryGraph *g,
 	SegmentIntersector *si=new SegmentIntersector(li, includeProper, true);
 
 	si->setBoundaryNodes(getBoundaryNodes(), g->getBoundaryNodes());
-	auto_ptr<EdgeSetIntersector> esi(createEdgeSetIntersector());
+	auto_ptr<EdgeSetIntersector> esi(
+		createEdgeSetIntersector(*edges, g->edges));
 	esi->computeIntersections(edges, g->edges, si);
 #if GEOS_DEBUG
 	cerr<<"GeometryGraph::computeEdgeIntersections returns"<<endl;
@@ -0,0 +1,164 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/geomgraph/GraphArena.h>
+
+#include <new> // std::bad_alloc
+#include <cstdlib> // std::malloc, std::free
+#include <cstddef>
+
+#if defined(_MSC_VER)
+# define GEOS_THREAD_LOCAL __declspec(thread)
+#elif defined(__GNUC__)
+# define GEOS_THREAD_LOCAL __thread
+#endif
+
+using namespace std;
+
+namespace geos {
+namespace geomgraph { // geos.geomgraph
+
+namespace {
+
+/// Alignment of all blocks returned, enough for any type
+const size_t ALIGNMENT = 16;
+
+/// Size of the memory blocks requested to the heap
+const size_t BLOCK_SIZE = 64*1024;
+
+/// Room reserved in front of each component for its owner
+const size_t HEADER_SIZE = ALIGNMENT;
+
+inline size_t
+alignSize(size_t size)
+{
+	return (size + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+}
+
+#ifdef GEOS_THREAD_LOCAL
+GEOS_THREAD_LOCAL GraphArena* currentArena = 0;
+#endif
+
+} // anonymous namespace
+
+/*public*/
+GraphArena::GraphArena()
+	:
+	top(0),
+	end(0),
+	numBytes(0)
+{
+}
+
+/*public*/
+GraphArena::~GraphArena()
+{
+	for (size_t i=0, n=blocks.size(); i<n; ++i) free(blocks[i]);
+}
+
+/*public*/
+void*
+GraphArena::allocate(size_t size)
+{
+	size = alignSize(size ? size : 1);
+
+	if ( static_cast<size_t>(end - top) < size )
+	{
+		// Large requests get a block of their own, leaving
+		// the free space of the current one for later use
+		if ( size > BLOCK_SIZE / 4 )
+		{
+			char* block = static_cast<char*>(malloc(size));
+			if ( ! block ) throw std::bad_alloc();
+			blocks.push_back(block);
+			numBytes += size;
+			return block;
+		}
+
+		char* block = static_cast<char*>(malloc(BLOCK_SIZE));
+		if ( ! block ) throw std::bad_alloc();
+		blocks.push_back(block);
+		top = block;
+		end = block + BLOCK_SIZE;
+	}
+
+	void* ret = top;
+	top += size;
+	numBytes += size;
+	return ret;
+}
+
+/*public*/
+GraphArena::Scope::Scope(GraphArena& arena)
+	:
+	previous(getCurrent())
+{
+#ifdef GEOS_THREAD_LOCAL
+	currentArena = &arena;
+#else
+	// Without thread-local storage components always
+	// come from the heap
+	(void)arena;
+#endif
+}
+
+/*public*/
+GraphArena::Scope::~Scope()
+{
+#ifdef GEOS_THREAD_LOCAL
+	currentArena = previous;
+#endif
+}
+
+/*public static*/
+GraphArena*
+GraphArena::getCurrent()
+{
+#ifdef GEOS_THREAD_LOCAL
+	return currentArena;
+#else
+	return 0;
+#endif
+}
+
+/*public static*/
+void*
+GraphArena::allocateComponent(size_t size)
+{
+	// The header tells deallocateComponent whether the
+	// memory is owned by an arena or must be freed
+	GraphArena* arena = getCurrent();
+	char* mem;
+	if ( arena )
+	{
+		mem = static_cast<char*>(arena->allocate(HEADER_SIZE + size));
+	}
+	else
+	{
+		mem = static_cast<char*>(malloc(HEADER_SIZE + size));
+		if ( ! mem ) throw std::bad_alloc();
+	}
+	*reinterpret_cast<GraphArena**>(mem) = arena;
+	return mem + HEADER_SIZE;
+}
+
+/*public static*/
+void
+GraphArena::deallocateComponent(void* ptr)
+{
+	if ( ! ptr ) return;
+	char* mem = static_cast<char*>(ptr) - HEADER_SIZE;
+	if ( ! *reinterpret_cast<GraphArena**>(mem) ) free(mem);
+}
+
+} // namespace geos.geomgraph
+} // namespace geos
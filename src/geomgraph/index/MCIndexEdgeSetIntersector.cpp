@@ -0,0 +1,160 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/geomgraph/index/MCIndexEdgeSetIntersector.h>
+#include <geos/geomgraph/index/MonotoneChainEdge.h>
+#include <geos/geomgraph/Edge.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/Envelope.h>
+#include <geos/index/strtree/PackedSTRtree.h>
+
+#include <vector>
+
+using namespace std;
+
+namespace geos {
+namespace geomgraph { // geos.geomgraph
+namespace index { // geos.geomgraph.index
+
+/*public*/
+MCIndexEdgeSetIntersector::MCIndexEdgeSetIntersector()
+	:
+	nOverlaps(0)
+{
+}
+
+/*public*/
+MCIndexEdgeSetIntersector::~MCIndexEdgeSetIntersector()
+{
+}
+
+/*public*/
+void
+MCIndexEdgeSetIntersector::computeIntersections(vector<Edge*> *edges,
+	SegmentIntersector *si, bool testAllSegments)
+{
+	vector<Chain> chains;
+	if (testAllSegments)
+		addChains(edges, NULL, chains);
+	else
+		addChains(edges, chains);
+
+	// The chains are not moved anymore: index their addresses
+	geos::index::strtree::PackedSTRtree tree;
+	for (size_t i=0, n=chains.size(); i<n; ++i)
+		tree.insert(&chains[i].env, &chains[i]);
+
+	nOverlaps=0;
+	vector<void*> found;
+	for (size_t i=0, n=chains.size(); i<n; ++i)
+	{
+		Chain& c0 = chains[i];
+		found.clear();
+		tree.query(&c0.env, found);
+		for (size_t j=0, nj=found.size(); j<nj; ++j)
+		{
+			Chain& c1 = *static_cast<Chain*>(found[j]);
+
+			// compare each pair once, and a chain with
+			// itself if self-intersections are tested
+			if (&c1 < &c0) continue;
+
+			// don't compare edges in same group
+			// null group indicates that edges should be compared
+			if (c0.edgeSet==NULL || c0.edgeSet!=c1.edgeSet)
+			{
+				c0.mce->computeIntersectsForChain(c0.chainIndex,
+					*c1.mce, c1.chainIndex, *si);
+				nOverlaps++;
+			}
+		}
+	}
+}
+
+/*public*/
+void
+MCIndexEdgeSetIntersector::computeIntersections(vector<Edge*> *edges0,
+	vector<Edge*> *edges1, SegmentIntersector *si)
+{
+	vector<Chain> chains0, chains1;
+	addChains(edges0, edges0, chains0);
+	addChains(edges1, edges1, chains1);
+
+	geos::index::strtree::PackedSTRtree tree;
+	for (size_t i=0, n=chains1.size(); i<n; ++i)
+		tree.insert(&chains1[i].env, &chains1[i]);
+
+	nOverlaps=0;
+	vector<void*> found;
+	for (size_t i=0, n=chains0.size(); i<n; ++i)
+	{
+		Chain& c0 = chains0[i];
+		found.clear();
+		tree.query(&c0.env, found);
+		for (size_t j=0, nj=found.size(); j<nj; ++j)
+		{
+			Chain& c1 = *static_cast<Chain*>(found[j]);
+			c0.mce->computeIntersectsForChain(c0.chainIndex,
+				*c1.mce, c1.chainIndex, *si);
+			nOverlaps++;
+		}
+	}
+}
+
+/*private static*/
+void
+MCIndexEdgeSetIntersector::addChains(vector<Edge*> *edges,
+	vector<Chain>& chains)
+{
+	for (size_t i=0; i<edges->size(); ++i)
+	{
+		Edge *edge=(*edges)[i];
+		// edge is its own group
+		addChains(edge, edge, chains);
+	}
+}
+
+/*private static*/
+void
+MCIndexEdgeSetIntersector::addChains(vector<Edge*> *edges, void* edgeSet,
+	vector<Chain>& chains)
+{
+	for (size_t i=0; i<edges->size(); ++i)
+	{
+		addChains((*edges)[i], edgeSet, chains);
+	}
+}
+
+/*private static*/
+void
+MCIndexEdgeSetIntersector::addChains(Edge* edge, void* edgeSet,
+	vector<Chain>& chains)
+{
+	MonotoneChainEdge *mce=edge->getMonotoneChainEdge();
+	const geom::CoordinateSequence* pts=mce->getCoordinates();
+	vector<int> &startIndex=mce->getStartIndexes();
+	size_t n = startIndex.size()-1;
+	for(size_t i=0; i<n; ++i)
+	{
+		Chain c;
+		c.mce = mce;
+		c.chainIndex = static_cast<int>(i);
+		c.edgeSet = edgeSet;
+		// the end points of a monotone chain bound all of it
+		c.env.init(pts->getAt(startIndex[i]), pts->getAt(startIndex[i+1]));
+		chains.push_back(c);
+	}
+}
+
+} // namespace geos.geomgraph.index
+} // namespace geos.geomgraph
+} // namespace geos
@@ -22,6 +22,7 @@
 #include <geos/geomgraph/index/SegmentIntersector.h>
 #include <geos/geom/Coordinate.h>
 #include <geos/geom/CoordinateSequence.h>
+#include <geos/index/chain/SegmentEnvelopeBlock.h>
 
 using namespace std;
 using namespace geos::geom;
@@ -30,6 +31,29 @@ namespace geos {
 namespace geomgraph { // geos.geomgraph
 namespace index { // geos.geomgraph.index
 
+namespace {
+
+/// Ranges of at most this many segments are matched segment by segment
+const int BLOCK_SEGMENTS = 16;
+
+class IntersectionVisitor {
+public:
+	IntersectionVisitor(Edge* edge0, Edge* edge1, SegmentIntersector& si)
+		: e0(edge0), e1(edge1), ei(si) {}
+
+	void operator()(size_t i, size_t j)
+	{
+		ei.addIntersections(e0, static_cast<int>(i), e1, static_cast<int>(j));
+	}
+
+private:
+	Edge* e0;
+	Edge* e1;
+	SegmentIntersector& ei;
+};
+
+} // anonymous namespace
+
 /**
  * MonotoneChains are a way of partitioning the segments of an edge to
  * allow for fast searching of intersections.
@@ -139,6 +163,21 @@ MonotoneChainEdge::computeIntersectsForChain(int start0, int end0,
 	env2.init(p10,p11);
 
 	if (!env1.intersects(&env2)) return;
+
+	// short ranges: find the overlapping segments all at once,
+	// then test them in the order the bisection below would
+	if (end0-start0 <= BLOCK_SEGMENTS && end1-start1 <= BLOCK_SEGMENTS)
+	{
+		geos::index::chain::SegmentEnvelopeBlock block;
+		block.setSegments(*mce.pts, start1, end1);
+		unsigned int masks[BLOCK_SEGMENTS];
+		block.intersectingSegments(*pts, start0, end0, masks);
+		IntersectionVisitor visitor(e, mce.e, ei);
+		geos::index::chain::visitOverlaps(masks, start0, start1,
+			start0, end0, start1, end1, visitor);
+		return;
+	}
+
 	// the chains overlap, so split each in half and iterate 
 	// (binary search)
 	int mid0=(start0+end0)/2;
@@ -0,0 +1,288 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/geomgraph/index/RadixMCSweepLineIntersector.h>
+#include <geos/geomgraph/index/MonotoneChainEdge.h>
+#include <geos/geomgraph/index/MonotoneChain.h>
+#include <geos/geomgraph/Edge.h>
+#include <geos/platform.h> // for int64
+
+#include <vector>
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+namespace geos {
+namespace geomgraph { // geos.geomgraph
+namespace index { // geos.geomgraph.index
+
+namespace {
+
+// Below this number of events a comparison sort is cheaper
+const size_t MIN_RADIX_EVENTS = 256;
+
+const unsigned int RADIX_BITS = 8;
+const unsigned int RADIX_SIZE = 1 << RADIX_BITS;
+const unsigned int RADIX_PASSES = 64 / RADIX_BITS;
+
+} // anonymous namespace
+
+/*public*/
+RadixMCSweepLineIntersector::RadixMCSweepLineIntersector()
+	:
+	nOverlaps(0)
+{
+}
+
+/*public*/
+RadixMCSweepLineIntersector::~RadixMCSweepLineIntersector()
+{
+}
+
+/*public*/
+void
+RadixMCSweepLineIntersector::computeIntersections(vector<Edge*> *edges,
+	SegmentIntersector *si, bool testAllSegments)
+{
+	if (testAllSegments)
+		add(edges, NULL);
+	else
+		add(edges);
+	computeIntersections(si);
+}
+
+/*public*/
+void
+RadixMCSweepLineIntersector::computeIntersections(vector<Edge*> *edges0,
+	vector<Edge*> *edges1, SegmentIntersector *si)
+{
+	add(edges0, edges0);
+	add(edges1, edges1);
+	computeIntersections(si);
+}
+
+/*private*/
+void
+RadixMCSweepLineIntersector::add(vector<Edge*> *edges)
+{
+	for (size_t i=0; i<edges->size(); ++i)
+	{
+		Edge *edge=(*edges)[i];
+		// edge is its own group
+		add(edge, edge);
+	}
+}
+
+/*private*/
+void
+RadixMCSweepLineIntersector::add(vector<Edge*> *edges, void* edgeSet)
+{
+	for (size_t i=0; i<edges->size(); ++i)
+	{
+		add((*edges)[i], edgeSet);
+	}
+}
+
+/*private*/
+void
+RadixMCSweepLineIntersector::add(Edge *edge, void* edgeSet)
+{
+	MonotoneChainEdge *mce=edge->getMonotoneChainEdge();
+	vector<int> &startIndex=mce->getStartIndexes();
+	size_t n = startIndex.size()-1;
+	for(size_t i=0; i<n; ++i)
+	{
+		unsigned int chain = static_cast<unsigned int>(chains.size());
+		chains.push_back(MonotoneChain(mce, static_cast<int>(i)));
+		edgeSets.push_back(edgeSet);
+		inserts.push_back(makeEvent(mce->getMinX(i), chain, INSERT_EVENT));
+		deletes.push_back(makeEvent(mce->getMaxX(i), chain, DELETE_EVENT));
+	}
+}
+
+/*private static*/
+RadixMCSweepLineIntersector::Event
+RadixMCSweepLineIntersector::makeEvent(double x, unsigned int chain,
+	unsigned int type)
+{
+	// -0.0 and +0.0 must have the same key, or chains ending at one
+	// would be deleted before chains starting at the other are inserted
+	if (x == 0.0) x = 0.0;
+
+	int64 bits;
+	memcpy(&bits, &x, sizeof(bits));
+
+	Event ev;
+	ev.keyHi = static_cast<unsigned int>(bits >> 32);
+	ev.keyLo = static_cast<unsigned int>(bits & 0xFFFFFFFF);
+	// IEEE doubles order as sign-magnitude integers: flip
+	// negative ones and put positive ones above them
+	if ( bits < 0 )
+	{
+		ev.keyHi = ~ev.keyHi;
+		ev.keyLo = ~ev.keyLo;
+	}
+	else
+	{
+		ev.keyHi |= 0x80000000u;
+	}
+	ev.chain = chain;
+	ev.type = type;
+	return ev;
+}
+
+/**
+ * Because the index of the delete event of each chain is recorded,
+ * it is possible to compute exactly the range of events which must be
+ * compared to a given insert event.
+ */
+/*private*/
+void
+RadixMCSweepLineIntersector::prepareEvents()
+{
+	// Inserts before deletes, so that a stable sort on the x
+	// keys puts them first at equal x
+	events.clear();
+	events.reserve(inserts.size() + deletes.size());
+	events.insert(events.end(), inserts.begin(), inserts.end());
+	events.insert(events.end(), deletes.begin(), deletes.end());
+
+	sortEvents(events);
+
+	deleteIndex.resize(chains.size());
+	for(size_t i=0, n=events.size(); i<n; ++i)
+	{
+		const Event& ev = events[i];
+		if (ev.type == DELETE_EVENT)
+			deleteIndex[ev.chain] = static_cast<unsigned int>(i);
+	}
+}
+
+namespace {
+
+struct EventKeyLessThen {
+	template <class E>
+	bool operator()(const E& a, const E& b) const
+	{
+		if (a.keyHi != b.keyHi) return a.keyHi < b.keyHi;
+		return a.keyLo < b.keyLo;
+	}
+};
+
+template <class E>
+inline unsigned int
+radixDigit(const E& ev, unsigned int pass)
+{
+	unsigned int half = pass < RADIX_PASSES/2 ? ev.keyLo : ev.keyHi;
+	return (half >> ((pass % (RADIX_PASSES/2)) * RADIX_BITS)) & (RADIX_SIZE-1);
+}
+
+} // anonymous namespace
+
+/*private static*/
+void
+RadixMCSweepLineIntersector::sortEvents(vector<Event>& events)
+{
+	size_t n = events.size();
+	if ( n < MIN_RADIX_EVENTS )
+	{
+		stable_sort(events.begin(), events.end(), EventKeyLessThen());
+		return;
+	}
+
+	// Least significant digit first: each pass is stable, so the
+	// events end up sorted by key, and in input order at equal keys
+	vector<size_t> counts(RADIX_PASSES * RADIX_SIZE, 0);
+	for (size_t i=0; i<n; ++i)
+	{
+		for (unsigned int pass=0; pass<RADIX_PASSES; ++pass)
+			++counts[pass * RADIX_SIZE + radixDigit(events[i], pass)];
+	}
+
+	vector<Event> buffer(n);
+	Event* from = &events[0];
+	Event* to = &buffer[0];
+	for (unsigned int pass=0; pass<RADIX_PASSES; ++pass)
+	{
+		size_t* count = &counts[pass * RADIX_SIZE];
+
+		// nothing to do if all keys share this digit, as the
+		// high digits of close x-ordinates do
+		if ( count[radixDigit(from[0], pass)] == n ) continue;
+
+		size_t offset = 0;
+		for (unsigned int d=0; d<RADIX_SIZE; ++d)
+		{
+			size_t c = count[d];
+			count[d] = offset;
+			offset += c;
+		}
+		for (size_t i=0; i<n; ++i)
+			to[count[radixDigit(from[i], pass)]++] = from[i];
+
+		swap(from, to);
+	}
+
+	if ( from != &events[0] )
+		copy(from, from + n, events.begin());
+}
+
+/*private*/
+void
+RadixMCSweepLineIntersector::computeIntersections(SegmentIntersector *si)
+{
+	nOverlaps=0;
+	prepareEvents();
+	for(size_t i=0, n=events.size(); i<n; ++i)
+	{
+		const Event& ev = events[i];
+		if (ev.type == INSERT_EVENT)
+		{
+			processOverlaps(static_cast<unsigned int>(i),
+				deleteIndex[ev.chain], ev.chain, si);
+		}
+	}
+}
+
+/*private*/
+void
+RadixMCSweepLineIntersector::processOverlaps(unsigned int start,
+	unsigned int end, unsigned int chain0, SegmentIntersector *si)
+{
+	MonotoneChain& mc0 = chains[chain0];
+	void* edgeSet0 = edgeSets[chain0];
+
+	/*
+	 * Since we might need to test for self-intersections,
+	 * include current insert event in list of events to test.
+	 * Last index can be skipped, because it must be a Delete event.
+	 */
+	for(unsigned int i=start; i<end; ++i)
+	{
+		const Event& ev1 = events[i];
+		if (ev1.type == INSERT_EVENT)
+		{
+			// don't compare edges in same group
+			// null group indicates that edges should be compared
+			if (edgeSet0==NULL || edgeSet0!=edgeSets[ev1.chain])
+			{
+				mc0.computeIntersections(&chains[ev1.chain], si);
+				nOverlaps++;
+			}
+		}
+	}
+}
+
+} // namespace geos.geomgraph.index
+} // namespace geos.geomgraph
+} // namespace geos
@@ -20,6 +20,7 @@
 #include <geos/index/chain/MonotoneChain.h>
 #include <geos/index/chain/MonotoneChainSelectAction.h>
 #include <geos/index/chain/MonotoneChainOverlapAction.h>
+#include <geos/index/chain/SegmentEnvelopeBlock.h>
 #include <geos/geom/CoordinateSequence.h>
 #include <geos/geom/LineSegment.h>
 #include <geos/geom/Envelope.h>
@@ -30,6 +31,30 @@ namespace geos {
 namespace index { // geos.index
 namespace chain { // geos.index.chain
 
+namespace {
+
+/// Ranges of at most this many segments are matched segment by segment
+const size_t BLOCK_SEGMENTS = 16;
+
+class OverlapVisitor {
+public:
+    OverlapVisitor(MonotoneChain& chain0, MonotoneChain& chain1,
+                   MonotoneChainOverlapAction& action)
+        : mc0(chain0), mc1(chain1), mco(action) {}
+
+    void operator()(size_t i, size_t j)
+    {
+        mco.overlap(mc0, i, mc1, j);
+    }
+
+private:
+    MonotoneChain& mc0;
+    MonotoneChain& mc1;
+    MonotoneChainOverlapAction& mco;
+};
+
+} // anonymous namespace
+
 MonotoneChain::MonotoneChain(const geom::CoordinateSequence& newPts,
                              size_t nstart, size_t nend, void* nContext)
 	:
@@ -147,6 +172,20 @@ MonotoneChain::computeOverlaps(size_t start0, size_t end0,
     mco.tempEnv2.init(p10, p11);
     if (!mco.tempEnv1.intersects(mco.tempEnv2)) return;
 
+    // short ranges: find the overlapping segments all at once,
+    // then report them in the order the bisection below would
+    if (end0-start0 <= BLOCK_SEGMENTS && end1-start1 <= BLOCK_SEGMENTS)
+    {
+        SegmentEnvelopeBlock block;
+        block.setSegments(mc.pts, start1, end1);
+        unsigned int masks[BLOCK_SEGMENTS];
+        block.intersectingSegments(pts, start0, end0, masks);
+        OverlapVisitor visitor(*this, mc, mco);
+        visitOverlaps(masks, start0, start1, start0, end0, start1, end1,
+                      visitor);
+        return;
+    }
+
     // the chains overlap,so split each in half and iterate (binary search)
     size_t mid0=(start0+end0)/2;
     size_t mid1=(start1+end1)/2;
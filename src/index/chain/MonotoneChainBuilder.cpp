@@ -19,6 +19,7 @@
 #include <geos/index/chain/MonotoneChainBuilder.h> 
 #include <geos/index/chain/MonotoneChain.h> 
 #include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/FlatCoordinateSequence.h>
 #include <geos/geomgraph/Quadrant.h>
 
 #include <cassert>
@@ -41,6 +42,91 @@ namespace geos {
 namespace index { // geos.index
 namespace chain { // geos.index.chain
 
+namespace {
+
+/// Point access to any CoordinateSequence, for findChainEndIn
+class SequencePoints {
+	const CoordinateSequence& pts;
+public:
+	SequencePoints(const CoordinateSequence& p) : pts(p) {}
+	std::size_t size() const { return pts.getSize(); }
+	bool equals2D(std::size_t i, std::size_t j) const
+	{
+		return pts[i].equals2D(pts[j]);
+	}
+	int quadrant(std::size_t i, std::size_t j) const
+	{
+		return Quadrant::quadrant(pts[i], pts[j]);
+	}
+};
+
+/// Point access to a FlatCoordinateSequence, with no virtual calls
+class FlatPoints {
+	const FlatCoordinateSequence& pts;
+public:
+	FlatPoints(const FlatCoordinateSequence& p) : pts(p) {}
+	std::size_t size() const { return pts.getSize(); }
+	bool equals2D(std::size_t i, std::size_t j) const
+	{
+		return pts.getXAt(i) == pts.getXAt(j) &&
+		       pts.getYAt(i) == pts.getYAt(j);
+	}
+	int quadrant(std::size_t i, std::size_t j) const
+	{
+		return Quadrant::quadrant(pts.getXAt(j) - pts.getXAt(i),
+		                          pts.getYAt(j) - pts.getYAt(i));
+	}
+};
+
+template <class Points>
+std::size_t
+findChainEndIn(const Points& pts, std::size_t start)
+{
+	const std::size_t npts = pts.size(); // cache
+
+	assert(start < npts);
+	assert(npts); // should be implied by the assertion above,
+	              // 'start' being unsigned
+
+	std::size_t safeStart = start;
+
+        // skip any zero-length segments at the start of the sequence
+        // (since they cannot be used to establish a quadrant)
+	while ( safeStart < npts - 1
+		&& pts.equals2D(safeStart, safeStart+1) ) 
+	{
+		++safeStart;
+	}
+
+	// check if there are NO non-zero-length segments
+	if (safeStart >= npts - 1) {
+		return npts - 1;
+	}
+
+	// determine overall quadrant for chain
+	// (which is the starting quadrant)
+	int chainQuad = pts.quadrant(safeStart, safeStart + 1);
+	std::size_t last = start + 1;
+	while (last < npts)
+	{
+		// skip zero-length segments, but include them in the chain
+		if (! pts.equals2D(last - 1, last) )
+		{
+			// compute quadrant for next possible segment in chain
+			int quad = pts.quadrant(last - 1, last);
+			if (quad != chainQuad) break;
+		}
+		++last;	
+	}
+#if GEOS_DEBUG
+	std::cerr<<"MonotoneChainBuilder::findChainEnd() returning"<<std::endl;
+#endif
+
+	return last - 1;
+}
+
+} // anonymous namespace
+
 /* static public */
 vector<MonotoneChain*>*
 MonotoneChainBuilder::getChains(const CoordinateSequence* pts, void* context)
@@ -92,50 +178,12 @@ MonotoneChainBuilder::getChainStartIndices(const CoordinateSequence& pts,
 std::size_t
 MonotoneChainBuilder::findChainEnd(const CoordinateSequence& pts, std::size_t start)
 {
-
-	const std::size_t npts = pts.getSize(); // cache
-
-	assert(start < npts);
-	assert(npts); // should be implied by the assertion above,
-	              // 'start' being unsigned
-
-	std::size_t safeStart = start;
-
-        // skip any zero-length segments at the start of the sequence
-        // (since they cannot be used to establish a quadrant)
-	while ( safeStart < npts - 1
-		&& pts[safeStart].equals2D(pts[safeStart+1]) ) 
+	if ( const FlatCoordinateSequence* flat =
+	     dynamic_cast<const FlatCoordinateSequence*>(&pts) )
 	{
-		++safeStart;
+		return findChainEndIn(FlatPoints(*flat), start);
 	}
-
-	// check if there are NO non-zero-length segments
-	if (safeStart >= npts - 1) {
-		return npts - 1;
-	}
-
-	// determine overall quadrant for chain
-	// (which is the starting quadrant)
-	int chainQuad = Quadrant::quadrant(pts[safeStart],
-	                                   pts[safeStart + 1]);
-	std::size_t last = start + 1;
-	while (last < npts)
-	{
-		// skip zero-length segments, but include them in the chain
-		if (! pts[last - 1].equals2D( pts[last] ) )
-		{
-			// compute quadrant for next possible segment in chain
-			int quad = Quadrant::quadrant( pts[last - 1],
-			                               pts[last]      );
-			if (quad != chainQuad) break;
-		}
-		++last;	
-	}
-#if GEOS_DEBUG
-	std::cerr<<"MonotoneChainBuilder::findChainEnd() returning"<<std::endl;
-#endif
-
-	return last - 1;
+	return findChainEndIn(SequencePoints(pts), start);
 }
 
 } // namespace geos.index.chain
@@ -0,0 +1,148 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/index/chain/SegmentEnvelopeBlock.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/Coordinate.h>
+
+#include <algorithm> // std::min, std::max
+#include <cassert>
+
+#if defined(__AVX__)
+# include <immintrin.h>
+# define GEOS_SEGMENTENVELOPEBLOCK_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || \
+      (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+# include <emmintrin.h>
+# define GEOS_SEGMENTENVELOPEBLOCK_SSE2 1
+#endif
+
+using namespace std;
+
+namespace geos {
+namespace index { // geos.index
+namespace chain { // geos.index.chain
+
+namespace {
+
+/// Envelopes tested per iteration, the arrays are padded to it
+const size_t WIDTH = 4;
+
+} // anonymous namespace
+
+/*public*/
+void
+SegmentEnvelopeBlock::setSegments(const geom::CoordinateSequence& pts,
+                                  size_t start, size_t end)
+{
+	assert(end >= start);
+	assert(end - start <= CAPACITY);
+
+	count = end - start;
+	for (size_t i=0; i<count; ++i)
+	{
+		double x0 = pts.getX(start+i), x1 = pts.getX(start+i+1);
+		double y0 = pts.getY(start+i), y1 = pts.getY(start+i+1);
+		minX[i] = min(x0, x1); maxX[i] = max(x0, x1);
+		minY[i] = min(y0, y1); maxY[i] = max(y0, y1);
+	}
+
+	// The padding is masked out, but keep it initialized
+	size_t padded = (count + WIDTH-1) / WIDTH * WIDTH;
+	for (size_t i=count; i<padded; ++i)
+	{
+		minX[i] = maxX[i] = minY[i] = maxY[i] = 0.0;
+	}
+}
+
+/*public*/
+unsigned int
+SegmentEnvelopeBlock::intersecting(double qminx, double qminy,
+                                   double qmaxx, double qmaxy) const
+{
+	// Collect the disjoint envelopes, testing as in
+	// Envelope::intersects so that NaNs give the same answer
+	unsigned int disjoint = 0;
+
+#if defined(GEOS_SEGMENTENVELOPEBLOCK_AVX)
+	const __m256d qx0 = _mm256_set1_pd(qminx), qx1 = _mm256_set1_pd(qmaxx);
+	const __m256d qy0 = _mm256_set1_pd(qminy), qy1 = _mm256_set1_pd(qmaxy);
+	for (size_t i=0; i<count; i+=4)
+	{
+		__m256d d = _mm256_or_pd(
+			_mm256_or_pd(
+				_mm256_cmp_pd(_mm256_loadu_pd(maxX+i), qx0, _CMP_LT_OQ),
+				_mm256_cmp_pd(_mm256_loadu_pd(minX+i), qx1, _CMP_GT_OQ)),
+			_mm256_or_pd(
+				_mm256_cmp_pd(_mm256_loadu_pd(maxY+i), qy0, _CMP_LT_OQ),
+				_mm256_cmp_pd(_mm256_loadu_pd(minY+i), qy1, _CMP_GT_OQ)));
+		disjoint |= unsigned(_mm256_movemask_pd(d)) << i;
+	}
+#elif defined(GEOS_SEGMENTENVELOPEBLOCK_SSE2)
+	const __m128d qx0 = _mm_set1_pd(qminx), qx1 = _mm_set1_pd(qmaxx);
+	const __m128d qy0 = _mm_set1_pd(qminy), qy1 = _mm_set1_pd(qmaxy);
+	for (size_t i=0; i<count; i+=2)
+	{
+		__m128d d = _mm_or_pd(
+			_mm_or_pd(
+				_mm_cmplt_pd(_mm_loadu_pd(maxX+i), qx0),
+				_mm_cmpgt_pd(_mm_loadu_pd(minX+i), qx1)),
+			_mm_or_pd(
+				_mm_cmplt_pd(_mm_loadu_pd(maxY+i), qy0),
+				_mm_cmpgt_pd(_mm_loadu_pd(minY+i), qy1)));
+		disjoint |= unsigned(_mm_movemask_pd(d)) << i;
+	}
+#else
+	for (size_t i=0; i<count; ++i)
+	{
+		if ( qminx > maxX[i] || qmaxx < minX[i] ||
+		     qminy > maxY[i] || qmaxy < minY[i] )
+		{
+			disjoint |= 1u << i;
+		}
+	}
+#endif
+
+	unsigned int all = count < 32 ? (1u << count) - 1 : ~0u;
+	return ~disjoint & all;
+}
+
+/*public*/
+unsigned int
+SegmentEnvelopeBlock::intersecting(const geom::Coordinate& p0,
+                                   const geom::Coordinate& p1) const
+{
+	return intersecting(min(p0.x, p1.x), min(p0.y, p1.y),
+	                    max(p0.x, p1.x), max(p0.y, p1.y));
+}
+
+/*public*/
+void
+SegmentEnvelopeBlock::intersectingSegments(const geom::CoordinateSequence& pts,
+                                           size_t start, size_t end,
+                                           unsigned int* masks) const
+{
+	if ( start >= end ) return;
+
+	double x0 = pts.getX(start), y0 = pts.getY(start);
+	for (size_t i=start; i<end; ++i)
+	{
+		double x1 = pts.getX(i+1), y1 = pts.getY(i+1);
+		masks[i-start] = intersecting(min(x0, x1), min(y0, y1),
+		                              max(x0, x1), max(y0, y1));
+		x0 = x1; y0 = y1;
+	}
+}
+
+} // namespace geos.index.chain
+} // namespace geos.index
+} // namespace geos
@@ -142,6 +142,15 @@ SortedPackedIntervalRTree::query( double min, double max, index::ItemVisitor * v
 	root->query( min, max, visitor);
 }
 
+void 
+SortedPackedIntervalRTree::build()
+{
+	// an empty tree has no root to build
+	if ( leaves->empty() ) return;
+
+	init();
+}
+
 } // geos::intervalrtree
 } // geos::index
 } // geos
@@ -0,0 +1,34 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation. 
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/index/strtree/GeometryItemDistance.h>
+#include <geos/index/strtree/ItemBoundable.h>
+#include <geos/geom/Geometry.h>
+
+using namespace geos::geom;
+
+namespace geos {
+namespace index { // geos.index
+namespace strtree { // geos.index.strtree
+
+double
+GeometryItemDistance::distance(const ItemBoundable* item1,
+                               const ItemBoundable* item2)
+{
+	const Geometry* g1 = static_cast<const Geometry*>(item1->getItem());
+	const Geometry* g2 = static_cast<const Geometry*>(item2->getItem());
+	return g1->distance(g2);
+}
+
+} // namespace geos.index.strtree
+} // namespace geos.index
+} // namespace geos
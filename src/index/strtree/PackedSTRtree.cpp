@@ -0,0 +1,377 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/index/strtree/PackedSTRtree.h>
+#include <geos/index/strtree/AbstractSTRtree.h> // for compareDoubles
+#include <geos/index/ItemVisitor.h>
+#include <geos/geom/Envelope.h>
+#include <geos/util/IllegalArgumentException.h>
+
+#include <vector>
+#include <algorithm> // std::sort, std::min, std::max
+#include <memory> // std::auto_ptr
+#include <limits>
+#include <cassert>
+#include <cmath>
+
+using namespace std;
+using namespace geos::geom;
+
+namespace geos {
+namespace index { // geos.index
+namespace strtree { // geos.index.strtree
+
+namespace {
+
+/// Orders slots by the value they have in a vector of keys (centres)
+class KeyComparator {
+	const vector<double>& keys;
+public:
+	KeyComparator(const vector<double>& k) : keys(k) {}
+	bool operator()(size_t a, size_t b) const
+	{
+		return AbstractSTRtree::compareDoubles(keys[a], keys[b]);
+	}
+};
+
+} // anonymous namespace
+
+/*public*/
+PackedSTRtree::PackedSTRtree(size_t newNodeCapacity)
+	:
+	nodeCapacity(newNodeCapacity),
+	built(false),
+	numItems(0)
+{
+	assert(newNodeCapacity>1);
+}
+
+/*public*/
+PackedSTRtree::~PackedSTRtree()
+{
+}
+
+/*public*/
+void
+PackedSTRtree::insert(const Envelope *itemEnv, void* item)
+{
+	// Cannot insert items into an STR packed R-tree after it has been built
+	if (built)
+	{
+		throw util::IllegalArgumentException(
+			"PackedSTRtree: cannot insert items once the tree is built");
+	}
+	if (itemEnv->isNull()) { return; }
+	minXs.push_back(itemEnv->getMinX());
+	minYs.push_back(itemEnv->getMinY());
+	maxXs.push_back(itemEnv->getMaxX());
+	maxYs.push_back(itemEnv->getMaxY());
+	items.push_back(item);
+}
+
+/*public*/
+size_t
+PackedSTRtree::size() const
+{
+	size_t n = 0;
+	for (size_t i=0, e=items.size(); i<e; ++i)
+	{
+		if ( ! isRemoved(i) ) ++n;
+	}
+	return n;
+}
+
+/*public*/
+void
+PackedSTRtree::build()
+{
+	if (built)
+	{
+		throw util::IllegalArgumentException(
+			"PackedSTRtree: the tree can only be built once");
+	}
+	built = true;
+	numItems = items.size();
+	if ( ! numItems ) return;
+
+	// Each pass sorts a level in place and appends its parents,
+	// until a level with a single node (the root) is created.
+	size_t levelBegin = 0;
+	size_t levelEnd = numItems;
+	do
+	{
+		createParentLevel(levelBegin, levelEnd);
+		levelBegin = levelEnd;
+		levelEnd = minXs.size();
+	}
+	while ( levelEnd - levelBegin > 1 );
+}
+
+/*private*/
+void
+PackedSTRtree::createParentLevel(size_t begin, size_t end)
+{
+	const size_t n = end - begin;
+	assert(n);
+
+	vector<double> centreX(n);
+	vector<double> centreY(n);
+	vector<size_t> order(n);
+	for (size_t i=0; i<n; ++i)
+	{
+		centreX[i] = (minXs[begin+i] + maxXs[begin+i]) / 2.0;
+		centreY[i] = (minYs[begin+i] + maxYs[begin+i]) / 2.0;
+		order[i] = i;
+	}
+
+	// Order by x of the midpoints, and group into vertical slices
+	size_t minLeafCount = (size_t) ceil((double)n / (double)nodeCapacity);
+	size_t sliceCount = (size_t) ceil(sqrt((double)minLeafCount));
+	size_t sliceCapacity = (size_t) ceil((double)n / (double)sliceCount);
+
+	sort(order.begin(), order.end(), KeyComparator(centreX));
+
+	// Order each slice by y of the midpoints
+	for (size_t s=0; s<n; s+=sliceCapacity)
+	{
+		size_t sEnd = min(s+sliceCapacity, n);
+		sort(order.begin()+s, order.begin()+sEnd, KeyComparator(centreY));
+	}
+
+	permute(begin, order);
+
+	// Group each slice into runs of nodeCapacity
+	for (size_t s=0; s<n; s+=sliceCapacity)
+	{
+		size_t sEnd = min(s+sliceCapacity, n);
+		for (size_t r=s; r<sEnd; r+=nodeCapacity)
+		{
+			addParent(begin+r, begin+min(r+nodeCapacity, sEnd));
+		}
+	}
+}
+
+/*private*/
+void
+PackedSTRtree::permute(size_t begin, const vector<size_t>& order)
+{
+	const size_t n = order.size();
+
+	vector<double> tmp(n);
+
+	vector<double>* bounds[] = { &minXs, &minYs, &maxXs, &maxYs };
+	for (size_t b=0; b<4; ++b)
+	{
+		vector<double>& v = *(bounds[b]);
+		for (size_t i=0; i<n; ++i) tmp[i] = v[begin+order[i]];
+		copy(tmp.begin(), tmp.end(), v.begin()+begin);
+	}
+
+	if ( begin < numItems )
+	{
+		vector<void*> tmpItems(n);
+		for (size_t i=0; i<n; ++i) tmpItems[i] = items[begin+order[i]];
+		copy(tmpItems.begin(), tmpItems.end(), items.begin()+begin);
+	}
+	else
+	{
+		size_t nodeBegin = begin - numItems;
+		vector<size_t> tmpBegin(n);
+		vector<size_t> tmpEnd(n);
+		for (size_t i=0; i<n; ++i)
+		{
+			tmpBegin[i] = childBegin[nodeBegin+order[i]];
+			tmpEnd[i] = childEnd[nodeBegin+order[i]];
+		}
+		copy(tmpBegin.begin(), tmpBegin.end(), childBegin.begin()+nodeBegin);
+		copy(tmpEnd.begin(), tmpEnd.end(), childEnd.begin()+nodeBegin);
+	}
+}
+
+/*private*/
+void
+PackedSTRtree::addParent(size_t begin, size_t end)
+{
+	assert(begin < end);
+
+	double minX = minXs[begin];
+	double minY = minYs[begin];
+	double maxX = maxXs[begin];
+	double maxY = maxYs[begin];
+	for (size_t i=begin+1; i<end; ++i)
+	{
+		minX = min(minX, minXs[i]);
+		minY = min(minY, minYs[i]);
+		maxX = max(maxX, maxXs[i]);
+		maxY = max(maxY, maxYs[i]);
+	}
+
+	minXs.push_back(minX);
+	minYs.push_back(minY);
+	maxXs.push_back(maxX);
+	maxYs.push_back(maxY);
+	childBegin.push_back(begin);
+	childEnd.push_back(end);
+}
+
+/*public*/
+void
+PackedSTRtree::query(const Envelope *searchEnv, vector<void*>& matches)
+{
+	if (!built) build();
+	if ( ! numItems ) return;
+
+	size_t root = rootSlot();
+	if ( intersects(root, *searchEnv) )
+	{
+		query(*searchEnv, root, matches);
+	}
+}
+
+/*private*/
+void
+PackedSTRtree::query(const Envelope& searchEnv, size_t node,
+                     vector<void*>& matches) const
+{
+	assert(node >= numItems);
+
+	size_t nodeIndex = node - numItems;
+	for (size_t i=childBegin[nodeIndex], e=childEnd[nodeIndex]; i<e; ++i)
+	{
+		if ( ! intersects(i, searchEnv) ) continue;
+
+		if ( i < numItems )
+		{
+			// removed slots can still meet infinite search bounds
+			if ( ! isRemoved(i) ) matches.push_back(items[i]);
+		}
+		else query(searchEnv, i, matches);
+	}
+}
+
+/*public*/
+void
+PackedSTRtree::query(const Envelope *searchEnv, ItemVisitor& visitor)
+{
+	if (!built) build();
+	if ( ! numItems ) return;
+
+	size_t root = rootSlot();
+	if ( intersects(root, *searchEnv) )
+	{
+		query(*searchEnv, root, visitor);
+	}
+}
+
+/*private*/
+void
+PackedSTRtree::query(const Envelope& searchEnv, size_t node,
+                     ItemVisitor& visitor) const
+{
+	assert(node >= numItems);
+
+	size_t nodeIndex = node - numItems;
+	for (size_t i=childBegin[nodeIndex], e=childEnd[nodeIndex]; i<e; ++i)
+	{
+		if ( ! intersects(i, searchEnv) ) continue;
+
+		if ( i < numItems )
+		{
+			// removed slots can still meet infinite search bounds
+			if ( ! isRemoved(i) ) visitor.visitItem(items[i]);
+		}
+		else query(searchEnv, i, visitor);
+	}
+}
+
+/*public*/
+bool
+PackedSTRtree::remove(const Envelope *itemEnv, void* item)
+{
+	for (size_t i=0, e=items.size(); i<e; ++i)
+	{
+		if ( items[i] != item || isRemoved(i) ) continue;
+		if ( ! intersects(i, *itemEnv) ) continue;
+
+		if ( ! built )
+		{
+			minXs.erase(minXs.begin()+i);
+			minYs.erase(minYs.begin()+i);
+			maxXs.erase(maxXs.begin()+i);
+			maxYs.erase(maxYs.begin()+i);
+			items.erase(items.begin()+i);
+		}
+		else
+		{
+			// Mask the slot with an envelope which intersects nothing
+			// finite; queries also skip removed slots
+			minXs[i] = minYs[i] = numeric_limits<double>::max();
+			maxXs[i] = maxYs[i] = -numeric_limits<double>::max();
+		}
+		return true;
+	}
+	return false;
+}
+
+/*public*/
+void
+PackedSTRtree::iterate(ItemVisitor& visitor)
+{
+	for (size_t i=0, e=items.size(); i<e; ++i)
+	{
+		if ( ! isRemoved(i) ) visitor.visitItem(items[i]);
+	}
+}
+
+/*public*/
+ItemsList*
+PackedSTRtree::itemsTree()
+{
+	if (!built) build();
+
+	ItemsList* valuesTree = 0;
+	if ( numItems ) valuesTree = itemsTree(rootSlot());
+	if ( valuesTree == NULL ) return new ItemsList();
+	return valuesTree;
+}
+
+/*private*/
+ItemsList*
+PackedSTRtree::itemsTree(size_t node) const
+{
+	std::auto_ptr<ItemsList> valuesTreeForNode (new ItemsList());
+
+	size_t nodeIndex = node - numItems;
+	for (size_t i=childBegin[nodeIndex], e=childEnd[nodeIndex]; i<e; ++i)
+	{
+		if ( i < numItems )
+		{
+			if ( ! isRemoved(i) ) valuesTreeForNode->push_back(items[i]);
+		}
+		else
+		{
+			ItemsList* valuesTreeForChild = itemsTree(i);
+			// only add if not null (which indicates an item somewhere in this tree
+			if (valuesTreeForChild != NULL)
+				valuesTreeForNode->push_back_owned(valuesTreeForChild);
+		}
+	}
+
+	if (valuesTreeForNode->empty())
+		return NULL;
+
+	return valuesTreeForNode.release();
+}
+
+} // namespace geos.index.strtree
+} // namespace geos.index
+} // namespace geos
@@ -18,14 +18,20 @@
  **********************************************************************/
 
 #include <geos/index/strtree/STRtree.h>
+#include <geos/index/strtree/ItemBoundable.h>
+#include <geos/index/strtree/ItemDistance.h>
+#include <geos/index/ItemPairVisitor.h>
 #include <geos/geom/Envelope.h>
+#include <geos/util/TaskGroup.h>
 
 #include <vector>
 #include <cassert>
 #include <cmath>
-#include <algorithm> // std::sort
+#include <algorithm> // std::stable_sort, std::merge, std::min
+#include <utility> // std::pair
 #include <iostream> // for debugging
 #include <limits>
+#include <queue>
 
 using namespace std;
 using namespace geos::geom;
@@ -35,60 +41,11 @@ namespace index { // geos.index
 namespace strtree { // geos.index.strtree
 
 
-static bool yComparator(Boundable *a, Boundable *b)
-{
-	assert(a);
-	assert(b);
-	const void* aBounds = a->getBounds();
-	const void* bBounds = b->getBounds();
-	assert(aBounds);
-	assert(bBounds);
-	const Envelope* aEnv = static_cast<const Envelope*>(aBounds);
-	const Envelope* bEnv = static_cast<const Envelope*>(bBounds);
-
-    // NOTE - mloskot:
-    // The problem of instability is directly related to mathematical definition of
-    // "strict weak ordering" as a fundamental requirement for binary predicate:
-    // 
-    // if a is less than b then b is not less than a,
-    // if a is less than b and b is less than c
-    // then a is less than c,
-    // and so on.
-    //
-    // For some very low values, this predicate does not fulfill this requiremnet,
-
-    // NOTE - strk:
-	// It seems that the '<' comparison here gives unstable results.
-	// In particular, when inlines are on (for Envelope::getMinY and getMaxY)
-	// things are fine, but when they are off we can even get a memory corruption !!
-	//return STRtree::centreY(aEnv) < STRtree::centreY(bEnv);
-    
-    // NOTE - mloskot:
-    // This comparison does not answer if a is "lower" than b
-    // what is required for sorting. This comparison only answeres
-    // if a and b are "almost the same" or different
-    
-    /*NOTE - cfis
-      In debug mode VC++ checks the predicate in both directions.  
-      
-      If !_Pred(_Left, _Right)
-      Then an exception is thrown if _Pred(_Right, _Left).
-      See xutility around line 320:
-      
-      	bool __CLRCALL_OR_CDECL _Debug_lt_pred(_Pr _Pred, _Ty1& _Left, _Ty2& _Right,
-		const wchar_t *_Where, unsigned int _Line)*/
-
-    //return std::fabs( STRtree::centreY(aEnv) - STRtree::centreY(bEnv) ) < 1e-30
-
-    // NOTE - strk:
-    // See http://trac.osgeo.org/geos/ticket/293
-    // as for why simple comparison (<) isn't used here
-    return AbstractSTRtree::compareDoubles(STRtree::centreY(aEnv),
-                                           STRtree::centreY(bEnv));
-}
-
 /*public*/
-STRtree::STRtree(size_t nodeCapacity): AbstractSTRtree(nodeCapacity)
+STRtree::STRtree(size_t nodeCapacity)
+	:
+	AbstractSTRtree(nodeCapacity),
+	buildThreads(1)
 { 
 }
 
@@ -103,6 +60,266 @@ STRtree::STRIntersectsOp::intersects(const void* aBounds, const void* bBounds)
 	return ((Envelope*)aBounds)->intersects((Envelope*)bBounds);
 }
 
+class STRAbstractNode: public AbstractNode{
+public:
+
+	STRAbstractNode(int level, int capacity)
+		:
+		AbstractNode(level, capacity)
+	{}
+
+	~STRAbstractNode()
+	{
+		delete (Envelope *)bounds;
+	}
+
+protected:
+
+	void* computeBounds() const
+	{
+		Envelope* bounds=NULL;
+		const BoundableList& b = *getChildBoundables();
+
+		if ( b.empty() ) return NULL;
+
+		BoundableList::const_iterator i=b.begin();
+		BoundableList::const_iterator e=b.end();
+
+		bounds=new Envelope(* static_cast<const Envelope*>((*i)->getBounds()) );
+		for(; i!=e; ++i)
+		{
+			const Boundable* childBoundable=*i;
+			bounds->expandToInclude((Envelope*)childBoundable->getBounds());
+		}
+		return bounds;
+	}
+
+};
+
+namespace {
+
+/// Boundables are sorted on precomputed keys, to avoid calling
+/// getBounds() at each comparison
+typedef std::pair<double, Boundable*> KeyedBoundable;
+typedef vector<KeyedBoundable> KeyedBoundableList;
+
+bool
+keyLessThan(const KeyedBoundable& a, const KeyedBoundable& b)
+{
+	// See http://trac.osgeo.org/geos/ticket/293
+	// as for why simple comparison (<) isn't used here
+	return AbstractSTRtree::compareDoubles(a.first, b.first);
+}
+
+double
+midpointY(const Boundable* b)
+{
+	const Envelope* e = static_cast<const Envelope*>(b->getBounds());
+	return STRtree::centreY(e);
+}
+
+void
+keyBoundables(const BoundableList& input, double (*key)(const Boundable*),
+              KeyedBoundableList& output)
+{
+	output.reserve(input.size());
+	for (BoundableList::const_iterator i=input.begin(), e=input.end();
+			i!=e; ++i)
+	{
+		output.push_back(KeyedBoundable(key(*i), *i));
+	}
+}
+
+void
+unkeyBoundables(const KeyedBoundableList& input, BoundableList& output)
+{
+	output.resize(input.size());
+	for (size_t i=0, n=input.size(); i<n; ++i)
+	{
+		output[i] = input[i].second;
+	}
+}
+
+/// Stable-sorts a run of KeyedBoundables
+class SortRunTask: public util::Task {
+	KeyedBoundableList::iterator begin, end;
+public:
+	SortRunTask(KeyedBoundableList::iterator b, KeyedBoundableList::iterator e)
+		: begin(b), end(e)
+	{}
+	void run() { std::stable_sort(begin, end, keyLessThan); }
+};
+
+/// Merges two adjacent sorted runs of KeyedBoundables into another list
+class MergeRunsTask: public util::Task {
+	KeyedBoundableList::iterator begin, mid, end, out;
+public:
+	MergeRunsTask(KeyedBoundableList::iterator b,
+	              KeyedBoundableList::iterator m,
+	              KeyedBoundableList::iterator e,
+	              KeyedBoundableList::iterator o)
+		: begin(b), mid(m), end(e), out(o)
+	{}
+	void run() { std::merge(begin, mid, mid, end, out, keyLessThan); }
+};
+
+/**
+ * Stable-sorts a list of KeyedBoundables by sorting a run per thread
+ * and then merging pairs of runs, which gives the same result as a
+ * single std::stable_sort.
+ */
+void
+sortKeyedBoundables(KeyedBoundableList& list, size_t numThreads)
+{
+	if ( numThreads < 2 )
+	{
+		std::stable_sort(list.begin(), list.end(), keyLessThan);
+		return;
+	}
+
+	util::TaskGroup tasks(numThreads);
+
+	vector<size_t> runs; // run boundaries
+	for (size_t i=0; i<numThreads; ++i)
+	{
+		runs.push_back(list.size() * i / numThreads);
+	}
+	runs.push_back(list.size());
+
+	vector<SortRunTask> sorters;
+	sorters.reserve(numThreads);
+	for (size_t i=0; i+1<runs.size(); ++i)
+	{
+		sorters.push_back(SortRunTask(list.begin()+runs[i],
+		                              list.begin()+runs[i+1]));
+		tasks.add(&sorters.back());
+	}
+	tasks.run();
+
+	KeyedBoundableList buffer(list.size());
+	KeyedBoundableList* src = &list;
+	KeyedBoundableList* dst = &buffer;
+	while ( runs.size() > 2 )
+	{
+		vector<size_t> mergedRuns;
+		vector<MergeRunsTask> mergers;
+		mergers.reserve(runs.size()/2);
+		size_t i=0;
+		for (; i+2<runs.size(); i+=2)
+		{
+			mergers.push_back(MergeRunsTask(src->begin()+runs[i],
+			                                src->begin()+runs[i+1],
+			                                src->begin()+runs[i+2],
+			                                dst->begin()+runs[i]));
+			tasks.add(&mergers.back());
+			mergedRuns.push_back(runs[i]);
+		}
+		if ( i+1 < runs.size() )
+		{
+			// odd run out, merge it with nothing
+			mergers.push_back(MergeRunsTask(src->begin()+runs[i],
+			                                src->begin()+runs[i+1],
+			                                src->begin()+runs[i+1],
+			                                dst->begin()+runs[i]));
+			tasks.add(&mergers.back());
+			mergedRuns.push_back(runs[i]);
+		}
+		mergedRuns.push_back(runs.back());
+		tasks.run();
+
+		runs.swap(mergedRuns);
+		std::swap(src, dst);
+	}
+
+	if ( src != &list ) list.swap(buffer);
+}
+
+/**
+ * Sorts a vertical slice by the y of the midpoints and groups it into
+ * runs of nodeCapacity, creating a new (parent) node for each run.
+ * The nodes are not registered with the tree, so that slices can be
+ * packed by concurrent threads.
+ */
+class PackSliceTask: public util::Task {
+	const BoundableList* slice;
+	int level;
+	size_t nodeCapacity;
+	BoundableList* parents;
+public:
+	PackSliceTask(const BoundableList* s, int l, size_t c, BoundableList* p)
+		: slice(s), level(l), nodeCapacity(c), parents(p)
+	{}
+
+	void run()
+	{
+		KeyedBoundableList sorted;
+		keyBoundables(*slice, midpointY, sorted);
+		std::stable_sort(sorted.begin(), sorted.end(), keyLessThan);
+
+		AbstractNode* last = 0;
+		for (size_t i=0, n=sorted.size(); i<n; ++i)
+		{
+			if ( i % nodeCapacity == 0 )
+			{
+				std::auto_ptr<AbstractNode> node (
+					new STRAbstractNode(level, static_cast<int>(nodeCapacity)) );
+				parents->push_back(node.get());
+				last = node.release();
+			}
+			last->addChildBoundable(sorted[i].second);
+		}
+
+		// Compute the bounds now, while we own the nodes
+		for (size_t i=0, n=parents->size(); i<n; ++i)
+		{
+			(*parents)[i]->getBounds();
+		}
+	}
+};
+
+/**
+ * Owns the nodes created by PackSliceTasks, one list per slice,
+ * until they are released to the tree.
+ * Deletes them if they were not released, so that no node leaks
+ * when a task throws.
+ */
+class SliceParents {
+	vector<BoundableList> lists;
+public:
+	SliceParents(size_t numSlices) : lists(numSlices) {}
+
+	~SliceParents()
+	{
+		for (size_t i=0, n=lists.size(); i<n; ++i)
+		{
+			for (size_t j=0, m=lists[i].size(); j<m; ++j)
+			{
+				delete lists[i][j];
+			}
+		}
+	}
+
+	BoundableList& operator[](size_t i) { return lists[i]; }
+
+	size_t numNodes() const
+	{
+		size_t n=0;
+		for (size_t i=0; i<lists.size(); ++i) n += lists[i].size();
+		return n;
+	}
+
+	/// Forgets about the nodes, now owned by somebody else
+	void release()
+	{
+		for (size_t i=0, n=lists.size(); i<n; ++i) lists[i].clear();
+	}
+};
+
+/// Minimum number of boundables for a level to be built in parallel
+const size_t PARALLEL_BUILD_MIN_BOUNDABLES = 10000;
+
+} // anonymous namespace
+
 /*private*/
 std::auto_ptr<BoundableList>
 STRtree::createParentBoundables(BoundableList* childBoundables, int newLevel)
@@ -110,14 +327,23 @@ STRtree::createParentBoundables(BoundableList* childBoundables, int newLevel)
 	assert(!childBoundables->empty());
 	int minLeafCount=(int) ceil((double)childBoundables->size()/(double)getNodeCapacity());
 
-	std::auto_ptr<BoundableList> sortedChildBoundables ( sortBoundables(childBoundables) );
+	size_t numThreads = 1;
+	if ( childBoundables->size() >= PARALLEL_BUILD_MIN_BOUNDABLES )
+	{
+		numThreads = buildThreads ? buildThreads
+		                          : util::TaskGroup::getNumProcessors();
+	}
+
+	std::auto_ptr<BoundableList> sortedChildBoundables (
+			parallelSortBoundables(childBoundables, numThreads) );
 
 	std::auto_ptr< vector<BoundableList*> > verticalSlicesV (
 			verticalSlices(sortedChildBoundables.get(), (int)ceil(sqrt((double)minLeafCount)))
 			);
 
 	std::auto_ptr<BoundableList> ret (
-		createParentBoundablesFromVerticalSlices(verticalSlicesV.get(), newLevel)
+		createParentBoundablesFromVerticalSlices(verticalSlicesV.get(),
+			newLevel, numThreads)
 	);
 	for (size_t i=0, vssize=verticalSlicesV->size(); i<vssize; ++i)
 	{
@@ -130,24 +356,62 @@ STRtree::createParentBoundables(BoundableList* childBoundables, int newLevel)
 
 /*private*/
 std::auto_ptr<BoundableList>
-STRtree::createParentBoundablesFromVerticalSlices(std::vector<BoundableList*>* verticalSlices, int newLevel)
+STRtree::createParentBoundablesFromVerticalSlices(std::vector<BoundableList*>* verticalSlices, int newLevel, size_t numThreads)
 {
 	assert(!verticalSlices->empty());
 	std::auto_ptr<BoundableList> parentBoundables( new BoundableList() );
 
-	for (size_t i=0, vssize=verticalSlices->size(); i<vssize; ++i)
+	if ( numThreads < 2 )
 	{
-		std::auto_ptr<BoundableList> toAdd (
-			createParentBoundablesFromVerticalSlice(
-				(*verticalSlices)[i], newLevel)
-			);
-		assert(!toAdd->empty());
+		for (size_t i=0, vssize=verticalSlices->size(); i<vssize; ++i)
+		{
+			std::auto_ptr<BoundableList> toAdd (
+				createParentBoundablesFromVerticalSlice(
+					(*verticalSlices)[i], newLevel)
+				);
+			assert(!toAdd->empty());
+
+			parentBoundables->insert(
+					parentBoundables->end(),
+					toAdd->begin(),
+					toAdd->end());
+		}
+		return parentBoundables;
+	}
+
+	size_t vssize=verticalSlices->size();
+	SliceParents sliceParents(vssize);
+	vector<PackSliceTask> packers;
+	packers.reserve(vssize);
+
+	util::TaskGroup tasks(numThreads);
+	for (size_t i=0; i<vssize; ++i)
+	{
+		if ( (*verticalSlices)[i]->empty() ) continue;
+		packers.push_back(PackSliceTask((*verticalSlices)[i], newLevel,
+		                                nodeCapacity, &sliceParents[i]));
+		tasks.add(&packers.back());
+	}
+	tasks.run();
 
-		parentBoundables->insert(
-				parentBoundables->end(),
-				toAdd->begin(),
-				toAdd->end());
+	// Make room first, so that the nodes are either all
+	// registered or all deleted by sliceParents
+	size_t numNodes = sliceParents.numNodes();
+	nodes->reserve(nodes->size() + numNodes);
+	parentBoundables->reserve(numNodes);
+
+	// Register the new nodes in slice order, for a deterministic tree
+	for (size_t i=0; i<vssize; ++i)
+	{
+		const BoundableList& toAdd = sliceParents[i];
+		for (size_t j=0, n=toAdd.size(); j<n; ++j)
+		{
+			nodes->push_back(static_cast<AbstractNode*>(toAdd[j]));
+		}
+		parentBoundables->insert(parentBoundables->end(),
+				toAdd.begin(), toAdd.end());
 	}
+	sliceParents.release();
 	return parentBoundables;
 }
 
@@ -183,71 +447,505 @@ STRtree::verticalSlices(BoundableList* childBoundables, size_t sliceCount)
 	return slices;
 }
 
-class STRAbstractNode: public AbstractNode{
-public:
+/*protected*/
+AbstractNode*
+STRtree::createNode(int level)
+{
+	AbstractNode *an = new STRAbstractNode(level, static_cast<int>(nodeCapacity));
+	nodes->push_back(an);
+	return an;
+}
 
-	STRAbstractNode(int level, int capacity)
-		:
-		AbstractNode(level, capacity)
+/*public*/
+void
+STRtree::insert(const Envelope *itemEnv, void* item)
+{
+	if (itemEnv->isNull()) { return; }
+	AbstractSTRtree::insert(itemEnv, item);
+}
+
+namespace {
+
+/// A tree node or item waiting to be visited by nearestNeighbour
+struct NearestCandidate {
+	NearestCandidate(double d, const Boundable* b)
+		: distance(d), boundable(b)
 	{}
+	double distance;
+	const Boundable* boundable;
+};
 
-	~STRAbstractNode()
+/// Orders the nearestNeighbour queue so that the closest candidate is on top
+struct NearestCandidateFartherThan {
+	bool operator()(const NearestCandidate& a,
+	                const NearestCandidate& b) const
 	{
-		delete (Envelope *)bounds;
+		return AbstractSTRtree::compareDoubles(b.distance, a.distance);
 	}
+};
 
-protected:
+} // anonymous namespace
 
-	void* computeBounds() const
+/*public*/
+void*
+STRtree::nearestNeighbour(const Envelope* env, const void* item,
+                          ItemDistance* itemDist)
+{
+	vector<void*> neighbours;
+	nearestNeighbour(env, item, itemDist, 1, neighbours);
+	if ( neighbours.empty() ) return NULL;
+	return neighbours.front();
+}
+
+/*public*/
+void
+STRtree::nearestNeighbour(const Envelope* env, const void* item,
+                          ItemDistance* itemDist, size_t k,
+                          vector<void*>& neighbours)
+{
+	assert(env);
+	assert(itemDist);
+
+	if (!built) build();
+
+	if ( k == 0 || root->getChildBoundables()->empty() ) return;
+
+	ItemBoundable queryBoundable(env, const_cast<void*>(item));
+
+	std::priority_queue<NearestCandidate, vector<NearestCandidate>,
+	                    NearestCandidateFartherThan> candidates;
+
+	// Distances of the k closest items seen so far, farthest on top.
+	// Once k items have been seen, anything farther than the top
+	// can be pruned.
+	std::priority_queue<double> bestDistances;
+
+	candidates.push(NearestCandidate(
+		static_cast<const Envelope*>(root->getBounds())->distance(env),
+		root));
+
+	size_t found = 0;
+	while ( ! candidates.empty() )
 	{
-		Envelope* bounds=NULL;
-		const BoundableList& b = *getChildBoundables();
+		NearestCandidate c = candidates.top();
+		candidates.pop();
 
-		if ( b.empty() ) return NULL;
+		if ( bestDistances.size() == k && c.distance > bestDistances.top() )
+		{
+			// all remaining candidates are farther away
+			break;
+		}
 
-		BoundableList::const_iterator i=b.begin();
-		BoundableList::const_iterator e=b.end();
+		if (const ItemBoundable* ib =
+		    dynamic_cast<const ItemBoundable*>(c.boundable))
+		{
+			// items are queued with their actual distance, which is
+			// never less than that of any node still in the queue
+			neighbours.push_back(ib->getItem());
+			if ( ++found == k ) break;
+			continue;
+		}
 
-		bounds=new Envelope(* static_cast<const Envelope*>((*i)->getBounds()) );
-		for(; i!=e; ++i)
+		const AbstractNode* an = static_cast<const AbstractNode*>(c.boundable);
+		const BoundableList& children = *(an->getChildBoundables());
+		for (BoundableList::const_iterator i=children.begin(),
+				e=children.end(); i!=e; ++i)
 		{
-			const Boundable* childBoundable=*i;
-			bounds->expandToInclude((Envelope*)childBoundable->getBounds());
+			const Boundable* child = *i;
+			double d;
+			if (const ItemBoundable* cib =
+			    dynamic_cast<const ItemBoundable*>(child))
+			{
+				d = itemDist->distance(&queryBoundable, cib);
+				if ( bestDistances.size() < k ) {
+					bestDistances.push(d);
+				}
+				else if ( d < bestDistances.top() ) {
+					bestDistances.pop();
+					bestDistances.push(d);
+				}
+				else if ( d > bestDistances.top() ) {
+					continue;
+				}
+			}
+			else
+			{
+				d = static_cast<const Envelope*>(child->getBounds())->distance(env);
+				if ( bestDistances.size() == k && d > bestDistances.top() ) {
+					continue;
+				}
+			}
+			candidates.push(NearestCandidate(d, child));
 		}
-		return bounds;
 	}
+}
+
+namespace {
 
+/// A pair of boundables waiting to be visited by nearestPair
+struct NearestPairCandidate {
+	NearestPairCandidate(double d, const Boundable* a, const Boundable* b)
+		: distance(d), boundable0(a), boundable1(b)
+	{}
+	double distance;
+	const Boundable* boundable0;
+	const Boundable* boundable1;
 };
 
-/*protected*/
-AbstractNode*
-STRtree::createNode(int level)
+/// Orders the nearestPair queue so that the closest pair is on top
+struct NearestPairCandidateFartherThan {
+	bool operator()(const NearestPairCandidate& a,
+	                const NearestPairCandidate& b) const
+	{
+		return AbstractSTRtree::compareDoubles(b.distance, a.distance);
+	}
+};
+
+inline const Envelope*
+boundsOf(const Boundable* b)
 {
-	AbstractNode *an = new STRAbstractNode(level, static_cast<int>(nodeCapacity));
-	nodes->push_back(an);
-	return an;
+	return static_cast<const Envelope*>(b->getBounds());
+}
+
+} // anonymous namespace
+
+/*public*/
+pair<void*, void*>
+STRtree::nearestNeighbour(STRtree& other, ItemDistance* itemDist,
+                          double terminateDistance)
+{
+	pair<void*, void*> nearest;
+	nearestPair(other, itemDist, terminateDistance,
+	            numeric_limits<double>::infinity(), nearest);
+	return nearest;
+}
+
+/*public*/
+bool
+STRtree::isWithinDistance(STRtree& other, ItemDistance* itemDist,
+                          double maxDistance)
+{
+	pair<void*, void*> nearest;
+	return nearestPair(other, itemDist, maxDistance, maxDistance,
+	                   nearest) <= maxDistance;
+}
+
+/*private*/
+double
+STRtree::nearestPair(STRtree& other, ItemDistance* itemDist,
+                     double terminateDistance, double maxDistance,
+                     pair<void*, void*>& nearest)
+{
+	assert(itemDist);
+
+	if (!built) build();
+	if (!other.built) other.build();
+
+	nearest = pair<void*, void*>(static_cast<void*>(0), static_cast<void*>(0));
+	if ( root->getChildBoundables()->empty() ||
+	     other.root->getChildBoundables()->empty() )
+	{
+		return numeric_limits<double>::infinity();
+	}
+
+	std::priority_queue<NearestPairCandidate, vector<NearestPairCandidate>,
+	                    NearestPairCandidateFartherThan> candidates;
+
+	// Pairs farther apart than this can't be nearer than the best
+	// pair of items found so far (or than maxDistance)
+	double bound = maxDistance;
+	bool found = false;
+
+	candidates.push(NearestPairCandidate(
+		boundsOf(root)->distance(boundsOf(other.root)), root, other.root));
+
+	while ( ! candidates.empty() )
+	{
+		NearestPairCandidate c = candidates.top();
+		candidates.pop();
+
+		// all remaining pairs are farther away
+		if ( c.distance > bound ) break;
+
+		// Only pairs with a node are queued: expand the node, or the
+		// larger one so that the pairs queued get apart quickly
+		bool expandFirst = dynamic_cast<const ItemBoundable*>(c.boundable1)
+			|| ( ! dynamic_cast<const ItemBoundable*>(c.boundable0) &&
+			     boundsOf(c.boundable0)->getArea() >=
+			     boundsOf(c.boundable1)->getArea() );
+		const AbstractNode* node = static_cast<const AbstractNode*>(
+			expandFirst ? c.boundable0 : c.boundable1);
+		const Boundable* kept = expandFirst ? c.boundable1 : c.boundable0;
+		const ItemBoundable* keptItem =
+			dynamic_cast<const ItemBoundable*>(kept);
+
+		const BoundableList& children = *(node->getChildBoundables());
+		for (BoundableList::const_iterator i=children.begin(),
+				e=children.end(); i!=e; ++i)
+		{
+			const Boundable* child = *i;
+			const Boundable* b0 = expandFirst ? child : kept;
+			const Boundable* b1 = expandFirst ? kept : child;
+
+			const ItemBoundable* childItem =
+				dynamic_cast<const ItemBoundable*>(child);
+			if ( childItem && keptItem )
+			{
+				const ItemBoundable* ib0 = expandFirst ? childItem : keptItem;
+				const ItemBoundable* ib1 = expandFirst ? keptItem : childItem;
+				double d = itemDist->distance(ib0, ib1);
+				if ( d > bound || ( found && d == bound ) ) continue;
+
+				bound = d;
+				found = true;
+				nearest = pair<void*, void*>(ib0->getItem(), ib1->getItem());
+				if ( bound <= terminateDistance ) return bound;
+				continue;
+			}
+
+			double d = boundsOf(b0)->distance(boundsOf(b1));
+			if ( d <= bound )
+				candidates.push(NearestPairCandidate(d, b0, b1));
+		}
+	}
+
+	return found ? bound : numeric_limits<double>::infinity();
 }
 
+namespace {
+
+/// Number of queries traversing the tree together in queryBatch
+const size_t QUERY_BATCH_SIZE = 64;
+
+typedef std::pair<double, size_t> KeyedQuery;
+
+bool
+keyedQueryLessThan(const KeyedQuery& a, const KeyedQuery& b)
+{
+	return AbstractSTRtree::compareDoubles(a.first, b.first);
+}
+
+/**
+ * Orders the query envelopes the way the tree orders its items
+ * (vertical slices of midpoints, sorted by y), so that consecutive
+ * queries are likely to visit the same nodes.
+ */
+void
+sortQueries(const vector<const Envelope*>& searchEnvs, vector<size_t>& order)
+{
+	const size_t n = searchEnvs.size();
+
+	vector<KeyedQuery> keyed(n);
+	for (size_t i=0; i<n; ++i)
+	{
+		const Envelope* e = searchEnvs[i];
+		keyed[i] = KeyedQuery(STRtree::avg(e->getMinX(), e->getMaxX()), i);
+	}
+	std::stable_sort(keyed.begin(), keyed.end(), keyedQueryLessThan);
+
+	size_t batchCount = (size_t) ceil((double)n / (double)QUERY_BATCH_SIZE);
+	size_t sliceCount = (size_t) ceil(sqrt((double)batchCount));
+	size_t sliceCapacity = (size_t) ceil((double)n / (double)sliceCount);
+	for (size_t s=0; s<n; s+=sliceCapacity)
+	{
+		size_t sEnd = min(s+sliceCapacity, n);
+		for (size_t i=s; i<sEnd; ++i)
+		{
+			keyed[i].first = STRtree::centreY(searchEnvs[keyed[i].second]);
+		}
+		std::stable_sort(keyed.begin()+s, keyed.begin()+sEnd,
+		                 keyedQueryLessThan);
+	}
+
+	order.resize(n);
+	for (size_t i=0; i<n; ++i) order[i] = keyed[i].second;
+}
+
+/// An item found by queryBatch, with the index of the query finding it
+typedef std::pair<size_t, void*> QueryHit;
+
+/**
+ * Walks the tree with a batch of queries, testing each node
+ * against the queries which intersect its parent.
+ */
+class BatchQuerier {
+public:
+	BatchQuerier(const vector<const Envelope*>& envs, AbstractNode& root,
+	             vector<QueryHit>& h)
+		: searchEnvs(envs), hits(h), scratch(root.getLevel()+1)
+	{}
+
+	/// Visits the children of node intersecting any of the active queries
+	void visit(AbstractNode& node, const vector<size_t>& active, size_t depth)
+	{
+		// one list of active queries per depth, reused across nodes
+		assert(depth < scratch.size());
+		vector<size_t>& childActive = scratch[depth];
+
+		const BoundableList& children = *(node.getChildBoundables());
+		const bool isLeaf = ( node.getLevel() == 0 );
+
+		for (BoundableList::const_iterator i=children.begin(),
+				e=children.end(); i!=e; ++i)
+		{
+			Boundable* child = *i;
+			const Envelope* childEnv =
+				static_cast<const Envelope*>(child->getBounds());
+
+			childActive.clear();
+			for (size_t j=0, n=active.size(); j<n; ++j)
+			{
+				if ( childEnv->intersects(searchEnvs[active[j]]) )
+					childActive.push_back(active[j]);
+			}
+			if ( childActive.empty() ) continue;
+
+			if ( isLeaf )
+			{
+				void* item = static_cast<ItemBoundable*>(child)->getItem();
+				for (size_t j=0, n=childActive.size(); j<n; ++j)
+				{
+					hits.push_back(QueryHit(childActive[j], item));
+				}
+			}
+			else
+			{
+				visit(*static_cast<AbstractNode*>(child), childActive,
+				      depth+1);
+			}
+		}
+	}
+
+private:
+	const vector<const Envelope*>& searchEnvs;
+	vector<QueryHit>& hits;
+	vector< vector<size_t> > scratch;
+};
+
+} // anonymous namespace
+
 /*public*/
 void
-STRtree::insert(const Envelope *itemEnv, void* item)
+STRtree::queryBatch(const vector<const Envelope*>& searchEnvs,
+                    vector<size_t>& offsets, vector<void*>& items)
 {
-	if (itemEnv->isNull()) { return; }
-	AbstractSTRtree::insert(itemEnv, item);
+	if (!built) build();
+
+	const size_t n = searchEnvs.size();
+	offsets.assign(n+1, 0);
+	items.clear();
+	if ( ! n ) return;
+
+	vector<size_t> order;
+	sortQueries(searchEnvs, order);
+
+	// Each query belongs to a single batch, so its items
+	// are found in the same order query() would find them
+	vector<QueryHit> hits;
+	BatchQuerier querier(searchEnvs, *root, hits);
+	vector<size_t> batch;
+	for (size_t b=0; b<n; b+=QUERY_BATCH_SIZE)
+	{
+		batch.assign(order.begin()+b,
+		             order.begin()+min(b+QUERY_BATCH_SIZE, n));
+		querier.visit(*root, batch, 0);
+	}
+
+	// Group the items by query
+	for (size_t i=0, nh=hits.size(); i<nh; ++i) ++offsets[hits[i].first+1];
+	for (size_t i=0; i<n; ++i) offsets[i+1] += offsets[i];
+
+	vector<size_t> next(offsets.begin(), offsets.end()-1);
+	items.resize(hits.size());
+	for (size_t i=0, nh=hits.size(); i<nh; ++i)
+	{
+		items[ next[hits[i].first]++ ] = hits[i].second;
+	}
+}
+
+/*public*/
+void
+STRtree::join(STRtree& other, ItemPairVisitor& visitor)
+{
+	if (!built) build();
+	if (!other.built) other.build();
+
+	if ( root->getChildBoundables()->empty() ) return;
+	if ( other.root->getChildBoundables()->empty() ) return;
+
+	if ( intersectsOp.intersects(root->getBounds(), other.root->getBounds()) )
+	{
+		join(root, other.root, visitor);
+	}
+}
+
+/*private static*/
+void
+STRtree::join(Boundable* a, Boundable* b, ItemPairVisitor& visitor)
+{
+	// Items are given level -1, so that the deeper side
+	// of the pair is always the one being expanded
+	AbstractNode* an = dynamic_cast<AbstractNode*>(a);
+	AbstractNode* bn = dynamic_cast<AbstractNode*>(b);
+	int aLevel = an ? an->getLevel() : -1;
+	int bLevel = bn ? bn->getLevel() : -1;
+
+	if ( ! an && ! bn )
+	{
+		visitor.visitItemPair(static_cast<ItemBoundable*>(a)->getItem(),
+		                      static_cast<ItemBoundable*>(b)->getItem());
+		return;
+	}
+
+	if ( aLevel >= bLevel )
+	{
+		const Envelope* bEnv = static_cast<const Envelope*>(b->getBounds());
+		const BoundableList& children = *(an->getChildBoundables());
+		for (size_t i=0, n=children.size(); i<n; ++i)
+		{
+			const Envelope* childEnv =
+				static_cast<const Envelope*>(children[i]->getBounds());
+			if ( childEnv->intersects(bEnv) )
+				join(children[i], b, visitor);
+		}
+	}
+	else
+	{
+		const Envelope* aEnv = static_cast<const Envelope*>(a->getBounds());
+		const BoundableList& children = *(bn->getChildBoundables());
+		for (size_t i=0, n=children.size(); i<n; ++i)
+		{
+			const Envelope* childEnv =
+				static_cast<const Envelope*>(children[i]->getBounds());
+			if ( aEnv->intersects(childEnv) )
+				join(a, children[i], visitor);
+		}
+	}
 }
 
 /*private*/
 std::auto_ptr<BoundableList>
-STRtree::sortBoundables(const BoundableList* input)
+STRtree::parallelSortBoundables(const BoundableList* input, size_t numThreads)
 {
 	assert(input);
-	std::auto_ptr<BoundableList> output ( new BoundableList(*input) );
-	assert(output->size() == input->size());
+	KeyedBoundableList keyed;
+	keyBoundables(*input, midpointY, keyed);
+	sortKeyedBoundables(keyed, numThreads);
 
-	sort(output->begin(), output->end(), yComparator);
+	std::auto_ptr<BoundableList> output ( new BoundableList() );
+	unkeyBoundables(keyed, *output);
+	assert(output->size() == input->size());
 	return output;
 }
 
+/*private*/
+std::auto_ptr<BoundableList>
+STRtree::sortBoundables(const BoundableList* input)
+{
+	assert(input);
+	return parallelSortBoundables(input, 1);
+}
+
 } // namespace geos.index.strtree
 } // namespace geos.index
 } // namespace geos
@@ -17,14 +17,57 @@
  **********************************************************************/
 
 #include <geos/inline.h>
+#include <geos/io/ByteOrderDataInStream.h>
+#include <geos/io/ByteOrderValues.h>
+#include <geos/io/ParseException.h>
+#include <geos/util/Machine.h> // for getMachineByteOrder
 
 #ifndef GEOS_INLINE
 #include <geos/io/ByteOrderDataInStream.inl>
 #endif
 
+#include <iostream> // istream
+#include <cstring> // memcpy
+
 namespace geos {
 namespace io { // geos::io
 
+void
+ByteOrderDataInStream::readDoubles(double *out, std::size_t n)
+{
+	const std::size_t nbytes = n*8;
+	const unsigned char *src;
+	if ( ! stream )
+	{
+		// check the whole run at once, before copying anything
+		if ( static_cast<std::size_t>(dataEnd - data) / 8 < n )
+			throw  ParseException("Unexpected EOF parsing WKB");
+		src = data;
+		data += nbytes;
+	}
+	else
+	{
+		// read the run in place, then swap its bytes if needed
+		stream->read(reinterpret_cast<char *>(out), nbytes);
+		if ( stream->eof() )
+			throw  ParseException("Unexpected EOF parsing WKB");
+		src = reinterpret_cast<const unsigned char *>(out);
+	}
+
+	if ( byteOrder == getMachineByteOrder() )
+	{
+		if ( src != reinterpret_cast<const unsigned char *>(out) )
+			std::memcpy(out, src, nbytes);
+		return;
+	}
+
+	for (std::size_t i=0; i<n; ++i)
+	{
+		// getDouble copies the value out before we overwrite it
+		out[i] = ByteOrderValues::getDouble(src + i*8, byteOrder);
+	}
+}
+
 } // namespace geos::io
 } // namespace geos
 
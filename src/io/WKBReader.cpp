@@ -229,6 +229,15 @@ WKBReader::read(istream &is)
 	return readGeometry();
 }
 
+Geometry *
+WKBReader::read(const unsigned char *buf, size_t size)
+{
+	dis.setInBuffer(buf, size); // will default to machine endian
+	Geometry *g = readGeometry();
+	dis.setInBuffer(0, 0); // don't keep a pointer to caller's memory
+	return g;
+}
+
 Geometry *
 WKBReader::readGeometry()
 {
@@ -478,17 +487,41 @@ WKBReader::readGeometryCollection()
 CoordinateSequence *
 WKBReader::readCoordinateSequence(int size)
 {
-	CoordinateSequence *seq = factory.getCoordinateSequenceFactory()->create(size, inputDimension);
-	unsigned int targetDim = seq->getDimension();
-	if ( targetDim > inputDimension )
-		targetDim = inputDimension;
-	for (int i=0; i<size; i++) {
-		readCoordinate();
-		for (unsigned int j=0; j<targetDim; j++) {
-			seq->setOrdinate(i, j, ordValues[j]);
+	if ( size < 0 ) throw ParseException("Negative number of points in WKB");
+
+	const size_t npts = size;
+
+	// don't trust the size of truncated buffers
+	if ( dis.available() / (8*inputDimension) < npts )
+		throw ParseException("Unexpected EOF parsing WKB");
+
+	vector<Coordinate> *coords = new vector<Coordinate>(npts);
+	try {
+		if ( npts )
+		{
+			// read all ordinates in one go
+			const size_t nords = npts*inputDimension;
+			if ( ordValues.size() < nords ) ordValues.resize(nords);
+			dis.readDoubles(&ordValues[0], nords);
+		}
+
+		const PrecisionModel &pm = *factory.getPrecisionModel();
+		const bool makePrecise = pm.getType() != PrecisionModel::FLOATING;
+		const double *ord = npts ? &ordValues[0] : 0;
+		for (size_t i=0; i<npts; ++i, ord += inputDimension)
+		{
+			Coordinate& c = (*coords)[i];
+			c.x = makePrecise ? pm.makePrecise(ord[0]) : ord[0];
+			c.y = makePrecise ? pm.makePrecise(ord[1]) : ord[1];
+			if ( inputDimension > 2 ) c.z = ord[2];
 		}
+	} catch (...) {
+		delete coords;
+		throw;
 	}
-	return seq;
+
+	// ownership of coords transferred here
+	return factory.getCoordinateSequenceFactory()->create(coords, inputDimension);
 }
 
 void
@@ -39,16 +39,15 @@ namespace noding { // geos::noding
  */
 FastSegmentSetIntersectionFinder::
 FastSegmentSetIntersectionFinder( noding::SegmentString::ConstVect * baseSegStrings)
-:	segSetMutInt( new MCIndexSegmentSetMutualIntersector()),
-	lineIntersector( new LineIntersector())
+:	segSetMutInt( new MCIndexSegmentSetMutualIntersector())
 {
 	segSetMutInt->setBaseSegments( baseSegStrings);
+	segSetMutInt->buildIndex();
 }
 
 FastSegmentSetIntersectionFinder::
 ~FastSegmentSetIntersectionFinder()
 {
-	delete lineIntersector;
 	delete segSetMutInt;
 }
 
@@ -57,7 +56,8 @@ bool
 FastSegmentSetIntersectionFinder::
 intersects( noding::SegmentString::ConstVect * segStrings)
 {
-	SegmentIntersectionDetector intFinder( lineIntersector);
+	LineIntersector li;
+	SegmentIntersectionDetector intFinder( &li);
 
 	return this->intersects( segStrings, &intFinder);
 }
@@ -67,8 +67,7 @@ FastSegmentSetIntersectionFinder::
 intersects( noding::SegmentString::ConstVect * segStrings, 
 			SegmentIntersectionDetector * intDetector)
 {
-	segSetMutInt->setSegmentIntersector( intDetector);
-	segSetMutInt->process( segStrings);
+	segSetMutInt->process( segStrings, *intDetector);
 
 	return intDetector->hasIntersection();
 }
@@ -21,6 +21,9 @@
 #include <geos/noding/NodedSegmentString.h>
 #include <geos/index/chain/MonotoneChain.h> 
 #include <geos/index/chain/MonotoneChainBuilder.h> 
+#include <geos/algorithm/LineIntersector.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/util/TaskGroup.h>
 
 #include <cassert>
 #include <functional>
@@ -40,6 +43,105 @@ using namespace geos::index::chain;
 namespace geos {
 namespace noding { // geos.noding
 
+namespace {
+
+/// Fewer chains are not worth the threads
+const size_t MIN_PARALLEL_CHAINS = 256;
+
+/// A pair of segments found to intersect
+struct SegmentPair {
+	SegmentString* ss0;
+	SegmentString* ss1;
+	int segIndex0;
+	int segIndex1;
+};
+
+/*
+ * Records the pairs of overlapping segments which intersect.
+ */
+class PairCollector : public MonotoneChainOverlapAction {
+public:
+	PairCollector(vector<SegmentPair>& p)
+		:
+		MonotoneChainOverlapAction(),
+		pairs(p)
+	{}
+
+	void overlap(MonotoneChain& mc1, size_t start1,
+	             MonotoneChain& mc2, size_t start2)
+	{
+		SegmentString* ss0 = const_cast<SegmentString*>(
+			static_cast<const SegmentString *>(mc1.getContext()));
+		SegmentString* ss1 = const_cast<SegmentString*>(
+			static_cast<const SegmentString *>(mc2.getContext()));
+
+		li.computeIntersection(
+			ss0->getCoordinate(start1), ss0->getCoordinate(start1+1),
+			ss1->getCoordinate(start2), ss1->getCoordinate(start2+1));
+		if ( ! li.hasIntersection() ) return;
+
+		SegmentPair p;
+		p.ss0 = ss0;
+		p.ss1 = ss1;
+		p.segIndex0 = static_cast<int>(start1);
+		p.segIndex1 = static_cast<int>(start2);
+		pairs.push_back(p);
+	}
+
+private:
+	vector<SegmentPair>& pairs;
+
+	// Without precision model: only used to tell whether
+	// segments intersect
+	algorithm::LineIntersector li;
+};
+
+/*
+ * Searches the overlaps of a range of chains with the
+ * chains of higher id.
+ */
+class ChainOverlapTask : public util::Task {
+public:
+	ChainOverlapTask(index::SpatialIndex& idx,
+	                 vector<MonotoneChain*>::const_iterator b,
+	                 vector<MonotoneChain*>::const_iterator e)
+		:
+		index(&idx),
+		begin(b),
+		end(e),
+		nOverlaps(0)
+	{}
+
+	void run()
+	{
+		PairCollector collector(pairs);
+		vector<void*> overlapChains;
+		for (vector<MonotoneChain*>::const_iterator i=begin; i!=end; ++i)
+		{
+			MonotoneChain* queryChain = *i;
+			overlapChains.clear();
+			index->query(&(queryChain->getEnvelope()), overlapChains);
+			for (size_t j=0, n=overlapChains.size(); j<n; ++j)
+			{
+				MonotoneChain* testChain =
+					static_cast<MonotoneChain*>(overlapChains[j]);
+				if (testChain->getId() > queryChain->getId()) {
+					queryChain->computeOverlaps(testChain, &collector);
+					nOverlaps++;
+				}
+			}
+		}
+	}
+
+	index::SpatialIndex* index;
+	vector<MonotoneChain*>::const_iterator begin;
+	vector<MonotoneChain*>::const_iterator end;
+	vector<SegmentPair> pairs;
+	int nOverlaps;
+};
+
+} // anonymous namespace
+
 /*public*/
 void
 MCIndexNoder::computeNodes(SegmentString::NonConstVect* inputSegStrings)
@@ -60,6 +162,12 @@ MCIndexNoder::intersectChains()
 {
 	assert(segInt);
 
+	if ( numThreads != 1 && monoChains.size() >= MIN_PARALLEL_CHAINS )
+	{
+		intersectChainsParallel();
+		return;
+	}
+
 	SegmentOverlapAction overlapAction(*segInt);
 
 	for (vector<MonotoneChain*>::iterator
@@ -98,6 +206,47 @@ MCIndexNoder::intersectChains()
 	}
 }
 
+/*private*/
+void
+MCIndexNoder::intersectChainsParallel()
+{
+	// Queries build the index and compute the root bounds:
+	// do it before the threads share it
+	vector<void*> overlapChains;
+	index.query(&(monoChains.front()->getEnvelope()), overlapChains);
+
+	util::TaskGroup group(numThreads);
+
+	// A few ranges per thread even out the load
+	size_t numChains = monoChains.size();
+	size_t numRanges = 4 * group.getNumThreads();
+	vector<ChainOverlapTask> tasks;
+	tasks.reserve(numRanges);
+	for (size_t r=0; r<numRanges; ++r)
+	{
+		tasks.push_back(ChainOverlapTask(index,
+			monoChains.begin() + numChains * r / numRanges,
+			monoChains.begin() + numChains * (r+1) / numRanges));
+	}
+	for (size_t r=0; r<numRanges; ++r) group.add(&tasks[r]);
+	group.run();
+
+	// Ranges are in chain order: this is the order
+	// of the single-threaded search
+	for (size_t r=0; r<numRanges; ++r)
+	{
+		ChainOverlapTask& task = tasks[r];
+		nOverlaps += task.nOverlaps;
+		for (size_t i=0, n=task.pairs.size(); i<n; ++i)
+		{
+			const SegmentPair& p = task.pairs[i];
+			segInt->processIntersections(p.ss0, p.segIndex0,
+			                             p.ss1, p.segIndex1);
+			if (segInt->isDone()) return;
+		}
+	}
+}
+
 /*private*/
 void
 MCIndexNoder::add(SegmentString* segStr)
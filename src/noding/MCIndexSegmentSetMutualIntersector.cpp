@@ -25,6 +25,7 @@
 #include <geos/index/chain/MonotoneChainBuilder.h>
 #include <geos/index/chain/MonotoneChainOverlapAction.h>
 #include <geos/index/strtree/STRtree.h>
+#include <geos/geom/Envelope.h>
 // std
 #include <cstddef>
 
@@ -56,11 +57,20 @@ MCIndexSegmentSetMutualIntersector::addToIndex(SegmentString* segStr)
 void 
 MCIndexSegmentSetMutualIntersector::intersectChains()
 {
-    MCIndexSegmentSetMutualIntersector::SegmentOverlapAction overlapAction( *segInt);
+    nOverlaps += intersectChains(monoChains, *segInt);
+}
 
-    for (MonoChains::size_type i = 0, ni = monoChains.size(); i < ni; ++i)
+/*private*/
+int
+MCIndexSegmentSetMutualIntersector::intersectChains(const MonoChains& chains,
+                                                    SegmentIntersector& si)
+{
+    MCIndexSegmentSetMutualIntersector::SegmentOverlapAction overlapAction(si);
+
+    int overlaps = 0;
+    for (MonoChains::size_type i = 0, ni = chains.size(); i < ni; ++i)
     {
-        MonotoneChain * queryChain = (MonotoneChain *)monoChains[i];
+        MonotoneChain * queryChain = chains[i];
 
         std::vector<void*> overlapChains;
         index->query( &(queryChain->getEnvelope()), overlapChains);
@@ -70,11 +80,12 @@ MCIndexSegmentSetMutualIntersector::intersectChains()
             MonotoneChain * testChain = (MonotoneChain *)(overlapChains[j]);
 
             queryChain->computeOverlaps( testChain, &overlapAction);
-            nOverlaps++;
-            if (segInt->isDone()) 
-                return;
+            overlaps++;
+            if (si.isDone()) 
+                return overlaps;
         }
     }
+    return overlaps;
 }
 
 /*private*/
@@ -157,6 +168,41 @@ MCIndexSegmentSetMutualIntersector::process(SegmentString::ConstVect * segString
     intersectChains();
 }
 
+/*public*/
+void 
+MCIndexSegmentSetMutualIntersector::process(SegmentString::ConstVect * segStrings,
+                                            SegmentIntersector& si)
+{
+    MonoChains chains;
+    try
+    {
+        for (SegmentString::ConstVect::size_type i = 0, n = segStrings->size(); i < n; i++)
+        {
+            SegmentString * seg = (SegmentString *)((*segStrings)[i]);
+            MonotoneChainBuilder::getChains(seg->getCoordinates(), seg, chains);
+        }
+        intersectChains(chains, si);
+    }
+    catch (...)
+    {
+        for (MonoChains::size_type i = 0, n = chains.size(); i < n; i++)
+            delete chains[i];
+        throw;
+    }
+
+    for (MonoChains::size_type i = 0, n = chains.size(); i < n; i++)
+        delete chains[i];
+}
+
+/*public*/
+void 
+MCIndexSegmentSetMutualIntersector::buildIndex()
+{
+    // the tree is built by its first query
+    geom::Envelope env;
+    std::vector<void*> unused;
+    index->query(&env, unused);
+}
 
 /* public */
 void 
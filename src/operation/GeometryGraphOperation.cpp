@@ -52,6 +52,7 @@ GeometryGraphOperation::GeometryGraphOperation(const Geometry *g0,
 	else
 		setComputationPrecision(pm1);
 
+	GraphArena::Scope scope(arena);
 	arg[0]=new GeometryGraph(0, g0,
 		algorithm::BoundaryNodeRule::OGC_SFS_BOUNDARY_RULE);
 	arg[1]=new GeometryGraph(1, g1,
@@ -76,6 +77,7 @@ GeometryGraphOperation::GeometryGraphOperation(const Geometry *g0,
 	else
 		setComputationPrecision(pm1);
 
+	GraphArena::Scope scope(arena);
 	arg[0]=new GeometryGraph(0, g0, boundaryNodeRule);
 	arg[1]=new GeometryGraph(1, g1, boundaryNodeRule);
 }
@@ -89,6 +91,7 @@ GeometryGraphOperation::GeometryGraphOperation(const Geometry *g0):
 
 	setComputationPrecision(pm0);
 
+	GraphArena::Scope scope(arena);
 	arg[0]=new GeometryGraph(0, g0);
 }
 
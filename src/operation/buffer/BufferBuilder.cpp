@@ -374,6 +374,9 @@ BufferBuilder::buffer(const Geometry *g, double distance)
 	// factory must be the same as the one used by the input
 	geomFact=g->getFactory();
 
+	// allocate all graph components from the builder arena
+	GraphArena::Scope arenaScope(arena);
+
   { // This scope is here to force release of resources owned by 
     // OffsetCurveSetBuilder when we're doing with it
 
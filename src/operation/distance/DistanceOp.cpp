@@ -21,6 +21,7 @@
 #include <geos/operation/distance/DistanceOp.h>
 #include <geos/operation/distance/GeometryLocation.h>
 #include <geos/operation/distance/ConnectedElementLocationFilter.h>
+#include <geos/operation/distance/IndexedFacetDistance.h>
 #include <geos/algorithm/PointLocator.h> 
 #include <geos/algorithm/CGAlgorithms.h> 
 #include <geos/geom/Coordinate.h>
@@ -54,6 +55,13 @@ namespace distance { // geos.operation.distance
 using namespace geom;
 //using namespace geom::util;
 
+namespace {
+
+/// Products of the input sizes from which facets are searched by index
+const size_t INDEX_THRESHOLD = 2500;
+
+} // anonymous namespace
+
 /*public static (deprecated)*/
 double
 DistanceOp::distance(const Geometry *g0, const Geometry *g1)
@@ -382,6 +390,13 @@ DistanceOp::computeFacetDistance()
 	using geom::util::LinearComponentExtracter;
 	using geom::util::PointExtracter;
 
+	// comparing all facets is quadratic: index them for large inputs
+	if ( geom[0]->getNumPoints() * geom[1]->getNumPoints() >= INDEX_THRESHOLD )
+	{
+		computeFacetDistanceIndexed();
+		return;
+	}
+
 	vector<GeometryLocation*> locGeom(2);
 
 	/**
@@ -455,6 +470,26 @@ DistanceOp::computeFacetDistance()
 #endif
 }
 
+/*private*/
+void
+DistanceOp::computeFacetDistanceIndexed()
+{
+	IndexedFacetDistance index0(*(geom[0]));
+	IndexedFacetDistance index1(*(geom[1]));
+
+	vector<GeometryLocation*> locGeom(2);
+	double dist = index0.nearestLocations(index1, terminateDistance,
+	                                      locGeom[0], locGeom[1]);
+	if ( locGeom[0] && dist < minDistance )
+	{
+		minDistance = dist;
+		updateMinDistance(locGeom, false);
+		return;
+	}
+	delete locGeom[0];
+	delete locGeom[1];
+}
+
 /*private*/
 void
 DistanceOp::computeMinDistanceLines(
@@ -621,6 +656,13 @@ DistanceOp::isWithinDistance(const geom::Geometry& g0,
 	                     const geom::Geometry& g1,
 	                     double distance)
 {
+	// the search would find out anyway, though less quickly
+	if ( ! g0.isEmpty() && ! g1.isEmpty() &&
+	     g0.getEnvelopeInternal()->distance(g1.getEnvelopeInternal()) > distance )
+	{
+		return false;
+	}
+
 	DistanceOp distOp(g0, g1, distance);
 	return distOp.distance() <= distance;
 }
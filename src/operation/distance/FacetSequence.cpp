@@ -0,0 +1,143 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/operation/distance/FacetSequence.h>
+#include <geos/operation/distance/GeometryLocation.h>
+#include <geos/algorithm/CGAlgorithms.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/LineSegment.h>
+#include <geos/platform.h> // for DoubleInfinity
+
+#include <memory>
+#include <cassert>
+
+using namespace geos::geom;
+using geos::algorithm::CGAlgorithms;
+
+namespace geos {
+namespace operation { // geos.operation
+namespace distance { // geos.operation.distance
+
+/*public*/
+FacetSequence::FacetSequence(const Geometry* comp,
+                             const CoordinateSequence& p,
+                             size_t nstart, size_t nend)
+	:
+	component(comp),
+	pts(&p),
+	start(nstart),
+	end(nend)
+{
+	assert(start < end);
+	assert(end <= pts->size());
+	for (size_t i=start; i<end; ++i)
+		env.expandToInclude(pts->getX(i), pts->getY(i));
+}
+
+/*public*/
+double
+FacetSequence::distance(const FacetSequence& other) const
+{
+	return computeDistance(other, 0, 0);
+}
+
+/*public*/
+double
+FacetSequence::nearestLocations(const FacetSequence& other,
+                                GeometryLocation*& loc0,
+                                GeometryLocation*& loc1) const
+{
+	return computeDistance(other, &loc0, &loc1);
+}
+
+/*private*/
+double
+FacetSequence::computeDistance(const FacetSequence& other,
+                               GeometryLocation** loc0,
+                               GeometryLocation** loc1) const
+{
+	const CoordinateSequence& pts1 = *other.pts;
+
+	// Facet pairs are tested as DistanceOp does, keeping the first
+	// nearest one, so that the same pair is found for the same input
+	double minDistance = DoubleInfinity;
+	size_t i0 = start, i1 = other.start;
+
+	if ( isPoint() && other.isPoint() )
+	{
+		minDistance = pts->getAt(start).distance(pts1.getAt(other.start));
+	}
+	else if ( isPoint() )
+	{
+		const Coordinate& p = pts->getAt(start);
+		for (size_t j=other.start; j+1<other.end; ++j)
+		{
+			double d = CGAlgorithms::distancePointLine(p,
+				pts1.getAt(j), pts1.getAt(j+1));
+			if ( d < minDistance ) { minDistance = d; i1 = j; }
+		}
+	}
+	else if ( other.isPoint() )
+	{
+		const Coordinate& p = pts1.getAt(other.start);
+		for (size_t i=start; i+1<end; ++i)
+		{
+			double d = CGAlgorithms::distancePointLine(p,
+				pts->getAt(i), pts->getAt(i+1));
+			if ( d < minDistance ) { minDistance = d; i0 = i; }
+		}
+	}
+	else
+	{
+		for (size_t i=start; i+1<end; ++i)
+		{
+			const Coordinate& p0 = pts->getAt(i);
+			const Coordinate& p1 = pts->getAt(i+1);
+			for (size_t j=other.start; j+1<other.end; ++j)
+			{
+				double d = CGAlgorithms::distanceLineLine(p0, p1,
+					pts1.getAt(j), pts1.getAt(j+1));
+				if ( d < minDistance ) { minDistance = d; i0 = i; i1 = j; }
+			}
+		}
+	}
+
+	if ( ! loc0 ) return minDistance;
+
+	Coordinate c0 = pts->getAt(i0);
+	Coordinate c1 = pts1.getAt(i1);
+	if ( ! isPoint() && ! other.isPoint() )
+	{
+		LineSegment seg0(pts->getAt(i0), pts->getAt(i0+1));
+		LineSegment seg1(pts1.getAt(i1), pts1.getAt(i1+1));
+		std::auto_ptr<CoordinateSequence> closest(seg0.closestPoints(seg1));
+		c0 = closest->getAt(0);
+		c1 = closest->getAt(1);
+	}
+	else if ( ! isPoint() )
+	{
+		LineSegment(pts->getAt(i0), pts->getAt(i0+1)).closestPoint(c1, c0);
+	}
+	else if ( ! other.isPoint() )
+	{
+		LineSegment(pts1.getAt(i1), pts1.getAt(i1+1)).closestPoint(c0, c1);
+	}
+
+	*loc0 = new GeometryLocation(component, static_cast<int>(i0), c0);
+	*loc1 = new GeometryLocation(other.component, static_cast<int>(i1), c1);
+	return minDistance;
+}
+
+} // namespace geos.operation.distance
+} // namespace geos.operation
+} // namespace geos
@@ -0,0 +1,160 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/operation/distance/IndexedFacetDistance.h>
+#include <geos/operation/distance/FacetSequence.h>
+#include <geos/operation/distance/GeometryLocation.h>
+#include <geos/index/strtree/ItemDistance.h>
+#include <geos/index/strtree/ItemBoundable.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/LineString.h>
+#include <geos/geom/Point.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/util/LinearComponentExtracter.h>
+#include <geos/geom/util/PointExtracter.h>
+
+#include <algorithm> // std::min
+#include <utility> // std::pair
+
+using namespace std;
+using namespace geos::geom;
+using geos::index::strtree::ItemBoundable;
+
+namespace geos {
+namespace operation { // geos.operation
+namespace distance { // geos.operation.distance
+
+namespace {
+
+/// Node capacity of the facet trees: few facets per leaf prune best
+const size_t NODE_CAPACITY = 4;
+
+class FacetSequenceDistance: public index::strtree::ItemDistance {
+public:
+	double distance(const ItemBoundable* item1, const ItemBoundable* item2)
+	{
+		const FacetSequence* fs1 =
+			static_cast<const FacetSequence*>(item1->getItem());
+		const FacetSequence* fs2 =
+			static_cast<const FacetSequence*>(item2->getItem());
+		return fs1->distance(*fs2);
+	}
+};
+
+} // anonymous namespace
+
+const size_t IndexedFacetDistance::FACET_SEQUENCE_SIZE;
+
+/*public*/
+IndexedFacetDistance::IndexedFacetDistance(const Geometry& g)
+	:
+	tree(NODE_CAPACITY)
+{
+	addFacetSequences(g, facets);
+
+	// the vector does not move anymore: index its elements
+	for (size_t i=0, n=facets.size(); i<n; ++i)
+		tree.insert(&facets[i].getEnvelope(), &facets[i]);
+	tree.build();
+}
+
+/*public*/
+IndexedFacetDistance::~IndexedFacetDistance()
+{
+}
+
+/*private static*/
+void
+IndexedFacetDistance::addFacetSequences(const Geometry& g,
+                                        vector<FacetSequence>& facets)
+{
+	LineString::ConstVect lines;
+	util::LinearComponentExtracter::getLines(g, lines);
+	for (size_t l=0, nl=lines.size(); l<nl; ++l)
+	{
+		const CoordinateSequence& pts = *(lines[l]->getCoordinatesRO());
+		size_t n = pts.size();
+		if ( n == 0 ) continue;
+		if ( n == 1 )
+		{
+			facets.push_back(FacetSequence(lines[l], pts, 0, 1));
+			continue;
+		}
+		// consecutive sequences share their end point
+		for (size_t i=0; i+1<n; i+=FACET_SEQUENCE_SIZE)
+		{
+			size_t end = min(i+FACET_SEQUENCE_SIZE, n-1) + 1;
+			facets.push_back(FacetSequence(lines[l], pts, i, end));
+		}
+	}
+
+	Point::ConstVect points;
+	util::PointExtracter::getPoints(g, points);
+	for (size_t i=0, n=points.size(); i<n; ++i)
+	{
+		if ( points[i]->isEmpty() ) continue;
+		facets.push_back(FacetSequence(points[i],
+			*(points[i]->getCoordinatesRO()), 0, 1));
+	}
+}
+
+/*public static*/
+double
+IndexedFacetDistance::distance(const Geometry& g1, const Geometry& g2)
+{
+	IndexedFacetDistance ifd(g1);
+	return ifd.getDistance(g2);
+}
+
+/*public*/
+double
+IndexedFacetDistance::getDistance(const Geometry& g)
+{
+	IndexedFacetDistance other(g);
+	FacetSequenceDistance itemDist;
+	pair<void*, void*> nearest = tree.nearestNeighbour(other.tree, &itemDist);
+	if ( ! nearest.first ) return 0.0;
+	return static_cast<FacetSequence*>(nearest.first)->distance(
+		*static_cast<FacetSequence*>(nearest.second));
+}
+
+/*public*/
+bool
+IndexedFacetDistance::isWithinDistance(const Geometry& g, double maxDistance)
+{
+	IndexedFacetDistance other(g);
+	FacetSequenceDistance itemDist;
+	return tree.isWithinDistance(other.tree, &itemDist, maxDistance);
+}
+
+/*public*/
+double
+IndexedFacetDistance::nearestLocations(IndexedFacetDistance& other,
+                                       double terminateDistance,
+                                       GeometryLocation*& loc0,
+                                       GeometryLocation*& loc1)
+{
+	loc0 = loc1 = 0;
+
+	FacetSequenceDistance itemDist;
+	pair<void*, void*> nearest =
+		tree.nearestNeighbour(other.tree, &itemDist, terminateDistance);
+	if ( ! nearest.first ) return 0.0;
+
+	const FacetSequence* fs0 = static_cast<FacetSequence*>(nearest.first);
+	const FacetSequence* fs1 = static_cast<FacetSequence*>(nearest.second);
+	return fs0->nearestLocations(*fs1, loc0, loc1);
+}
+
+} // namespace geos.operation.distance
+} // namespace geos.operation
+} // namespace geos
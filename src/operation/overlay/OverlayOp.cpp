@@ -38,6 +38,7 @@
 #include <geos/geomgraph/Edge.h>
 #include <geos/geomgraph/Node.h>
 #include <geos/geomgraph/GeometryGraph.h>
+#include <geos/geomgraph/GraphArena.h>
 #include <geos/geomgraph/EdgeEndStar.h>
 #include <geos/geomgraph/DirectedEdgeStar.h>
 #include <geos/geomgraph/DirectedEdge.h>
@@ -648,6 +649,8 @@ void
 OverlayOp::computeOverlay(OverlayOp::OpCode opCode)
 	//throw(TopologyException *)
 {
+	// allocate all graph components from the operation arena
+	GraphArena::Scope arenaScope(arena);
 
 	// copy points from input Geometries.
 	// This ensures that any Point geometries
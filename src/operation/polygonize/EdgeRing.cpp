@@ -26,7 +26,10 @@
 #include <geos/geom/Envelope.h>
 #include <geos/geom/GeometryFactory.h>
 #include <geos/geom/CoordinateSequenceFactory.h>
+#include <geos/geom/Location.h>
 #include <geos/algorithm/CGAlgorithms.h>
+#include <geos/algorithm/RayCrossingCounter.h>
+#include <geos/algorithm/locate/IndexedPointInAreaLocator.h>
 
 #include <vector>
 #include <cassert>
@@ -51,7 +54,6 @@ EdgeRing::findEdgeRingContaining(EdgeRing *testEr,
 	const LinearRing *testRing=testEr->getRingInternal();
 	if ( ! testRing ) return NULL;
 	const Envelope *testEnv=testRing->getEnvelopeInternal();
-	Coordinate testPt=testRing->getCoordinateN(0);
 	EdgeRing *minShell=NULL;
 	const Envelope *minEnv=NULL;
 
@@ -61,27 +63,19 @@ EdgeRing::findEdgeRingContaining(EdgeRing *testEr,
 		LinearRing *tryRing=tryShell->getRingInternal();
 		const Envelope *tryEnv=tryRing->getEnvelopeInternal();
 		if (minShell!=NULL) minEnv=minShell->getRingInternal()->getEnvelopeInternal();
-		bool isContained=false;
 
 		// the hole envelope cannot equal the shell envelope
-
 		if (tryEnv->equals(testEnv)) continue;
 
-		const CoordinateSequence *tryCoords =
-			tryRing->getCoordinatesRO();
+		// nor be outside of it
+		if (!tryEnv->contains(testEnv)) continue;
 
-		testPt=ptNotInList(testRing->getCoordinatesRO(),
-			tryCoords);
+		if (!tryShell->containsRing(testRing->getCoordinatesRO())) continue;
 
-		if (tryEnv->contains(testEnv)
-			&& CGAlgorithms::isPointInRing(testPt, tryCoords))
-				isContained=true;
 		// check if this new containing ring is smaller
 		// than the current minimum ring
-		if (isContained) {
-			if (minShell==NULL || minEnv->contains(tryEnv)) {
-				minShell=tryShell;
-			}
+		if (minShell==NULL || minEnv->contains(tryEnv)) {
+			minShell=tryShell;
 		}
 	}
 	return minShell;
@@ -122,7 +116,8 @@ EdgeRing::EdgeRing(const GeometryFactory *newFactory)
 	factory(newFactory),
 	ring(0),
 	ringPts(0),
-	holes(0)
+	holes(0),
+	ringLocator(0)
 {
 #ifdef DEBUG_ALLOC
 	cerr<<"["<<this<<"] EdgeRing(factory)"<<endl;
@@ -140,6 +135,7 @@ EdgeRing::~EdgeRing()
 			delete (*holes)[i];
 		delete holes;
 	}
+	deleteLocator();
 	delete ring;
 	delete ringPts;
 }
@@ -170,6 +166,7 @@ EdgeRing::addHole(LinearRing *hole)
 Polygon*
 EdgeRing::getPolygon()
 {
+	deleteLocator(); // refers to ring
 	Polygon *poly=factory->createPolygon(ring, holes);
 	ring=NULL;
 	holes=NULL;
@@ -233,10 +230,41 @@ LinearRing *
 EdgeRing::getRingOwnership()
 {
 	LinearRing *ret = getRingInternal();
+	deleteLocator(); // refers to ring
 	ring = NULL;
 	return ret;
 }
 
+/*private*/
+bool
+EdgeRing::containsRing(const CoordinateSequence *testPts)
+{
+	const LinearRing *r = getRingInternal();
+	const CoordinateSequence *pts = r->getCoordinatesRO();
+	if ( ! ringLocator && pts->getSize() >= MIN_INDEXED_POINTS )
+	{
+		ringLocator = new algorithm::locate::IndexedPointInAreaLocator(*r);
+	}
+
+	for (std::size_t i=0, n=testPts->getSize(); i<n; ++i)
+	{
+		const Coordinate& pt = testPts->getAt(i);
+		int loc = ringLocator ?
+			ringLocator->locate(&pt) :
+			algorithm::RayCrossingCounter::locatePointInRing(pt, *pts);
+		if ( loc != Location::BOUNDARY ) return loc == Location::INTERIOR;
+	}
+	return false;
+}
+
+/*private*/
+void
+EdgeRing::deleteLocator()
+{
+	delete ringLocator;
+	ringLocator = 0;
+}
+
 /*private*/
 void
 EdgeRing::addEdge(const CoordinateSequence *coords, bool isForward,
@@ -21,11 +21,21 @@
 #include <geos/operation/polygonize/Polygonizer.h>
 #include <geos/operation/polygonize/PolygonizeGraph.h>
 #include <geos/operation/polygonize/EdgeRing.h>
+#include <geos/operation/polygonize/PolygonizeEdge.h>
+#include <geos/planargraph/Subgraph.h>
+#include <geos/planargraph/algorithm/ConnectedSubgraphFinder.h>
 #include <geos/geom/LineString.h>
 #include <geos/geom/Geometry.h>
 #include <geos/geom/Polygon.h>
+#include <geos/geom/LinearRing.h>
+#include <geos/geom/Envelope.h>
+#include <geos/index/strtree/STRtree.h>
+#include <geos/util/TaskGroup.h>
 // std
 #include <vector>
+#include <map>
+#include <set>
+#include <algorithm>
 
 #ifdef _MSC_VER
 #pragma warning(disable:4355)
@@ -42,6 +52,67 @@ namespace geos {
 namespace operation { // geos.operation
 namespace polygonize { // geos.operation.polygonize
 
+namespace {
+
+// Components are grouped in at most this many tasks, whatever
+// the number of threads, so that the output does not depend on it
+const std::size_t MAX_COMPONENT_TASKS = 64;
+
+// Groups of components with less edges are not worth a task
+const std::size_t MIN_TASK_EDGES = 256;
+
+} // anonymous namespace
+
+/*
+ * Polygonizes the lines of a group of connected components of the
+ * input in a graph of its own, which is kept for the EdgeRings
+ * it owns.
+ */
+class Polygonizer::ComponentTask: public util::Task
+{
+public:
+	ComponentTask()
+		: graph(NULL)
+	{}
+
+	~ComponentTask()
+	{
+		delete graph;
+		for (size_t i=0, n=invalidRingLines.size(); i<n; ++i)
+			delete invalidRingLines[i];
+	}
+
+	void run()
+	{
+		graph = new PolygonizeGraph(lines.front()->getFactory());
+		for (size_t i=0, n=lines.size(); i<n; ++i)
+			graph->addEdge(lines[i]);
+
+		graph->deleteDangles(dangles);
+		graph->deleteCutEdges(cutEdges);
+
+		vector<EdgeRing*> edgeRingList;
+		graph->getEdgeRings(edgeRingList);
+		vector<EdgeRing*> validEdgeRingList;
+		findValidRings(edgeRingList, validEdgeRingList, invalidRingLines);
+		findShellsAndHoles(validEdgeRingList, holeList, shellList);
+	}
+
+	vector<const LineString*> lines;
+
+	PolygonizeGraph* graph;
+	vector<const LineString*> dangles;
+	vector<const LineString*> cutEdges;
+	vector<LineString*> invalidRingLines;
+	vector<EdgeRing*> holeList;
+	vector<EdgeRing*> shellList;
+
+private:
+	// Declare type as noncopyable
+	ComponentTask(const ComponentTask& other);
+	ComponentTask& operator=(const ComponentTask& rhs);
+};
+
 Polygonizer::LineStringAdder::LineStringAdder(Polygonizer *p):
 	pol(p)
 {
@@ -67,7 +138,9 @@ Polygonizer::Polygonizer():
 	invalidRingLines(),
 	holeList(),
 	shellList(),
-	polyList(NULL)
+	polyList(NULL),
+	numThreads(1),
+	componentGraphs()
 {
 }
 
@@ -75,6 +148,9 @@ Polygonizer::~Polygonizer()
 {
 	delete graph;
 
+	for (unsigned int i=0, n=componentGraphs.size(); i<n; ++i)
+		delete componentGraphs[i];
+
 	for (unsigned int i=0, n=invalidRingLines.size(); i<n; ++i)
 		delete invalidRingLines[i];
 
@@ -213,29 +289,36 @@ Polygonizer::polygonize()
 	// if no geometries were supplied it's possible graph could be null
 	if (graph==NULL) return; 
 
-	graph->deleteDangles(dangles);
+	invalidRingLines.clear(); /* what if it was populated already ? we should clean ! */
+
+	size_t threads = numThreads ? numThreads
+	                            : util::TaskGroup::getNumProcessors();
+	if (threads > 1)
+	{
+		polygonizeComponents(threads);
+	}
+	else
+	{
+		graph->deleteDangles(dangles);
 
-	graph->deleteCutEdges(cutEdges);
+		graph->deleteCutEdges(cutEdges);
 
-	vector<EdgeRing*> edgeRingList;
-	graph->getEdgeRings(edgeRingList);
+		vector<EdgeRing*> edgeRingList;
+		graph->getEdgeRings(edgeRingList);
 #if GEOS_DEBUG
-	cerr<<"Polygonizer::polygonize(): "<<edgeRingList.size()<<" edgeRings in graph"<<endl;
+		cerr<<"Polygonizer::polygonize(): "<<edgeRingList.size()<<" edgeRings in graph"<<endl;
 #endif
-	vector<EdgeRing*> validEdgeRingList;
-	invalidRingLines.clear(); /* what if it was populated already ? we should clean ! */
-	findValidRings(edgeRingList, validEdgeRingList, invalidRingLines);
+		vector<EdgeRing*> validEdgeRingList;
+		findValidRings(edgeRingList, validEdgeRingList, invalidRingLines);
+		findShellsAndHoles(validEdgeRingList, holeList, shellList);
+	}
 #if GEOS_DEBUG
-	cerr<<"                           "<<validEdgeRingList.size()<<" valid"<<endl;
 	cerr<<"                           "<<invalidRingLines.size()<<" invalid"<<endl;
-#endif
-
-	findShellsAndHoles(validEdgeRingList);
-#if GEOS_DEBUG
 	cerr<<"                           "<<holeList.size()<<" holes"<<endl;
 	cerr<<"                           "<<shellList.size()<<" shells"<<endl;
 #endif
 
+	// Holes may lie in shells of other components
 	assignHolesToShells(holeList, shellList);
 
 	for (unsigned int i=0, n=shellList.size(); i<n; ++i)
@@ -245,6 +328,94 @@ Polygonizer::polygonize()
 	}
 }
 
+/* private */
+void
+Polygonizer::polygonizeComponents(size_t threads)
+{
+	typedef vector<planargraph::Edge*> EdgeList;
+
+	holeList.clear();
+	shellList.clear();
+
+	// Number the connected components
+	map<const planargraph::Edge*, size_t> componentOf;
+	vector<planargraph::Subgraph*> subgraphs;
+	planargraph::algorithm::ConnectedSubgraphFinder finder(*graph);
+	finder.getConnectedSubgraphs(subgraphs);
+	for (size_t i=0, n=subgraphs.size(); i<n; ++i)
+	{
+		planargraph::Subgraph* sg = subgraphs[i];
+		for (set<planargraph::Edge*>::iterator it=sg->edgeBegin(),
+				end=sg->edgeEnd(); it!=end; ++it)
+		{
+			componentOf[*it] = i;
+		}
+		delete sg;
+	}
+
+	// Collect the lines of each component in the order they were
+	// added, taking the components in the order of their first line
+	vector< vector<const LineString*> > componentLines(subgraphs.size());
+	vector<size_t> componentOrder;
+	EdgeList* edges = graph->getEdges();
+	for (EdgeList::size_type i=0, n=edges->size(); i<n; ++i)
+	{
+		PolygonizeEdge* e = static_cast<PolygonizeEdge*>((*edges)[i]);
+		vector<const LineString*>& lines = componentLines[componentOf[e]];
+		if ( lines.empty() ) componentOrder.push_back(componentOf[e]);
+		lines.push_back(e->getLine());
+	}
+
+	// Group consecutive components into tasks of similar size
+	size_t taskEdges = max(edges->size() / MAX_COMPONENT_TASKS,
+	                       MIN_TASK_EDGES);
+	vector<ComponentTask*> tasks;
+	try
+	{
+		for (size_t i=0, n=componentOrder.size(); i<n; ++i)
+		{
+			if ( tasks.empty() || tasks.back()->lines.size() >= taskEdges )
+				tasks.push_back(new ComponentTask());
+			vector<const LineString*>& lines =
+				componentLines[componentOrder[i]];
+			tasks.back()->lines.insert(tasks.back()->lines.end(),
+				lines.begin(), lines.end());
+		}
+
+		util::TaskGroup group(threads);
+		for (size_t i=0, n=tasks.size(); i<n; ++i)
+			group.add(tasks[i]);
+		group.run();
+
+		for (size_t i=0, n=tasks.size(); i<n; ++i)
+		{
+			ComponentTask& task = *tasks[i];
+			componentGraphs.push_back(task.graph);
+			task.graph = NULL;
+			dangles.insert(dangles.end(),
+				task.dangles.begin(), task.dangles.end());
+			cutEdges.insert(cutEdges.end(),
+				task.cutEdges.begin(), task.cutEdges.end());
+			invalidRingLines.insert(invalidRingLines.end(),
+				task.invalidRingLines.begin(), task.invalidRingLines.end());
+			task.invalidRingLines.clear();
+			holeList.insert(holeList.end(),
+				task.holeList.begin(), task.holeList.end());
+			shellList.insert(shellList.end(),
+				task.shellList.begin(), task.shellList.end());
+		}
+	}
+	catch (...)
+	{
+		for (size_t i=0, n=tasks.size(); i<n; ++i)
+			delete tasks[i];
+		throw;
+	}
+
+	for (size_t i=0, n=tasks.size(); i<n; ++i)
+		delete tasks[i];
+}
+
 /* private */
 void
 Polygonizer::findValidRings(const vector<EdgeRing*>& edgeRingList,
@@ -271,7 +442,8 @@ Polygonizer::findValidRings(const vector<EdgeRing*>& edgeRingList,
 
 /* private */
 void
-Polygonizer::findShellsAndHoles(const vector<EdgeRing*>& edgeRingList)
+Polygonizer::findShellsAndHoles(const vector<EdgeRing*>& edgeRingList,
+	vector<EdgeRing*>& holeList, vector<EdgeRing*>& shellList)
 {
 	holeList.clear(); 
 	shellList.clear();
@@ -289,10 +461,37 @@ Polygonizer::findShellsAndHoles(const vector<EdgeRing*>& edgeRingList)
 void
 Polygonizer::assignHolesToShells(const vector<EdgeRing*>& holeList, vector<EdgeRing*>& shellList)
 {
+	if ( holeList.empty() ) return;
+
+	// Index the shells, so that each hole only tests the shells
+	// overlapping it. Items point into shellList, to give them
+	// back in list order: the innermost shell is chosen the same
+	// way as when scanning the whole list.
+	index::strtree::STRtree shellIndex;
+	for (unsigned int i=0, n=shellList.size(); i<n; ++i)
+	{
+		const LinearRing *ring = shellList[i]->getRingInternal();
+		shellIndex.insert(ring->getEnvelopeInternal(), &shellList[i]);
+	}
+
+	vector<void*> found;
+	vector<EdgeRing*> candidates;
 	for (unsigned int i=0, n=holeList.size(); i<n; ++i)
 	{
 		EdgeRing *holeER=holeList[i];
-		assignHoleToShell(holeER, shellList);
+		const LinearRing *holeRing = holeER->getRingInternal();
+		if ( ! holeRing ) continue;
+
+		found.clear();
+		shellIndex.query(holeRing->getEnvelopeInternal(), found);
+		sort(found.begin(), found.end());
+
+		candidates.clear();
+		for (vector<void*>::size_type j=0; j<found.size(); ++j)
+		{
+			candidates.push_back(*static_cast<EdgeRing**>(found[j]));
+		}
+		assignHoleToShell(holeER, candidates);
 	}
 }
 
@@ -21,6 +21,9 @@
 #include <geos/geom/LineString.h>
 #include <geos/geom/CoordinateSequence.h>
 #include <geos/algorithm/LineIntersector.h>
+#include <geos/index/chain/SegmentEnvelopeBlock.h>
+
+#include <algorithm> // std::min
 
 using namespace geos::geom;
 
@@ -53,21 +56,17 @@ SegmentIntersectionTester::hasIntersection(
   size_type seq0size = seq0.getSize();
 
   const CoordinateSequence &seq1 = *(testLine.getCoordinatesRO());
-  size_type seq1size = seq1.getSize();
+
+  BlockVect blocks1;
+  buildBlocks(seq1, blocks1);
 
   for (size_type i = 1; i<seq0size && !hasIntersectionVar; ++i)
 	{
     seq0.getAt(i - 1, pt00);
     seq0.getAt(i, pt01);
 
-    for (size_type j = 1; j < seq1size && !hasIntersectionVar; ++j)
-		{
-      seq1.getAt(j-1, pt10);
-      seq1.getAt(j, pt11); 
-		
-			li.computeIntersection(pt00, pt01, pt10, pt11);
-			if (li.hasIntersection()) hasIntersectionVar = true;
-		}
+    if (intersectsBlocks(pt00, pt01, seq1, blocks1, pt10, pt11))
+      hasIntersectionVar = true;
 	}
 
 	return hasIntersectionVar;
@@ -80,14 +79,13 @@ SegmentIntersectionTester::hasIntersectionWithEnvelopeFilter(
   typedef std::size_t size_type;
 
 	const CoordinateSequence &seq0 = *(line.getCoordinatesRO());
-  size_type seq0size = seq0.getSize();
 
   const CoordinateSequence &seq1 = *(testLine.getCoordinatesRO());
   size_type seq1size = seq1.getSize();
 
   const Envelope* lineEnv = line.getEnvelopeInternal();
 
-  typedef std::size_t size_type;
+  BlockVect blocks0;
 
   for (size_type i = 1; i<seq1size && !hasIntersectionVar; ++i)
 	{
@@ -97,19 +95,54 @@ SegmentIntersectionTester::hasIntersectionWithEnvelopeFilter(
     // skip test if segment does not intersect query envelope
     if (! lineEnv->intersects(Envelope(pt10, pt11))) continue;
 
-    for (size_type j = 1; j < seq0size && !hasIntersectionVar; ++j)
-		{
-      seq0.getAt(j - 1, pt00);
-      seq0.getAt(j, pt01);
-		
-			li.computeIntersection(pt00, pt01, pt10, pt11);
-			if (li.hasIntersection()) hasIntersectionVar = true;
-		}
+    if (blocks0.empty()) buildBlocks(seq0, blocks0);
+
+    if (intersectsBlocks(pt10, pt11, seq0, blocks0, pt00, pt01))
+      hasIntersectionVar = true;
 	}
 
 	return hasIntersectionVar;
 }
 
+/*private*/
+void
+SegmentIntersectionTester::buildBlocks(const CoordinateSequence& seq,
+	BlockVect& blocks)
+{
+	const std::size_t cap = index::chain::SegmentEnvelopeBlock::CAPACITY;
+	std::size_t nseg = seq.getSize() > 1 ? seq.getSize() - 1 : 0;
+	blocks.resize((nseg + cap - 1) / cap);
+	for (std::size_t b=0; b<blocks.size(); ++b)
+	{
+		std::size_t start = b * cap;
+		blocks[b].setSegments(seq, start, std::min(start + cap, nseg));
+	}
+}
+
+/*private*/
+bool
+SegmentIntersectionTester::intersectsBlocks(
+	const Coordinate& p0, const Coordinate& p1,
+	const CoordinateSequence& seq, const BlockVect& blocks,
+	Coordinate& q0, Coordinate& q1)
+{
+	const std::size_t cap = index::chain::SegmentEnvelopeBlock::CAPACITY;
+	for (std::size_t b=0; b<blocks.size(); ++b)
+	{
+		// only segments with envelopes intersecting p0-p1 may intersect it
+		unsigned int mask = blocks[b].intersecting(p0, p1);
+		for (std::size_t k=b*cap; mask; ++k, mask >>= 1)
+		{
+			if (!(mask & 1)) continue;
+			seq.getAt(k, q0);
+			seq.getAt(k+1, q1);
+			li.computeIntersection(p0, p1, q0, q1);
+			if (li.hasIntersection()) return true;
+		}
+	}
+	return false;
+}
+
 } // namespace predicate
 } // namespace operation
 } // namespace geos
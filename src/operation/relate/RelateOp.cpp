@@ -71,6 +71,8 @@ RelateOp::~RelateOp()
 IntersectionMatrix*
 RelateOp::getIntersectionMatrix()
 {
+	// allocate all graph components from the operation arena
+	geomgraph::GraphArena::Scope arenaScope(arena);
 	return relateComp.computeIM();
 }
 
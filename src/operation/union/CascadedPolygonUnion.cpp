@@ -24,10 +24,12 @@
 #include <geos/geom/MultiPolygon.h>
 #include <geos/geom/util/GeometryCombiner.h>
 #include <geos/geom/util/PolygonExtracter.h>
-#include <geos/index/strtree/STRtree.h>
+#include <geos/index/strtree/PackedSTRtree.h>
+#include <geos/util/TaskGroup.h>
 // std
 #include <cassert>
 #include <cstddef>
+#include <map>
 #include <memory>
 #include <vector>
 
@@ -42,13 +44,60 @@ void GeometryListHolder::deleteItem(geom::Geometry* item)
 }
 
 ///////////////////////////////////////////////////////////////////////////////
-geom::Geometry* CascadedPolygonUnion::Union(std::vector<geom::Polygon*>* polys)
+/**
+ * Unions the children of a node of the tree, whose own children
+ * have already been unioned.
+ */
+class CascadedPolygonUnion::NodeUnionTask: public util::Task
+{
+public:
+    typedef std::map<const index::strtree::ItemsList*, geom::Geometry*> UnionMap;
+
+    NodeUnionTask(CascadedPolygonUnion* o, index::strtree::ItemsList* n,
+                  UnionMap* u)
+      : op(o), node(n), unions(u), result(NULL)
+    {}
+
+    void run()
+    {
+        GeometryListHolder geoms;
+
+        typedef index::strtree::ItemsList::iterator iterator_type;
+        iterator_type end = node->end();
+        for (iterator_type i = node->begin(); i != end; ++i) {
+            if ((*i).get_type() == index::strtree::ItemsListItem::item_is_list) {
+                // take ownership of the union of the child; only the
+                // value is changed, so other tasks can use the map
+                UnionMap::iterator u = unions->find((*i).get_itemslist());
+                assert(u != unions->end());
+                geoms.push_back_owned(u->second);
+                u->second = NULL;
+            }
+            else {
+                geoms.push_back(reinterpret_cast<geom::Geometry*>((*i).get_geometry()));
+            }
+        }
+
+        result = op->binaryUnion(&geoms);
+    }
+
+    CascadedPolygonUnion* op;
+    index::strtree::ItemsList* node;
+    UnionMap* unions;
+    geom::Geometry* result;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+geom::Geometry* CascadedPolygonUnion::Union(std::vector<geom::Polygon*>* polys,
+    std::size_t numThreads)
 {
     CascadedPolygonUnion op (polys);
+    op.setNumThreads(numThreads);
     return op.Union();
 }
 
-geom::Geometry* CascadedPolygonUnion::Union(const geom::MultiPolygon* multipoly)
+geom::Geometry* CascadedPolygonUnion::Union(const geom::MultiPolygon* multipoly,
+    std::size_t numThreads)
 {
     std::vector<geom::Polygon*> polys;
     
@@ -58,6 +107,7 @@ geom::Geometry* CascadedPolygonUnion::Union(const geom::MultiPolygon* multipoly)
         polys.push_back(dynamic_cast<geom::Polygon*>(*i));
 
     CascadedPolygonUnion op (&polys);
+    op.setNumThreads(numThreads);
     return op.Union();
 }
 
@@ -74,7 +124,7 @@ geom::Geometry* CascadedPolygonUnion::Union()
      * This makes unioning more efficient, since vertices are more likely 
      * to be eliminated on each round.
      */
-    index::strtree::STRtree index(STRTREE_NODE_CAPACITY);
+    index::strtree::PackedSTRtree index(STRTREE_NODE_CAPACITY);
 
     typedef std::vector<geom::Polygon*>::iterator iterator_type;
     iterator_type end = inputPolys->end();
@@ -85,6 +135,11 @@ geom::Geometry* CascadedPolygonUnion::Union()
 
     std::auto_ptr<index::strtree::ItemsList> itemTree (index.itemsTree());
 
+    std::size_t threads = numThreads ? numThreads
+                                     : util::TaskGroup::getNumProcessors();
+    if (threads > 1)
+        return unionTreeParallel(itemTree.get(), threads);
+
     return unionTree(itemTree.get());
 }
 
@@ -99,6 +154,63 @@ geom::Geometry* CascadedPolygonUnion::unionTree(
     return binaryUnion(geoms.get());
 }
 
+geom::Geometry* CascadedPolygonUnion::unionTreeParallel(
+    index::strtree::ItemsList* geomTree, std::size_t threads)
+{
+    typedef index::strtree::ItemsList ItemsList;
+    typedef std::vector<ItemsList*> NodeList;
+
+    // The nodes of the tree, by depth
+    std::vector<NodeList> levels(1, NodeList(1, geomTree));
+    for (;;) {
+        NodeList children;
+        const NodeList& parents = levels.back();
+        for (std::size_t i = 0; i < parents.size(); ++i) {
+            ItemsList& node = *(parents[i]);
+            for (std::size_t j = 0; j < node.size(); ++j) {
+                if (node[j].get_type() == index::strtree::ItemsListItem::item_is_list)
+                    children.push_back(node[j].get_itemslist());
+            }
+        }
+        if (children.empty()) break;
+        levels.push_back(children);
+    }
+
+    NodeUnionTask::UnionMap unions;
+    std::vector<NodeUnionTask> tasks;
+    try {
+        for (std::size_t d = levels.size(); d > 0; --d) {
+            const NodeList& nodes = levels[d-1];
+
+            // The children have all been unioned, so each node is
+            // independent from the others at the same depth
+            util::TaskGroup group(threads);
+            tasks.clear();
+            tasks.reserve(nodes.size());
+            for (std::size_t i = 0; i < nodes.size(); ++i) {
+                tasks.push_back(NodeUnionTask(this, nodes[i], &unions));
+                group.add(&tasks.back());
+            }
+            group.run();
+
+            for (std::size_t i = 0; i < tasks.size(); ++i) {
+                unions[tasks[i].node] = tasks[i].result;
+            }
+            tasks.clear();
+        }
+    }
+    catch (...) {
+        for (std::size_t i = 0; i < tasks.size(); ++i)
+            delete tasks[i].result;
+        for (NodeUnionTask::UnionMap::iterator i = unions.begin();
+                i != unions.end(); ++i)
+            delete i->second;
+        throw;
+    }
+
+    return unions[geomTree];
+}
+
 geom::Geometry* CascadedPolygonUnion::binaryUnion(GeometryListHolder* geoms)
 {
     return binaryUnion(geoms, 0, geoms->size());
@@ -226,7 +338,7 @@ CascadedPolygonUnion::restrictToPolygons(std::auto_ptr<geom::Geometry> g)
     }
 
     Polygon::ConstVect polygons;
-    util::PolygonExtracter::getPolygons(*g, polygons);
+    geom::util::PolygonExtracter::getPolygons(*g, polygons);
 
     if (polygons.size() == 1)
       return std::auto_ptr<Geometry>(polygons[0]->clone());
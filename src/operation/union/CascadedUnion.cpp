@@ -21,7 +21,7 @@
 #include <geos/geom/GeometryFactory.h>
 #include <geos/geom/Geometry.h>
 #include <geos/geom/util/GeometryCombiner.h>
-#include <geos/index/strtree/STRtree.h>
+#include <geos/index/strtree/PackedSTRtree.h>
 // std
 #include <cassert>
 #include <cstddef>
@@ -51,7 +51,7 @@ geom::Geometry* CascadedUnion::Union()
      * This makes unioning more efficient, since vertices are more likely 
      * to be eliminated on each round.
      */
-    index::strtree::STRtree index(STRTREE_NODE_CAPACITY);
+    index::strtree::PackedSTRtree index(STRTREE_NODE_CAPACITY);
 
     typedef std::vector<geom::Geometry*>::const_iterator iterator_type;
     iterator_type end = inputGeoms->end();
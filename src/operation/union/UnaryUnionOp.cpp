@@ -99,7 +99,8 @@ UnaryUnionOp::Union()
   GeomAutoPtr unionPolygons;
   if (!polygons.empty()) {
       unionPolygons.reset( CascadedPolygonUnion::Union( polygons.begin(),
-                                                        polygons.end()   ) );
+                                                        polygons.end(),
+                                                        numThreads ) );
   }
 
   /**
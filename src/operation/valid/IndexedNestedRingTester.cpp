@@ -21,7 +21,7 @@
 #include <geos/geom/LinearRing.h> // for use
 #include <geos/algorithm/CGAlgorithms.h> // for use
 #include <geos/operation/valid/IsValidOp.h> // for use (findPtNotNode)
-#include <geos/index/strtree/STRtree.h> // for use
+#include <geos/index/strtree/PackedSTRtree.h> // for use
 
 // Forward declarations
 namespace geos {
@@ -60,10 +60,12 @@ IndexedNestedRingTester::isNonNested()
 				continue;
 			}
 
-                        const geom::Coordinate *innerRingPt =
+			// Without a graph the rings are known not to touch
+			const geom::Coordinate *innerRingPt = graph ?
 				IsValidOp::findPtNotNode(innerRingPts,
 							 searchRing,
-							 graph);
+							 graph) :
+				&innerRingPts->getAt(0);
 
         /**
          * If no non-node pts can be found, this means
@@ -106,7 +108,7 @@ IndexedNestedRingTester::buildIndex()
 {
 	delete index;
 
-	index = new index::strtree::STRtree();
+	index = new index::strtree::PackedSTRtree();
 	for (size_t i=0, n=rings.size(); i<n; ++i)
 	{
 		const geom::LinearRing* ring = rings[i];
@@ -49,7 +49,8 @@ namespace valid { // geos.operation.valid
 class IndexedNestedRingTester
 {
 public:
-	// @param newGraph : ownership retained by caller
+	// @param newGraph : ownership retained by caller, or NULL
+	//                   if the rings are known not to touch
 	IndexedNestedRingTester(geomgraph::GeometryGraph* newGraph)
 		:
 		graph(newGraph),
@@ -28,6 +28,10 @@
 #include <geos/operation/valid/ConnectedInteriorTester.h>
 #include <geos/util/UnsupportedOperationException.h>
 #include <geos/geomgraph/index/SegmentIntersector.h> 
+#include <geos/noding/MCIndexNoder.h>
+#include <geos/noding/BasicSegmentString.h>
+#include <geos/noding/SegmentIntersector.h>
+#include <geos/index/strtree/PackedSTRtree.h>
 #include <geos/geomgraph/GeometryGraph.h> 
 #include <geos/geomgraph/Edge.h> 
 #include <geos/algorithm/MCPointInRing.h> 
@@ -40,11 +44,14 @@
 #include <geos/geom/Polygon.h>
 #include <geos/geom/MultiPolygon.h>
 #include <geos/geom/GeometryCollection.h>
+#include <geos/geom/Envelope.h>
 
 #include <cassert>
 #include <cmath>
 #include <typeinfo>
 #include <set>
+#include <vector>
+#include <cstdlib>
 
 using namespace std;
 using namespace geos::algorithm;
@@ -55,6 +62,141 @@ namespace geos {
 namespace operation { // geos.operation
 namespace valid { // geos.operation.valid
 
+namespace {
+
+/*
+ * Finds the first intersection between the segments of a set of
+ * rings, other than the common vertex of consecutive segments
+ * of a ring.
+ */
+class RingIntersectionFinder: public noding::SegmentIntersector {
+public:
+	RingIntersectionFinder()
+		:
+		found(false),
+		proper(false)
+	{}
+
+	void processIntersections(noding::SegmentString* e0, int segIndex0,
+		noding::SegmentString* e1, int segIndex1)
+	{
+		if (found) return;
+
+		li.computeIntersection(
+			e0->getCoordinate(segIndex0), e0->getCoordinate(segIndex0+1),
+			e1->getCoordinate(segIndex1), e1->getCoordinate(segIndex1+1));
+		if ( ! li.hasIntersection() ) return;
+
+		// rings have no repeated points: consecutive segments
+		// only meet at their common vertex, unless they overlap
+		if ( e0 == e1 && li.getIntersectionNum() == 1 &&
+		     isConsecutive(segIndex0, segIndex1, e0->size()) ) return;
+
+		found = true;
+		proper = li.isProper();
+	}
+
+	bool isDone() const { return found; }
+
+	bool hasIntersection() const { return found; }
+
+	/// A proper intersection is a crossing of the rings
+	bool hasProperIntersection() const { return proper; }
+
+private:
+
+	static bool isConsecutive(int i0, int i1, unsigned int nPts)
+	{
+		int d = abs(i0 - i1);
+		// the last segment closes the ring on the first one
+		return d == 1 || d == static_cast<int>(nPts) - 2;
+	}
+
+	LineIntersector li;
+	bool found;
+	bool proper;
+};
+
+bool
+hasInvalidCoordinates(const CoordinateSequence *cs)
+{
+	for (size_t i=0, n=cs->getSize(); i<n; ++i)
+	{
+		if (! IsValidOp::isValid(cs->getAt(i)) ) return true;
+	}
+	return false;
+}
+
+bool
+hasInvalidCoordinates(const Polygon *poly)
+{
+	if (hasInvalidCoordinates(poly->getExteriorRing()->getCoordinatesRO()))
+		return true;
+	for (size_t i=0, n=poly->getNumInteriorRing(); i<n; ++i)
+	{
+		if (hasInvalidCoordinates(
+				poly->getInteriorRingN(i)->getCoordinatesRO()))
+			return true;
+	}
+	return false;
+}
+
+/*
+ * Number of points of a sequence once repeated points are
+ * removed, as the topology graph does
+ */
+size_t
+countDistinctPoints(const CoordinateSequence *cs)
+{
+	size_t n = cs->getSize();
+	if (n == 0) return 0;
+	size_t count = 1;
+	for (size_t i=1; i<n; ++i)
+	{
+		if (! (cs->getAt(i) == cs->getAt(i-1)) ) ++count;
+	}
+	return count;
+}
+
+/*
+ * Adds a segment string for a ring, removing its repeated points
+ * in a copy only if it has any
+ */
+void
+addRing(const LineString *ring,
+	vector<noding::SegmentString*>& segStrings,
+	vector<CoordinateSequence*>& copies)
+{
+	const CoordinateSequence *pts = ring->getCoordinatesRO();
+	CoordinateSequence *ssPts;
+	if ( pts->hasRepeatedPoints() )
+	{
+		ssPts = CoordinateSequence::removeRepeatedPoints(pts);
+		copies.push_back(ssPts);
+	}
+	else
+	{
+		// only read by the noder
+		ssPts = const_cast<CoordinateSequence*>(pts);
+	}
+	segStrings.push_back(new noding::BasicSegmentString(ssPts, NULL));
+}
+
+/*
+ * Finds intersections between the rings, indexing their monotone
+ * chains as FastNodingValidator does
+ */
+void
+findIntersections(vector<noding::SegmentString*>& segStrings,
+	RingIntersectionFinder& finder)
+{
+	noding::MCIndexNoder noder;
+	noder.setSegmentIntersector(&finder);
+	noder.computeNodes(&segStrings);
+}
+
+} // anonymous namespace
+
 /**
  * Find a point from the list of testCoords
  * that is NOT a node in the edge for the list of searchCoords
@@ -85,6 +227,20 @@ IsValidOp::findPtNotNode(const CoordinateSequence *testCoords,
 bool
 IsValidOp::isValid()
 {
+	if (!isChecked)
+	{
+		switch (checkValidFast(parentGeometry))
+		{
+			case eFastValid:
+				isChecked=true;
+				return true;
+			case eFastInvalid:
+				// the error is only computed on request
+				return false;
+			default:
+				break;
+		}
+	}
 	checkValid();
 	return validErr==NULL;
 }
@@ -292,6 +448,212 @@ IsValidOp::checkValid(const GeometryCollection *gc)
 	}
 }
 
+IsValidOp::FastCheck
+IsValidOp::checkValidFast(const Geometry *g)
+{
+	if (0 == g) return eFastValid;
+
+	// empty geometries are always valid!
+	if (g->isEmpty()) return eFastValid;
+
+	if ( const Point* x = dynamic_cast<const Point*>(g) )
+	{
+		if (hasInvalidCoordinates(x->getCoordinatesRO()))
+			return eFastInvalid;
+		return eFastValid;
+	}
+	// LineString also handles LinearRings, so we check LinearRing first
+	else if ( const LinearRing* x = dynamic_cast<const LinearRing*>(g) )
+		return checkValidFast(x);
+	else if ( const LineString* x = dynamic_cast<const LineString*>(g) )
+		return checkValidFast(x);
+	else if ( const Polygon* x = dynamic_cast<const Polygon*>(g) )
+		return checkValidFast(vector<const Polygon*>(1, x));
+	else if ( const MultiPolygon* x = dynamic_cast<const MultiPolygon*>(g) )
+	{
+		vector<const Polygon*> polys(x->getNumGeometries());
+		for (size_t i=0, n=polys.size(); i<n; ++i)
+		{
+			polys[i] = dynamic_cast<const Polygon*>(x->getGeometryN(i));
+		}
+		return checkValidFast(polys);
+	}
+	else if ( const GeometryCollection* x =
+		dynamic_cast<const GeometryCollection*>(g) )
+	{
+		for (size_t i=0, n=x->getNumGeometries(); i<n; ++i)
+		{
+			FastCheck check = checkValidFast(x->getGeometryN(i));
+			if (check != eFastValid) return check;
+		}
+		return eFastValid;
+	}
+	return eFastUnknown;
+}
+
+IsValidOp::FastCheck
+IsValidOp::checkValidFast(const LineString *g)
+{
+	const CoordinateSequence *pts = g->getCoordinatesRO();
+	if (hasInvalidCoordinates(pts)) return eFastInvalid;
+	if (countDistinctPoints(pts) < 2) return eFastInvalid;
+	return eFastValid;
+}
+
+IsValidOp::FastCheck
+IsValidOp::checkValidFast(const LinearRing *g)
+{
+	const CoordinateSequence *pts = g->getCoordinatesRO();
+	if (hasInvalidCoordinates(pts)) return eFastInvalid;
+	if (!g->isClosed()) return eFastInvalid;
+	// the graph only requires two distinct points of a ring
+	if (countDistinctPoints(pts) < 4) return eFastUnknown;
+
+	vector<noding::SegmentString*> segStrings;
+	vector<CoordinateSequence*> copies;
+	addRing(g, segStrings, copies);
+
+	RingIntersectionFinder finder;
+	findIntersections(segStrings, finder);
+
+	delete segStrings[0];
+	for (size_t i=0; i<copies.size(); ++i) delete copies[i];
+
+	if (finder.hasProperIntersection()) return eFastInvalid;
+	if (finder.hasIntersection()) return eFastUnknown;
+	return eFastValid;
+}
+
+IsValidOp::FastCheck
+IsValidOp::checkValidFast(const vector<const Polygon*>& polys)
+{
+	size_t nRings = 0;
+	for (size_t i=0, n=polys.size(); i<n; ++i)
+	{
+		const Polygon *p = polys[i];
+		if (hasInvalidCoordinates(p)) return eFastInvalid;
+
+		size_t nholes = p->getNumInteriorRing();
+		for (size_t j=0; j<=nholes; ++j)
+		{
+			const LineString *ring = j ? p->getInteriorRingN(j-1)
+			                           : p->getExteriorRing();
+			if (!ring->isClosed() && !ring->isEmpty()) return eFastInvalid;
+		}
+		nRings += nholes + 1;
+	}
+
+	// Empty rings and rings with too few points are left to
+	// the graph, which skips or reports them
+	for (size_t i=0, n=polys.size(); i<n; ++i)
+	{
+		const Polygon *p = polys[i];
+		size_t nholes = p->getNumInteriorRing();
+		for (size_t j=0; j<=nholes; ++j)
+		{
+			const LineString *ring = j ? p->getInteriorRingN(j-1)
+			                           : p->getExteriorRing();
+			if (countDistinctPoints(ring->getCoordinatesRO()) < 4)
+				return eFastUnknown;
+		}
+	}
+
+	vector<noding::SegmentString*> segStrings;
+	vector<CoordinateSequence*> copies;
+	segStrings.reserve(nRings);
+	for (size_t i=0, n=polys.size(); i<n; ++i)
+	{
+		const Polygon *p = polys[i];
+		addRing(p->getExteriorRing(), segStrings, copies);
+		for (size_t j=0, nj=p->getNumInteriorRing(); j<nj; ++j)
+			addRing(p->getInteriorRingN(j), segStrings, copies);
+	}
+
+	RingIntersectionFinder finder;
+	findIntersections(segStrings, finder);
+
+	for (size_t i=0; i<segStrings.size(); ++i) delete segStrings[i];
+	for (size_t i=0; i<copies.size(); ++i) delete copies[i];
+
+	if (finder.hasProperIntersection()) return eFastInvalid;
+	if (finder.hasIntersection()) return eFastUnknown;
+
+	// Rings do not touch: they are simple, no interior can be
+	// disconnected and any vertex of a ring tells on which side
+	// of another ring it lies
+	return checkNotNestedFast(polys);
+}
+
+IsValidOp::FastCheck
+IsValidOp::checkNotNestedFast(const vector<const Polygon*>& polys)
+{
+	for (size_t i=0, n=polys.size(); i<n; ++i)
+	{
+		const Polygon *p = polys[i];
+		size_t nholes = p->getNumInteriorRing();
+		if (nholes == 0) continue;
+
+		const LinearRing *shell = static_cast<const LinearRing*>(
+				p->getExteriorRing());
+		MCPointInRing pir(shell);
+
+		// without a graph the tester takes the first hole points
+		IndexedNestedRingTester nestedTester(NULL);
+		for (size_t j=0; j<nholes; ++j)
+		{
+			const LinearRing *hole = static_cast<const LinearRing*>(
+					p->getInteriorRingN(j));
+			if (!pir.isInside(hole->getCoordinatesRO()->getAt(0)))
+				return eFastInvalid;
+			nestedTester.add(hole);
+		}
+		if (!nestedTester.isNonNested()) return eFastInvalid;
+	}
+
+	if (polys.size() < 2) return eFastValid;
+
+	// A shell is nested in another polygon if one of its points is
+	// inside the polygon shell, but not inside one of its holes
+	geos::index::strtree::PackedSTRtree index;
+	for (size_t i=0, n=polys.size(); i<n; ++i)
+	{
+		index.insert(polys[i]->getExteriorRing()->getEnvelopeInternal(),
+			const_cast<Polygon*>(polys[i]));
+	}
+
+	vector<void*> found;
+	for (size_t i=0, n=polys.size(); i<n; ++i)
+	{
+		const Coordinate& shellPt =
+			polys[i]->getExteriorRing()->getCoordinatesRO()->getAt(0);
+		Envelope env(shellPt);
+		found.clear();
+		index.query(&env, found);
+		for (size_t j=0, nj=found.size(); j<nj; ++j)
+		{
+			const Polygon *p = static_cast<const Polygon*>(found[j]);
+			if (p == polys[i]) continue;
+
+			if (!CGAlgorithms::isPointInRing(shellPt,
+					p->getExteriorRing()->getCoordinatesRO()))
+				continue;
+
+			bool insideHole = false;
+			for (size_t k=0, nk=p->getNumInteriorRing(); k<nk; ++k)
+			{
+				if (CGAlgorithms::isPointInRing(shellPt,
+						p->getInteriorRingN(k)->getCoordinatesRO()))
+				{
+					insideHole = true;
+					break;
+				}
+			}
+			if (!insideHole) return eFastInvalid;
+		}
+	}
+	return eFastValid;
+}
+
 void
 IsValidOp::checkTooFewPoints(GeometryGraph *graph)
 {
@@ -0,0 +1,236 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************/
+
+#include <geos/platform.h> // for HAVE_PTHREAD
+#include <geos/util/TaskGroup.h>
+#include <geos/util/GEOSException.h>
+#include <geos/util/TopologyException.h>
+
+#include <vector>
+#include <algorithm> // std::min
+#include <exception>
+#include <cstddef>
+
+#if defined(_WIN32)
+# define GEOS_TASKGROUP_WIN32 1
+# include <windows.h>
+# include <process.h>
+#elif defined(HAVE_PTHREAD)
+# define GEOS_TASKGROUP_PTHREAD 1
+# include <pthread.h>
+# include <unistd.h>
+#endif
+
+using namespace std;
+
+namespace geos {
+namespace util { // geos.util
+
+namespace {
+
+/// A mutex, or nothing on platforms without threads
+class Mutex {
+#if defined(GEOS_TASKGROUP_WIN32)
+	CRITICAL_SECTION cs;
+public:
+	Mutex() { InitializeCriticalSection(&cs); }
+	~Mutex() { DeleteCriticalSection(&cs); }
+	void lock() { EnterCriticalSection(&cs); }
+	void unlock() { LeaveCriticalSection(&cs); }
+#elif defined(GEOS_TASKGROUP_PTHREAD)
+	pthread_mutex_t m;
+public:
+	Mutex() { pthread_mutex_init(&m, NULL); }
+	~Mutex() { pthread_mutex_destroy(&m); }
+	void lock() { pthread_mutex_lock(&m); }
+	void unlock() { pthread_mutex_unlock(&m); }
+#else
+public:
+	void lock() {}
+	void unlock() {}
+#endif
+};
+
+/// The state shared by the threads running a TaskGroup
+class TaskQueue {
+public:
+
+	TaskQueue(const vector<Task*>& t)
+		:
+		tasks(t),
+		next(0),
+		errors(t.size(), static_cast<GEOSException*>(0))
+	{}
+
+	~TaskQueue()
+	{
+		for (size_t i=0, n=errors.size(); i<n; ++i) delete errors[i];
+	}
+
+	/// Runs tasks until there are no more left
+	void work()
+	{
+		for (;;)
+		{
+			mutex.lock();
+			size_t i = next++;
+			mutex.unlock();
+
+			if ( i >= tasks.size() ) return;
+
+			// each thread only writes to the slots of its own tasks
+			try {
+				tasks[i]->run();
+			}
+			catch (const TopologyException& e) {
+				errors[i] = new TopologyException(e);
+			}
+			catch (const GEOSException& e) {
+				errors[i] = new GEOSException(e);
+			}
+			catch (const std::exception& e) {
+				errors[i] = new GEOSException(e.what());
+			}
+			catch (...) {
+				errors[i] = new GEOSException("Unknown exception thrown");
+			}
+		}
+	}
+
+	/// Throws the exception of the first failed task, if any
+	void rethrow() const
+	{
+		for (size_t i=0, n=errors.size(); i<n; ++i)
+		{
+			if ( ! errors[i] ) continue;
+			if ( TopologyException* te =
+			     dynamic_cast<TopologyException*>(errors[i]) )
+			{
+				throw TopologyException(*te);
+			}
+			throw GEOSException(*errors[i]);
+		}
+	}
+
+private:
+
+	const vector<Task*>& tasks;
+
+	size_t next;
+
+	vector<GEOSException*> errors;
+
+	Mutex mutex;
+};
+
+#if defined(GEOS_TASKGROUP_WIN32)
+
+unsigned __stdcall
+threadMain(void* arg)
+{
+	static_cast<TaskQueue*>(arg)->work();
+	return 0;
+}
+
+#elif defined(GEOS_TASKGROUP_PTHREAD)
+
+void*
+threadMain(void* arg)
+{
+	static_cast<TaskQueue*>(arg)->work();
+	return NULL;
+}
+
+#endif
+
+} // anonymous namespace
+
+/*public*/
+TaskGroup::TaskGroup(size_t nThreads)
+	:
+	numThreads(nThreads ? nThreads : getNumProcessors())
+{
+}
+
+/*public*/
+TaskGroup::~TaskGroup()
+{
+}
+
+/*public static*/
+size_t
+TaskGroup::getNumProcessors()
+{
+#if defined(GEOS_TASKGROUP_WIN32)
+	SYSTEM_INFO info;
+	GetSystemInfo(&info);
+	return info.dwNumberOfProcessors > 0 ? info.dwNumberOfProcessors : 1;
+#elif defined(GEOS_TASKGROUP_PTHREAD) && defined(_SC_NPROCESSORS_ONLN)
+	long n = sysconf(_SC_NPROCESSORS_ONLN);
+	return n > 0 ? static_cast<size_t>(n) : 1;
+#else
+	return 1;
+#endif
+}
+
+/*public*/
+void
+TaskGroup::run()
+{
+	TaskQueue queue(tasks);
+
+	// One of the workers is the calling thread
+	size_t numWorkers = min(numThreads, tasks.size());
+	size_t numSpawned = 0;
+
+#if defined(GEOS_TASKGROUP_WIN32)
+	vector<HANDLE> threads;
+	for (size_t i=1; i<numWorkers; ++i)
+	{
+		uintptr_t h = _beginthreadex(NULL, 0, threadMain, &queue, 0, NULL);
+		if ( ! h ) break; // the other threads will do the work
+		threads.push_back(reinterpret_cast<HANDLE>(h));
+	}
+	numSpawned = threads.size();
+#elif defined(GEOS_TASKGROUP_PTHREAD)
+	vector<pthread_t> threads(numWorkers ? numWorkers-1 : 0);
+	for (size_t i=0; i<threads.size(); ++i)
+	{
+		if ( pthread_create(&threads[i], NULL, threadMain, &queue) ) break;
+		++numSpawned;
+	}
+#endif
+
+	queue.work();
+
+#if defined(GEOS_TASKGROUP_WIN32)
+	for (size_t i=0; i<numSpawned; ++i)
+	{
+		WaitForSingleObject(threads[i], INFINITE);
+		CloseHandle(threads[i]);
+	}
+#elif defined(GEOS_TASKGROUP_PTHREAD)
+	for (size_t i=0; i<numSpawned; ++i)
+	{
+		pthread_join(threads[i], NULL);
+	}
+#else
+	(void)numWorkers;
+	(void)numSpawned;
+#endif
+
+	tasks.clear();
+	queue.rethrow();
+}
+
+} // namespace geos.util
+} // namespace geos
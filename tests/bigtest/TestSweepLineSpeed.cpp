@@ -61,9 +61,22 @@
 
 #include <geos/geom/GeometryFactory.h>
 #include <geos/geom/Polygon.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/CoordinateArraySequence.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geomgraph/Edge.h>
+#include <geos/geomgraph/index/EdgeSetIntersector.h>
+#include <geos/geomgraph/index/SimpleMCSweepLineIntersector.h>
+#include <geos/geomgraph/index/RadixMCSweepLineIntersector.h>
+#include <geos/geomgraph/index/SegmentIntersector.h>
+#include <geos/algorithm/LineIntersector.h>
 #include "bigtest.h"
 
+#include <vector>
+
 using namespace geos::geom;
+using namespace geos::geomgraph;
+using namespace geos::geomgraph::index;
 
 /**
  * Run relate between two large geometries to test the performance
@@ -89,6 +102,65 @@ void run(int nPts, GeometryFactory *fact) {
     // FIXME - mloskot: Why generated test geometries are not destroyed?"
 }
 
+/**
+ * A zigzag of nPts points from (x, y), split into edges of 16 points.
+ * Each segment is a monotone chain of its own.
+ */
+void zigzag(double x, double y, int nPts, std::vector<Edge*>& edges) {
+	CoordinateSequence *pts=NULL;
+	for (int i=0; i<nPts; ++i) {
+		if (i % 15 == 0) {
+			if (pts) {
+				pts->add(Coordinate(x+i, y+(i%2)));
+				edges.push_back(new Edge(pts));
+			}
+			pts=new CoordinateArraySequence();
+		}
+		pts->add(Coordinate(x+i, y+(i%2)));
+	}
+	if (pts->getSize() > 1) edges.push_back(new Edge(pts));
+	else delete pts;
+	// the chains are computed once per edge, outside of the timings
+	for (size_t i=0; i<edges.size(); ++i) edges[i]->getMonotoneChainEdge();
+}
+
+/**
+ * Compute the intersections of two crossing zigzags with an
+ * EdgeSetIntersector, returning the number of segment tests
+ */
+int intersectEdges(EdgeSetIntersector& esi, int nPts, double& msecs) {
+	std::vector<Edge*> edges0, edges1;
+	zigzag(0.0, 0.0, nPts, edges0);
+	zigzag(0.5, 0.0, nPts, edges1);
+	geos::algorithm::LineIntersector li;
+	SegmentIntersector si(&li, true, false);
+
+	clock_t startTime=clock();
+	esi.computeIntersections(&edges0, &edges1, &si);
+	msecs = 1000.0 * (clock() - startTime) / CLOCKS_PER_SEC;
+
+	for (size_t i=0; i<edges0.size(); ++i) delete edges0[i];
+	for (size_t i=0; i<edges1.size(); ++i) delete edges1[i];
+	return si.numTests;
+}
+
+/**
+ * Compare the sweepline sorting events by pointer with the one
+ * radix sorting value events
+ */
+bool compare(int nPts) {
+	double simpleTime, radixTime;
+	SimpleMCSweepLineIntersector simple;
+	int simpleTests = intersectEdges(simple, nPts, simpleTime);
+	RadixMCSweepLineIntersector radix;
+	int radixTests = intersectEdges(radix, nPts, radixTime);
+
+	printf( "n Pts: %i  SimpleMC %6.1f ms, RadixMC %6.1f ms, %i tests\n",
+		nPts, simpleTime, radixTime, radixTests);
+
+	return simpleTests == radixTests;
+}
+
 int main(int /* argc */, char** /* argv[] */) {
 
 	GeometryFactory *fact=new GeometryFactory();
@@ -105,6 +177,13 @@ int main(int /* argc */, char** /* argv[] */) {
 	run(512000,fact);
 	run(1024000,fact);
 
+	for (int nPts=1000; nPts<=64000; nPts*=4) {
+		if ( ! compare(nPts) ) {
+			cout << "Intersectors disagree" << endl;
+			return 1;
+		}
+	}
+
 //	_CrtDumpMemoryLeaks();
 
 	cout << "Done" << endl;
@@ -0,0 +1,139 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Compares the memory held by small polygons as Geometry trees and
+ * as CompactGeometry blocks, and times intersects and distance
+ * queries against both
+ *
+ **********************************************************************/
+
+#include <geos/geom/CompactGeometry.h>
+#include <geos/geom/CoordinateArraySequence.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/LinearRing.h>
+#include <geos/geom/Polygon.h>
+#include <geos/profiler.h>
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <cstdlib>
+#include <cmath>
+
+using namespace geos::geom;
+using namespace std;
+
+class CompactGeometryPerfTest
+{
+public:
+
+  // Random polygons of nVertices vertices (plus closing point),
+  // a few units wide, scattered over the extent
+  CompactGeometryPerfTest(size_t nPolys, size_t nVertices)
+  {
+    srand(4711);
+    for (size_t i=0; i<nPolys; ++i) {
+      double cx = rand() % EXTENT;
+      double cy = rand() % EXTENT;
+      CoordinateSequence* seq = new CoordinateArraySequence();
+      for (size_t j=0; j<nVertices; ++j) {
+        double a = 2 * M_PI * j / nVertices;
+        double r = 1 + rand() % 4;
+        seq->add(Coordinate(cx + r * cos(a), cy + r * sin(a)));
+      }
+      seq->add(seq->getAt(0));
+      polys.push_back(gf.createPolygon(gf.createLinearRing(seq), 0));
+    }
+  }
+
+  ~CompactGeometryPerfTest()
+  {
+    for (size_t i=0; i<polys.size(); ++i) delete polys[i];
+    for (size_t i=0; i<compact.size(); ++i) delete compact[i];
+  }
+
+  void testMemory()
+  {
+    geos::util::Profile prof("CompactGeometry::create");
+
+    prof.start();
+    for (size_t i=0; i<polys.size(); ++i)
+      compact.push_back(CompactGeometry::create(*polys[i]).release());
+    prof.stop();
+
+    // Each allocation also costs some malloc bookkeeping:
+    // a Polygon, its holes vector, the shell, its sequence and
+    // the sequence vector for the tree, a single block otherwise
+    size_t treeBytes = 0, compactBytes = 0;
+    for (size_t i=0; i<polys.size(); ++i) {
+      polys[i]->getEnvelopeInternal(); // as after any query
+      treeBytes += polys[i]->getMemoryUsage() + 5 * MALLOC_OVERHEAD;
+      compactBytes += compact[i]->getMemoryUsage() + MALLOC_OVERHEAD;
+    }
+
+    cout << polys.size() << " polygons of "
+         << polys[0]->getNumPoints() << " points: tree "
+         << treeBytes / polys.size() << " bytes each, compact "
+         << compactBytes / polys.size() << " bytes each ("
+         << double(treeBytes) / compactBytes << "x), encoded in "
+         << prof.getTot() << " usecs" << endl;
+  }
+
+  void testQueries()
+  {
+    geos::util::Profile tree("Geometry");
+    geos::util::Profile packed("CompactGeometry");
+
+    size_t treeHits = 0;
+    double treeDist = 0;
+    tree.start();
+    for (size_t i=1; i<polys.size(); ++i) {
+      if (polys[0]->intersects(polys[i])) ++treeHits;
+      treeDist += polys[i-1]->distance(polys[i]);
+    }
+    tree.stop();
+
+    size_t compactHits = 0;
+    double compactDist = 0;
+    packed.start();
+    for (size_t i=1; i<compact.size(); ++i) {
+      if (compact[0]->intersects(*compact[i])) ++compactHits;
+      compactDist += compact[i-1]->distance(*compact[i]);
+    }
+    packed.stop();
+
+    cout << "intersects+distance: tree " << treeHits << " hits, "
+         << treeDist << " total, " << tree.getTot() << " usecs; compact "
+         << compactHits << " hits, " << compactDist << " total, "
+         << packed.getTot() << " usecs" << endl;
+  }
+
+private:
+
+  static const int EXTENT = 1000;
+  static const size_t MALLOC_OVERHEAD = 16;
+
+  GeometryFactory gf;
+  vector<Geometry*> polys;
+  vector<CompactGeometry*> compact;
+};
+
+int
+main()
+{
+  size_t vertices[] = { 4, 8, 32 };
+  for (size_t i=0; i<sizeof(vertices)/sizeof(vertices[0]); ++i) {
+    CompactGeometryPerfTest tester(100000, vertices[i]);
+    tester.testMemory();
+    tester.testQueries();
+  }
+}
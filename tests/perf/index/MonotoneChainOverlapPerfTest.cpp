@@ -0,0 +1,213 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation.
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Compares the SegmentEnvelopeBlock filter with one Envelope test per
+ * pair of segments, and times the operations using it on dense linework:
+ * MonotoneChain overlaps (MCIndexNoder), MonotoneChainEdge intersections
+ * (relate) and SegmentIntersectionTester (prepared line intersects)
+ *
+ **********************************************************************/
+
+#include <geos/index/chain/SegmentEnvelopeBlock.h>
+#include <geos/noding/MCIndexNoder.h>
+#include <geos/noding/NodedSegmentString.h>
+#include <geos/noding/SegmentIntersector.h>
+#include <geos/noding/SegmentString.h>
+#include <geos/algorithm/LineIntersector.h>
+#include <geos/operation/predicate/SegmentIntersectionTester.h>
+#include <geos/geom/CoordinateArraySequence.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/Envelope.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/LineString.h>
+#include <geos/geom/IntersectionMatrix.h>
+#include <geos/profiler.h>
+#include <iostream>
+#include <vector>
+#include <memory>
+#include <cstdlib>
+
+using namespace geos::geom;
+using namespace geos::noding;
+using geos::index::chain::SegmentEnvelopeBlock;
+using namespace std;
+
+class IntersectionCounter: public SegmentIntersector
+{
+public:
+  IntersectionCounter() : tests(0), found(0) {}
+  void processIntersections(SegmentString* e0, int i0,
+                            SegmentString* e1, int i1)
+  {
+    if (e0 == e1 && i0 == i1) return;
+    ++tests;
+    const CoordinateSequence& s0 = *e0->getCoordinates();
+    const CoordinateSequence& s1 = *e1->getCoordinates();
+    li.computeIntersection(s0[i0], s0[i0+1], s1[i1], s1[i1+1]);
+    if (li.hasIntersection()) ++found;
+  }
+  geos::algorithm::LineIntersector li;
+  size_t tests;
+  size_t found;
+};
+
+class MonotoneChainOverlapPerfTest
+{
+public:
+
+  // Random walks with short steps, wiggling enough to
+  // make short monotone chains crossing each other often
+  MonotoneChainOverlapPerfTest(size_t nLines, size_t nPoints)
+  {
+    srand(4711);
+    for (size_t i=0; i<nLines; ++i) {
+      CoordinateSequence* seq = new CoordinateArraySequence();
+      double x = rand() % EXTENT;
+      double y = rand() % EXTENT;
+      for (size_t j=0; j<nPoints; ++j) {
+        seq->add(Coordinate(x, y));
+        x += rand() % (2*STEP+1) - STEP;
+        y += rand() % (2*STEP+1) - STEP;
+      }
+      lines.push_back(seq);
+    }
+  }
+
+  ~MonotoneChainOverlapPerfTest()
+  {
+    for (size_t i=0; i<lines.size(); ++i) delete lines[i];
+  }
+
+  // Each segment of the first line against all others of the set
+  void testKernel()
+  {
+    geos::util::Profile scalar("Envelope");
+    geos::util::Profile block("SegmentEnvelopeBlock");
+
+    vector<const CoordinateSequence*> seqs(lines.begin(), lines.end());
+    const CoordinateSequence& q = *seqs[0];
+
+    size_t scalarHits = 0;
+    scalar.start();
+    for (size_t s=0; s<seqs.size(); ++s) {
+      const CoordinateSequence& seq = *seqs[s];
+      for (size_t i=0; i+1<q.size(); ++i) {
+        Envelope qe(q[i], q[i+1]);
+        for (size_t j=0; j+1<seq.size(); ++j) {
+          if (qe.intersects(Envelope(seq[j], seq[j+1]))) ++scalarHits;
+        }
+      }
+    }
+    scalar.stop();
+
+    size_t blockHits = 0;
+    unsigned int masks[1];
+    block.start();
+    for (size_t s=0; s<seqs.size(); ++s) {
+      const CoordinateSequence& seq = *seqs[s];
+      size_t nseg = seq.size() - 1;
+      SegmentEnvelopeBlock env;
+      for (size_t b=0; b<nseg; b+=SegmentEnvelopeBlock::CAPACITY) {
+        size_t e = b + SegmentEnvelopeBlock::CAPACITY;
+        env.setSegments(seq, b, e < nseg ? e : nseg);
+        for (size_t i=0; i+1<q.size(); ++i) {
+          env.intersectingSegments(q, i, i+1, masks);
+          for (unsigned int m = masks[0]; m; m &= m-1) ++blockHits;
+        }
+      }
+    }
+    block.stop();
+
+    cout << "Segment envelope tests: " << scalarHits << " hits "
+         << scalar.getTot() << " usecs, blocks " << blockHits << " hits "
+         << block.getTot() << " usecs" << endl;
+  }
+
+  void testNoder()
+  {
+    geos::util::Profile prof("MCIndexNoder");
+
+    vector<SegmentString*> strings;
+    for (size_t i=0; i<lines.size(); ++i)
+      strings.push_back(new NodedSegmentString(lines[i]->clone(), 0));
+
+    IntersectionCounter counter;
+    prof.start();
+    MCIndexNoder noder(&counter);
+    noder.computeNodes(&strings);
+    prof.stop();
+
+    cout << "MCIndexNoder: " << lines.size() << " lines, "
+         << counter.tests << " segment pairs tested, "
+         << counter.found << " intersecting, "
+         << prof.getTot() << " usecs" << endl;
+
+    for (size_t i=0; i<strings.size(); ++i) delete strings[i];
+  }
+
+  void testRelate()
+  {
+    geos::util::Profile relate("relate");
+    geos::util::Profile tester("SegmentIntersectionTester");
+
+    GeometryFactory gf;
+    vector<LineString*> geoms;
+    for (size_t i=0; i<lines.size(); ++i)
+      geoms.push_back(gf.createLineString(lines[i]->clone()));
+
+    size_t related = 0;
+    relate.start();
+    for (size_t i=1; i<geoms.size(); ++i) {
+      auto_ptr<IntersectionMatrix> im(geoms[0]->relate(geoms[i]));
+      if (im->isIntersects()) ++related;
+    }
+    relate.stop();
+
+    size_t intersecting = 0;
+    tester.start();
+    for (int iter=0; iter<MAX_ITER; ++iter) {
+      for (size_t i=1; i<geoms.size(); ++i) {
+        geos::operation::predicate::SegmentIntersectionTester sit;
+        if (sit.hasIntersection(*geoms[0], *geoms[i])) ++intersecting;
+      }
+    }
+    tester.stop();
+
+    cout << "relate: " << geoms.size()-1 << " pairs (" << related
+         << " intersecting) " << relate.getTot() << " usecs, "
+         << "SegmentIntersectionTester: " << MAX_ITER * (geoms.size()-1)
+         << " pairs (" << intersecting << " intersecting) "
+         << tester.getTot() << " usecs" << endl;
+
+    for (size_t i=0; i<geoms.size(); ++i) delete geoms[i];
+  }
+
+private:
+
+  static const int MAX_ITER = 10;
+  static const int EXTENT = 1000;
+  static const int STEP = 20;
+
+  vector<CoordinateSequence*> lines;
+};
+
+int
+main()
+{
+  size_t points[] = { 100, 1000 };
+  for (size_t i=0; i<sizeof(points)/sizeof(points[0]); ++i) {
+    MonotoneChainOverlapPerfTest tester(200, points[i]);
+    tester.testKernel();
+    tester.testNoder();
+    tester.testRelate();
+  }
+}
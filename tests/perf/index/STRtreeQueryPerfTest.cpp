@@ -0,0 +1,182 @@
+/**********************************************************************
+ *
+ * GEOS - Geometry Engine Open Source
+ * http://geos.osgeo.org
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation. 
+ * See the COPYING file for more information.
+ *
+ **********************************************************************
+ *
+ * Compares build and query throughput of STRtree and PackedSTRtree,
+ * and of single, batch and tree-to-tree STRtree queries (random windows
+ * and self-join)
+ *
+ **********************************************************************/
+
+#include <geos/index/strtree/STRtree.h>
+#include <geos/index/strtree/PackedSTRtree.h>
+#include <geos/index/ItemPairVisitor.h>
+#include <geos/geom/Envelope.h>
+#include <geos/profiler.h>
+#include <iostream>
+#include <vector>
+#include <cstdlib>
+
+using namespace geos::geom;
+using namespace geos::index::strtree;
+using namespace std;
+
+class PairCounter: public geos::index::ItemPairVisitor
+{
+public:
+  PairCounter() : count(0) {}
+  void visitItemPair(void*, void*) { ++count; }
+  size_t count;
+};
+
+class STRtreeQueryPerfTest
+{
+public:
+
+  STRtreeQueryPerfTest(size_t nItems)
+  {
+    srand(4711);
+    for (size_t i=0; i<nItems; ++i) {
+      double x = rand() % EXTENT;
+      double y = rand() % EXTENT;
+      items.push_back(Envelope(x, x + rand() % 10, y, y + rand() % 10));
+    }
+    for (size_t i=0; i<NUM_QUERIES; ++i) {
+      double x = rand() % EXTENT;
+      double y = rand() % EXTENT;
+      queries.push_back(Envelope(x, x + QUERY_SIZE, y, y + QUERY_SIZE));
+    }
+  }
+
+  template <class T>
+  void test(const char* name)
+  {
+    geos::util::Profile build(name);
+    geos::util::Profile query(name);
+
+    build.start();
+    T tree(10);
+    for (size_t i=0; i<items.size(); ++i)
+      tree.insert(&items[i], &items[i]);
+    vector<void*> found;
+    tree.query(&queries[0], found);
+    build.stop();
+
+    size_t hits = 0;
+    query.start();
+    for (int iter = 0; iter < MAX_ITER; ++iter) {
+      for (size_t i=0; i<queries.size(); ++i) {
+        found.clear();
+        tree.query(&queries[i], found);
+        hits += found.size();
+      }
+    }
+    query.stop();
+
+    cout << name << ": " << items.size() << " items, "
+         << "build " << build.getTot() << " usecs, "
+         << MAX_ITER * queries.size() << " queries ("
+         << hits << " hits) " << query.getTot() << " usecs" << endl;
+  }
+
+  void testBatch()
+  {
+    geos::util::Profile query("STRtree batch");
+
+    STRtree tree(10);
+    for (size_t i=0; i<items.size(); ++i)
+      tree.insert(&items[i], &items[i]);
+    tree.build();
+
+    vector<const Envelope*> searchEnvs;
+    for (size_t i=0; i<queries.size(); ++i)
+      searchEnvs.push_back(&queries[i]);
+
+    vector<size_t> offsets;
+    vector<void*> found;
+    size_t hits = 0;
+    query.start();
+    for (int iter = 0; iter < MAX_ITER; ++iter) {
+      tree.queryBatch(searchEnvs, offsets, found);
+      hits += found.size();
+    }
+    query.stop();
+
+    cout << "STRtree batch: " << items.size() << " items, "
+         << MAX_ITER * queries.size() << " queries ("
+         << hits << " hits) " << query.getTot() << " usecs" << endl;
+  }
+
+  // Queries the tree with the envelope of each of its items
+  void testJoin()
+  {
+    geos::util::Profile single("STRtree join");
+    geos::util::Profile batch("STRtree batch join");
+    geos::util::Profile dual("STRtree dual-tree join");
+
+    STRtree tree(10);
+    vector<const Envelope*> searchEnvs;
+    for (size_t i=0; i<items.size(); ++i) {
+      tree.insert(&items[i], &items[i]);
+      searchEnvs.push_back(&items[i]);
+    }
+    tree.build();
+
+    vector<void*> found;
+    size_t singleHits = 0;
+    single.start();
+    for (size_t i=0; i<searchEnvs.size(); ++i) {
+      found.clear();
+      tree.query(searchEnvs[i], found);
+      singleHits += found.size();
+    }
+    single.stop();
+
+    vector<size_t> offsets;
+    batch.start();
+    tree.queryBatch(searchEnvs, offsets, found);
+    batch.stop();
+
+    PairCounter counter;
+    dual.start();
+    tree.join(tree, counter);
+    dual.stop();
+
+    cout << "STRtree self-join: " << items.size() << " queries ("
+         << singleHits << " hits) " << single.getTot() << " usecs, batch ("
+         << found.size() << " hits) " << batch.getTot() << " usecs, "
+         << "dual-tree (" << counter.count << " hits) "
+         << dual.getTot() << " usecs" << endl;
+  }
+
+private:
+
+  static const int MAX_ITER = 10;
+  static const size_t NUM_QUERIES = 1000;
+  static const int EXTENT = 100000;
+  static const int QUERY_SIZE = 500;
+
+  vector<Envelope> items;
+  vector<Envelope> queries;
+};
+
+int
+main()
+{
+  size_t sizes[] = { 10000, 100000, 1000000 };
+  for (size_t i=0; i<sizeof(sizes)/sizeof(sizes[0]); ++i) {
+    STRtreeQueryPerfTest tester(sizes[i]);
+    tester.test<STRtree>("STRtree");
+    tester.test<PackedSTRtree>("PackedSTRtree");
+    tester.testBatch();
+    tester.testJoin();
+  }
+}
@@ -0,0 +1,147 @@
+/************************************************************************
+ *
+ *
+ * Context handle stress test for C-Wrapper of GEOS library
+ *
+ * This is free software; you can redistribute and/or modify it under
+ * the terms of the GNU Lesser General Public Licence as published
+ * by the Free Software Foundation. 
+ * See the COPYING file for more information.
+ *
+ * Each thread serves many short requests, creating a context for
+ * each of them as threadtest does, doing a little work and hitting
+ * an error. Compares initGEOS_r/finishGEOS_r and error handlers with
+ * pooled contexts (GEOSContext_acquire_r) recording their errors.
+ *
+ ***********************************************************************/
+
+#define _GNU_SOURCE
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdarg.h>
+#include <string.h>
+#include <pthread.h>
+#include <sys/time.h>
+
+#include "geos_c.h"
+
+#define DEFAULT_THREADS 8
+#define DEFAULT_REQUESTS 20000
+
+static int nrequests = DEFAULT_REQUESTS;
+static int pooled = 0;
+
+void
+usage(char *me)
+{
+	fprintf(stderr, "Usage: %s [<threads> [<requests per thread>]]\n", me);
+	exit(1);
+}
+
+/* Formats the message, as a handler logging it would */
+void
+error_handler(const char *fmt, ...) {
+	char buf[1024];
+	va_list ap;
+
+	va_start (ap, fmt);
+	vsnprintf(buf, sizeof(buf), fmt, ap);
+	va_end(ap);
+}
+
+void *
+serve(void *arg)
+{
+	int i;
+	long errors = 0;
+
+	(void)arg;
+
+	for (i=0; i<nrequests; i++)
+	{
+		GEOSContextHandle_t handle;
+		GEOSGeometry *g;
+		double area;
+
+		if ( pooled ) {
+			handle = GEOSContext_acquire_r(NULL, NULL);
+			GEOSContext_setErrorMode_r(handle, GEOS_ERROR_RECORD);
+		} else {
+			handle = initGEOS_r(NULL, error_handler);
+		}
+
+		g = GEOSGeomFromWKT_r(handle,
+		                      "POLYGON((0 0, 10 0, 10 10, 0 10, 0 0))");
+		GEOSArea_r(handle, g, &area);
+
+		/* not a point */
+		if ( 0 == GEOSGeomGetX_r(handle, g, &area) ) ++errors;
+		GEOSGeom_destroy_r(handle, g);
+
+		if ( pooled ) {
+			errors -= GEOSContext_getLastError_r(handle, NULL);
+			GEOSContext_release_r(handle);
+		} else {
+			finishGEOS_r(handle);
+		}
+	}
+
+	return (void*)errors;
+}
+
+double
+run(int nthreads)
+{
+	pthread_t *threads;
+	struct timeval start, end;
+	int i;
+
+	threads = malloc(nthreads * sizeof(pthread_t));
+
+	gettimeofday(&start, NULL);
+	for (i=0; i<nthreads; i++) {
+		if ( pthread_create(&threads[i], NULL, serve, NULL) ) {
+			fprintf(stderr, "Could not create thread %d\n", i);
+			exit(1);
+		}
+	}
+	for (i=0; i<nthreads; i++) {
+		void *errors;
+		pthread_join(threads[i], &errors);
+		if ( pooled && errors ) {
+			fprintf(stderr, "Errors not recorded: %ld\n", (long)errors);
+			exit(1);
+		}
+	}
+	gettimeofday(&end, NULL);
+
+	free(threads);
+
+	return (end.tv_sec - start.tv_sec) * 1000.0 +
+	       (end.tv_usec - start.tv_usec) / 1000.0;
+}
+
+int
+main(int argc, char **argv)
+{
+	int nthreads = DEFAULT_THREADS;
+	double ms;
+
+	if ( argc > 3 ) usage(argv[0]);
+	if ( argc > 1 ) nthreads = atoi(argv[1]);
+	if ( argc > 2 ) nrequests = atoi(argv[2]);
+	if ( nthreads < 1 || nrequests < 1 ) usage(argv[0]);
+
+	pooled = 0;
+	ms = run(nthreads);
+	printf("initGEOS_r, error handler: %d threads x %d requests: %.1f ms\n",
+	       nthreads, nrequests, ms);
+
+	pooled = 1;
+	ms = run(nthreads);
+	printf("GEOSContext_acquire_r, recorded errors: %d threads x %d requests: %.1f ms\n",
+	       nthreads, nrequests, ms);
+
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,172 @@
+// 
+// Test Suite for C-API context handles and error reporting
+
+#include <tut.hpp>
+// geos
+#include <geos_c.h>
+#include <geos/platform.h> // for HAVE_PTHREAD
+// std
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <string>
+
+namespace tut
+{
+    //
+    // Test Group
+    //
+
+    // Common data used in test cases.
+    struct test_capigeoscontext_data
+    {
+        static std::string lastMessage;
+        static int numMessages;
+
+        static void error(const char *fmt, ...)
+        {
+            char buf[1024];
+            va_list ap;
+            va_start(ap, fmt);
+            std::vsprintf(buf, fmt, ap);
+            va_end(ap);
+
+            lastMessage = buf;
+            ++numMessages;
+        }
+
+        test_capigeoscontext_data()
+        {
+            lastMessage.clear();
+            numMessages = 0;
+        }
+    };
+
+    std::string test_capigeoscontext_data::lastMessage;
+    int test_capigeoscontext_data::numMessages = 0;
+
+    typedef test_group<test_capigeoscontext_data> group;
+    typedef group::object object;
+
+    group test_capigeoscontext_group("capi::GEOSContext");
+
+    //
+    // Test Cases
+    //
+
+    // Errors are counted and recorded, the handler getting them too
+    template<>
+    template<>
+    void object::test<1>()
+    {
+        GEOSContextHandle_t ctx = initGEOS_r(0, error);
+
+        const char* msg = 0;
+        ensure_equals(GEOSContext_getLastError_r(ctx, &msg), 0);
+        ensure_equals(std::string(msg), "");
+
+        GEOSGeometry* pt = GEOSGeomFromWKT_r(ctx, "POINT(1 2)");
+        ensure_equals(GEOSGetNumInteriorRings_r(ctx, pt), -1);
+        ensure_equals(GEOSGetNumInteriorRings_r(ctx, pt), -1);
+        ensure_equals(numMessages, 2);
+        ensure_equals(lastMessage, "Argument is not a Polygon");
+
+        ensure_equals(GEOSContext_getLastError_r(ctx, &msg), 2);
+        ensure_equals(std::string(msg), "Argument is not a Polygon");
+        ensure_equals(GEOSContext_getLastError_r(ctx, 0), 0);
+
+        GEOSGeom_destroy_r(ctx, pt);
+
+        // a NULL handler is not called
+        GEOSContext_setErrorHandler_r(ctx, 0);
+        ensure(0 == GEOSGeomFromWKT_r(ctx, "POINT(1"));
+        ensure_equals(GEOSContext_getLastError_r(ctx, &msg), 1);
+        ensure_equals(numMessages, 2);
+
+        finishGEOS_r(ctx);
+    }
+
+    // Errors are only recorded in GEOS_ERROR_RECORD mode
+    template<>
+    template<>
+    void object::test<2>()
+    {
+        GEOSContextHandle_t ctx = initGEOS_r(0, error);
+
+        ensure_equals(GEOSContext_setErrorMode_r(ctx, GEOS_ERROR_RECORD),
+                      int(GEOS_ERROR_CALL_HANDLER));
+        ensure_equals(GEOSContext_setErrorMode_r(ctx, 7), -1);
+
+        ensure(0 == GEOSGeomFromWKT_r(ctx, "POINT(1"));
+        ensure_equals(numMessages, 0);
+
+        const char* msg = 0;
+        ensure_equals(GEOSContext_getLastError_r(ctx, &msg), 1);
+        ensure(std::string(msg).find("ParseException") != std::string::npos);
+
+        ensure_equals(GEOSContext_setErrorMode_r(ctx, GEOS_ERROR_CALL_HANDLER),
+                      int(GEOS_ERROR_RECORD));
+        ensure(0 == GEOSGeomFromWKT_r(ctx, "POINT(1"));
+        ensure_equals(numMessages, 1);
+        ensure_equals(lastMessage, std::string(msg));
+
+        finishGEOS_r(ctx);
+    }
+
+    // Released handles are reused, with their settings reset
+    template<>
+    template<>
+    void object::test<3>()
+    {
+        GEOSContextHandle_t ctx1 = GEOSContext_acquire_r(0, error);
+        GEOSContextHandle_t ctx2 = GEOSContext_acquire_r(0, error);
+        ensure(ctx1 != ctx2);
+
+        GEOSContext_setErrorMode_r(ctx1, GEOS_ERROR_RECORD);
+        GEOS_setWKBByteOrder_r(ctx1, GEOS_WKB_XDR);
+        GEOSGeometry* pt = GEOSGeomFromWKT_r(ctx1, "POINT(1 2)");
+        GEOSGetNumInteriorRings_r(ctx1, pt);
+        GEOSGeom_destroy_r(ctx1, pt);
+
+        GEOSContext_release_r(ctx1);
+        GEOSContext_release_r(ctx2);
+
+        GEOSContextHandle_t ctx3 = GEOSContext_acquire_r(0, error);
+        GEOSContextHandle_t ctx4 = GEOSContext_acquire_r(0, error);
+        GEOSContextHandle_t ctx5 = GEOSContext_acquire_r(0, error);
+#if defined(HAVE_PTHREAD) && ! defined(_WIN32)
+        ensure(ctx3 == ctx1 || ctx3 == ctx2);
+        ensure(ctx4 == ctx1 || ctx4 == ctx2);
+        ensure(ctx5 != ctx1 && ctx5 != ctx2);
+#endif
+
+        GEOSContextHandle_t ctx = ctx3 == ctx1 ? ctx3 : ctx4;
+        ensure_equals(GEOSContext_getLastError_r(ctx, 0), 0);
+        ensure_equals(GEOS_getWKBByteOrder_r(ctx),
+                      GEOS_getWKBByteOrder_r(ctx5));
+        ensure_equals(GEOSContext_setErrorMode_r(ctx, GEOS_ERROR_RECORD),
+                      int(GEOS_ERROR_CALL_HANDLER));
+
+        GEOSContext_release_r(ctx3);
+        GEOSContext_release_r(ctx4);
+        GEOSContext_release_r(ctx5);
+    }
+
+    // finishGEOS frees the handles pooled by the calling thread,
+    // even if initGEOS was not called
+    template<>
+    template<>
+    void object::test<4>()
+    {
+        GEOSContext_release_r(GEOSContext_acquire_r(0, error));
+        finishGEOS();
+
+        GEOSContextHandle_t ctx = GEOSContext_acquire_r(0, error);
+        ensure(ctx != 0);
+        ensure_equals(GEOSContext_getLastError_r(ctx, 0), 0);
+        GEOSContext_release_r(ctx);
+        finishGEOS();
+    }
+
+} // namespace tut
+
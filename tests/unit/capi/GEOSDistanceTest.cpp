@@ -81,6 +81,24 @@ namespace tut
         ensure_equals(ret, 1);
         ensure_distance(dist, 8.06225774829855, 1e-12);
     }
+
+    // GEOSDistanceWithin
+    template<>
+    template<>
+    void object::test<2>()
+    {
+        geom1_ = GEOSGeomFromWKT("LINESTRING(0 0, 10 0, 10 10)");
+        geom2_ = GEOSGeomFromWKT("MULTIPOINT((13 5), (30 30))");
+        geom3_ = GEOSGeomFromWKT("POLYGON((-1 -1, 20 -1, 20 20, -1 -1))");
+
+        ensure_equals(GEOSDistanceWithin(geom1_, geom2_, 3), 1);
+        ensure_equals(GEOSDistanceWithin(geom1_, geom2_, 2.9), 0);
+        ensure_equals(GEOSDistanceWithin(geom2_, geom1_, 3.1), 1);
+
+        // inside the polygon
+        ensure_equals(GEOSDistanceWithin(geom3_, geom1_, 0), 1);
+        ensure_equals(GEOSDistanceWithin(geom3_, geom2_, 0), 1);
+    }
     
 
 } // namespace tut
@@ -11,6 +11,7 @@
 #include <cstdio>
 #include <cstdlib>
 #include <memory>
+#include <vector>
 
 namespace tut
 {
@@ -143,5 +144,76 @@ namespace tut
     //    test_wkb(ewkb, wkt);
     //}
 
+    // Batch decoding, whatever the number of threads
+    template<>
+    template<>
+    void object::test<7>()
+    {
+        std::vector<wkb_hex_decoder::binary_type> wkbs(100);
+        std::vector<const unsigned char*> bufs(100);
+        std::vector<size_t> sizes(100);
+        for (size_t i=0; i<100; ++i)
+        {
+            // POINT(1.234 5.678) and MULTIPOINT
+            wkb_hex_decoder::decode(i % 2 ?
+                "01010000005839B4C876BEF33F83C0CAA145B61640" :
+                "01040000000300000001010000002b8716d9cef7f13fb29defa7c64bf73f010100000096438b6ce7fb0040d9cef753e3a50340010100000096438b6ce7fb0840d9cef753e3a50b40",
+                wkbs[i]);
+            bufs[i] = &wkbs[i][0];
+            sizes[i] = wkbs[i].size();
+        }
+
+        for (unsigned int threads=0; threads<4; ++threads)
+        {
+            std::vector<GEOSGeometry*> geoms(100);
+            int n = GEOSGeomFromWKB_batch(&bufs[0], &sizes[0], 100,
+                                          threads, &geoms[0]);
+            ensure_equals(n, 100);
+            for (size_t i=0; i<100; ++i)
+            {
+                ensure(0 != geoms[i]);
+                ensure_equals(GEOSGetNumGeometries(geoms[i]), i % 2 ? 1 : 3);
+                GEOSGeom_destroy(geoms[i]);
+            }
+        }
+
+        // empty batch
+        ensure_equals(GEOSGeomFromWKB_batch(0, 0, 0, 2, 0), 0);
+    }
+
+    // Batch decoding failures are reported per input
+    template<>
+    template<>
+    void object::test<8>()
+    {
+        const char* wkts[] = {
+            "POINT(0 0)",
+            "LINESTRING(0 0",
+            0,
+            "POLYGON((0 0, 1 0, 1 1, 0 0))"
+        };
+        GEOSGeometry* geoms[4];
+        int n = GEOSGeomFromWKT_batch(wkts, 4, 2, geoms);
+        ensure_equals(n, 2);
+        ensure(0 != geoms[0]);
+        ensure(0 == geoms[1]);
+        ensure(0 == geoms[2]);
+        ensure(0 != geoms[3]);
+        ensure_equals(GEOSGeomTypeId(geoms[3]), GEOS_POLYGON);
+        GEOSGeom_destroy(geoms[0]);
+        GEOSGeom_destroy(geoms[3]);
+
+        // a truncated WKB buffer
+        wkb_hex_decoder::binary_type wkb;
+        wkb_hex_decoder::decode("01010000005839B4C876BEF33F83C0CAA145B61640", wkb);
+        const unsigned char* bufs[] = { &wkb[0], &wkb[0] };
+        size_t sizes[] = { wkb.size(), wkb.size() - 4 };
+        n = GEOSGeomFromWKB_batch(bufs, sizes, 2, 1, geoms);
+        ensure_equals(n, 1);
+        ensure(0 != geoms[0]);
+        ensure(0 == geoms[1]);
+        GEOSGeom_destroy(geoms[0]);
+    }
+
 } // namespace tut
 
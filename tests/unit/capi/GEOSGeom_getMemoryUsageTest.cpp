@@ -0,0 +1,102 @@
+// 
+// Test Suite for C-API GEOSGeom_getMemoryUsage and geometry counting
+
+#include <tut.hpp>
+// geos
+#include <geos_c.h>
+// std
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+
+namespace tut
+{
+    //
+    // Test Group
+    //
+
+    // Common data used in test cases.
+    struct test_capigeosgeomgetmemoryusage_data
+    {
+        GEOSGeometry* geom1_;
+        GEOSGeometry* geom2_;
+
+        static void notice(const char *fmt, ...)
+        {
+            std::fprintf( stdout, "NOTICE: ");
+
+            va_list ap;
+            va_start(ap, fmt);
+            std::vfprintf(stdout, fmt, ap);
+            va_end(ap);
+        
+            std::fprintf(stdout, "\n");
+        }
+
+        test_capigeosgeomgetmemoryusage_data()
+            : geom1_(0), geom2_(0)
+        {
+            initGEOS(notice, notice);
+        }       
+
+        ~test_capigeosgeomgetmemoryusage_data()
+        {
+            GEOSGeom_destroy(geom1_);
+            GEOSGeom_destroy(geom2_);
+            geom1_ = 0;
+            geom2_ = 0;
+            GEOS_setGeometryCounting(0);
+            finishGEOS();
+        }
+
+    };
+
+    typedef test_group<test_capigeosgeomgetmemoryusage_data> group;
+    typedef group::object object;
+
+    group test_capigeosgeomgetmemoryusage_group("capi::GEOSGeom_getMemoryUsage");
+
+    //
+    // Test Cases
+    //
+
+    template<>
+    template<>
+    void object::test<1>()
+    {
+        geom1_ = GEOSGeomFromWKT("LINESTRING(0 0, 10 0, 10 10)");
+        geom2_ = GEOSGeomFromWKT(
+            "MULTILINESTRING((0 0, 10 0, 10 10), (0 0, 10 0, 10 10))");
+
+        size_t bytes1 = GEOSGeom_getMemoryUsage(geom1_);
+        size_t bytes2 = GEOSGeom_getMemoryUsage(geom2_);
+
+        ensure( bytes1 >= 3 * 2 * sizeof(double) );
+        ensure( bytes2 > 2 * bytes1 );
+    }
+
+    // Geometry counting
+    template<>
+    template<>
+    void object::test<2>()
+    {
+        size_t created0, live0, created, live;
+
+        ensure_equals(GEOS_setGeometryCounting(1), 0);
+        ensure_equals(GEOS_getGeometryCounts(&created0, &live0), 1);
+
+        geom1_ = GEOSGeomFromWKT("MULTIPOINT((0 0), (1 1))");
+        ensure_equals(GEOS_getGeometryCounts(&created, &live), 1);
+        ensure_equals(created - created0, 3u);
+        ensure_equals(live - live0, 3u);
+
+        GEOSGeom_destroy(geom1_);
+        geom1_ = 0;
+        ensure_equals(GEOS_getGeometryCounts(0, &live), 1);
+        ensure_equals(live, live0);
+
+        ensure_equals(GEOS_setGeometryCounting(0), 1);
+    }
+
+} // namespace tut
+
@@ -5,10 +5,12 @@
 // geos
 #include <geos_c.h>
 // std
+#include <cmath>
 #include <cstdarg>
 #include <cstdio>
 #include <cstdlib>
 #include <memory>
+#include <vector>
 
 namespace tut
 {
@@ -170,6 +172,157 @@ namespace tut
 
     }
 
+    // Test predicates on geometries prepared by the context cache
+    template<>
+    template<>
+    void object::test<7>()
+    {
+    geom1_ = GEOSGeomFromWKT("POLYGON((0 0, 0 10, 10 11, 10 0, 0 0))");
+    geom2_ = GEOSGeomFromWKT("POINT(5 5)");
+
+    unsigned long hits, misses;
+    ensure_equals(GEOSContext_getPreparedCacheStats(&hits, &misses), 1);
+    ensure_equals(hits + misses, 0ul);
+
+    for (int i=0; i<10; ++i)
+    {
+        ensure_equals(GEOSPreparedContains_cached(geom1_, geom2_), 1);
+        ensure_equals(GEOSPreparedDisjoint_cached(geom1_, geom2_), 0);
+        ensure_equals(GEOSPreparedWithin_cached(geom2_, geom1_), 1);
+    }
+
+    GEOSContext_getPreparedCacheStats(&hits, &misses);
+    ensure_equals(misses, 2ul);
+    ensure_equals(hits, 28ul);
+
+    // a single entry: geom1_ and geom2_ evict each other
+    ensure_equals(GEOSContext_setPreparedCacheSize(1), 16);
+    ensure_equals(GEOSPreparedIntersects_cached(geom1_, geom2_), 1);
+    ensure_equals(GEOSPreparedIntersects_cached(geom2_, geom1_), 1);
+    ensure_equals(GEOSPreparedIntersects_cached(geom1_, geom2_), 1);
+    GEOSContext_getPreparedCacheStats(&hits, &misses);
+    ensure_equals(misses, 5ul);
+
+    // a new geometry, possibly at the address of a destroyed one
+    GEOSGeom_destroy(geom1_);
+    geom1_ = GEOSGeomFromWKT("POLYGON((20 20, 20 30, 30 30, 30 20, 20 20))");
+    ensure_equals(GEOSPreparedIntersects_cached(geom1_, geom2_), 0);
+    GEOSContext_getPreparedCacheStats(&hits, &misses);
+    ensure_equals(misses, 6ul);
+    }
+
+    // Test PreparedDistance and PreparedDistanceWithin
+    template<>
+    template<>
+    void object::test<8>()
+    {
+    geom1_ = GEOSGeomFromWKT("POLYGON((0 0, 0 10, 10 10, 10 0, 0 0))");
+    prepGeom1_ = GEOSPrepare(geom1_);
+
+    ensure(0 != prepGeom1_);
+
+    const char* wkts[] = {
+        "POINT(5 5)",
+        "POINT(13 14)",
+        "LINESTRING(12 -5, 12 15)",
+        "POLYGON((20 20, 20 30, 30 30, 30 20, 20 20))"
+    };
+    double expected[] = { 0.0, 5.0, 2.0, sqrt(200.0) };
+
+    // twice, the second time reusing the index
+    for (int j=0; j<2; ++j)
+    {
+        for (int i=0; i<4; ++i)
+        {
+            geom2_ = GEOSGeomFromWKT(wkts[i]);
+
+            double dist = -1;
+            ensure_equals(GEOSPreparedDistance(prepGeom1_, geom2_, &dist), 1);
+            ensure(fabs(dist - expected[i]) < 1e-12);
+
+            ensure_equals(GEOSPreparedDistanceWithin(prepGeom1_, geom2_,
+                                                     expected[i] + 0.1), 1);
+            if ( expected[i] > 0 )
+            {
+                ensure_equals(GEOSPreparedDistanceWithin(prepGeom1_, geom2_,
+                                                         expected[i] - 0.1), 0);
+            }
+
+            GEOSGeom_destroy(geom2_);
+            geom2_ = 0;
+        }
+    }
+    }
+
+    // Test Prepared*_many against the single predicates
+    template<>
+    template<>
+    void object::test<9>()
+    {
+    geom1_ = GEOSGeomFromWKT("POLYGON((0 0, 0 100, 100 100, 100 0, 0 0),"
+                             " (40 40, 60 40, 60 60, 40 60, 40 40))");
+    prepGeom1_ = GEOSPrepare(geom1_);
+
+    ensure(0 != prepGeom1_);
+
+    // points on a grid crossing the shell and hole,
+    // with a few lines among them
+    const size_t n = 1000;
+    std::vector<GEOSGeometry*> geoms(n);
+    for (size_t i=0; i<n; ++i)
+    {
+        char wkt[128];
+        double x = double(i % 40) * 3 - 10;
+        double y = double(i / 40) * 5 - 10;
+        if ( i % 10 == 0 )
+            std::sprintf(wkt, "LINESTRING(%g %g, %g %g)", x, y, x + 4, y + 7);
+        else
+            std::sprintf(wkt, "POINT(%g %g)", x, y);
+        geoms[i] = GEOSGeomFromWKT(wkt);
+    }
+
+    // the first batch runs on threads before any index is built
+    prepGeom2_ = GEOSPrepare(geom1_);
+    std::vector<char> expected(n), results(n);
+    for (int threads=4; threads>=0; threads-=2)
+    {
+        int numTrue = 0;
+        for (size_t i=0; i<n; ++i)
+        {
+            expected[i] = GEOSPreparedIntersects(prepGeom1_, geoms[i]);
+            if ( expected[i] == 1 ) ++numTrue;
+        }
+        ensure_equals(GEOSPreparedIntersects_many(prepGeom2_, &geoms[0], n,
+                                                  threads, &results[0]),
+                      numTrue);
+        ensure(results == expected);
+
+        numTrue = 0;
+        for (size_t i=0; i<n; ++i)
+        {
+            expected[i] = GEOSPreparedContainsProperly(prepGeom1_, geoms[i]);
+            if ( expected[i] == 1 ) ++numTrue;
+        }
+        ensure_equals(GEOSPreparedContainsProperly_many(prepGeom2_, &geoms[0],
+                                                        n, threads, &results[0]),
+                      numTrue);
+        ensure(results == expected);
+    }
+
+    // a NULL input gets a result of 2, the others are evaluated
+    GEOSGeometry* g = geoms[500];
+    geoms[500] = 0;
+    GEOSPreparedCovers_many(prepGeom2_, &geoms[0], n, 2, &results[0]);
+    ensure_equals(int(results[500]), 2);
+    ensure_equals(results[501], GEOSPreparedCovers(prepGeom1_, geoms[501]));
+    geoms[500] = g;
+
+    ensure_equals(GEOSPreparedContains_many(prepGeom2_, &geoms[0], 0, 2,
+                                            &results[0]), 0);
+
+    for (size_t i=0; i<n; ++i) GEOSGeom_destroy(geoms[i]);
+    }
+
     // TODO: add lots of more tests
     
 } // namespace tut
@@ -0,0 +1,264 @@
+// 
+// Test Suite for C-API GEOSSTRtree
+
+#include <tut.hpp>
+// geos
+#include <geos_c.h>
+// std
+#include <cstdarg>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+namespace tut
+{
+    //
+    // Test Group
+    //
+
+    // Common data used in test cases.
+    struct test_capigeosstrtree_data
+    {
+        GEOSSTRtree* tree_;
+        std::vector<GEOSGeometry*> geoms_;
+
+        static void notice(const char *fmt, ...)
+        {
+            std::fprintf( stdout, "NOTICE: ");
+
+            va_list ap;
+            va_start(ap, fmt);
+            std::vfprintf(stdout, fmt, ap);
+            va_end(ap);
+        
+            std::fprintf(stdout, "\n");
+        }
+
+        static void collect(void *item, void *userdata)
+        {
+            static_cast< std::vector<void*>* >(userdata)->push_back(item);
+        }
+
+        static void collectPair(void *item1, void *item2, void *userdata)
+        {
+            std::vector<void*>* v = static_cast< std::vector<void*>* >(userdata);
+            v->push_back(item1);
+            v->push_back(item2);
+        }
+
+        static int failingDistance(const void*, const void*,
+                                   double*, void*)
+        {
+            return 0;
+        }
+
+        test_capigeosstrtree_data()
+            : tree_(0)
+        {
+            initGEOS(notice, notice);
+            tree_ = GEOSSTRtree_create(4);
+        }       
+
+        ~test_capigeosstrtree_data()
+        {
+            GEOSSTRtree_destroy(tree_);
+            for (std::size_t i=0; i<geoms_.size(); ++i)
+                GEOSGeom_destroy(geoms_[i]);
+            tree_ = 0;
+            finishGEOS();
+        }
+
+        GEOSGeometry* add(const char* wkt)
+        {
+            GEOSGeometry* g = GEOSGeomFromWKT(wkt);
+            geoms_.push_back(g);
+            GEOSSTRtree_insert(tree_, g, g);
+            return g;
+        }
+
+    };
+
+    typedef test_group<test_capigeosstrtree_data> group;
+    typedef group::object object;
+
+    group test_capigeosstrtree_group("capi::GEOSSTRtree");
+
+    //
+    // Test Cases
+    //
+
+    // Nearest neighbours of a geometry, using the default metric
+    template<>
+    template<>
+    void object::test<1>()
+    {
+        add("POINT(0 0)");
+        GEOSGeometry* b = add("LINESTRING(10 0, 10 10)");
+        GEOSGeometry* c = add("POINT(5 5)");
+        add("POLYGON((20 20, 30 20, 30 30, 20 30, 20 20))");
+
+        GEOSGeometry* q = GEOSGeomFromWKT("POINT(8 4)");
+
+        void* results[3];
+        int n = GEOSSTRtree_nearest(tree_, q, q, 2, 0, 0, results);
+        ensure_equals(n, 2);
+        ensure(results[0] == b);
+        ensure(results[1] == c);
+
+        GEOSGeom_destroy(q);
+    }
+
+    // Nearest neighbour of an empty tree
+    template<>
+    template<>
+    void object::test<2>()
+    {
+        GEOSGeometry* q = GEOSGeomFromWKT("POINT(8 4)");
+
+        void* results[1];
+        int n = GEOSSTRtree_nearest(tree_, q, q, 1, 0, 0, results);
+        ensure_equals(n, 0);
+
+        GEOSGeom_destroy(q);
+    }
+
+    // A failing distance callback is reported as an exception
+    template<>
+    template<>
+    void object::test<3>()
+    {
+        add("POINT(0 0)");
+        GEOSGeometry* q = GEOSGeomFromWKT("POINT(8 4)");
+
+        void* results[1];
+        int n = GEOSSTRtree_nearest(tree_, q, q, 1, failingDistance, 0,
+                                    results);
+        ensure_equals(n, -1);
+
+        GEOSGeom_destroy(q);
+    }
+
+    // Packed tree insert, query, remove
+    template<>
+    template<>
+    void object::test<4>()
+    {
+        GEOSPackedSTRtree* tree = GEOSPackedSTRtree_create(4);
+        GEOSGeometry* a = add("POINT(0 0)");
+        GEOSGeometry* b = add("LINESTRING(10 0, 10 10)");
+        GEOSGeometry* c = add("POINT(5 5)");
+        GEOSPackedSTRtree_insert(tree, a, a);
+        GEOSPackedSTRtree_insert(tree, b, b);
+        GEOSPackedSTRtree_insert(tree, c, c);
+
+        GEOSGeometry* q = GEOSGeomFromWKT("POLYGON((4 4, 11 4, 11 6, 4 6, 4 4))");
+
+        std::vector<void*> found;
+        GEOSPackedSTRtree_query(tree, q, collect, &found);
+        ensure_equals(found.size(), 2u);
+
+        ensure_equals(GEOSPackedSTRtree_remove(tree, c, c), 1);
+        ensure_equals(GEOSPackedSTRtree_remove(tree, c, c), 0);
+
+        found.clear();
+        GEOSPackedSTRtree_query(tree, q, collect, &found);
+        ensure_equals(found.size(), 1u);
+        ensure(found[0] == b);
+
+        found.clear();
+        GEOSPackedSTRtree_iterate(tree, collect, &found);
+        ensure_equals(found.size(), 2u);
+
+        // the tree is built: inserts are refused
+        GEOSGeometry* d = add("POINT(6 5)");
+        GEOSPackedSTRtree_insert(tree, d, d);
+        found.clear();
+        GEOSPackedSTRtree_query(tree, q, collect, &found);
+        ensure_equals(found.size(), 1u);
+
+        GEOSGeom_destroy(q);
+        GEOSPackedSTRtree_destroy(tree);
+    }
+
+    // Batch query, checked against single queries
+    template<>
+    template<>
+    void object::test<5>()
+    {
+        for (int x=0; x<10; ++x)
+        {
+            for (int y=0; y<10; ++y)
+            {
+                char wkt[64];
+                std::sprintf(wkt, "POINT(%d %d)", x, y);
+                add(wkt);
+            }
+        }
+
+        std::vector<GEOSGeometry*> qs;
+        qs.push_back(GEOSGeomFromWKT("POLYGON((0 0, 1 0, 1 1, 0 1, 0 0))"));
+        qs.push_back(GEOSGeomFromWKT("POINT(50 50)"));
+        qs.push_back(GEOSGeomFromWKT("LINESTRING(2.5 3, 6.5 3)"));
+        qs.push_back(GEOSGeomFromWKT("POINT(9 9)"));
+
+        size_t* offsets = 0;
+        void** items = 0;
+        int ret = GEOSSTRtree_query_batch(tree_, &qs[0], qs.size(),
+                                          &offsets, &items);
+        ensure_equals(ret, 1);
+        ensure_equals(offsets[0], 0u);
+        ensure_equals(offsets[1], 4u);
+        ensure_equals(offsets[2], 4u);
+        ensure_equals(offsets[3], 8u);
+        ensure_equals(offsets[4], 9u);
+
+        for (std::size_t i=0; i<qs.size(); ++i)
+        {
+            std::vector<void*> found;
+            GEOSSTRtree_query(tree_, qs[i], collect, &found);
+            std::vector<void*> batch(items+offsets[i], items+offsets[i+1]);
+            ensure(found == batch);
+            GEOSGeom_destroy(qs[i]);
+        }
+
+        GEOSFree(offsets);
+        GEOSFree(items);
+    }
+
+    // Join of two trees, on envelopes and refined
+    template<>
+    template<>
+    void object::test<6>()
+    {
+        GEOSGeometry* square = add("POLYGON((0 0, 10 0, 10 10, 0 10, 0 0))");
+        add("LINESTRING(20 0, 30 10)");
+
+        GEOSSTRtree* points = GEOSSTRtree_create(4);
+        GEOSGeometry* p1 = GEOSGeomFromWKT("POINT(5 5)");
+        GEOSGeometry* p2 = GEOSGeomFromWKT("POINT(22 8)");
+        GEOSSTRtree_insert(points, p1, p1);
+        GEOSSTRtree_insert(points, p2, p2);
+
+        std::vector<void*> found;
+        ensure_equals(GEOSSTRtree_join(tree_, points, GEOSJOIN_ENVELOPES,
+                                       collectPair, &found), 1);
+        ensure_equals(found.size(), 4u);
+
+        found.clear();
+        ensure_equals(GEOSSTRtree_join(tree_, points, GEOSJOIN_CONTAINS,
+                                       collectPair, &found), 1);
+        ensure_equals(found.size(), 2u);
+        ensure(found[0] == square);
+        ensure(found[1] == p1);
+
+        found.clear();
+        ensure_equals(GEOSSTRtree_join(tree_, points, 100,
+                                       collectPair, &found), 0);
+        ensure(found.empty());
+
+        GEOSSTRtree_destroy(points);
+        GEOSGeom_destroy(p1);
+        GEOSGeom_destroy(p2);
+    }
+
+} // namespace tut
@@ -192,5 +192,21 @@ namespace tut
 ));
     }
 
-} // namespace tut
+    // Self-union on several threads
+    template<>
+    template<>
+    void object::test<9>()
+    {
+        geom1_ = GEOSGeomFromWKT("GEOMETRYCOLLECTION (MULTILINESTRING((5 7, 12 7), (4 5, 6 5), (5.5 7.5, 6.5 7.5)), POLYGON((0 0, 10 0, 10 10, 0 10, 0 0),(5 6, 7 6, 7 8, 5 8, 5 6)), POLYGON((8 8, 20 8, 20 20, 8 20, 8 8)), POLYGON((30 0, 40 0, 40 10, 30 10, 30 0)), POLYGON((35 5, 45 5, 45 15, 35 15, 35 5)), POLYGON((50 0, 60 0, 60 10, 50 10, 50 0)), MULTIPOINT(6 6.5, 6 1, 12 2, 6 1))");
+        ensure( 0 != geom1_ );
 
+        geom2_ = GEOSUnaryUnion(geom1_);
+        ensure( 0 != geom2_ );
+
+        GEOSGeometry* parallel = GEOSUnaryUnionParallel(geom1_, 3);
+        ensure( 0 != parallel );
+        ensure_equals(toWKT(parallel), toWKT(geom2_));
+        GEOSGeom_destroy(parallel);
+    }
+
+} // namespace tut
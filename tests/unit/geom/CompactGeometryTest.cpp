@@ -0,0 +1,196 @@
+//
+// Test Suite for geos::geom::CompactGeometry class.
+
+#include <tut.hpp>
+// geos
+#include <geos/geom/CompactGeometry.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/Location.h>
+#include <geos/geom/Point.h>
+#include <geos/algorithm/PointLocator.h>
+#include <geos/io/WKTReader.h>
+#include <geos/io/WKTWriter.h>
+// std
+#include <memory>
+#include <string>
+
+using geos::geom::CompactGeometry;
+using geos::geom::Coordinate;
+using geos::geom::Geometry;
+using geos::geom::Location;
+
+namespace tut
+{
+	//
+	// Test Group
+	//
+
+	// Common data used by tests
+	struct test_compactgeometry_data
+	{
+		typedef std::auto_ptr<Geometry> GeomPtr;
+		typedef std::auto_ptr<CompactGeometry> CompactPtr;
+
+		geos::geom::GeometryFactory factory;
+		geos::io::WKTReader reader;
+		geos::io::WKTWriter writer;
+
+		test_compactgeometry_data()
+			: reader(&factory)
+		{}
+
+		GeomPtr read(const std::string& wkt)
+		{
+			return GeomPtr(reader.read(wkt));
+		}
+	};
+
+	typedef test_group<test_compactgeometry_data> group;
+	typedef group::object object;
+
+	group test_compactgeometry_group("geos::geom::CompactGeometry");
+
+	// Geometries of all types, used by several tests
+	const char* wkts[] = {
+		"POINT(5 5)",
+		"LINESTRING(0 0, 10 10, 20 0)",
+		"LINEARRING(0 0, 0 3, 3 3, 0 0)",
+		"POLYGON((0 0, 10 0, 10 10, 0 10, 0 0), (2 2, 2 8, 8 8, 8 2, 2 2))",
+		"MULTIPOINT((1 1), (15 5), (5 5))",
+		"MULTILINESTRING((-5 -5, -1 -1), (3 5, 7 5))",
+		"MULTIPOLYGON(((3 3, 7 3, 7 7, 3 7, 3 3)), ((20 20, 30 20, 30 30, 20 20)))",
+		"GEOMETRYCOLLECTION(POINT(12 12), LINESTRING(11 0, 11 20),"
+		" POLYGON((-10 -10, -2 -10, -2 -2, -10 -10)))"
+	};
+	const std::size_t numWkts = sizeof(wkts) / sizeof(wkts[0]);
+
+	//
+	// Test Cases
+	//
+
+	// 1 - Encoding and decoding preserves the geometry
+	template<>
+	template<>
+	void object::test<1>()
+	{
+		const char* others[] = {
+			"POINT EMPTY",
+			"POLYGON EMPTY",
+			"GEOMETRYCOLLECTION EMPTY",
+			"LINESTRING(0 0 1, 10 10 2)"
+		};
+
+		for (std::size_t i=0; i<numWkts+4; ++i)
+		{
+			GeomPtr g = read(i < numWkts ? wkts[i] : others[i-numWkts]);
+			CompactPtr cg = CompactGeometry::create(*g);
+
+			ensure_equals( cg->getGeometryTypeId(), g->getGeometryTypeId() );
+			ensure_equals( cg->getNumPoints(), g->getNumPoints() );
+			ensure_equals( cg->isEmpty(), g->isEmpty() );
+			if ( ! g->isEmpty() )
+				ensure( cg->getEnvelope().equals(g->getEnvelopeInternal()) );
+
+			GeomPtr back = cg->toGeometry(factory);
+			ensure_equals( back->getGeometryTypeId(), g->getGeometryTypeId() );
+			ensure_equals( writer.write(back.get()), writer.write(g.get()) );
+			ensure( back->equalsExact(g.get()) );
+		}
+
+		GeomPtr g3d = read("LINESTRING(0 0 1, 10 10 2)");
+		CompactPtr cg3d = CompactGeometry::create(*g3d);
+		ensure_equals( cg3d->getCoordinateDimension(), 3u );
+		GeomPtr back = cg3d->toGeometry(factory);
+		ensure_equals( back->getCoordinate()->z, 1.0 );
+
+		CompactPtr cg2d = CompactGeometry::create(*read(wkts[1]));
+		ensure_equals( cg2d->getCoordinateDimension(), 2u );
+	}
+
+	// 2 - Point queries agree with the Geometry tree
+	template<>
+	template<>
+	void object::test<2>()
+	{
+		geos::algorithm::PointLocator locator;
+
+		for (std::size_t i=0; i<numWkts; ++i)
+		{
+			GeomPtr g = read(wkts[i]);
+			CompactPtr cg = CompactGeometry::create(*g);
+			// locate only considers the areal components
+			bool areal = g->getGeometryTypeId() == geos::geom::GEOS_POLYGON ||
+			             g->getGeometryTypeId() == geos::geom::GEOS_MULTIPOLYGON;
+
+			for (int x=-12; x<=32; ++x)
+			for (int y=-12; y<=32; ++y)
+			{
+				Coordinate p(x, y);
+				std::auto_ptr<geos::geom::Point> pt(factory.createPoint(p));
+
+				ensure_equals( cg->intersects(p), g->intersects(pt.get()) );
+				ensure_distance( cg->distance(p), g->distance(pt.get()), 1e-12 );
+				if ( areal )
+					ensure_equals( cg->locate(p), locator.locate(p, g.get()) );
+			}
+		}
+
+		// the areal part of a collection
+		GeomPtr gc = read(wkts[numWkts-1]);
+		CompactPtr cgc = CompactGeometry::create(*gc);
+		ensure_equals( cgc->locate(Coordinate(-8, -9)), int(Location::INTERIOR) );
+		ensure_equals( cgc->locate(Coordinate(-2, -5)), int(Location::BOUNDARY) );
+		ensure_equals( cgc->locate(Coordinate(11, 5)), int(Location::EXTERIOR) );
+	}
+
+	// 3 - Binary predicates and distance agree with the Geometry tree
+	template<>
+	template<>
+	void object::test<3>()
+	{
+		for (std::size_t i=0; i<numWkts; ++i)
+		{
+			GeomPtr a = read(wkts[i]);
+			CompactPtr ca = CompactGeometry::create(*a);
+			for (std::size_t j=0; j<numWkts; ++j)
+			{
+				GeomPtr b = read(wkts[j]);
+				CompactPtr cb = CompactGeometry::create(*b);
+
+				ensure_equals( ca->intersects(*cb), a->intersects(b.get()) );
+				double d = a->distance(b.get());
+				ensure_distance( ca->distance(*cb), d, 1e-12 );
+				ensure( ca->isWithinDistance(*cb, d) );
+				if ( d > 0 )
+					ensure( ! ca->isWithinDistance(*cb, d * 0.99) );
+			}
+		}
+
+		// polygon inside a hole, and inside the shell
+		GeomPtr holed = read(wkts[3]);
+		CompactPtr ch = CompactGeometry::create(*holed);
+		CompactPtr inHole = CompactGeometry::create(
+			*read("POLYGON((4 4, 6 4, 6 6, 4 4))"));
+		CompactPtr inShell = CompactGeometry::create(
+			*read("LINESTRING(0.5 0.5, 1.5 1.5)"));
+		ensure( ! ch->intersects(*inHole) );
+		ensure_distance( ch->distance(*inHole), 2.0, 1e-12 );
+		ensure( ch->intersects(*inShell) );
+		ensure_equals( ch->distance(*inShell), 0.0 );
+	}
+
+	// 4 - A small polygon takes a fraction of the Geometry memory
+	template<>
+	template<>
+	void object::test<4>()
+	{
+		GeomPtr g = read("POLYGON((0 0, 10 0, 10 10, 0 10, 0 0))");
+		CompactPtr cg = CompactGeometry::create(*g);
+
+		ensure( cg->getMemoryUsage() * 2 < g->getMemoryUsage() );
+	}
+
+} // namespace tut
+
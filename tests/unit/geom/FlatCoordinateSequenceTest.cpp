@@ -0,0 +1,236 @@
+//
+// Test Suite for geos::geom::FlatCoordinateSequence class.
+
+#include <tut.hpp>
+// geos
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/FlatCoordinateSequence.h>
+#include <geos/geom/FlatCoordinateSequenceFactory.h>
+#include <geos/geom/CoordinateArraySequence.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/Polygon.h>
+#include <geos/geom/LinearRing.h>
+#include <geos/geom/Envelope.h>
+#include <geos/geom/PrecisionModel.h>
+#include <geos/io/WKTReader.h>
+#include <geos/algorithm/CGAlgorithms.h>
+#include <geos/index/chain/MonotoneChainBuilder.h>
+// std
+#include <memory>
+#include <string>
+#include <vector>
+
+using geos::geom::Coordinate;
+using geos::geom::CoordinateSequence;
+using geos::geom::FlatCoordinateSequence;
+using geos::geom::FlatCoordinateSequenceFactory;
+
+namespace tut
+{
+	//
+	// Test Group
+	//
+
+	// Common data used by tests
+	struct test_flatcoordinatesequence_data
+	{
+		static std::vector<Coordinate> ring(std::size_t n)
+		{
+			// a closed zig-zag ring
+			std::vector<Coordinate> pts;
+			for (std::size_t i=0; i<n; ++i)
+				pts.push_back(Coordinate(i, (i%2) ? 1 : 0, i));
+			pts.push_back(Coordinate(n, -10, 0));
+			pts.push_back(Coordinate(0, -10, 0));
+			pts.push_back(pts[0]);
+			return pts;
+		}
+	};
+
+	typedef test_group<test_flatcoordinatesequence_data> group;
+	typedef group::object object;
+
+	group test_flatcoordinatesequence_group("geos::geom::FlatCoordinateSequence");
+
+	//
+	// Test Cases
+	//
+
+	// 1 - Empty sequences
+	template<>
+	template<>
+	void object::test<1>()
+	{
+		FlatCoordinateSequence xy(2);
+		ensure( xy.isEmpty() );
+		ensure_equals( xy.size(), 0u );
+		ensure_equals( xy.getDimension(), 2u );
+		ensure_equals( xy.toString(), std::string("()") );
+
+		FlatCoordinateSequence xyz;
+		ensure_equals( xyz.getDimension(), 3u );
+
+		FlatCoordinateSequence zeros(3, 2);
+		ensure_equals( zeros.size(), 3u );
+		ensure( zeros.getAt(2).equals2D(Coordinate(0, 0)) );
+		ensure( zeros.hasRepeatedPoints() );
+	}
+
+	// 2 - XY sequences drop Z and grow past their inline storage
+	template<>
+	template<>
+	void object::test<2>()
+	{
+		FlatCoordinateSequence seq(2);
+		for (int i=0; i<100; ++i) seq.add(Coordinate(i, -i, 5));
+
+		ensure_equals( seq.size(), 100u );
+		ensure_equals( seq.getStride(), 2u );
+		for (int i=0; i<100; ++i)
+		{
+			ensure_equals( seq.getXAt(i), double(i) );
+			ensure_equals( seq.getYAt(i), double(-i) );
+			ensure( ISNAN(seq.getZAt(i)) );
+			ensure_equals( seq.getOrdinates()[2*i+1], double(-i) );
+
+			const Coordinate& c = seq.getAt(i);
+			ensure_equals( c.x, double(i) );
+			ensure( ISNAN(c.z) );
+		}
+
+		seq.setOrdinate(7, CoordinateSequence::Y, 42);
+		seq.setOrdinate(7, CoordinateSequence::Z, 42);
+		ensure_equals( seq.getAt(7).y, 42.0 );
+		ensure( ISNAN(seq.getOrdinate(7, CoordinateSequence::Z)) );
+
+		ensure_equals( seq.toVector()->size(), 100u );
+	}
+
+	// 3 - XYZ sequences keep Z, copies are independent
+	template<>
+	template<>
+	void object::test<3>()
+	{
+		FlatCoordinateSequence seq(3);
+		seq.add(Coordinate(1, 2, 3));
+		seq.add(Coordinate(4, 5, 6));
+
+		ensure_equals( seq.getAt(1).z, 6.0 );
+
+		std::auto_ptr<CoordinateSequence> copy(seq.clone());
+		seq.setAt(Coordinate(7, 8, 9), 1);
+		ensure_equals( copy->getAt(1).z, 6.0 );
+		ensure_equals( seq.getAt(1).z, 9.0 );
+		ensure_equals( copy->toString(), std::string("(1 2 3, 4 5 6)") );
+	}
+
+	// 4 - Insertions, deletions and repeated points
+	template<>
+	template<>
+	void object::test<4>()
+	{
+		FlatCoordinateSequence seq(2);
+		seq.add(Coordinate(0, 0));
+		seq.add(Coordinate(2, 2));
+		seq.add(1, Coordinate(1, 1), false);
+		seq.add(1, Coordinate(1, 1), false); // repeated, skipped
+		seq.add(Coordinate(2, 2), false);    // repeated, skipped
+		ensure_equals( seq.size(), 3u );
+		ensure_equals( seq.getAt(1).x, 1.0 );
+
+		seq.add(Coordinate(2, 2));
+		seq.add(Coordinate(2, 2));
+		seq.add(Coordinate(3, 3));
+		ensure( seq.hasRepeatedPoints() );
+		seq.removeRepeatedPoints();
+		ensure_equals( seq.size(), 4u );
+		ensure_equals( seq.getAt(3).x, 3.0 );
+
+		seq.deleteAt(0);
+		ensure_equals( seq.size(), 3u );
+		ensure_equals( seq.getXAt(0), 1.0 );
+	}
+
+	// 5 - Factory, and algorithms reading the ordinates directly
+	template<>
+	template<>
+	void object::test<5>()
+	{
+		const geos::geom::CoordinateSequenceFactory* csf =
+			FlatCoordinateSequenceFactory::instance();
+
+		std::vector<Coordinate> pts = ring(50);
+		std::auto_ptr<CoordinateSequence> flat(
+			csf->create(new std::vector<Coordinate>(pts), 2));
+		geos::geom::CoordinateArraySequence array(new std::vector<Coordinate>(pts));
+
+		using geos::algorithm::CGAlgorithms;
+		std::size_t bytes = flat->getMemoryUsage();
+		ensure_equals( CGAlgorithms::signedArea(flat.get()),
+		               CGAlgorithms::signedArea(&array) );
+		ensure_equals( CGAlgorithms::length(flat.get()),
+		               CGAlgorithms::length(&array) );
+		ensure_equals( CGAlgorithms::locatePointInRing(Coordinate(25, -5), *flat),
+		               CGAlgorithms::locatePointInRing(Coordinate(25, -5), array) );
+
+		using geos::index::chain::MonotoneChainBuilder;
+		std::vector<std::size_t> flatStarts, arrayStarts;
+		MonotoneChainBuilder::getChainStartIndices(*flat, flatStarts);
+		MonotoneChainBuilder::getChainStartIndices(array, arrayStarts);
+		ensure( flatStarts == arrayStarts );
+
+		// none of the above built a Coordinate copy of the sequence
+		ensure_equals( flat->getMemoryUsage(), bytes );
+		flat->getAt(0);
+		ensure( flat->getMemoryUsage() > bytes );
+
+		// dimension 0: keep Z only if there is any
+		std::auto_ptr<CoordinateSequence> detected(
+			csf->create(new std::vector<Coordinate>(pts)));
+		ensure_equals( detected->getDimension(), 3u );
+		std::vector<Coordinate>* flat2d = new std::vector<Coordinate>(1);
+		detected.reset(csf->create(flat2d));
+		ensure_equals( detected->getDimension(), 2u );
+
+		// geometries built on the factory
+		geos::geom::PrecisionModel pm;
+		geos::geom::GeometryFactory gf(&pm, 0,
+			const_cast<geos::geom::CoordinateSequenceFactory*>(csf));
+		geos::io::WKTReader reader(&gf);
+		std::auto_ptr<geos::geom::Geometry> g(
+			reader.read("POLYGON((0 0, 10 0, 10 10, 0 10, 0 0))"));
+		ensure_equals( g->getArea(), 100.0 );
+		std::auto_ptr<geos::geom::Geometry> b(g->buffer(1));
+		ensure( b->getArea() > 100.0 );
+	}
+
+	// 6 - Geometry envelopes, closure, area and length read the ordinates
+	template<>
+	template<>
+	void object::test<6>()
+	{
+		const geos::geom::CoordinateSequenceFactory* csf =
+			FlatCoordinateSequenceFactory::instance();
+		geos::geom::PrecisionModel pm;
+		geos::geom::GeometryFactory gf(&pm, 0,
+			const_cast<geos::geom::CoordinateSequenceFactory*>(csf));
+
+		std::vector<Coordinate> pts = ring(50);
+		CoordinateSequence* seq = csf->create(
+			new std::vector<Coordinate>(pts), 2);
+		std::size_t bytes = seq->getMemoryUsage();
+
+		// the ring checks it is closed when built
+		std::auto_ptr<geos::geom::Geometry> poly(
+			gf.createPolygon(gf.createLinearRing(seq), 0));
+		ensure_equals( poly->getEnvelopeInternal()->getMinY(), -10.0 );
+		ensure_equals( poly->getEnvelopeInternal()->getMaxX(), 50.0 );
+		ensure( poly->getArea() > 0.0 );
+		ensure( poly->getLength() > 0.0 );
+
+		ensure_equals( seq->getMemoryUsage(), bytes );
+	}
+
+} // namespace tut
+
@@ -0,0 +1,119 @@
+//
+// Test Suite for Geometry::getMemoryUsage() function
+
+// tut
+#include <tut.hpp>
+// geos
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/LineString.h>
+#include <geos/geom/Point.h>
+#include <geos/geom/Polygon.h>
+#include <geos/io/WKTReader.h>
+// std
+#include <memory>
+#include <string>
+
+namespace tut
+{
+    //
+    // Test Group
+    //
+
+    struct test_getmemoryusage_data
+    {
+        typedef std::auto_ptr<geos::geom::Geometry> GeomPtr;
+
+        geos::geom::GeometryFactory factory;
+        geos::io::WKTReader reader;
+
+        test_getmemoryusage_data()
+            : reader(&factory)
+        {}
+
+        GeomPtr read(const std::string& wkt)
+        {
+            return GeomPtr(reader.read(wkt));
+        }
+    };
+
+    typedef test_group<test_getmemoryusage_data> group;
+    typedef group::object object;
+
+    group test_getmemoryusage_group("geos::geom::Geometry::getMemoryUsage");
+
+    //
+    // Test Cases
+    //
+
+    // 1 - Coordinates and envelope cache are accounted for
+    template<>
+    template<>
+    void object::test<1>()
+    {
+        GeomPtr line = read("LINESTRING(0 0, 1 1, 2 2)");
+        GeomPtr longer = read("LINESTRING(0 0, 1 1, 2 2, 3 3, 4 4, 5 5)");
+
+        const geos::geom::LineString* ls =
+            dynamic_cast<const geos::geom::LineString*>(line.get());
+        ensure( ls != 0 );
+
+        std::size_t bytes = line->getMemoryUsage();
+        ensure( bytes >= sizeof(geos::geom::LineString)
+                         + 3 * sizeof(geos::geom::Coordinate) );
+        ensure( bytes > ls->getCoordinatesRO()->getMemoryUsage() );
+        ensure( longer->getMemoryUsage() > bytes );
+
+        // computing the envelope caches it
+        line->getEnvelopeInternal();
+        ensure_equals( line->getMemoryUsage(),
+                       bytes + sizeof(geos::geom::Envelope) );
+    }
+
+    // 2 - Collections sum up their components
+    template<>
+    template<>
+    void object::test<2>()
+    {
+        GeomPtr shell = read("POLYGON((0 0, 10 0, 10 10, 0 10, 0 0))");
+        GeomPtr poly = read("POLYGON((0 0, 10 0, 10 10, 0 10, 0 0),"
+                            " (1 1, 2 1, 2 2, 1 1))");
+        GeomPtr hole = read("LINEARRING(1 1, 2 1, 2 2, 1 1)");
+
+        ensure( poly->getMemoryUsage() > shell->getMemoryUsage()
+                                         + hole->getMemoryUsage() );
+
+        GeomPtr pt1 = read("POINT(1 2)");
+        GeomPtr pt2 = read("POINT(3 4)");
+        GeomPtr mp = read("MULTIPOINT((1 2), (3 4))");
+        ensure( mp->getMemoryUsage() > pt1->getMemoryUsage()
+                                       + pt2->getMemoryUsage() );
+
+        GeomPtr gc = read("GEOMETRYCOLLECTION(MULTIPOINT((1 2), (3 4)),"
+                          " POLYGON((0 0, 10 0, 10 10, 0 10, 0 0),"
+                          " (1 1, 2 1, 2 2, 1 1)))");
+        ensure( gc->getMemoryUsage() > mp->getMemoryUsage()
+                                       + poly->getMemoryUsage() );
+
+        // a clone has exactly sized vectors, the reader grew them
+        GeomPtr copy(gc->clone());
+        ensure( copy->getMemoryUsage() <= gc->getMemoryUsage() );
+        ensure( copy->getMemoryUsage() > mp->getMemoryUsage()
+                                         + poly->getMemoryUsage() / 2 );
+    }
+
+    // 3 - Empty geometries still hold their own storage
+    template<>
+    template<>
+    void object::test<3>()
+    {
+        GeomPtr empty = read("POINT EMPTY");
+        ensure( empty->getMemoryUsage() >= sizeof(geos::geom::Point) );
+
+        GeomPtr emptyPoly = read("POLYGON EMPTY");
+        ensure( emptyPoly->getMemoryUsage() >= sizeof(geos::geom::Polygon) );
+    }
+
+} // namespace tut
+
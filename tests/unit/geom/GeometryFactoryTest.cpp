@@ -1280,4 +1280,44 @@ namespace tut
 		}
 	}
 
+	// Test of geometry counting
+	template<>
+	template<>
+	void object::test<37>()
+	{
+		typedef std::auto_ptr<geos::geom::Geometry> GeometryAutoPtr;
+
+		ensure( !factory_.isGeometryCounting() );
+		GeometryAutoPtr before(factory_.createPoint(geos::geom::Coordinate(x_, y_)));
+		ensure_equals( factory_.getNumGeometriesCreated(), 0u );
+
+		factory_.setGeometryCounting(true);
+		ensure( factory_.isGeometryCounting() );
+		{
+			GeometryAutoPtr poly(reader_.read(
+				"POLYGON((0 0, 10 0, 10 10, 0 10, 0 0), (1 1, 2 1, 2 2, 1 1))"));
+			// the polygon and its two rings
+			ensure_equals( factory_.getNumGeometriesCreated(), 3u );
+			ensure_equals( factory_.getNumGeometriesLive(), 3u );
+
+			GeometryAutoPtr copy(poly->clone());
+			ensure_equals( factory_.getNumGeometriesCreated(), 6u );
+			ensure_equals( factory_.getNumGeometriesLive(), 6u );
+		}
+		ensure_equals( factory_.getNumGeometriesCreated(), 6u );
+		ensure_equals( factory_.getNumGeometriesLive(), 0u );
+
+		// uncounted geometries are not subtracted
+		before.reset();
+		ensure_equals( factory_.getNumGeometriesLive(), 0u );
+
+		// counted geometries are, after counting stops
+		GeometryAutoPtr pt(factory_.createPoint(geos::geom::Coordinate(x_, y_)));
+		factory_.setGeometryCounting(false);
+		ensure_equals( factory_.getNumGeometriesLive(), 1u );
+		pt.reset();
+		ensure_equals( factory_.getNumGeometriesLive(), 0u );
+		ensure_equals( factory_.getNumGeometriesCreated(), 7u );
+	}
+
 } // namespace tut
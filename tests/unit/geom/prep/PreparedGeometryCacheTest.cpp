@@ -0,0 +1,171 @@
+//
+// Test Suite for geos::geom::prep::PreparedGeometryCache class.
+
+#include <tut.hpp>
+// geos
+#include <geos/geom/prep/PreparedGeometryCache.h>
+#include <geos/geom/prep/PreparedGeometry.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/LineString.h>
+#include <geos/geom/PrecisionModel.h>
+#include <geos/io/WKTReader.h>
+// std
+#include <memory>
+#include <string>
+#include <sstream>
+
+using geos::geom::Geometry;
+using geos::geom::prep::PreparedGeometry;
+using geos::geom::prep::PreparedGeometryCache;
+
+namespace tut
+{
+	//
+	// Test Group
+	//
+
+	// Common data used by tests
+	struct test_preparedgeometrycache_data
+	{
+		geos::geom::PrecisionModel pm;
+		geos::geom::GeometryFactory factory;
+		geos::io::WKTReader reader;
+
+		test_preparedgeometrycache_data()
+			: pm(1.0), factory(&pm, 0), reader(&factory)
+		{}
+
+		Geometry* read(const std::string& wkt)
+		{
+			return reader.read(wkt);
+		}
+	};
+
+	typedef test_group<test_preparedgeometrycache_data> group;
+	typedef group::object object;
+
+	group test_preparedgeometrycache_group("geos::geom::prep::PreparedGeometryCache");
+
+	//
+	// Test Cases
+	//
+
+	// 1 - Hits, misses and least recently used eviction
+	template<>
+	template<>
+	void object::test<1>()
+	{
+		std::auto_ptr<Geometry> a(read("POLYGON((0 0, 10 0, 10 10, 0 10, 0 0))"));
+		std::auto_ptr<Geometry> b(read("LINESTRING(0 0, 10 10)"));
+		std::auto_ptr<Geometry> c(read("POINT(5 5)"));
+
+		PreparedGeometryCache cache(2);
+		const PreparedGeometry& pa = cache.get(*a);
+		// a copy is prepared
+		ensure(&pa.getGeometry() != a.get());
+		ensure(pa.getGeometry().equalsExact(a.get()));
+		ensure(&cache.get(*a) == &pa);
+		ensure_equals(cache.getHits(), 1ul);
+		ensure_equals(cache.getMisses(), 1ul);
+
+		cache.get(*b);
+		cache.get(*a); // b is now the least recently used
+		cache.get(*c);
+		ensure_equals(cache.size(), 2u);
+		ensure_equals(cache.getMisses(), 3ul);
+
+		cache.get(*a);
+		cache.get(*c);
+		ensure_equals(cache.getHits(), 4ul);
+		cache.get(*b);
+		ensure_equals(cache.getMisses(), 4ul);
+
+		cache.remove(b.get());
+		ensure_equals(cache.size(), 1u);
+		cache.setCapacity(0);
+		ensure_equals(cache.getCapacity(), 1u);
+		cache.clear();
+		ensure_equals(cache.size(), 0u);
+	}
+
+	// 2 - Changed geometries are prepared again
+	template<>
+	template<>
+	void object::test<2>()
+	{
+		std::auto_ptr<Geometry> g(read("LINESTRING(0 0, 10 10, 20 0)"));
+		PreparedGeometryCache cache;
+		std::auto_ptr<Geometry> p(read("POINT(30 30)"));
+		ensure(! cache.get(*g).intersects(p.get()));
+
+		geos::geom::LineString* ls = dynamic_cast<geos::geom::LineString*>(g.get());
+		const_cast<geos::geom::CoordinateSequence*>(ls->getCoordinatesRO())
+			->setAt(geos::geom::Coordinate(30, 30), 2);
+		g->geometryChanged();
+
+		ensure(cache.get(*g).intersects(p.get()));
+		ensure_equals(cache.getMisses(), 2ul);
+		ensure_equals(cache.size(), 1u);
+	}
+
+	// 3 - Content hashes
+	template<>
+	template<>
+	void object::test<3>()
+	{
+		std::auto_ptr<Geometry> a(read("MULTIPOINT(0 0, 1 1)"));
+		std::auto_ptr<Geometry> b(read("MULTIPOINT(0 0, 1 1)"));
+		std::auto_ptr<Geometry> c(read("MULTIPOINT(1 1, 0 0)"));
+		std::auto_ptr<Geometry> e(read("GEOMETRYCOLLECTION EMPTY"));
+
+		ensure_equals(PreparedGeometryCache::contentHash(*a),
+		              PreparedGeometryCache::contentHash(*b));
+		ensure(PreparedGeometryCache::contentHash(*a) !=
+		       PreparedGeometryCache::contentHash(*c));
+		PreparedGeometryCache::contentHash(*e);
+	}
+
+	// 4 - Entries do not depend on the geometries they were built from
+	template<>
+	template<>
+	void object::test<4>()
+	{
+		PreparedGeometryCache cache;
+		std::auto_ptr<Geometry> p(read("POINT(500 1)"));
+
+		// a zigzag whose middle vertex is not sampled by the hash
+		std::ostringstream wkt;
+		wkt << "LINESTRING(";
+		for (int i=0; i<=1000; ++i)
+			wkt << (i ? "," : "") << i << " " << i % 2;
+		wkt << ")";
+
+		std::auto_ptr<Geometry> g(read(wkt.str()));
+		ensure(! cache.get(*g).intersects(p.get()));
+
+		// a different geometry, with the same hash, at the same address
+		geos::geom::LineString* ls = dynamic_cast<geos::geom::LineString*>(g.get());
+		const geos::geom::CoordinateSequence* cs = ls->getCoordinatesRO();
+		geos::geom::Coordinate c = cs->getAt(500);
+		std::size_t hash = PreparedGeometryCache::contentHash(*g);
+		const_cast<geos::geom::CoordinateSequence*>(cs)
+			->setAt(geos::geom::Coordinate(c.x, c.y + 1), 500);
+		g->geometryChanged();
+		ensure_equals(PreparedGeometryCache::contentHash(*g), hash);
+
+		ensure(cache.get(*g).intersects(p.get()));
+		ensure_equals(cache.getMisses(), 2ul);
+
+		// deleted without remove(): the entry stays usable
+		std::auto_ptr<Geometry> mp(read("MULTIPOLYGON(((0 0,1 0,1 1,0 0)),((5 5,6 5,6 6,5 5)))"));
+		const PreparedGeometry& pp = cache.get(*mp->getGeometryN(1));
+		mp.reset();
+		ensure(pp.getGeometry().intersects(p.get()) == false);
+		ensure_equals(cache.size(), 2u);
+		cache.clear();
+	}
+
+} // namespace tut
+
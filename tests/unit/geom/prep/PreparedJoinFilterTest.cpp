@@ -0,0 +1,112 @@
+// 
+// Test Suite for geos::geom::prep::PreparedJoinFilter class.
+
+// tut
+#include <tut.hpp>
+// geos
+#include <geos/geom/prep/PreparedJoinFilter.h>
+#include <geos/index/strtree/STRtree.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/Geometry.h>
+#include <geos/io/WKTReader.h>
+// std
+#include <vector>
+#include <utility>
+#include <cstddef>
+
+using namespace geos::geom;
+using geos::geom::prep::PreparedJoinFilter;
+using geos::index::strtree::STRtree;
+
+namespace tut
+{
+    //
+    // Test Group
+    //
+
+    // Collects the pairs of items it is given
+    struct PairCollector: public geos::index::ItemPairVisitor
+    {
+        std::vector< std::pair<void*, void*> > pairs;
+
+        void visitItemPair(void *item, void *otherItem)
+        {
+            pairs.push_back(std::make_pair(item, otherItem));
+        }
+    };
+
+    // Common data used by tests
+    struct test_preparedjoinfilter_data
+    {
+        geos::geom::GeometryFactory factory_;
+        geos::io::WKTReader reader_;
+        std::vector<Geometry*> geoms_;
+
+        test_preparedjoinfilter_data()
+            : factory_(), reader_(&factory_)
+        {}
+
+        ~test_preparedjoinfilter_data()
+        {
+            for (std::size_t i=0; i<geoms_.size(); ++i)
+                factory_.destroyGeometry(geoms_[i]);
+        }
+
+        Geometry* add(STRtree& tree, const char* wkt)
+        {
+            Geometry* g = reader_.read(wkt);
+            geoms_.push_back(g);
+            tree.insert(g->getEnvelopeInternal(), g);
+            return g;
+        }
+    };
+
+    typedef test_group<test_preparedjoinfilter_data> group;
+    typedef group::object object;
+
+    group test_preparedjoinfilter_group("geos::geom::prep::PreparedJoinFilter");
+
+    //
+    // Test Cases
+    //
+
+    // 1 - Points in polygons
+    template<>
+    template<>
+    void object::test<1>()
+    {
+        STRtree polys;
+        STRtree points;
+        Geometry* square = add(polys,
+            "POLYGON((0 0, 10 0, 10 10, 0 10, 0 0))");
+        // envelope contains the points, polygon only the first
+        Geometry* triangle = add(polys,
+            "POLYGON((20 0, 30 0, 20 10, 20 0))");
+        Geometry* p1 = add(points, "POINT(5 5)");
+        Geometry* p2 = add(points, "POINT(22 2)");
+        add(points, "POINT(29 9)");
+        Geometry* p4 = add(points, "POINT(10 5)"); // on the boundary
+        add(points, "POINT(50 50)");
+
+        PairCollector collector;
+        PreparedJoinFilter filter(PreparedJoinFilter::CONTAINS, collector);
+        polys.join(points, filter);
+
+        ensure_equals(collector.pairs.size(), 2u);
+        ensure(collector.pairs[0].first == square);
+        ensure(collector.pairs[0].second == p1);
+        ensure(collector.pairs[1].first == triangle);
+        ensure(collector.pairs[1].second == p2);
+        ensure_equals(filter.getNumPrepared(), 2u);
+
+        // the boundary point intersects, but is not contained
+        PairCollector intersecting;
+        PreparedJoinFilter ifilter(PreparedJoinFilter::INTERSECTS,
+                                   intersecting);
+        polys.join(points, ifilter);
+        ensure_equals(intersecting.pairs.size(), 3u);
+        ensure(intersecting.pairs[1].second == p4);
+    }
+
+} // namespace tut
+
@@ -0,0 +1,189 @@
+//
+// Test Suite for geos::geom::prep::PreparedPolygon class.
+
+#include <tut.hpp>
+// geos
+#include <geos/geom/prep/PreparedPolygon.h>
+#include <geos/geom/prep/PreparedGeometryFactory.h>
+#include <geos/geom/Geometry.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/PrecisionModel.h>
+#include <geos/io/WKTReader.h>
+// std
+#include <memory>
+#include <sstream>
+#include <string>
+
+using geos::geom::Geometry;
+using geos::geom::prep::PreparedGeometry;
+using geos::geom::prep::PreparedGeometryFactory;
+using geos::geom::prep::PreparedPolygon;
+
+namespace tut
+{
+	//
+	// Test Group
+	//
+
+	// Common data used by tests
+	struct test_preparedpolygon_data
+	{
+		geos::geom::PrecisionModel pm;
+		geos::geom::GeometryFactory factory;
+		geos::io::WKTReader reader;
+
+		test_preparedpolygon_data()
+			: pm(1.0), factory(&pm, 0), reader(&factory)
+		{}
+
+		Geometry* read(const std::string& wkt)
+		{
+			return reader.read(wkt);
+		}
+
+		// Checks all predicates agree between eager and
+		// adaptive preparation of poly against the given points
+		void checkPoints(const Geometry& poly, const char** points)
+		{
+			std::auto_ptr<const PreparedGeometry> eager(
+				PreparedGeometryFactory::prepare(&poly));
+			std::auto_ptr<const PreparedGeometry> lazy(
+				PreparedGeometryFactory::prepareAdaptive(&poly));
+
+			for (const char** wkt = points; *wkt; ++wkt)
+			{
+				std::auto_ptr<Geometry> g(read(*wkt));
+				ensure_equals(*wkt, lazy->intersects(g.get()),
+				              eager->intersects(g.get()));
+				ensure_equals(*wkt, lazy->contains(g.get()),
+				              eager->contains(g.get()));
+				ensure_equals(*wkt, lazy->covers(g.get()),
+				              eager->covers(g.get()));
+				ensure_equals(*wkt, lazy->containsProperly(g.get()),
+				              eager->containsProperly(g.get()));
+			}
+		}
+	};
+
+	typedef test_group<test_preparedpolygon_data> group;
+	typedef group::object object;
+
+	group test_preparedpolygon_group("geos::geom::prep::PreparedPolygon");
+
+	//
+	// Test Cases
+	//
+
+	// 1 - Points answered without indexes match the indexed answers
+	template<>
+	template<>
+	void object::test<1>()
+	{
+		std::auto_ptr<Geometry> poly(read(
+			"MULTIPOLYGON(((0 0, 10 0, 10 10, 0 10, 0 0), (2 2, 2 8, 8 8, 8 2, 2 2)),"
+			" ((20 0, 30 0, 25 10, 20 0)))"));
+		const char* points[] = {
+			"POINT(1 1)",         // interior
+			"POINT(5 5)",         // in hole
+			"POINT(0 5)",         // shell boundary
+			"POINT(2 5)",         // hole boundary
+			"POINT(25 5)",        // second polygon
+			"POINT(15 5)",        // between
+			"MULTIPOINT(1 1, 0 0)",
+			"MULTIPOINT(1 1, 5 5)",
+			"MULTIPOINT(0 0, 10 10)",
+			"MULTIPOINT(1 1, 25 5)",
+			0
+		};
+		checkPoints(*poly, points);
+	}
+
+	// 2 - Indexes are built once past the threshold
+	template<>
+	template<>
+	void object::test<2>()
+	{
+		std::auto_ptr<Geometry> poly(read("POLYGON((0 0, 10 0, 5 10, 0 0))"));
+		std::auto_ptr<Geometry> pt(read("POINT(5 5)"));
+		std::auto_ptr<Geometry> line(read("LINESTRING(5 5, 20 20)"));
+
+		PreparedPolygon pp(poly.get());
+		ensure(pp.intersects(pt.get()));
+		ensure(pp.isIndexed());
+
+		PreparedPolygon lazy(poly.get());
+		lazy.setIndexThreshold(3);
+		for (int i=0; i<3; ++i)
+		{
+			ensure(lazy.contains(pt.get()));
+			ensure(! lazy.isIndexed());
+		}
+		ensure(lazy.contains(pt.get()));
+		ensure(lazy.isIndexed());
+
+		// non-puntal arguments always use the indexes
+		PreparedPolygon lazy2(poly.get());
+		lazy2.setIndexThreshold(3);
+		ensure(lazy2.intersects(line.get()));
+		ensure(lazy2.isIndexed());
+	}
+
+	// 3 - Distances through the facet index match Geometry::distance
+	template<>
+	template<>
+	void object::test<3>()
+	{
+		std::auto_ptr<Geometry> poly(read(
+			"MULTIPOLYGON(((0 0, 10 0, 10 10, 0 10, 0 0), (2 2, 2 8, 8 8, 8 2, 2 2)),"
+			" ((20 0, 30 0, 25 10, 20 0)))"));
+		const char* geoms[] = {
+			"POINT(1 1)",         // interior
+			"POINT(5 5)",         // in hole
+			"POINT(15 5)",        // between
+			"POINT(-3 -4)",
+			"LINESTRING(4 4, 6 6)",
+			"LINESTRING(-5 20, 40 20)",
+			"POLYGON((3 3, 7 3, 7 7, 3 7, 3 3))",
+			"POLYGON((-10 -10, 40 -10, 40 20, -10 20, -10 -10))",
+			"MULTIPOINT(15 5, 5 5)",
+			"POINT EMPTY",
+			0
+		};
+
+		std::auto_ptr<const PreparedGeometry> pg(
+			PreparedGeometryFactory::prepare(poly.get()));
+
+		for (const char** wkt = geoms; *wkt; ++wkt)
+		{
+			std::auto_ptr<Geometry> g(read(*wkt));
+			double expected = poly->distance(g.get());
+			ensure_equals(*wkt, pg->distance(g.get()), expected);
+			ensure_equals(*wkt, pg->isWithinDistance(g.get(), expected), true);
+			if ( expected > 0 )
+			{
+				ensure_equals(*wkt,
+				    pg->isWithinDistance(g.get(), expected * 0.99), false);
+			}
+		}
+	}
+
+	// 4 - buildIndexes leaves nothing to build on first use
+	template<>
+	template<>
+	void object::test<4>()
+	{
+		std::auto_ptr<Geometry> poly(read("POLYGON((0 0, 10 0, 5 10, 0 0))"));
+		std::auto_ptr<Geometry> pt(read("POINT(5 5)"));
+
+		PreparedPolygon pp(poly.get());
+		pp.setIndexThreshold(3);
+		ensure(! pp.isIndexed());
+		pp.buildIndexes();
+		ensure(pp.isIndexed());
+		ensure(pp.contains(pt.get()));
+		ensure(pp.covers(pt.get()));
+		ensure(! pp.containsProperly(poly.get()));
+	}
+
+} // namespace tut
+
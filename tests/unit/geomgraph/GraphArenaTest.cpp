@@ -0,0 +1,119 @@
+//
+// Test Suite for geos::geomgraph::GraphArena class.
+
+#include <tut.hpp>
+// geos
+#include <geos/geomgraph/GraphArena.h>
+#include <geos/geomgraph/EdgeIntersection.h>
+#include <geos/geom/Coordinate.h>
+// std
+#include <cstddef>
+
+using namespace geos::geomgraph;
+using geos::geom::Coordinate;
+
+namespace tut
+{
+	//
+	// Test Group
+	//
+
+	// Common data used by tests
+	struct test_grapharena_data
+	{
+		static bool isAligned(void* p)
+		{
+			return reinterpret_cast<std::size_t>(p) % 16 == 0;
+		}
+	};
+
+	typedef test_group<test_grapharena_data> group;
+	typedef group::object object;
+
+	group test_grapharena_group("geos::geomgraph::GraphArena");
+
+	//
+	// Test Cases
+	//
+
+	// 1 - Blocks are aligned, distinct and accounted for
+	template<>
+	template<>
+	void object::test<1>()
+	{
+		GraphArena arena;
+		ensure_equals(arena.getNumBytes(), 0u);
+
+		char* a = static_cast<char*>(arena.allocate(3));
+		char* b = static_cast<char*>(arena.allocate(40));
+		ensure(isAligned(a));
+		ensure(isAligned(b));
+		ensure(b >= a + 3 || a >= b + 40);
+		ensure_equals(arena.getNumBytes(), 16u + 48u);
+
+		// a request larger than the arena blocks
+		char* big = static_cast<char*>(arena.allocate(1000000));
+		ensure(isAligned(big));
+		big[999999] = 1;
+		ensure_equals(arena.getNumBytes(), 16u + 48u + 1000000u);
+
+		// small allocations keep using the current block
+		char* c = static_cast<char*>(arena.allocate(16));
+		ensure(c == b + 48);
+	}
+
+	// 2 - Scopes set and restore the current arena
+	template<>
+	template<>
+	void object::test<2>()
+	{
+		ensure(GraphArena::getCurrent() == 0);
+
+		GraphArena outer;
+		GraphArena inner;
+		{
+			GraphArena::Scope s1(outer);
+			ensure(GraphArena::getCurrent() == &outer);
+			{
+				GraphArena::Scope s2(inner);
+				ensure(GraphArena::getCurrent() == &inner);
+			}
+			ensure(GraphArena::getCurrent() == &outer);
+		}
+		ensure(GraphArena::getCurrent() == 0);
+	}
+
+	// 3 - Graph components come from the current arena, if any
+	template<>
+	template<>
+	void object::test<3>()
+	{
+		Coordinate c(1, 2);
+
+		// no arena: plain heap allocation
+		EdgeIntersection* ei = new EdgeIntersection(c, 1, 0.5);
+		ensure_equals(ei->segmentIndex, 1);
+		delete ei;
+
+		GraphArena arena;
+		{
+			GraphArena::Scope scope(arena);
+			for (int i=0; i<1000; ++i)
+			{
+				ei = new EdgeIntersection(c, i, 0.5);
+				ensure(isAligned(ei));
+				ensure_equals(ei->segmentIndex, i);
+				delete ei; // runs the destructor, keeps the memory
+			}
+		}
+		ensure(arena.getNumBytes() >= 1000*sizeof(EdgeIntersection));
+
+		// arena no longer current
+		std::size_t used = arena.getNumBytes();
+		ei = new EdgeIntersection(c, 1, 0.5);
+		delete ei;
+		ensure_equals(arena.getNumBytes(), used);
+	}
+
+} // namespace tut
+
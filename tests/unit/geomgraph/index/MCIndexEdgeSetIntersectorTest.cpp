@@ -0,0 +1,201 @@
+//
+// Test Suite for geos::geomgraph::index::MCIndexEdgeSetIntersector class.
+
+#include <tut.hpp>
+// geos
+#include <geos/geomgraph/index/MCIndexEdgeSetIntersector.h>
+#include <geos/geomgraph/index/RadixMCSweepLineIntersector.h>
+#include <geos/geomgraph/index/SegmentIntersector.h>
+#include <geos/geomgraph/Edge.h>
+#include <geos/geomgraph/EdgeIntersection.h>
+#include <geos/geomgraph/EdgeIntersectionList.h>
+#include <geos/algorithm/LineIntersector.h>
+#include <geos/geom/CoordinateArraySequence.h>
+#include <geos/geom/Coordinate.h>
+// std
+#include <vector>
+
+using namespace geos::geomgraph;
+using namespace geos::geomgraph::index;
+using geos::geom::Coordinate;
+using geos::geom::CoordinateArraySequence;
+
+namespace tut
+{
+	//
+	// Test Group
+	//
+
+	// Common data used by tests
+	struct test_mcindexedgesetintersector_data
+	{
+		typedef std::vector<Edge*> EdgeList;
+
+		// A zigzag of n segments from (x, y), dx wide and dy high
+		static Edge* zigzag(double x, double y, double dx, double dy, int n)
+		{
+			CoordinateArraySequence* pts = new CoordinateArraySequence();
+			for (int i=0; i<=n; ++i)
+				pts->add(Coordinate(x + i * dx, y + (i % 2) * dy));
+			return new Edge(pts);
+		}
+
+		// Long east-west lines, each wavy enough to touch its
+		// neighbours, crossed by a few north-south zigzags
+		static void makeStripes(EdgeList& edges)
+		{
+			for (int i=0; i<40; ++i)
+				edges.push_back(zigzag(0, i, 5, 1, 40));
+			for (int i=0; i<5; ++i)
+				edges.push_back(zigzag(10 + 40 * i, -5, 0.5, 50, 8));
+		}
+
+		static void deleteEdges(EdgeList& edges)
+		{
+			for (std::size_t i=0; i<edges.size(); ++i) delete edges[i];
+		}
+
+		static std::size_t countIntersections(const EdgeList& edges)
+		{
+			std::size_t n = 0;
+			for (std::size_t i=0; i<edges.size(); ++i)
+			{
+				const EdgeIntersectionList& eil = edges[i]->getEdgeIntersectionList();
+				for (EdgeIntersectionList::const_iterator it = eil.begin();
+						it != eil.end(); ++it)
+					++n;
+			}
+			return n;
+		}
+
+		static bool sameIntersections(const EdgeList& a, const EdgeList& b)
+		{
+			for (std::size_t i=0; i<a.size(); ++i)
+			{
+				const EdgeIntersectionList& ea = a[i]->getEdgeIntersectionList();
+				const EdgeIntersectionList& eb = b[i]->getEdgeIntersectionList();
+				EdgeIntersectionList::const_iterator ia = ea.begin();
+				EdgeIntersectionList::const_iterator ib = eb.begin();
+				for (; ia != ea.end() && ib != eb.end(); ++ia, ++ib)
+				{
+					if ( ! (*ia)->coord.equals2D((*ib)->coord) ) return false;
+					if ( (*ia)->segmentIndex != (*ib)->segmentIndex ) return false;
+				}
+				if ( ia != ea.end() || ib != eb.end() ) return false;
+			}
+			return true;
+		}
+	};
+
+	typedef test_group<test_mcindexedgesetintersector_data> group;
+	typedef group::object object;
+
+	group test_mcindexedgesetintersector_group("geos::geomgraph::index::MCIndexEdgeSetIntersector");
+
+	//
+	// Test Cases
+	//
+
+	// 1 - Self intersections are the same as with a sweep line,
+	//     comparing far fewer chains on long east-west edges
+	template<>
+	template<>
+	void object::test<1>()
+	{
+		geos::algorithm::LineIntersector li;
+		EdgeList expected, obtained;
+		makeStripes(expected);
+		makeStripes(obtained);
+
+		SegmentIntersector siExpected(&li, true, false);
+		RadixMCSweepLineIntersector sweep;
+		sweep.computeIntersections(&expected, &siExpected, true);
+
+		SegmentIntersector siObtained(&li, true, false);
+		MCIndexEdgeSetIntersector indexed;
+		indexed.computeIntersections(&obtained, &siObtained, true);
+
+		ensure( countIntersections(expected) > 100 );
+		ensure( sameIntersections(expected, obtained) );
+		ensure( indexed.getNumOverlaps() * 4 < sweep.getNumOverlaps() );
+
+		deleteEdges(expected);
+		deleteEdges(obtained);
+	}
+
+	// 2 - Each edge in its own group: no self intersections
+	template<>
+	template<>
+	void object::test<2>()
+	{
+		geos::algorithm::LineIntersector li;
+		EdgeList expected, obtained;
+		makeStripes(expected);
+		makeStripes(obtained);
+
+		SegmentIntersector siExpected(&li, true, false);
+		RadixMCSweepLineIntersector sweep;
+		sweep.computeIntersections(&expected, &siExpected, false);
+
+		SegmentIntersector siObtained(&li, true, false);
+		MCIndexEdgeSetIntersector indexed;
+		indexed.computeIntersections(&obtained, &siObtained, false);
+
+		ensure( sameIntersections(expected, obtained) );
+
+		// an edge crossing itself at (3 0)
+		CoordinateArraySequence* pts = new CoordinateArraySequence();
+		pts->add(Coordinate(0, 0));
+		pts->add(Coordinate(4, 0));
+		pts->add(Coordinate(4, 1));
+		pts->add(Coordinate(2, -1));
+		EdgeList single(1, new Edge(pts));
+		SegmentIntersector si(&li, true, false);
+		MCIndexEdgeSetIntersector own;
+		own.computeIntersections(&single, &si, false);
+		ensure( ! single[0]->getEdgeIntersectionList().isIntersection(Coordinate(3, 0)) );
+		MCIndexEdgeSetIntersector all;
+		all.computeIntersections(&single, &si, true);
+		ensure( single[0]->getEdgeIntersectionList().isIntersection(Coordinate(3, 0)) );
+
+		deleteEdges(expected);
+		deleteEdges(obtained);
+		deleteEdges(single);
+	}
+
+	// 3 - Intersections between two sets of edges
+	template<>
+	template<>
+	void object::test<3>()
+	{
+		geos::algorithm::LineIntersector li;
+		EdgeList a0, b0, a1, b1;
+		for (int i=0; i<20; ++i)
+		{
+			a0.push_back(zigzag(0, 2 * i, 4, 1, 50));
+			a1.push_back(zigzag(0, 2 * i, 4, 1, 50));
+			b0.push_back(zigzag(7 + 9 * i, -3, 0.5, 50, 4));
+			b1.push_back(zigzag(7 + 9 * i, -3, 0.5, 50, 4));
+		}
+
+		SegmentIntersector siExpected(&li, true, false);
+		RadixMCSweepLineIntersector sweep;
+		sweep.computeIntersections(&a0, &b0, &siExpected);
+
+		SegmentIntersector siObtained(&li, true, false);
+		MCIndexEdgeSetIntersector indexed;
+		indexed.computeIntersections(&a1, &b1, &siObtained);
+
+		ensure( countIntersections(a0) > 100 );
+		ensure( sameIntersections(a0, a1) );
+		ensure( sameIntersections(b0, b1) );
+		ensure_equals( siObtained.hasProperIntersection(),
+		               siExpected.hasProperIntersection() );
+
+		deleteEdges(a0);
+		deleteEdges(b0);
+		deleteEdges(a1);
+		deleteEdges(b1);
+	}
+
+} // namespace tut
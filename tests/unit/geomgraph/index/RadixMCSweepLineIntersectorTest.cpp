@@ -0,0 +1,234 @@
+//
+// Test Suite for geos::geomgraph::index::RadixMCSweepLineIntersector class.
+
+#include <tut.hpp>
+// geos
+#include <geos/geomgraph/index/RadixMCSweepLineIntersector.h>
+#include <geos/geomgraph/index/SimpleMCSweepLineIntersector.h>
+#include <geos/geomgraph/index/SegmentIntersector.h>
+#include <geos/geomgraph/Edge.h>
+#include <geos/geomgraph/EdgeIntersection.h>
+#include <geos/geomgraph/EdgeIntersectionList.h>
+#include <geos/algorithm/LineIntersector.h>
+#include <geos/geom/CoordinateArraySequence.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/Geometry.h>
+#include <geos/io/WKTReader.h>
+// std
+#include <vector>
+#include <cmath>
+#include <memory>
+
+using namespace geos::geomgraph;
+using namespace geos::geomgraph::index;
+using geos::geom::Coordinate;
+using geos::geom::CoordinateArraySequence;
+
+namespace tut
+{
+	//
+	// Test Group
+	//
+
+	// Common data used by tests
+	struct test_radixmcsweeplineintersector_data
+	{
+		typedef std::vector<Edge*> EdgeList;
+
+		// A zigzag of n segments from (x, y), dx wide and dy high
+		static Edge* zigzag(double x, double y, double dx, double dy, int n)
+		{
+			CoordinateArraySequence* pts = new CoordinateArraySequence();
+			for (int i=0; i<=n; ++i)
+				pts->add(Coordinate(x + i * dx, y + (i % 2) * dy));
+			return new Edge(pts);
+		}
+
+		// Zigzags crossing each other, also at negative ordinates,
+		// with many chains starting and ending at the same x
+		static void makeEdges(EdgeList& edges)
+		{
+			for (int i=0; i<30; ++i)
+			{
+				edges.push_back(zigzag(-50 + i, -20 + i, 3, 5, 20));
+				edges.push_back(zigzag(-40 + 2 * i, 10 - i, 2, -4, 30));
+			}
+		}
+
+		static void deleteEdges(EdgeList& edges)
+		{
+			for (std::size_t i=0; i<edges.size(); ++i) delete edges[i];
+		}
+
+		// Number of intersections recorded on the edges
+		static std::size_t countIntersections(const EdgeList& edges)
+		{
+			std::size_t n = 0;
+			for (std::size_t i=0; i<edges.size(); ++i)
+			{
+				const EdgeIntersectionList& eil = edges[i]->getEdgeIntersectionList();
+				for (EdgeIntersectionList::const_iterator it = eil.begin();
+						it != eil.end(); ++it)
+					++n;
+			}
+			return n;
+		}
+
+		static bool sameIntersections(const EdgeList& a, const EdgeList& b)
+		{
+			for (std::size_t i=0; i<a.size(); ++i)
+			{
+				const EdgeIntersectionList& ea = a[i]->getEdgeIntersectionList();
+				const EdgeIntersectionList& eb = b[i]->getEdgeIntersectionList();
+				EdgeIntersectionList::const_iterator ia = ea.begin();
+				EdgeIntersectionList::const_iterator ib = eb.begin();
+				for (; ia != ea.end() && ib != eb.end(); ++ia, ++ib)
+				{
+					if ( ! (*ia)->coord.equals2D((*ib)->coord) ) return false;
+					if ( (*ia)->segmentIndex != (*ib)->segmentIndex ) return false;
+				}
+				if ( ia != ea.end() || ib != eb.end() ) return false;
+			}
+			return true;
+		}
+	};
+
+	typedef test_group<test_radixmcsweeplineintersector_data> group;
+	typedef group::object object;
+
+	group test_radixmcsweeplineintersector_group("geos::geomgraph::index::RadixMCSweepLineIntersector");
+
+	//
+	// Test Cases
+	//
+
+	// 1 - Self intersections are the same as the pointer-based sweep line
+	template<>
+	template<>
+	void object::test<1>()
+	{
+		geos::algorithm::LineIntersector li;
+		EdgeList expected, obtained;
+		makeEdges(expected);
+		makeEdges(obtained);
+
+		SegmentIntersector siExpected(&li, true, false);
+		SimpleMCSweepLineIntersector simple;
+		simple.computeIntersections(&expected, &siExpected, true);
+
+		SegmentIntersector siObtained(&li, true, false);
+		RadixMCSweepLineIntersector radix;
+		radix.computeIntersections(&obtained, &siObtained, true);
+
+		ensure( countIntersections(expected) > 100 );
+		ensure_equals( siObtained.numTests, siExpected.numTests );
+		ensure( sameIntersections(expected, obtained) );
+
+		deleteEdges(expected);
+		deleteEdges(obtained);
+	}
+
+	// 2 - Intersections between two sets of edges, and chains that
+	//     only touch at the x of the sweep line
+	template<>
+	template<>
+	void object::test<2>()
+	{
+		geos::algorithm::LineIntersector li;
+		EdgeList a0, b0, a1, b1;
+		makeEdges(a0);
+		makeEdges(a1);
+		for (int i=0; i<40; ++i)
+		{
+			b0.push_back(zigzag(-60 + 3 * i, -30, 0.5, 60, 6));
+			b1.push_back(zigzag(-60 + 3 * i, -30, 0.5, 60, 6));
+		}
+		// touches the end of the last zigzag of a
+		b0.push_back(zigzag(-40 + 58 + 60, -19, 1, 1, 2));
+		b1.push_back(zigzag(-40 + 58 + 60, -19, 1, 1, 2));
+
+		SegmentIntersector siExpected(&li, true, false);
+		SimpleMCSweepLineIntersector simple;
+		simple.computeIntersections(&a0, &b0, &siExpected);
+
+		SegmentIntersector siObtained(&li, true, false);
+		RadixMCSweepLineIntersector radix;
+		radix.computeIntersections(&a1, &b1, &siObtained);
+
+		ensure( countIntersections(a0) > 100 );
+		ensure_equals( siObtained.numTests, siExpected.numTests );
+		ensure( sameIntersections(a0, a1) );
+		ensure( sameIntersections(b0, b1) );
+		ensure( b1.back()->getEdgeIntersectionList().isIntersection(
+			Coordinate(18 + 60, -19)) );
+
+		deleteEdges(a0);
+		deleteEdges(b0);
+		deleteEdges(a1);
+		deleteEdges(b1);
+	}
+
+	// 3 - Few edges, sorted without the radix passes
+	template<>
+	template<>
+	void object::test<3>()
+	{
+		geos::algorithm::LineIntersector li;
+		EdgeList edges;
+		edges.push_back(zigzag(0, 0, 10, 10, 1));
+		edges.push_back(zigzag(0, 10, 10, -10, 1));
+		edges.push_back(zigzag(10, 10, 5, -20, 1));
+
+		SegmentIntersector si(&li, true, false);
+		RadixMCSweepLineIntersector radix;
+		radix.computeIntersections(&edges, &si, true);
+
+		ensure( si.hasIntersection() );
+		ensure( edges[0]->getEdgeIntersectionList().isIntersection(Coordinate(5, 5)) );
+		ensure( edges[2]->getEdgeIntersectionList().isIntersection(Coordinate(10, 10)) );
+
+		deleteEdges(edges);
+	}
+
+	// 4 - Chains ending at x=-0 and starting at x=+0 are compared
+	template<>
+	template<>
+	void object::test<4>()
+	{
+		geos::algorithm::LineIntersector li;
+		EdgeList edges0, edges1;
+		CoordinateArraySequence* pts0 = new CoordinateArraySequence();
+		pts0->add(Coordinate(-1, 0));
+		pts0->add(Coordinate(-0.0, 0));
+		pts0->add(Coordinate(-1, 1));
+		edges0.push_back(new Edge(pts0));
+		CoordinateArraySequence* pts1 = new CoordinateArraySequence();
+		pts1->add(Coordinate(1, -1));
+		pts1->add(Coordinate(0, 0));
+		pts1->add(Coordinate(1, 1));
+		edges1.push_back(new Edge(pts1));
+
+		SegmentIntersector si(&li, true, false);
+		RadixMCSweepLineIntersector radix;
+		radix.computeIntersections(&edges0, &edges1, &si);
+
+		ensure( si.hasIntersection() );
+		ensure( edges1[0]->getEdgeIntersectionList().isIntersection(Coordinate(0, 0)) );
+
+		deleteEdges(edges0);
+		deleteEdges(edges1);
+
+		// through the topology graph
+		geos::io::WKTReader reader;
+		std::auto_ptr<geos::geom::Geometry> a(
+			reader.read("LINESTRING(-1 0,-0 0,-1 1)"));
+		std::auto_ptr<geos::geom::Geometry> b(
+			reader.read("LINESTRING(1 -1,0 0,1 1)"));
+		ensure( a->intersects(b.get()) );
+
+		std::auto_ptr<geos::geom::Geometry> poly(
+			reader.read("POLYGON((-1 -1,-0 0,-1 1,1 1,0 0,1 -1,-1 -1))"));
+		ensure( ! poly->isValid() );
+	}
+
+} // namespace tut
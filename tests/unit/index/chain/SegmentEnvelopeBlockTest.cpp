@@ -0,0 +1,173 @@
+//
+// Test Suite for geos::index::chain::SegmentEnvelopeBlock class.
+
+#include <tut.hpp>
+// geos
+#include <geos/index/chain/SegmentEnvelopeBlock.h>
+#include <geos/geom/CoordinateArraySequence.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/Envelope.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/LineString.h>
+#include <geos/operation/predicate/SegmentIntersectionTester.h>
+// std
+#include <memory>
+#include <utility>
+#include <vector>
+#include <cstddef>
+
+using namespace geos::index::chain;
+using geos::geom::Coordinate;
+using geos::geom::CoordinateArraySequence;
+using geos::geom::Envelope;
+
+namespace tut
+{
+	//
+	// Test Group
+	//
+
+	// Common data used by tests
+	struct test_segmentenvelopeblock_data
+	{
+		typedef std::vector< std::pair<std::size_t, std::size_t> > PairVect;
+
+		struct PairCollector
+		{
+			PairVect pairs;
+			void operator()(std::size_t i, std::size_t j)
+			{
+				pairs.push_back(std::make_pair(i, j));
+			}
+		};
+
+		// a pseudo-random walk
+		static CoordinateArraySequence* walk(unsigned int seed,
+		                                     std::size_t n)
+		{
+			CoordinateArraySequence* seq = new CoordinateArraySequence();
+			double x = 50, y = 50;
+			for (std::size_t i=0; i<n; ++i)
+			{
+				seq->add(Coordinate(x, y));
+				seed = seed * 1103515245 + 12345;
+				x += int((seed >> 8) % 21) - 10;
+				seed = seed * 1103515245 + 12345;
+				y += int((seed >> 8) % 21) - 10;
+			}
+			return seq;
+		}
+	};
+
+	typedef test_group<test_segmentenvelopeblock_data> group;
+	typedef group::object object;
+
+	group test_segmentenvelopeblock_group("geos::index::chain::SegmentEnvelopeBlock");
+
+	//
+	// Test Cases
+	//
+
+	// 1 - Masks match Envelope::intersects, for all block sizes
+	template<>
+	template<>
+	void object::test<1>()
+	{
+		std::auto_ptr<CoordinateArraySequence> a(walk(3, 40));
+		std::auto_ptr<CoordinateArraySequence> b(walk(7, 40));
+
+		for (std::size_t n=0; n<=SegmentEnvelopeBlock::CAPACITY; ++n)
+		{
+			SegmentEnvelopeBlock block;
+			block.setSegments(*b, 3, 3+n);
+			ensure_equals( block.size(), n );
+
+			std::vector<unsigned int> masks(a->size()-1);
+			block.intersectingSegments(*a, 0, a->size()-1, &masks[0]);
+
+			for (std::size_t i=0; i+1<a->size(); ++i)
+			{
+				Envelope ea(a->getAt(i), a->getAt(i+1));
+				unsigned int expected = 0;
+				for (std::size_t j=0; j<n; ++j)
+				{
+					Envelope eb(b->getAt(3+j), b->getAt(3+j+1));
+					if (ea.intersects(eb)) expected |= 1u << j;
+				}
+				ensure_equals( masks[i], expected );
+				ensure_equals( block.intersecting(a->getAt(i), a->getAt(i+1)),
+				               expected );
+			}
+		}
+
+		// touching extents intersect, as for Envelope
+		SegmentEnvelopeBlock block;
+		block.setSegments(*a, 0, 1);
+		Envelope e(a->getAt(0), a->getAt(1));
+		ensure_equals( block.intersecting(e.getMaxX(), e.getMaxY(),
+		                                  e.getMaxX() + 1, e.getMaxY() + 1), 1u );
+		ensure_equals( block.intersecting(e.getMaxX() + 1, e.getMinY(),
+		                                  e.getMaxX() + 2, e.getMaxY()), 0u );
+	}
+
+	// 2 - visitOverlaps reports the masked pairs in bisection order
+	template<>
+	template<>
+	void object::test<2>()
+	{
+		// all pairs set: the order of the recursive bisection
+		unsigned int all[4] = { 0x7, 0x7, 0x7, 0x7 };
+		PairCollector full;
+		visitOverlaps(all, 10, 20, 10, 14, 20, 23, full);
+		ensure_equals( full.pairs.size(), 12u );
+		std::size_t expected[12][2] = {
+			{10,20}, {10,21}, {10,22}, {11,20}, {11,21}, {11,22},
+			{12,20}, {12,21}, {12,22}, {13,20}, {13,21}, {13,22}
+		};
+		// quadrants (10-12)x(20-21), (10-12)x(21-23), (12-14)x(20-21), ...
+		std::size_t order[12] = { 0, 3, 1, 2, 4, 5, 6, 9, 7, 8, 10, 11 };
+		for (std::size_t k=0; k<12; ++k)
+		{
+			ensure_equals( full.pairs[k].first, expected[order[k]][0] );
+			ensure_equals( full.pairs[k].second, expected[order[k]][1] );
+		}
+
+		// some pairs set: the same order, others dropped
+		unsigned int some[4] = { 0x2, 0x0, 0x5, 0x1 };
+		PairCollector partial;
+		visitOverlaps(some, 10, 20, 10, 14, 20, 23, partial);
+		PairVect filtered;
+		for (std::size_t k=0; k<full.pairs.size(); ++k)
+		{
+			std::size_t i = full.pairs[k].first, j = full.pairs[k].second;
+			if (some[i-10] & (1u << (j-20))) filtered.push_back(full.pairs[k]);
+		}
+		ensure( partial.pairs == filtered );
+	}
+
+	// 3 - SegmentIntersectionTester agrees with a brute force test
+	template<>
+	template<>
+	void object::test<3>()
+	{
+		geos::geom::GeometryFactory gf;
+		std::auto_ptr<geos::geom::LineString> line(gf.createLineString(walk(1, 60)));
+
+		for (unsigned int seed=2; seed<30; ++seed)
+		{
+			std::auto_ptr<geos::geom::LineString> test(
+				gf.createLineString(walk(seed, 70)));
+
+			bool expected = line->intersects(test.get());
+
+			geos::operation::predicate::SegmentIntersectionTester sit;
+			ensure_equals( sit.hasIntersection(*line, *test), expected );
+
+			geos::operation::predicate::SegmentIntersectionTester sitEnv;
+			ensure_equals( sitEnv.hasIntersectionWithEnvelopeFilter(*line, *test),
+			               expected );
+		}
+	}
+
+} // namespace tut
+
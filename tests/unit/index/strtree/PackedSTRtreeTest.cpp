@@ -0,0 +1,221 @@
+// 
+// Test Suite for geos::index::strtree::PackedSTRtree class.
+
+#include <tut.hpp>
+// geos
+#include <geos/index/strtree/PackedSTRtree.h>
+#include <geos/index/strtree/AbstractSTRtree.h>
+#include <geos/index/ItemVisitor.h>
+#include <geos/geom/Envelope.h>
+#include <geos/util/IllegalArgumentException.h>
+// std
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <cstddef>
+#include <limits>
+
+using namespace geos::index::strtree;
+using geos::geom::Envelope;
+
+namespace tut
+{
+	//
+	// Test Group
+	//
+
+	// Common data used by tests
+	struct test_packedstrtree_data
+	{
+		std::vector<Envelope> envs;
+
+		test_packedstrtree_data()
+		{
+			// a pseudo-random set of small envelopes
+			unsigned int seed = 17;
+			for (int i=0; i<1000; ++i)
+			{
+				seed = seed * 1103515245 + 12345;
+				double x = (seed >> 8) % 1000;
+				seed = seed * 1103515245 + 12345;
+				double y = (seed >> 8) % 1000;
+				envs.push_back(Envelope(x, x + (i%7), y, y + (i%5)));
+			}
+		}
+
+		void fill(PackedSTRtree& t)
+		{
+			for (std::size_t i=0; i<envs.size(); ++i)
+				t.insert(&envs[i], &envs[i]);
+		}
+
+		void bruteForce(const Envelope& q, std::vector<void*>& found)
+		{
+			for (std::size_t i=0; i<envs.size(); ++i)
+				if ( envs[i].intersects(q) ) found.push_back(&envs[i]);
+		}
+
+		struct ItemCollector: public geos::index::ItemVisitor
+		{
+			std::vector<void*> items;
+			void visitItem(void* item) { items.push_back(item); }
+		};
+
+		static std::size_t countItems(ItemsList* l)
+		{
+			std::size_t n = 0;
+			for (ItemsList::iterator i=l->begin(), e=l->end(); i!=e; ++i)
+			{
+				if ( i->get_type() == ItemsListItem::item_is_list )
+					n += countItems(i->get_itemslist());
+				else ++n;
+			}
+			return n;
+		}
+	};
+
+	typedef test_group<test_packedstrtree_data> group;
+	typedef group::object object;
+
+	group test_packedstrtree_group("geos::index::strtree::PackedSTRtree");
+
+	//
+	// Test Cases
+	//
+
+	// 1 - Query an empty tree
+	template<>
+	template<>
+	void object::test<1>()
+	{
+		PackedSTRtree t;
+		Envelope q(0, 10, 0, 10);
+		std::vector<void*> found;
+		t.query(&q, found);
+		ensure(found.empty());
+		ensure_equals(t.size(), 0u);
+	}
+
+	// 2 - Query results match a brute-force scan
+	template<>
+	template<>
+	void object::test<2>()
+	{
+		PackedSTRtree t(4);
+		fill(t);
+		ensure_equals(t.size(), envs.size());
+
+		for (int i=0; i<10; ++i)
+		{
+			Envelope q(i*90, i*90+120, 1000-i*100, 1000-i*100+60);
+
+			std::vector<void*> found;
+			t.query(&q, found);
+			std::vector<void*> expected;
+			bruteForce(q, expected);
+
+			std::sort(found.begin(), found.end());
+			std::sort(expected.begin(), expected.end());
+			ensure(found == expected);
+		}
+	}
+
+	// 3 - Removed items are not found anymore
+	template<>
+	template<>
+	void object::test<3>()
+	{
+		PackedSTRtree t;
+		fill(t);
+
+		// before build
+		ensure(t.remove(&envs[0], &envs[0]));
+		ensure(! t.remove(&envs[0], &envs[0]));
+
+		std::vector<void*> found;
+		t.query(&envs[1], found);
+		ensure(std::find(found.begin(), found.end(), &envs[1]) != found.end());
+
+		// after build
+		ensure(t.remove(&envs[1], &envs[1]));
+		ensure(! t.remove(&envs[1], &envs[1]));
+		ensure_equals(t.size(), envs.size() - 2);
+
+		found.clear();
+		t.query(&envs[1], found);
+		ensure(std::find(found.begin(), found.end(), &envs[1]) == found.end());
+	}
+
+	// 4 - itemsTree holds all items
+	template<>
+	template<>
+	void object::test<4>()
+	{
+		PackedSTRtree t(4);
+		fill(t);
+
+		std::auto_ptr<ItemsList> tree ( t.itemsTree() );
+		ensure_equals(countItems(tree.get()), envs.size());
+		ensure(tree->size() <= 4);
+	}
+
+	// 5 - Items cannot be inserted once the tree is built
+	template<>
+	template<>
+	void object::test<5>()
+	{
+		PackedSTRtree t(4);
+		fill(t);
+		std::vector<void*> found;
+		Envelope all(-1e9, 1e9, -1e9, 1e9);
+		t.query(&all, found);
+
+		Envelope env(0, 1, 0, 1);
+		try {
+			t.insert(&env, &env);
+			fail("insert after build did not throw");
+		} catch (const geos::util::IllegalArgumentException&) {
+		}
+		try {
+			t.build();
+			fail("second build did not throw");
+		} catch (const geos::util::IllegalArgumentException&) {
+		}
+
+		std::vector<void*> again;
+		t.query(&all, again);
+		ensure_equals(again.size(), found.size());
+	}
+
+	// 6 - Removed items are not found by unbounded queries
+	template<>
+	template<>
+	void object::test<6>()
+	{
+		PackedSTRtree t(4);
+		fill(t);
+		t.build();
+		ensure(t.remove(&envs[0], &envs[0]));
+		ensure(t.remove(&envs[1], &envs[1]));
+
+		const double inf = std::numeric_limits<double>::infinity();
+		const double max = std::numeric_limits<double>::max();
+		Envelope infinite(-inf, inf, -inf, inf);
+		Envelope maximal(-max, max, -max, max);
+
+		std::vector<void*> found;
+		t.query(&infinite, found);
+		ensure_equals(found.size(), envs.size() - 2);
+		ensure(std::find(found.begin(), found.end(), &envs[0]) == found.end());
+
+		found.clear();
+		t.query(&maximal, found);
+		ensure_equals(found.size(), envs.size() - 2);
+		ensure(std::find(found.begin(), found.end(), &envs[1]) == found.end());
+
+		ItemCollector visitor;
+		t.query(&infinite, visitor);
+		ensure_equals(visitor.items.size(), envs.size() - 2);
+	}
+
+} // namespace tut
@@ -0,0 +1,390 @@
+// 
+// Test Suite for geos::index::strtree::STRtree class.
+
+#include <tut.hpp>
+// geos
+#include <geos/index/strtree/STRtree.h>
+#include <geos/index/strtree/ItemBoundable.h>
+#include <geos/index/strtree/ItemDistance.h>
+#include <geos/index/ItemPairVisitor.h>
+#include <geos/geom/Envelope.h>
+#include <geos/platform.h>
+// std
+#include <vector>
+#include <memory>
+#include <utility>
+#include <algorithm>
+#include <cstddef>
+
+using namespace geos::index::strtree;
+using geos::geom::Envelope;
+
+namespace tut
+{
+	//
+	// Test Group
+	//
+
+	// Uses the envelopes themselves as items
+	struct EnvelopeItemDistance: public ItemDistance
+	{
+		double distance(const ItemBoundable* item1,
+		                const ItemBoundable* item2)
+		{
+			const Envelope* e1 = static_cast<const Envelope*>(item1->getItem());
+			const Envelope* e2 = static_cast<const Envelope*>(item2->getItem());
+			return e1->distance(e2);
+		}
+	};
+
+	// Collects the pairs of items it is given
+	struct PairCollector: public geos::index::ItemPairVisitor
+	{
+		std::vector< std::pair<void*, void*> > pairs;
+
+		void visitItemPair(void *item, void *otherItem)
+		{
+			pairs.push_back(std::make_pair(item, otherItem));
+		}
+	};
+
+	// Common data used by tests
+	struct test_strtree_data
+	{
+		std::vector<Envelope> envs;
+
+		test_strtree_data()
+		{
+			// a 20x20 grid of unit squares, 2 units apart
+			for (int x=0; x<20; ++x)
+				for (int y=0; y<20; ++y)
+					envs.push_back(Envelope(x*2, x*2+1, y*2, y*2+1));
+		}
+
+		void fill(STRtree& t)
+		{
+			for (std::size_t i=0; i<envs.size(); ++i)
+				t.insert(&envs[i], &envs[i]);
+		}
+
+		// Appends the items of a tree, with a 0 marking the end of each node
+		static void flatten(const ItemsList& l, std::vector<void*>& out)
+		{
+			for (std::size_t i=0; i<l.size(); ++i)
+			{
+				if ( l[i].get_type() == ItemsListItem::item_is_list )
+					flatten(*l[i].get_itemslist(), out);
+				else
+					out.push_back(l[i].get_geometry());
+			}
+			out.push_back(0);
+		}
+	};
+
+	typedef test_group<test_strtree_data> group;
+	typedef group::object object;
+
+	group test_strtree_group("geos::index::strtree::STRtree");
+
+	//
+	// Test Cases
+	//
+
+	// 1 - nearestNeighbour on an empty tree
+	template<>
+	template<>
+	void object::test<1>()
+	{
+		STRtree t;
+		EnvelopeItemDistance dist;
+		Envelope q(0, 1, 0, 1);
+		ensure(0 == t.nearestNeighbour(&q, &q, &dist));
+	}
+
+	// 2 - nearestNeighbour finds the closest item
+	template<>
+	template<>
+	void object::test<2>()
+	{
+		STRtree t(4);
+		fill(t);
+		EnvelopeItemDistance dist;
+
+		Envelope q(10.2, 10.4, 14.6, 14.8);
+		void* nn = t.nearestNeighbour(&q, &q, &dist);
+		ensure(0 != nn);
+		ensure(*static_cast<Envelope*>(nn) == Envelope(10, 11, 14, 15));
+
+		Envelope far(-100, -99, 100, 101);
+		nn = t.nearestNeighbour(&far, &far, &dist);
+		ensure(*static_cast<Envelope*>(nn) == Envelope(0, 1, 38, 39));
+	}
+
+	// 3 - k nearest neighbours agree with a brute-force scan
+	template<>
+	template<>
+	void object::test<3>()
+	{
+		STRtree t(4);
+		fill(t);
+		EnvelopeItemDistance dist;
+
+		Envelope q(15.5, 15.5, 21.5, 21.5);
+		ItemBoundable qb(&q, &q);
+
+		const std::size_t k = 9;
+		std::vector<void*> nn;
+		t.nearestNeighbour(&q, &q, &dist, k, nn);
+		ensure_equals(nn.size(), k);
+
+		// results are sorted by distance
+		for (std::size_t i=1; i<nn.size(); ++i)
+		{
+			ensure(static_cast<Envelope*>(nn[i-1])->distance(&q) <=
+			       static_cast<Envelope*>(nn[i])->distance(&q));
+		}
+
+		// no item left out is closer than the farthest one found
+		double maxDist = static_cast<Envelope*>(nn.back())->distance(&q);
+		std::size_t closer = 0;
+		for (std::size_t i=0; i<envs.size(); ++i)
+		{
+			if ( envs[i].distance(&q) < maxDist ) ++closer;
+		}
+		ensure(closer < k);
+	}
+
+	// 4 - asking for more neighbours than items returns all items
+	template<>
+	template<>
+	void object::test<4>()
+	{
+		STRtree t;
+		fill(t);
+		EnvelopeItemDistance dist;
+
+		Envelope q(0, 0, 0, 0);
+		std::vector<void*> nn;
+		t.nearestNeighbour(&q, &q, &dist, envs.size()+10, nn);
+		ensure_equals(nn.size(), envs.size());
+	}
+
+	// 5 - building with several threads gives the same tree
+	template<>
+	template<>
+	void object::test<5>()
+	{
+		// enough items for the lower levels to be built in parallel,
+		// with many duplicate centres to check sort stability
+		std::vector<Envelope> many;
+		for (int i=0; i<40000; ++i)
+			many.push_back(Envelope(i%251, i%251+1, i%113, i%113+2));
+
+		STRtree serial;
+		STRtree parallel;
+		parallel.setBuildThreads(4);
+		ensure_equals(parallel.getBuildThreads(), std::size_t(4));
+		for (std::size_t i=0; i<many.size(); ++i)
+		{
+			serial.insert(&many[i], &many[i]);
+			parallel.insert(&many[i], &many[i]);
+		}
+
+		std::auto_ptr<ItemsList> serialTree(serial.itemsTree());
+		std::auto_ptr<ItemsList> parallelTree(parallel.itemsTree());
+		std::vector<void*> serialItems, parallelItems;
+		flatten(*serialTree, serialItems);
+		flatten(*parallelTree, parallelItems);
+		ensure(serialItems == parallelItems);
+
+		Envelope q(10.5, 20.5, 30.5, 40.5);
+		std::vector<void*> serialHits, parallelHits;
+		serial.query(&q, serialHits);
+		parallel.query(&q, parallelHits);
+		ensure(! serialHits.empty());
+		ensure(serialHits == parallelHits);
+	}
+
+	// 6 - building with one thread per processor
+	template<>
+	template<>
+	void object::test<6>()
+	{
+		STRtree t;
+		t.setBuildThreads(0);
+		fill(t);
+
+		Envelope q(0, 3, 0, 3);
+		std::vector<void*> hits;
+		t.query(&q, hits);
+		ensure_equals(hits.size(), std::size_t(4));
+	}
+
+	// 7 - batch queries find what single queries find
+	template<>
+	template<>
+	void object::test<7>()
+	{
+		STRtree t;
+		fill(t);
+
+		std::vector<Envelope> qs;
+		for (int i=0; i<300; ++i)
+			qs.push_back(Envelope((i*7)%40, (i*7)%40+i%5, (i*13)%40, (i*13)%40+i%3));
+		qs.push_back(Envelope()); // null envelope finds nothing
+		qs.push_back(Envelope(-10, 100, -10, 100));
+
+		std::vector<const Envelope*> qptrs;
+		for (std::size_t i=0; i<qs.size(); ++i) qptrs.push_back(&qs[i]);
+
+		std::vector<std::size_t> offsets;
+		std::vector<void*> items;
+		t.queryBatch(qptrs, offsets, items);
+		ensure_equals(offsets.size(), qs.size()+1);
+		ensure_equals(offsets.back(), items.size());
+		ensure_equals(offsets[qs.size()]-offsets[qs.size()-1], envs.size());
+
+		for (std::size_t i=0; i<qs.size(); ++i)
+		{
+			std::vector<void*> found;
+			if ( ! qs[i].isNull() ) t.query(&qs[i], found);
+			std::vector<void*> batch(items.begin()+offsets[i],
+			                         items.begin()+offsets[i+1]);
+			ensure(found == batch);
+		}
+	}
+
+	// 8 - batch queries on an empty tree
+	template<>
+	template<>
+	void object::test<8>()
+	{
+		STRtree t;
+		Envelope q(0, 1, 0, 1);
+		std::vector<const Envelope*> qptrs(2, &q);
+
+		std::vector<std::size_t> offsets;
+		std::vector<void*> items;
+		t.queryBatch(qptrs, offsets, items);
+		ensure_equals(offsets.size(), std::size_t(3));
+		ensure_equals(offsets[2], std::size_t(0));
+		ensure(items.empty());
+	}
+
+	// 9 - join finds the same pairs as a nested loop
+	template<>
+	template<>
+	void object::test<9>()
+	{
+		STRtree t;
+		fill(t);
+
+		// a different layout, some out of the grid
+		std::vector<Envelope> others;
+		for (int i=0; i<500; ++i)
+			others.push_back(Envelope((i*17)%50-5, (i*17)%50-5+i%4,
+			                          (i*31)%50-5, (i*31)%50-5+i%3));
+		STRtree o(4);
+		for (std::size_t i=0; i<others.size(); ++i)
+			o.insert(&others[i], &others[i]);
+
+		PairCollector collector;
+		t.join(o, collector);
+
+		std::vector< std::pair<void*, void*> > expected;
+		for (std::size_t i=0; i<envs.size(); ++i)
+			for (std::size_t j=0; j<others.size(); ++j)
+				if ( envs[i].intersects(others[j]) )
+					expected.push_back(std::make_pair(
+						(void*)&envs[i], (void*)&others[j]));
+
+		std::sort(collector.pairs.begin(), collector.pairs.end());
+		std::sort(expected.begin(), expected.end());
+		ensure(! expected.empty());
+		ensure(collector.pairs == expected);
+
+		// joining with an empty tree
+		STRtree empty;
+		PairCollector none;
+		t.join(empty, none);
+		empty.join(t, none);
+		ensure(none.pairs.empty());
+	}
+
+	// 10 - dual-tree nearestNeighbour and isWithinDistance
+	template<>
+	template<>
+	void object::test<10>()
+	{
+		STRtree t;
+		fill(t);
+
+		// some unit squares around the grid, none touching it
+		std::vector<Envelope> others;
+		for (int i=0; i<100; ++i)
+		{
+			double x = 41.5 + (i*7)%13, y = -20.0 + (i*11)%80;
+			others.push_back(Envelope(x, x+1, y, y+1));
+		}
+		STRtree o(4);
+		for (std::size_t i=0; i<others.size(); ++i)
+			o.insert(&others[i], &others[i]);
+
+		double expected = DoubleInfinity;
+		for (std::size_t i=0; i<envs.size(); ++i)
+			for (std::size_t j=0; j<others.size(); ++j)
+				expected = std::min(expected, envs[i].distance(&others[j]));
+		ensure(expected > 0);
+
+		EnvelopeItemDistance dist;
+		std::pair<void*, void*> nearest = t.nearestNeighbour(o, &dist);
+		ensure(nearest.first != 0);
+		const Envelope* e0 = static_cast<const Envelope*>(nearest.first);
+		const Envelope* e1 = static_cast<const Envelope*>(nearest.second);
+		// items come in tree order
+		ensure(e0 >= &envs.front() && e0 <= &envs.back());
+		ensure_equals(e0->distance(e1), expected);
+
+		ensure(t.isWithinDistance(o, &dist, expected));
+		ensure(! t.isWithinDistance(o, &dist, expected * 0.99));
+		ensure(o.isWithinDistance(t, &dist, expected * 1.01));
+
+		// with an empty tree
+		STRtree empty;
+		ensure(t.nearestNeighbour(empty, &dist).first == 0);
+		ensure(empty.nearestNeighbour(t, &dist).second == 0);
+		ensure(! t.isWithinDistance(empty, &dist, 1e10));
+	}
+
+	// 11 - the tree is the same for any number of threads
+	template<>
+	template<>
+	void object::test<11>()
+	{
+		std::vector<Envelope> many;
+		for (int i=0; i<30000; ++i)
+			many.push_back(Envelope(i%97, i%97+3, i%89, i%89+1));
+
+		STRtree serial;
+		for (std::size_t i=0; i<many.size(); ++i)
+			serial.insert(&many[i], &many[i]);
+		std::auto_ptr<ItemsList> serialTree(serial.itemsTree());
+		std::vector<void*> serialItems;
+		flatten(*serialTree, serialItems);
+
+		const std::size_t threads[] = { 2, 3, 7 };
+		for (std::size_t t=0; t<3; ++t)
+		{
+			STRtree parallel;
+			parallel.setBuildThreads(threads[t]);
+			for (std::size_t i=0; i<many.size(); ++i)
+				parallel.insert(&many[i], &many[i]);
+
+			std::auto_ptr<ItemsList> parallelTree(parallel.itemsTree());
+			std::vector<void*> parallelItems;
+			flatten(*parallelTree, parallelItems);
+			ensure(serialItems == parallelItems);
+		}
+	}
+
+} // namespace tut
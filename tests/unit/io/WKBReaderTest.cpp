@@ -12,6 +12,7 @@
 #include <geos/io/WKBConstants.h>
 #include <geos/io/WKBWriter.h>
 #include <geos/io/WKTReader.h>
+#include <geos/io/ParseException.h>
 #include <geos/geom/PrecisionModel.h>
 #include <geos/geom/GeometryFactory.h>
 #include <geos/geom/Geometry.h>
@@ -19,6 +20,8 @@
 #include <sstream>
 #include <string>
 #include <memory>
+#include <vector>
+#include <cstdlib>
 
 namespace tut
 {
@@ -50,6 +53,18 @@ namespace tut
 			wktreader(&gf)
 		{}
 
+		static std::vector<unsigned char> fromHEX(const std::string& hex)
+		{
+			std::vector<unsigned char> bytes;
+			for (std::string::size_type i=0; i+1<hex.size(); i+=2)
+			{
+				std::string byte = hex.substr(i, 2);
+				bytes.push_back(static_cast<unsigned char>(
+					std::strtol(byte.c_str(), 0, 16)));
+			}
+			return bytes;
+		}
+
 		void testInputOutput(const std::string& WKT,
 				const std::string& ndrWKB,
 				const std::string& xdrWKB)
@@ -71,6 +86,16 @@ namespace tut
 			// Compare geoms read from NDR and XDR
 			ensure( gWKB_xdr->equalsExact(gWKB_ndr.get()) );
 
+			// Memory buffer input
+			std::vector<unsigned char> ndr_buf = fromHEX(ndrWKB);
+			GeomPtr gBuf_ndr(wkbreader.read(&ndr_buf[0], ndr_buf.size()));
+			ensure("NDR buffer input",
+				gBuf_ndr->equalsExact(gWKT.get()) );
+			std::vector<unsigned char> xdr_buf = fromHEX(xdrWKB);
+			GeomPtr gBuf_xdr(wkbreader.read(&xdr_buf[0], xdr_buf.size()));
+			ensure("XDR buffer input",
+				gBuf_xdr->equalsExact(gWKT.get()) );
+
 			// NDR output
 			std::stringstream ndr_out;
 			ndrwkbwriter.writeHEX(*gWKT, ndr_out);
@@ -241,6 +266,51 @@ namespace tut
 
 	}
 
+	// 8 - Read 3D geometries from a memory buffer
+	template<>
+	template<>
+	void object::test<8>()
+	{
+		geos::io::WKBWriter writer(3, geos::io::WKBConstants::wkbXDR);
+		GeomPtr g(wktreader.read("LINESTRING(1 2 3, 4 5 6, 7 8 9)"));
+		std::stringstream out;
+		writer.write(*g, out);
+		std::string wkb = out.str();
+
+		GeomPtr g2(wkbreader.read(
+			reinterpret_cast<const unsigned char*>(wkb.data()), wkb.size()));
+		ensure( g2->equalsExact(g.get()) );
+		ensure_equals( g2->getCoordinateDimension(), 3 );
+		ensure_equals( g2->getCoordinates()->getAt(2).z, 9.0 );
+	}
+
+	// 9 - Truncated buffers are rejected
+	template<>
+	template<>
+	void object::test<9>()
+	{
+		std::vector<unsigned char> wkb = fromHEX(
+			"010200000002000000000000000000F03F000000000000004000000000000008400000000000001040");
+
+		for (std::size_t n=0; n<wkb.size(); ++n)
+		{
+			try {
+				GeomPtr g(wkbreader.read(&wkb[0], n));
+				fail("Truncated WKB was accepted");
+			} catch (const geos::io::ParseException&) {
+				// expected
+			}
+		}
+
+		// a huge number of points in a short buffer
+		wkb[5] = 0xff; wkb[6] = 0xff; wkb[7] = 0xff; wkb[8] = 0x0f;
+		try {
+			GeomPtr g(wkbreader.read(&wkb[0], wkb.size()));
+			fail("Truncated WKB was accepted");
+		} catch (const geos::io::ParseException&) {
+			// expected
+		}
+	}
 
 } // namespace tut
 
@@ -0,0 +1,109 @@
+//
+// Test Suite for geos::noding::MCIndexNoder class.
+
+#include <tut.hpp>
+// geos
+#include <geos/noding/MCIndexNoder.h>
+#include <geos/noding/IntersectionAdder.h>
+#include <geos/noding/NodedSegmentString.h>
+#include <geos/noding/SegmentString.h>
+#include <geos/algorithm/LineIntersector.h>
+#include <geos/geom/Coordinate.h>
+#include <geos/geom/CoordinateArraySequence.h>
+// std
+#include <cstddef>
+#include <string>
+#include <vector>
+
+using namespace geos::noding;
+using geos::geom::Coordinate;
+using geos::geom::CoordinateArraySequence;
+
+namespace tut
+{
+	//
+	// Test Group
+	//
+
+	// Common data used by tests
+	struct test_mcindexnoder_data
+	{
+		// Zig-zag lines crossing each other, many chains each
+		static SegmentString::NonConstVect* makeLines()
+		{
+			SegmentString::NonConstVect* lines = new SegmentString::NonConstVect;
+			for (int l=0; l<30; ++l)
+			{
+				CoordinateArraySequence* cs = new CoordinateArraySequence();
+				for (int i=0; i<100; ++i)
+				{
+					double x = i + (l % 7) * 0.3;
+					double y = l + ((i * 7 + l) % 5) * 1.7;
+					if ( l % 2 ) cs->add(Coordinate(y, x));
+					else cs->add(Coordinate(x, y));
+				}
+				lines->push_back(new NodedSegmentString(cs, 0));
+			}
+			return lines;
+		}
+
+		static void destroy(SegmentString::NonConstVect* v)
+		{
+			// NodedSegmentStrings own their coordinates
+			for (std::size_t i=0; i<v->size(); ++i) delete (*v)[i];
+			delete v;
+		}
+
+		// Nodes the lines, returning the noded substrings as text
+		static std::string node(std::size_t numThreads, int& numInteriorInt)
+		{
+			SegmentString::NonConstVect* lines = makeLines();
+			geos::algorithm::LineIntersector li;
+			IntersectionAdder adder(li);
+			MCIndexNoder noder(&adder);
+			noder.setNumThreads(numThreads);
+			noder.computeNodes(lines);
+
+			SegmentString::NonConstVect* noded = noder.getNodedSubstrings();
+			std::string out;
+			for (std::size_t i=0; i<noded->size(); ++i)
+			{
+				out += (*noded)[i]->getCoordinates()->toString();
+				out += "\n";
+			}
+			numInteriorInt = adder.numInteriorIntersections;
+
+			destroy(noded);
+			destroy(lines);
+			return out;
+		}
+	};
+
+	typedef test_group<test_mcindexnoder_data> group;
+	typedef group::object object;
+
+	group test_mcindexnoder_group("geos::noding::MCIndexNoder");
+
+	//
+	// Test Cases
+	//
+
+	// 1 - Threads do not change the noding
+	template<>
+	template<>
+	void object::test<1>()
+	{
+		int expectedInt = 0;
+		std::string expected = node(1, expectedInt);
+		ensure(expectedInt > 100);
+
+		for (std::size_t threads=0; threads<4; ++threads)
+		{
+			int numInt = 0;
+			ensure(node(threads, numInt) == expected);
+			ensure_equals(numInt, expectedInt);
+		}
+	}
+
+} // namespace tut
+
@@ -14,10 +14,17 @@
 #include <geos/io/WKTReader.h>
 #include <geos/io/WKBReader.h>
 #include <geos/geom/CoordinateSequence.h>
+#include <geos/geom/CoordinateArraySequence.h>
+#include <geos/geom/LineString.h>
+#include <geos/geom/LinearRing.h>
+#include <geos/geom/Polygon.h>
+#include <geos/algorithm/CGAlgorithms.h>
 // std
 #include <memory>
 #include <string>
 #include <vector>
+#include <algorithm>
+#include <cmath>
 
 namespace tut
 {
@@ -478,6 +485,55 @@ namespace tut
         ensure_equals(g1->distance(g2.get()), 0);
     }
 
+	// Large inputs, searched by index: same as comparing all facets
+	template<>
+	template<>
+	void object::test<20>()
+	{
+		using geos::operation::distance::DistanceOp;
+		using geos::algorithm::CGAlgorithms;
+		using geos::geom::Coordinate;
+		using geos::geom::CoordinateArraySequence;
+
+		// two interleaved zig-zags, and a ring around the first
+		CoordinateArraySequence* cs0 = new CoordinateArraySequence();
+		CoordinateArraySequence* cs1 = new CoordinateArraySequence();
+		for (int i=0; i<300; ++i)
+		{
+			cs0->add(Coordinate(i, (i%2) ? 10 : 0));
+			cs1->add(Coordinate(i+0.3, (i%3) ? 21.5 - i%7 : 13.25));
+		}
+		CoordinateArraySequence* ring = new CoordinateArraySequence();
+		for (int i=0; i<100; ++i)
+			ring->add(Coordinate(150 + 400*std::cos(i*0.0628),
+			                     5 + 400*std::sin(i*0.0628)));
+		ring->add(ring->getAt(0));
+
+		GeomPtr g0(gf.createLineString(cs0));
+		GeomPtr g1(gf.createLineString(cs1));
+		GeomPtr poly(gf.createPolygon(gf.createLinearRing(ring), 0));
+
+		double expected = DoubleInfinity;
+		for (std::size_t i=0; i+1<cs0->size(); ++i)
+			for (std::size_t j=0; j+1<cs1->size(); ++j)
+				expected = std::min(expected, CGAlgorithms::distanceLineLine(
+					cs0->getAt(i), cs0->getAt(i+1),
+					cs1->getAt(j), cs1->getAt(j+1)));
+
+		DistanceOp dist(*g0, *g1);
+		ensure_equals(dist.distance(), expected);
+		CSPtr cs(dist.nearestPoints());
+		ensure_distance(cs->getAt(0).distance(cs->getAt(1)), expected, 1e-9);
+
+		ensure(DistanceOp::isWithinDistance(*g0, *g1, expected));
+		ensure(!DistanceOp::isWithinDistance(*g0, *g1, expected * 0.99));
+		ensure(g1->isWithinDistance(g0.get(), expected * 1.01));
+
+		// a line inside a polygon is at distance 0 from it
+		ensure_equals(DistanceOp::distance(*poly, *g1), 0);
+		ensure(poly->isWithinDistance(g0.get(), 0));
+	}
+
 	// TODO: finish the tests by adding:
 	// 	LINESTRING - *all*
 	// 	MULTILINESTRING - *all*
@@ -0,0 +1,131 @@
+//
+// Test Suite for geos::operation::distance::IndexedFacetDistance class.
+
+#include <tut.hpp>
+// geos
+#include <geos/operation/distance/IndexedFacetDistance.h>
+#include <geos/operation/distance/DistanceOp.h>
+#include <geos/operation/distance/GeometryLocation.h>
+#include <geos/geom/GeometryFactory.h>
+#include <geos/geom/Geometry.h>
+#include <geos/io/WKTReader.h>
+// std
+#include <memory>
+#include <string>
+
+using geos::operation::distance::IndexedFacetDistance;
+using geos::operation::distance::DistanceOp;
+using geos::operation::distance::GeometryLocation;
+
+namespace tut
+{
+	//
+	// Test Group
+	//
+
+	// Common data used by tests
+	struct test_indexedfacetdistance_data
+	{
+		geos::geom::GeometryFactory gf;
+		geos::io::WKTReader reader;
+
+		typedef std::auto_ptr<geos::geom::Geometry> GeomPtr;
+
+		test_indexedfacetdistance_data() : gf(), reader(&gf) {}
+
+		GeomPtr read(const std::string& wkt)
+		{
+			return GeomPtr(reader.read(wkt));
+		}
+	};
+
+	typedef test_group<test_indexedfacetdistance_data> group;
+	typedef group::object object;
+
+	group test_indexedfacetdistance_group("geos::operation::distance::IndexedFacetDistance");
+
+	//
+	// Test Cases
+	//
+
+	// 1 - Facet distances of points and lines, as DistanceOp
+	template<>
+	template<>
+	void object::test<1>()
+	{
+		const char* wkts[] = {
+			"POINT(0 0)",
+			"MULTIPOINT((10 10), (3 -4), (50 0))",
+			"LINESTRING(1 5, 2 6, 3 5, 4 6, 5 5, 6 6, 7 5, 8 6, 9 5, 10 6, 11 5)",
+			"MULTILINESTRING((20 0, 20 20), (-5 -5, -6 -6, -7 -5, -8 -6))",
+			"GEOMETRYCOLLECTION(POINT(30 30), LINESTRING(25 25, 26 20))"
+		};
+		const std::size_t n = sizeof(wkts)/sizeof(wkts[0]);
+		for (std::size_t i=0; i<n; ++i)
+		{
+			GeomPtr g0(read(wkts[i]));
+			IndexedFacetDistance ifd(*g0);
+			for (std::size_t j=0; j<n; ++j)
+			{
+				GeomPtr g1(read(wkts[j]));
+				double d = DistanceOp::distance(*g0, *g1);
+				ensure_equals( ifd.getDistance(*g1), d );
+				ensure_equals( IndexedFacetDistance::distance(*g1, *g0), d );
+				ensure( ifd.isWithinDistance(*g1, d) );
+				if ( d > 0 )
+					ensure( ! ifd.isWithinDistance(*g1, d * 0.99) );
+			}
+		}
+	}
+
+	// 2 - Long lines are cut in sequences; nearest locations
+	template<>
+	template<>
+	void object::test<2>()
+	{
+		GeomPtr g0(read("LINESTRING(0 0, 1 0, 2 0, 3 0, 4 0, 5 0, 6 0, 7 0, 8 0, 9 0, 10 0, 11 0, 12 0, 13 0)"));
+		GeomPtr g1(read("LINESTRING(12.5 3, 12.5 1)"));
+
+		IndexedFacetDistance ifd0(*g0);
+		IndexedFacetDistance ifd1(*g1);
+		ensure_equals( ifd0.getNumFacetSequences(), 3u );
+		ensure_equals( ifd1.getNumFacetSequences(), 1u );
+
+		GeometryLocation* loc0;
+		GeometryLocation* loc1;
+		double d = ifd0.nearestLocations(ifd1, 0.0, loc0, loc1);
+		ensure_equals( d, 1.0 );
+		ensure_equals( loc0->getSegmentIndex(), 12 );
+		ensure( loc0->getCoordinate().equals2D(geos::geom::Coordinate(12.5, 0)) );
+		ensure_equals( loc1->getSegmentIndex(), 0 );
+		ensure( loc1->getCoordinate().equals2D(geos::geom::Coordinate(12.5, 1)) );
+		ensure( loc0->getGeometryComponent() == g0.get() );
+		delete loc0;
+		delete loc1;
+	}
+
+	// 3 - Areas: only facets count; empty geometries
+	template<>
+	template<>
+	void object::test<3>()
+	{
+		GeomPtr poly(read("POLYGON((0 0, 10 0, 10 10, 0 10, 0 0))"));
+		GeomPtr inside(read("POINT(5 4)"));
+		ensure_equals( IndexedFacetDistance::distance(*poly, *inside), 4.0 );
+		ensure_equals( DistanceOp::distance(*poly, *inside), 0.0 );
+
+		GeomPtr empty(read("LINESTRING EMPTY"));
+		IndexedFacetDistance ifd(*empty);
+		ensure_equals( ifd.getNumFacetSequences(), 0u );
+		ensure_equals( ifd.getDistance(*poly), 0.0 );
+		ensure( ! ifd.isWithinDistance(*poly, 100) );
+
+		GeometryLocation* loc0;
+		GeometryLocation* loc1;
+		IndexedFacetDistance ifdPoly(*poly);
+		ifdPoly.nearestLocations(ifd, 0.0, loc0, loc1);
+		ensure( loc0 == 0 );
+		ensure( loc1 == 0 );
+	}
+
+} // namespace tut
@@ -19,6 +19,7 @@
 #include <string>
 #include <vector>
 #include <iostream>
+#include <sstream>
 
 namespace tut
 {
@@ -186,5 +187,121 @@ namespace tut
         doTest(inp, exp);
     }
 
+    // Nested rings: holes go to the innermost shell containing them,
+    // also when the shell is large enough to be indexed
+    template<>
+    template<>
+    void object::test<3>()
+    {
+        // a 100x100 square with a vertex every 5 units
+        std::ostringstream outer;
+        outer << "LINESTRING (0 0";
+        for (int i=5; i<=100; i+=5) outer << ", " << i << " 0";
+        for (int i=5; i<=100; i+=5) outer << ", 100 " << i;
+        for (int i=95; i>=0; i-=5) outer << ", " << i << " 100";
+        for (int i=95; i>=0; i-=5) outer << ", 0 " << i;
+        outer << ")";
+
+        static char const* const rings[] = {
+            "LINESTRING (10 10, 40 10, 40 40, 10 40, 10 10)",
+            "LINESTRING (20 20, 30 20, 30 30, 20 30, 20 20)",
+            "LINESTRING (60 60, 90 60, 90 90, 60 90, 60 60)",
+            "LINESTRING (200 200, 210 200, 210 210, 200 210, 200 200)",
+            NULL
+        };
+
+        std::vector<Geom*> inputGeoms;
+        inputGeoms.push_back(readWKT(outer.str()).release());
+        ensure( inputGeoms[0]->getNumPoints() > 64 );
+        readWKT(rings, inputGeoms);
+
+        Polygonizer polygonizer;
+        polygonizer.add(&inputGeoms);
+        std::auto_ptr< std::vector<Poly*> > polys( polygonizer.getPolygons() );
+        ensure_equals( polys->size(), 5u );
+
+        // number of holes, by lower left corner of the shell
+        for (std::size_t i=0; i<polys->size(); ++i)
+        {
+            const Poly* p = (*polys)[i];
+            double x = p->getEnvelopeInternal()->getMinX();
+            std::size_t expected = x == 0 ? 2 : x == 10 ? 1 : 0;
+            ensure_equals( p->getNumInteriorRing(), expected );
+        }
+
+        delAll(inputGeoms);
+        delAll(*polys);
+    }
+
+    // Polygonizing the connected components on several threads
+    // gives the same polygons, dangles, cut edges and invalid rings
+    template<>
+    template<>
+    void object::test<4>()
+    {
+        std::vector<Geom*> inputGeoms;
+
+        // a frame around all cells, whose shells become its holes
+        inputGeoms.push_back(readWKT(
+            "LINESTRING (-10 -10, 250 -10, 250 250, -10 250, -10 -10)").release());
+
+        for (int i=0; i<12; ++i)
+        for (int j=0; j<12; ++j)
+        {
+            int x = 20*i, y = 20*j;
+            std::ostringstream cell;
+            // a cell split into four edges, with an island
+            cell << "MULTILINESTRING ("
+                 << "(" << x << " " << y << ", " << x+10 << " " << y << "), "
+                 << "(" << x+10 << " " << y << ", " << x+10 << " " << y+10 << "), "
+                 << "(" << x+10 << " " << y+10 << ", " << x << " " << y+10 << "), "
+                 << "(" << x << " " << y+10 << ", " << x << " " << y << "), "
+                 << "(" << x+3 << " " << y+3 << ", " << x+7 << " " << y+3 << ", "
+                 << x+7 << " " << y+7 << ", " << x+3 << " " << y+7 << ", "
+                 << x+3 << " " << y+3 << ")";
+            // a dangle, a cut edge or an invalid ring in some cells
+            if ( (i+j) % 5 == 1 )
+                cell << ", (" << x+10 << " " << y << ", " << x+15 << " " << y+5 << ")";
+            else if ( (i+j) % 5 == 2 )
+                cell << ", (" << x+10 << " " << y << ", " << x+13 << " " << y << "), "
+                     << "(" << x+13 << " " << y << ", " << x+16 << " " << y << ", "
+                     << x+16 << " " << y+5 << ", " << x+13 << " " << y << ")";
+            else if ( (i+j) % 5 == 3 )
+                cell << ", (" << x+11 << " " << y+1 << ", " << x+15 << " " << y+5 << ", "
+                     << x+15 << " " << y+1 << ", " << x+11 << " " << y+5 << ", "
+                     << x+11 << " " << y+1 << ")";
+            cell << ")";
+            inputGeoms.push_back(readWKT(cell.str()).release());
+        }
+
+        // getPolygons gives up the polygons, so the other
+        // results are to be fetched first
+        Polygonizer serial;
+        serial.add(&inputGeoms);
+        Polygonizer parallel;
+        parallel.setNumThreads(4);
+        parallel.add(&inputGeoms);
+
+        ensure( ! serial.getDangles().empty() );
+        ensure_equals( parallel.getDangles().size(),
+                       serial.getDangles().size() );
+        ensure( ! serial.getCutEdges().empty() );
+        ensure_equals( parallel.getCutEdges().size(),
+                       serial.getCutEdges().size() );
+        ensure( ! serial.getInvalidRingLines().empty() );
+        ensure_equals( parallel.getInvalidRingLines().size(),
+                       serial.getInvalidRingLines().size() );
+
+        std::auto_ptr< std::vector<Poly*> > expected( serial.getPolygons() );
+        // the frame, each cell and its island, and the rings past cut edges
+        ensure( expected->size() > 1u + 2 * 144 );
+        std::auto_ptr< std::vector<Poly*> > obtained( parallel.getPolygons() );
+        ensure( compare(*expected, *obtained) );
+
+        delAll(*expected);
+        delAll(*obtained);
+        delAll(inputGeoms);
+    }
+
 } // namespace tut
 
@@ -12,6 +12,7 @@
 #include <geos/io/WKTReader.h>
 #include <geos/io/WKTWriter.h>
 // std
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -163,5 +164,28 @@ namespace tut
 //         std::for_each(g.begin(), g.end(), delete_geometry);
 //     }
 
-} // namespace tut
+    // Unioning with several threads gives the same result
+    template<>
+    template<>
+    void object::test<4>()
+    {
+        using geos::operation::geounion::CascadedPolygonUnion;
+
+        std::vector<geos::geom::Polygon*> g;
+        create_discs(gf, 12, 0.6, &g);
 
+        std::auto_ptr<geos::geom::Geometry> serial(
+            CascadedPolygonUnion::Union(&g));
+        std::auto_ptr<geos::geom::Geometry> parallel(
+            CascadedPolygonUnion::Union(&g, 4));
+
+        ensure(serial->equalsExact(parallel.get()));
+
+        std::auto_ptr<geos::geom::Geometry> perProcessor(
+            CascadedPolygonUnion::Union(g.begin(), g.end(), 0));
+        ensure(serial->equalsExact(perProcessor.get()));
+
+        std::for_each(g.begin(), g.end(), delete_geometry);
+    }
+
+} // namespace tut
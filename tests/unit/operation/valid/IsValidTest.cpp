@@ -14,6 +14,7 @@
 #include <geos/geom/GeometryFactory.h>
 #include <geos/geom/PrecisionModel.h>
 #include <geos/operation/valid/TopologyValidationError.h>
+#include <geos/io/WKTReader.h>
 #include <geos/platform.h> // for ISNAN
 // std
 #include <cmath>
@@ -36,9 +37,10 @@ namespace tut
 
         geos::geom::PrecisionModel pm_;
         geos::geom::GeometryFactory factory_;
+        geos::io::WKTReader reader_;
 
         test_isvalidop_data()
-			: pm_(1), factory_(&pm_, 0)
+			: pm_(1), factory_(&pm_, 0), reader_(&factory_)
         {}
     };
 
@@ -76,5 +78,64 @@ namespace tut
 	ensure_equals(valid, false);
     }
 
+    // 2 - isValid() tells the same as the validation error, with or
+    //     without the topology graph
+    template<>
+    template<>
+    void object::test<2>()
+    {
+	const char* valid[] = {
+		"POLYGON((0 0,10 0,10 10,0 10,0 0),(1 1,2 1,2 2,1 1),(5 5,6 5,6 6,5 5))",
+		"POLYGON((0 0,10 0,10 0,10 10,0 10,0 0))",
+		// hole touching the shell at a vertex
+		"POLYGON((0 0,10 0,10 10,0 10,0 0),(0 0,2 1,1 2,0 0))",
+		// island in a hole
+		"MULTIPOLYGON(((0 0,10 0,10 10,0 10,0 0),(1 1,9 1,9 9,1 9,1 1)),((2 2,8 2,8 8,2 8,2 2)))",
+		"MULTIPOLYGON(((0 0,1 0,1 1,0 0)),((1 1,2 1,2 2,1 1)))",
+		"LINEARRING(0 0,10 0,10 10,0 0)",
+		"GEOMETRYCOLLECTION(POINT(0 0),LINESTRING(0 0,0 0,1 1),POLYGON((0 0,1 0,1 1,0 0)))",
+		0
+	};
+	const char* invalid[] = {
+		// bow-tie
+		"POLYGON((0 0,10 10,10 0,0 10,0 0))",
+		"POLYGON((0 0,10 0,10 10,0 10,0 0),(11 1,12 1,12 2,11 1))",
+		"POLYGON((0 0,10 0,10 10,0 10,0 0),(1 1,9 1,9 9,1 9,1 1),(2 2,3 2,3 3,2 2))",
+		// hole touching the shell along a segment
+		"POLYGON((0 0,10 0,10 10,0 10,0 0),(0 0,5 0,1 2,0 0))",
+		// spike
+		"POLYGON((0 0,10 0,10 10,0 10,0 5,-5 5,0 5,0 0))",
+		"POLYGON((0 0,10 0,10 10,0 10,0 0),(1 1,2 1,2 2,1 2,1 1),(1 1,2 1,2 2,1 2,1 1))",
+		"MULTIPOLYGON(((0 0,10 0,10 10,0 10,0 0)),((2 2,8 2,8 8,2 8,2 2)))",
+		"MULTIPOLYGON(((0 0,10 0,10 10,0 10,0 0)),((5 5,15 5,15 15,5 15,5 5)))",
+		// holes disconnecting the interior
+		"POLYGON((0 0,10 0,10 10,0 10,0 0),(5 0,10 5,5 10,0 5,5 0))",
+		"LINEARRING(0 0,10 10,10 0,0 10,0 0)",
+		"LINESTRING(1 1,1 1)",
+		"GEOMETRYCOLLECTION(POINT(0 0),POLYGON((0 0,10 10,10 0,0 10,0 0)))",
+		0
+	};
+
+	for (const char** wkt = valid; *wkt; ++wkt)
+	{
+		GeomPtr g(reader_.read(*wkt));
+		IsValidOp op1(g.get());
+		IsValidOp op2(g.get());
+		ensure(*wkt, op1.isValid());
+		ensure(*wkt, 0 == op2.getValidationError());
+		ensure(*wkt, 0 == op1.getValidationError());
+	}
+	for (const char** wkt = invalid; *wkt; ++wkt)
+	{
+		GeomPtr g(reader_.read(*wkt));
+		IsValidOp op1(g.get());
+		IsValidOp op2(g.get());
+		ensure(*wkt, !op1.isValid());
+		ensure(*wkt, 0 != op2.getValidationError());
+		ensure(*wkt, 0 != op1.getValidationError());
+		ensure_equals(*wkt, op1.getValidationError()->getErrorType(),
+		              op2.getValidationError()->getErrorType());
+	}
+    }
 
 } // namespace tut